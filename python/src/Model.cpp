@@ -100,6 +100,12 @@ namespace einsum_ir {
           return einsum_ir::model::common::DType::FP32;
         case dtype_t::fp64:
           return einsum_ir::model::common::DType::FP64;
+        // BF16 GEMMs accumulate in FP32
+        case dtype_t::bf16:
+          return einsum_ir::model::common::DType::FP32;
+        // FP16 GEMMs of the tensor operations accumulate in FP32
+        case dtype_t::fp16:
+          return einsum_ir::model::common::DType::FP32;
         default:
           return einsum_ir::model::common::DType::FP32;
       }
@@ -45,6 +45,10 @@ namespace einsum_ir {
         relu = 3,
         gemm = 4,
         brgemm = 5,
+        gelu = 6,
+        silu = 7,
+        sigmoid = 8,
+        tanh = 9,
         undefined = 99
       };
 
@@ -60,7 +64,9 @@ namespace einsum_ir {
       /// data type
       enum class dtype_t : uint32_t {
         fp32 = 0,
-        fp64 = 1
+        fp64 = 1,
+        bf16 = 2,
+        fp16 = 3
       };
 
       /**
@@ -82,7 +88,7 @@ namespace einsum_ir {
        * @param exec_types Execution types for each dimension.
        * @param dim_sizes Sizes of each dimension.
        * @param strides 3D stride tensor.
-       * @param dtype The data type (fp32 or fp64).
+       * @param dtype The data type (fp32, fp64, bf16 or fp16).
        * @return Estimated execution time in seconds.
        */
       double predict(prim_t prim_main,
@@ -100,7 +106,7 @@ namespace einsum_ir {
        * @param exec_types Execution types for each dimension.
        * @param dim_sizes Sizes of each dimension.
        * @param strides 3D stride tensor.
-       * @param dtype The data type (fp32 or fp64).
+       * @param dtype The data type (fp32, fp64, bf16 or fp16).
        * @return Estimated GFLOPS for one GEMM iteration.
        */
       double predict_gflops(prim_t prim_main,
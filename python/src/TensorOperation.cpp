@@ -1,4 +1,5 @@
 #include "TensorOperation.h"
+#include <einsum_ir/basic/hardware.h>
 #include <einsum_ir/basic/threading.h>
 #include <cstdint>
 #include <tuple>
@@ -130,6 +131,14 @@ einsum_ir::basic::kernel_t einsum_ir::py::TensorOperation::convert_prim_to_kerne
       return einsum_ir::basic::kernel_t::COPY;
     case einsum_ir::py::TensorOperation::prim_t::relu:
       return einsum_ir::basic::kernel_t::RELU;
+    case einsum_ir::py::TensorOperation::prim_t::gelu:
+      return einsum_ir::basic::kernel_t::GELU;
+    case einsum_ir::py::TensorOperation::prim_t::silu:
+      return einsum_ir::basic::kernel_t::SILU;
+    case einsum_ir::py::TensorOperation::prim_t::sigmoid:
+      return einsum_ir::basic::kernel_t::SIGMOID;
+    case einsum_ir::py::TensorOperation::prim_t::tanh:
+      return einsum_ir::basic::kernel_t::TANH;
     case einsum_ir::py::TensorOperation::prim_t::gemm:
       return einsum_ir::basic::kernel_t::MADD;
     case einsum_ir::py::TensorOperation::prim_t::brgemm:
@@ -213,6 +222,8 @@ int64_t einsum_ir::py::TensorOperation::dtype_to_num_bytes( dtype_t dtype ) {
   switch (dtype) {
     case dtype_t::fp32: return sizeof(float);
     case dtype_t::fp64: return sizeof(double);
+    case dtype_t::bf16: return 2;
+    case dtype_t::fp16: return 2;
     default:            return 0; // Undefined or unsupported type
   }
 }
@@ -299,6 +310,8 @@ einsum_ir::py::TensorOperation::error_t einsum_ir::py::TensorOperation::setup_un
   switch (dtype) {
     case dtype_t::fp32: l_dtype_in = einsum_ir::basic::data_t::FP32; break;
     case dtype_t::fp64: l_dtype_in = einsum_ir::basic::data_t::FP64; break;
+    case dtype_t::bf16: l_dtype_in = einsum_ir::basic::data_t::BF16; break;
+    case dtype_t::fp16: l_dtype_in = einsum_ir::basic::data_t::FP16; break;
     default:            l_dtype_in = einsum_ir::basic::data_t::UNDEFINED_DTYPE; break;
   }
   einsum_ir::basic::data_t l_dtype_comp = l_dtype_in;
@@ -412,12 +425,20 @@ einsum_ir::py::TensorOperation::error_t einsum_ir::py::TensorOperation::setup_bi
   switch (dtype) {
     case dtype_t::fp32: l_dtype_left = einsum_ir::basic::data_t::FP32; break;
     case dtype_t::fp64: l_dtype_left = einsum_ir::basic::data_t::FP64; break;
+    case dtype_t::bf16: l_dtype_left = einsum_ir::basic::data_t::BF16; break;
+    case dtype_t::fp16: l_dtype_left = einsum_ir::basic::data_t::FP16; break;
     default:            l_dtype_left = einsum_ir::basic::data_t::UNDEFINED_DTYPE; break;
   }
   l_dtype_right = l_dtype_left;
   l_dtype_comp  = l_dtype_left;
   l_dtype_out   = l_dtype_left;
 
+  // BF16 and FP16 contractions accumulate in FP32
+  if(    l_dtype_comp == einsum_ir::basic::data_t::BF16
+      || l_dtype_comp == einsum_ir::basic::data_t::FP16 ) {
+    l_dtype_comp = einsum_ir::basic::data_t::FP32;
+  }
+
   l_ktype_first = convert_prim_to_kernel(prim_first);
   l_ktype_main = convert_prim_to_kernel(prim_main);
   l_ktype_last = convert_prim_to_kernel(prim_last);
@@ -478,7 +499,7 @@ einsum_ir::py::OptimizationConfig einsum_ir::py::TensorOperation::get_default_op
   config.br_gemm_support     = true;
   config.packing_support     = true;
   config.sfc_support         = true;
-  config.l2_cache_size       = 1048576;  // 1 MiB
+  config.l2_cache_size       = einsum_ir::basic::get_hardware().l2_cache_size;
 
   return config;
 }
@@ -657,7 +678,8 @@ einsum_ir::py::TensorOperation::error_t einsum_ir::py::TensorOperation::optimize
 
   // Initialize optimizer (scalar_optim = false)
   einsum_ir::basic::UnaryOptimizer l_optimizer;
-  l_optimizer.init(&l_iters, num_threads, false);
+  int64_t l_num_bytes = 2 * dtype_to_num_bytes(dtype);
+  l_optimizer.init(&l_iters, num_threads, false, l_num_bytes);
 
   // Run optimization
   einsum_ir::basic::err_t l_err = l_optimizer.optimize();
@@ -723,9 +745,10 @@ einsum_ir::py::TensorOperation::error_t einsum_ir::py::TensorOperation::optimize
   // Convert main primitive type to kernel type  
   einsum_ir::basic::kernel_t l_kernel_main = convert_prim_to_kernel(prim_main);
   int64_t l_num_bytes = dtype_to_num_bytes(dtype);
+  // packed GEMMs are not available for BF16 and FP16
   einsum_ir::basic::packed_gemm_t l_packed_gemm_support =
-    packed_gemm_support ? einsum_ir::basic::packed_gemm_t::ALL_STRIDE_ONE
-                        : einsum_ir::basic::packed_gemm_t::NONE;
+    (packed_gemm_support && dtype != dtype_t::bf16 && dtype != dtype_t::fp16) ? einsum_ir::basic::packed_gemm_t::ALL_STRIDE_ONE
+                                                                              : einsum_ir::basic::packed_gemm_t::NONE;
 
   // Initialize optimizer
   einsum_ir::basic::ContractionOptimizer l_optimizer;
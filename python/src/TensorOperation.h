@@ -55,6 +55,10 @@ class einsum_ir::py::TensorOperation {
       relu      =  3,
       gemm      =  4,
       brgemm    =  5,
+      gelu      =  6,
+      silu      =  7,
+      sigmoid   =  8,
+      tanh      =  9,
       undefined = 99
     };
 
@@ -70,7 +74,9 @@ class einsum_ir::py::TensorOperation {
     /// data type
     enum class dtype_t : uint32_t {
       fp32 = 0,
-      fp64 = 1
+      fp64 = 1,
+      bf16 = 2,
+      fp16 = 3
     };
 
     /// error codes
@@ -20,15 +20,21 @@ PYBIND11_MODULE(_etops_core, m) {
   py::enum_<TensorOperation::dtype_t>(m, "DataType" )
     .value("float32",  TensorOperation::dtype_t::fp32)
     .value("float64",  TensorOperation::dtype_t::fp64)
+    .value("bfloat16", TensorOperation::dtype_t::bf16)
+    .value("float16",  TensorOperation::dtype_t::fp16)
     .export_values();
 
   py::enum_<TensorOperation::prim_t>(m, "PrimType")
-    .value("none",   TensorOperation::prim_t::none)
-    .value("zero",   TensorOperation::prim_t::zero)
-    .value("relu",   TensorOperation::prim_t::relu)
-    .value("copy",   TensorOperation::prim_t::copy)
-    .value("gemm",   TensorOperation::prim_t::gemm)
-    .value("brgemm", TensorOperation::prim_t::brgemm)
+    .value("none",    TensorOperation::prim_t::none)
+    .value("zero",    TensorOperation::prim_t::zero)
+    .value("relu",    TensorOperation::prim_t::relu)
+    .value("gelu",    TensorOperation::prim_t::gelu)
+    .value("silu",    TensorOperation::prim_t::silu)
+    .value("sigmoid", TensorOperation::prim_t::sigmoid)
+    .value("tanh",    TensorOperation::prim_t::tanh)
+    .value("copy",    TensorOperation::prim_t::copy)
+    .value("gemm",    TensorOperation::prim_t::gemm)
+    .value("brgemm",  TensorOperation::prim_t::brgemm)
     .export_values();
 
   py::enum_<TensorOperation::exec_t>(m, "ExecType")
@@ -95,7 +101,7 @@ PYBIND11_MODULE(_etops_core, m) {
           - prim_main: gemm or brgemm
           - dim_types: use m, n, k, c as appropriate for contraction semantics
           - prim_first: zero or none (first touch operation)
-          - prim_last: relu or none (last touch operation)
+          - prim_last: relu, gelu, silu, sigmoid, tanh or none (last touch operation)
           - strides: [LEVEL][3][DIMENSION] tensor (each level has 3 tensors: in0, in1, out)
 
         Strides 3D tensor structure [LEVEL][TENSOR][DIMENSION]:
@@ -128,14 +134,25 @@ PYBIND11_MODULE(_etops_core, m) {
       "execute",
       [](
         TensorOperation & self,
-        py::array_t<float, py::array::c_style | py::array::forcecast> in0,
-        py::object                                                    in1,
-        py::array_t<float, py::array::c_style | py::array::forcecast> out
+        py::object        in0,
+        py::object        in1,
+        py::object        out
       ) {
+        // the data is passed without conversion to support all data types, e.g., bfloat16
+        py::array l_in0 = py::array::ensure( in0, py::array::c_style );
+        py::array l_in1;
+        if( !in1.is_none() ) {
+          l_in1 = py::array::ensure( in1, py::array::c_style );
+        }
+        py::array l_out = py::array::ensure( out, py::array::c_style );
+        if( !l_in0 || !l_out || ( !in1.is_none() && !l_in1 ) ) {
+          throw py::type_error( "tensors have to be arrays" );
+        }
+
         self.execute(
-          in0.data(),
-          in1.is_none() ? nullptr : py::array(in1).data(),
-          out.mutable_data()
+          l_in0.data(),
+          in1.is_none() ? nullptr : l_in1.data(),
+          l_out.mutable_data()
         );
       },
       R"doc(
@@ -143,6 +160,8 @@ PYBIND11_MODULE(_etops_core, m) {
 
         For binary operations: provide all three tensor arguments.
         For unary operations: pass None for in1 argument.
+        The element types of the arrays have to match the operation's data type,
+        bfloat16 data may be passed as uint16 arrays holding the raw bits.
 
         :param in0: First input tensor data.
         :param in1: Second input tensor data (pass None for unary operations).
@@ -39,26 +39,42 @@ dtype = DataType
 float32: _DataType = _DataType.float32
 #: Alias for DataType.float64
 float64: _DataType = _DataType.float64
+#: Alias for DataType.bfloat16
+bfloat16: _DataType = _DataType.bfloat16
+#: Alias for DataType.float16
+float16: _DataType = _DataType.float16
 
 class prim:
     """Namespace for primitive types used in tensor operations."""
     #: Alias for PrimType.none
-    none   = PrimType.none
+    none    = PrimType.none
     #: Alias for PrimType.zero
-    zero   = PrimType.zero
+    zero    = PrimType.zero
     #: Alias for PrimType.relu
-    relu   = PrimType.relu
+    relu    = PrimType.relu
+    #: Alias for PrimType.gelu
+    gelu    = PrimType.gelu
+    #: Alias for PrimType.silu
+    silu    = PrimType.silu
+    #: Alias for PrimType.sigmoid
+    sigmoid = PrimType.sigmoid
+    #: Alias for PrimType.tanh
+    tanh    = PrimType.tanh
     #: Alias for PrimType.copy
-    copy   = PrimType.copy
+    copy    = PrimType.copy
     #: Alias for PrimType.gemm
-    gemm   = PrimType.gemm
+    gemm    = PrimType.gemm
     #: Alias for PrimType.brgemm
-    brgemm = PrimType.brgemm
+    brgemm  = PrimType.brgemm
 
     __all__ = [
         "none",
         "zero",
         "relu",
+        "gelu",
+        "silu",
+        "sigmoid",
+        "tanh",
         "copy",
         "gemm",
         "brgemm"
@@ -169,7 +185,7 @@ class TensorOperationConfig:
       - prim_main: etops.prim.gemm or etops.prim.brgemm
       - dim_types: combination of etops.dim.m, .n, .k, .c
       - prim_first: etops.prim.zero or .none (optional first touch)
-      - prim_last: etops.prim.relu or .none (optional last touch)
+      - prim_last: etops.prim.relu, .gelu, .silu, .sigmoid, .tanh or .none (optional last touch)
       - strides: shape [1 or more][3][num_dims]
 
     Unary Operations:
@@ -278,10 +294,15 @@ class TensorOperationConfig:
                 )
 
             # Validate prim_last is compatible
-            if self.prim_last not in [PrimType.none, PrimType.relu]:
+            if self.prim_last not in [PrimType.none,
+                                      PrimType.relu,
+                                      PrimType.gelu,
+                                      PrimType.silu,
+                                      PrimType.sigmoid,
+                                      PrimType.tanh]:
                 raise ValueError(
-                    f"For binary contractions, prim_last must be etops.prim.none or "
-                    f"etops.prim.relu, got {self.prim_last}."
+                    f"For binary contractions, prim_last must be etops.prim.none, "
+                    f".relu, .gelu, .silu, .sigmoid or .tanh, got {self.prim_last}."
                 )
 
     def apply(self, op: _CppOp) -> None:
@@ -531,7 +552,7 @@ class _TPPBackend:
             - br_gemm_support (bool): Batch-reduce GEMM support.
             - packing_support (bool): Packing support.
             - sfc_support (bool): SFC support.
-            - l2_cache_size (int): L2 cache size in bytes (default: 1048576)
+            - l2_cache_size (int): L2 cache size in bytes (default: per-core share of the host's L2 cache)
         """
         return _CppOp.get_default_optimization_config("tpp")
 
@@ -624,6 +645,8 @@ __all__ = [
     "dtype",
     "float32",
     "float64",
+    "bfloat16",
+    "float16",
     "prim",
     "etype",
     "exec",
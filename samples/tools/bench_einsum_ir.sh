@@ -22,7 +22,7 @@ while getopts 'pe:l:r:b:d:k:n:hv' flag; do
        echo "      0: Use expr + contraction path, do NOT reorder dimensions"
        echo "      1: Use expr + contraction path, do     reorder dimensions."
        echo "      2: Use pre-optimized einsum tree."
-       echo "  -k: Benchmark keys to run (default: all, options: syn,tt,fctn,tw,getd,trn,mera,tnlm,tccg_blocked,tccg_blocked_reordered,fc)"
+       echo "  -k: Benchmark keys to run (default: all, options: syn,tt,fctn,tw,getd,trn,mera,tnlm,tccg_blocked,tccg_blocked_reordered,tccg_large,fc)"
        echo "  -n: Number of cores to use (default: detected from system)"
        echo "  -v: Verbose output (default: off)"; exit 0 ;;
     *) echo "Unexpected option ${flag}"
@@ -103,6 +103,7 @@ if [ "$mode" = "0" ] || [ "$mode" = "1" ]; then
   settings["tnlm"]="einsum_benchmark/lm_first_last_brackets_4_16d.cfg"
   settings["tccg_blocked_reordered"]="tccg/settings_blocked_reordered.cfg"
   settings["tccg_blocked"]="tccg/settings_blocked.cfg"
+  settings["tccg_large"]="tccg/settings_large.cfg"
   settings["fc"]="tensor_layers/fc.cfg"
 else
   settings["syn"]="einsum_benchmark/synthetic_et.cfg"
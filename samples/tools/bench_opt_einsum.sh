@@ -75,6 +75,7 @@ settings["mera"]="einsum_benchmark/str_nw_mera_open_26.cfg"
 settings["tnlm"]="einsum_benchmark/lm_first_last_brackets_4_16d.cfg"
 settings["tccg_blocked_reordered"]="tccg/settings_blocked_reordered.cfg"
 settings["tccg_blocked"]="tccg/settings_blocked.cfg"
+settings["tccg_large"]="tccg/settings_large.cfg"
 
 for key in $(echo "${!settings[@]}" | tr ' ' '\n')
 do
@@ -1,4 +1,7 @@
 #include "BinaryContraction.h"
+#include "../basic/binary/ContractionOptimizer.h"
+#include "../basic/hardware.h"
+#include "../model/src/common/common.h"
 #include <list>
 #include <algorithm>
 #include <cassert>
@@ -346,7 +349,323 @@ void einsum_ir::backend::BinaryContraction::init( int64_t
 
   m_num_threads = i_num_threads;
   
-  m_l2_cache_size = 1024 * 1024; // default to 1MB L2 cache size
+  m_l2_cache_size = basic::get_hardware().l2_cache_size;
+}
+
+void einsum_ir::backend::BinaryContraction::set_dynamic_scheduling( bool i_dynamic ) {
+  m_dynamic_scheduling = i_dynamic;
+}
+
+void einsum_ir::backend::BinaryContraction::set_l3_blocking( bool i_l3_blocking ) {
+  m_l3_blocking = i_l3_blocking;
+}
+
+void einsum_ir::backend::BinaryContraction::set_quant( float const * i_scales,
+                                                       int64_t       i_dim_id_channel,
+                                                       int32_t       i_zero_point ) {
+  m_quant_scales         = i_scales;
+  m_quant_dim_id_channel = i_dim_id_channel;
+  m_quant_zero_point     = i_zero_point;
+}
+
+void einsum_ir::backend::BinaryContraction::set_last_touch_params( basic::last_touch_params const & i_params ) {
+  m_last_touch_params = i_params;
+}
+
+void einsum_ir::backend::BinaryContraction::set_packing_prologue( kernel_t                         i_ktype_left,
+                                                                  kernel_t                         i_ktype_right,
+                                                                  basic::last_touch_params const & i_params ) {
+  m_ktype_prologue_left  = i_ktype_left;
+  m_ktype_prologue_right = i_ktype_right;
+  m_prologue_params      = i_params;
+}
+
+void einsum_ir::backend::BinaryContraction::set_block_sparsity( std::vector< int64_t > const & i_dim_ids_blocks_left,
+                                                                uint8_t                const * i_mask_blocks_left,
+                                                                std::vector< int64_t > const & i_dim_ids_blocks_right,
+                                                                uint8_t                const * i_mask_blocks_right ) {
+  m_dim_ids_blocks_left  = i_dim_ids_blocks_left;
+  m_mask_blocks_left     = i_mask_blocks_left;
+  m_dim_ids_blocks_right = i_dim_ids_blocks_right;
+  m_mask_blocks_right    = i_mask_blocks_right;
+}
+
+einsum_ir::basic::quant_params einsum_ir::backend::BinaryContraction::quant( std::map< int64_t, int64_t > const & i_strides_out ) const {
+  basic::quant_params l_quant;
+  l_quant.scales     = m_quant_scales;
+  l_quant.zero_point = m_quant_zero_point;
+
+  if( m_quant_dim_id_channel >= 0 ) {
+    l_quant.num_scales     = m_dim_sizes_outer_out->at( m_quant_dim_id_channel );
+    l_quant.stride_channel = i_strides_out.at( m_quant_dim_id_channel );
+  }
+
+  return l_quant;
+}
+
+std::vector< int64_t > einsum_ir::backend::BinaryContraction::strides_mask( std::vector< int64_t > const & i_dim_ids_blocks ) const {
+  std::vector< int64_t > l_strides( i_dim_ids_blocks.size() );
+
+  int64_t l_stride = 1;
+  for( int64_t l_bl = (int64_t) i_dim_ids_blocks.size() - 1; l_bl >= 0; l_bl-- ) {
+    l_strides[l_bl] = l_stride;
+    l_stride *= m_dim_sizes_inner->at( i_dim_ids_blocks[l_bl] );
+  }
+
+  return l_strides;
+}
+
+einsum_ir::basic::block_sparsity einsum_ir::backend::BinaryContraction::block_sparsity( std::vector< int64_t >       const & i_dim_ids_blocks,
+                                                                                        uint8_t                      const * i_mask_blocks,
+                                                                                        std::map< int64_t, int64_t > const * i_dim_sizes_outer,
+                                                                                        std::map< int64_t, int64_t > const & i_strides ) const {
+  basic::block_sparsity l_sparsity;
+  if( i_mask_blocks == nullptr ) {
+    return l_sparsity;
+  }
+
+  l_sparsity.mask = i_mask_blocks;
+  l_sparsity.strides_mask = strides_mask( i_dim_ids_blocks );
+  for( std::size_t l_bl = 0; l_bl < i_dim_ids_blocks.size(); l_bl++ ) {
+    l_sparsity.strides.push_back( i_strides.at( i_dim_ids_blocks[l_bl] ) );
+    l_sparsity.sizes.push_back( i_dim_sizes_outer->at( i_dim_ids_blocks[l_bl] ) );
+  }
+
+  return l_sparsity;
+}
+
+double einsum_ir::backend::BinaryContraction::density_blocks() const {
+  if(    m_mask_blocks_left  == nullptr
+      && m_mask_blocks_right == nullptr ) {
+    return 1.0;
+  }
+
+  // strides of the union of the block dimensions in the masks
+  std::vector< int64_t > l_dim_ids;
+  std::map< int64_t, int64_t > l_strides_left;
+  std::map< int64_t, int64_t > l_strides_right;
+
+  if( m_mask_blocks_left != nullptr ) {
+    std::vector< int64_t > l_strides = strides_mask( m_dim_ids_blocks_left );
+    for( std::size_t l_bl = 0; l_bl < l_strides.size(); l_bl++ ) {
+      l_dim_ids.push_back( m_dim_ids_blocks_left[l_bl] );
+      l_strides_left[ m_dim_ids_blocks_left[l_bl] ] = l_strides[l_bl];
+    }
+  }
+  if( m_mask_blocks_right != nullptr ) {
+    std::vector< int64_t > l_strides = strides_mask( m_dim_ids_blocks_right );
+    for( std::size_t l_bl = 0; l_bl < l_strides.size(); l_bl++ ) {
+      if( l_strides_left.count( m_dim_ids_blocks_right[l_bl] ) == 0 ) {
+        l_dim_ids.push_back( m_dim_ids_blocks_right[l_bl] );
+      }
+      l_strides_right[ m_dim_ids_blocks_right[l_bl] ] = l_strides[l_bl];
+    }
+  }
+
+  int64_t l_num_blocks = 1;
+  for( std::size_t l_di = 0; l_di < l_dim_ids.size(); l_di++ ) {
+    l_num_blocks *= m_dim_sizes_inner->at( l_dim_ids[l_di] );
+  }
+
+  // count the combinations of blocks which are non-zero in both masks
+  int64_t l_num_non_zero = 0;
+  for( int64_t l_bl = 0; l_bl < l_num_blocks; l_bl++ ) {
+    int64_t l_rem = l_bl;
+    int64_t l_id_left = 0;
+    int64_t l_id_right = 0;
+    for( int64_t l_di = (int64_t) l_dim_ids.size() - 1; l_di >= 0; l_di-- ) {
+      int64_t l_size = m_dim_sizes_inner->at( l_dim_ids[l_di] );
+      int64_t l_idx = l_rem % l_size;
+      l_rem /= l_size;
+
+      if( l_strides_left.count( l_dim_ids[l_di] ) > 0 ) {
+        l_id_left += l_idx * l_strides_left.at( l_dim_ids[l_di] );
+      }
+      if( l_strides_right.count( l_dim_ids[l_di] ) > 0 ) {
+        l_id_right += l_idx * l_strides_right.at( l_dim_ids[l_di] );
+      }
+    }
+
+    if(    ( m_mask_blocks_left  == nullptr || m_mask_blocks_left[l_id_left]   != 0 )
+        && ( m_mask_blocks_right == nullptr || m_mask_blocks_right[l_id_right] != 0 ) ) {
+      l_num_non_zero++;
+    }
+  }
+
+  return (double) l_num_non_zero / (double) l_num_blocks;
+}
+
+void einsum_ir::backend::BinaryContraction::restore_loops_opt( std::vector< basic::iter_property > const & i_loops,
+                                                               basic::kernel_t                             i_ktype_main,
+                                                               int64_t                                     i_num_threads_shared,
+                                                               int64_t                                     i_num_threads_m,
+                                                               int64_t                                     i_num_threads_n ) {
+  m_loops_opt = i_loops;
+  m_ktype_main_opt = i_ktype_main;
+  m_num_threads_shared_opt = i_num_threads_shared;
+  m_num_threads_m_opt = i_num_threads_m;
+  m_num_threads_n_opt = i_num_threads_n;
+  m_loops_opt_restored = true;
+}
+
+void einsum_ir::backend::BinaryContraction::set_optimizer_config( basic::optimizer_config const & i_config ) {
+  m_optimizer_config = i_config;
+}
+
+einsum_ir::basic::optimizer_config einsum_ir::backend::BinaryContraction::resolve_optimizer_config( int64_t i_target_m,
+                                                                                                   int64_t i_target_n,
+                                                                                                   int64_t i_target_k,
+                                                                                                   bool    i_packing ) const {
+  basic::optimizer_config l_config = m_optimizer_config;
+
+  if( l_config.target_m <= 0 ) {
+    l_config.target_m = i_target_m;
+  }
+  if( l_config.target_n <= 0 ) {
+    l_config.target_n = i_target_n;
+  }
+  if( l_config.target_k <= 0 ) {
+    l_config.target_k = i_target_k;
+  }
+  if( l_config.l2_cache_size <= 0 ) {
+    l_config.l2_cache_size = m_l2_cache_size;
+  }
+  l_config.packing = l_config.packing && i_packing;
+
+  // the thread split has to use all threads
+  if(    l_config.num_threads_shared <= 0
+      || l_config.num_threads_m <= 0
+      || l_config.num_threads_n <= 0
+      || l_config.num_threads_shared * l_config.num_threads_m * l_config.num_threads_n != m_num_threads ) {
+    l_config.num_threads_shared = 0;
+    l_config.num_threads_m = 0;
+    l_config.num_threads_n = 0;
+  }
+
+  return l_config;
+}
+
+void einsum_ir::backend::BinaryContraction::store_loops_opt( basic::optimizer_config             const & i_config,
+                                                             std::vector< basic::iter_property > const & i_loops,
+                                                             basic::kernel_t                             i_ktype_main,
+                                                             int64_t                                   & io_num_threads_shared,
+                                                             int64_t                                   & io_num_threads_m,
+                                                             int64_t                                   & io_num_threads_n ) {
+  if( i_config.num_threads_shared > 0 ) {
+    io_num_threads_shared = i_config.num_threads_shared;
+    io_num_threads_m      = i_config.num_threads_m;
+    io_num_threads_n      = i_config.num_threads_n;
+  }
+
+  m_loops_opt = i_loops;
+  m_ktype_main_opt = i_ktype_main;
+  m_num_threads_shared_opt = io_num_threads_shared;
+  m_num_threads_m_opt = io_num_threads_m;
+  m_num_threads_n_opt = io_num_threads_n;
+}
+
+void einsum_ir::backend::BinaryContraction::set_time_model( basic::ContractionOptimizer & io_optim ) const {
+  // tuned kernel targets take precedence
+  if(    m_optimizer_config.target_m > 0
+      || m_optimizer_config.target_n > 0
+      || m_optimizer_config.target_k > 0 ) {
+    return;
+  }
+
+  // models and default bandwidths (GB/s) of the packing
+  static std::string const l_uarch = basic::host_uarch();
+  model::common::Model l_model = model::common::Model::GENERIC;
+  double l_bandwidth = 0;
+  if(      l_uarch == "zen5" ) { l_model = model::common::Model::ZEN5; l_bandwidth = 40; }
+  else if( l_uarch == "m4"   ) { l_model = model::common::Model::M4;   l_bandwidth = 60; }
+  else if( l_uarch == "a76"  ) { l_model = model::common::Model::A76;  l_bandwidth = 12; }
+  else {
+    return;
+  }
+
+  // the models have no BF16 data, BF16 GEMMs accumulate in FP32
+  model::common::DType l_dtype = model::common::DType::FP32;
+  if(      m_dtype_comp == data_t::FP32 ) l_dtype = model::common::DType::FP32;
+  else if( m_dtype_comp == data_t::FP64 ) l_dtype = model::common::DType::FP64;
+  else if( m_dtype_comp == data_t::FP16 ) l_dtype = model::common::DType::FP16;
+  else {
+    return;
+  }
+  if( ce_cpx_op( m_ktype_main ) ) {
+    return;
+  }
+
+  io_optim.set_time_model( [l_model, l_dtype]( int64_t i_m,
+                                               int64_t i_n,
+                                               int64_t i_k,
+                                               bool    i_trans_a,
+                                               bool    i_trans_b ) {
+                             double l_gflops = 0;
+                             return model::common::get_time_model( (int) i_m,
+                                                                   (int) i_n,
+                                                                   (int) i_k,
+                                                                   i_trans_a,
+                                                                   i_trans_b,
+                                                                   l_dtype,
+                                                                   l_model,
+                                                                   l_gflops );
+                           },
+                           l_bandwidth );
+}
+
+std::string einsum_ir::backend::BinaryContraction::signature() const {
+  std::string l_sig = "";
+
+  int64_t                      const   l_num_dims[3]    = { m_num_dims_left,
+                                                            m_num_dims_right,
+                                                            m_num_dims_out };
+  int64_t                      const * l_dim_ids[3]     = { m_dim_ids_left,
+                                                            m_dim_ids_right,
+                                                            m_dim_ids_out };
+  std::map< int64_t, int64_t > const * l_sizes_outer[3] = { m_dim_sizes_outer_left,
+                                                            m_dim_sizes_outer_right,
+                                                            m_dim_sizes_outer_out };
+
+  // dimensions of the tensors: id, inner size and outer size
+  for( int64_t l_te = 0; l_te < 3; l_te++ ) {
+    for( int64_t l_di = 0; l_di < l_num_dims[l_te]; l_di++ ) {
+      int64_t l_id = l_dim_ids[l_te][l_di];
+      l_sig += std::to_string( l_id ) + ":"
+             + std::to_string( m_dim_sizes_inner->at( l_id ) ) + "/"
+             + std::to_string( l_sizes_outer[l_te]->at( l_id ) ) + ",";
+    }
+    l_sig += "|";
+  }
+
+  // auxiliary tensor
+  if( m_dim_sizes_outer_out_aux != nullptr ) {
+    for( int64_t l_di = 0; l_di < m_num_dims_out; l_di++ ) {
+      l_sig += std::to_string( m_dim_sizes_outer_out_aux->at( m_dim_ids_out[l_di] ) ) + ",";
+    }
+  }
+  l_sig += "|";
+
+  // data types, kernels and threads
+  int64_t const l_props[] = { m_dtype_left,
+                              m_dtype_right,
+                              m_dtype_comp,
+                              m_dtype_out,
+                              m_ktype_first_touch,
+                              m_ktype_main,
+                              m_ktype_last_touch,
+                              m_ktype_prologue_left,
+                              m_ktype_prologue_right,
+                              m_mask_blocks_left  != nullptr,
+                              m_mask_blocks_right != nullptr,
+                              m_num_threads };
+  for( int64_t l_prop : l_props ) {
+    l_sig += std::to_string( l_prop ) + ",";
+  }
+
+  return l_sig;
+}
+
+void einsum_ir::backend::BinaryContraction::first_touch_out( void * ) {
 }
 
 einsum_ir::err_t einsum_ir::backend::BinaryContraction::compile_base() {
@@ -422,6 +741,18 @@ einsum_ir::err_t einsum_ir::backend::BinaryContraction::compile_base() {
     m_dim_types.insert( l_pair );
   }
 
+  // block dimensions have to be dimensions of the respective input tensor
+  for( std::size_t l_bl = 0; l_bl < m_dim_ids_blocks_left.size(); l_bl++ ) {
+    if( std::find( m_dim_ids_left, m_dim_ids_left + m_num_dims_left, m_dim_ids_blocks_left[l_bl] ) == m_dim_ids_left + m_num_dims_left ) {
+      return err_t::INVALID_ID;
+    }
+  }
+  for( std::size_t l_bl = 0; l_bl < m_dim_ids_blocks_right.size(); l_bl++ ) {
+    if( std::find( m_dim_ids_right, m_dim_ids_right + m_num_dims_right, m_dim_ids_blocks_right[l_bl] ) == m_dim_ids_right + m_num_dims_right ) {
+      return err_t::INVALID_ID;
+    }
+  }
+
   if( m_loop_ids_ext != nullptr ){
     m_loop_ids_int.clear();
     m_loop_ids_int.reserve(m_loop_ids_ext->size());
@@ -450,15 +781,44 @@ int64_t einsum_ir::backend::BinaryContraction::num_ops() {
     l_size_k *= m_sizes_k[l_k];
   }
 
-  int64_t l_num_ops = l_size_c * l_size_m * l_size_n * l_size_k * 2;
+  int64_t l_num_ops = num_ops( l_size_c,
+                               l_size_m,
+                               l_size_n,
+                               l_size_k,
+                               m_ktype_first_touch,
+                               m_ktype_main );
+
+  // remove the multiply-adds of zero blocks
+  double l_density = density_blocks();
+  if( l_density < 1.0 ) {
+    int64_t l_num_ops_dense = num_ops( l_size_c,
+                                       l_size_m,
+                                       l_size_n,
+                                       l_size_k,
+                                       kernel_t::UNDEFINED_KTYPE,
+                                       m_ktype_main );
+    l_num_ops -= std::llround( (1.0 - l_density) * (double) l_num_ops_dense );
+    l_num_ops = std::max( l_num_ops, (int64_t) 0 );
+  }
+
+  return l_num_ops;
+}
+
+int64_t einsum_ir::backend::BinaryContraction::num_ops( int64_t  i_size_c,
+                                                        int64_t  i_size_m,
+                                                        int64_t  i_size_n,
+                                                        int64_t  i_size_k,
+                                                        kernel_t i_ktype_first_touch,
+                                                        kernel_t i_ktype_main ) {
+  int64_t l_num_ops = i_size_c * i_size_m * i_size_n * i_size_k * 2;
 
-  if( m_ktype_main == kernel_t::CPX_MADD ) {
+  if( i_ktype_main == kernel_t::CPX_MADD ) {
     l_num_ops *= 2; // four matrix mults ignoring previously counted batch dim
   }
 
-  if(    m_ktype_first_touch == ZERO
-      || m_ktype_first_touch == CPX_ZERO ) {
-    l_num_ops -= l_size_c * l_size_m * l_size_n;
+  if(    i_ktype_first_touch == ZERO
+      || i_ktype_first_touch == CPX_ZERO ) {
+    l_num_ops -= i_size_c * i_size_m * i_size_n;
   }
 
   return l_num_ops;
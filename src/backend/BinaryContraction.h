@@ -4,10 +4,14 @@
 #include <cstdint>
 #include <vector>
 #include <map>
+#include <string>
 #include "../constants.h"
 #include "MemoryManager.h"
 
 namespace einsum_ir {
+  namespace basic {
+    class ContractionOptimizer;
+  }
   namespace backend {
     class BinaryContraction;
   }
@@ -138,6 +142,53 @@ class einsum_ir::backend::BinaryContraction {
     //! size of the L2 cache in bytes
     int64_t m_l2_cache_size = 1;
 
+    //! true if the shared tasks are scheduled dynamically
+    bool m_dynamic_scheduling = false;
+
+    //! true if the outer iterations are blocked for the L3 cache
+    bool m_l3_blocking = false;
+
+    //! scales of the requantization, nullptr if the accumulators are not requantized
+    float const * m_quant_scales = nullptr;
+    //! id of the channel dimension of per-channel scales, -1 for per-tensor scales
+    int64_t m_quant_dim_id_channel = -1;
+    //! zero point of INT8 outputs
+    int32_t m_quant_zero_point = 0;
+
+    //! parameters of the last-touch kernel
+    basic::last_touch_params m_last_touch_params;
+
+    //! elementwise kernels applied to the left and right input tensors while packing
+    kernel_t m_ktype_prologue_left = kernel_t::UNDEFINED_KTYPE;
+    kernel_t m_ktype_prologue_right = kernel_t::UNDEFINED_KTYPE;
+    //! parameters of the packing prologues
+    basic::last_touch_params m_prologue_params;
+
+    //! block dimensions of the left input tensor
+    std::vector< int64_t > m_dim_ids_blocks_left;
+    //! block dimensions of the right input tensor
+    std::vector< int64_t > m_dim_ids_blocks_right;
+    //! masks of the left input tensor's blocks, nullptr if dense
+    uint8_t const * m_mask_blocks_left = nullptr;
+    //! masks of the right input tensor's blocks, nullptr if dense
+    uint8_t const * m_mask_blocks_right = nullptr;
+
+    //! loops derived by the contraction optimizer
+    std::vector< basic::iter_property > m_loops_opt;
+    //! main kernel type derived by the contraction optimizer
+    basic::kernel_t m_ktype_main_opt = basic::kernel_t::UNDEFINED_KTYPE;
+    //! number of threads parallelizing the shared loops
+    int64_t m_num_threads_shared_opt = 1;
+    //! number of threads parallelizing the m dimension
+    int64_t m_num_threads_m_opt = 1;
+    //! number of threads parallelizing the n dimension
+    int64_t m_num_threads_n_opt = 1;
+    //! true if the optimized loops were restored and the contraction optimizer is skipped
+    bool m_loops_opt_restored = false;
+
+    //! parameters of the contraction optimizer which overwrite the backend's defaults
+    basic::optimizer_config m_optimizer_config;
+
     /**
      * Derives the dimension types of tensor t2 w.r.t. tensors t0 and t1.
      *
@@ -248,6 +299,44 @@ class einsum_ir::backend::BinaryContraction {
                          std::map< int64_t, int64_t > const * i_dim_sizes,
                          std::map< int64_t, int64_t >       * o_strides );
 
+    /**
+     * Derives the requantization parameters of the basic backends.
+     *
+     * @param i_strides_out strides of the output tensor.
+     * @return requantization parameters.
+     **/
+    basic::quant_params quant( std::map< int64_t, int64_t > const & i_strides_out ) const;
+
+    /**
+     * Derives the strides of the block dimensions in a mask.
+     * The masks are stored row-major w.r.t. to the given order of the block dimensions.
+     *
+     * @param i_dim_ids_blocks ids of the block dimensions.
+     * @return strides of the block dimensions in the mask.
+     **/
+    std::vector< int64_t > strides_mask( std::vector< int64_t > const & i_dim_ids_blocks ) const;
+
+    /**
+     * Derives the block sparsity of an input tensor for the basic backends.
+     *
+     * @param i_dim_ids_blocks ids of the block dimensions.
+     * @param i_mask_blocks mask of the blocks, nullptr if dense.
+     * @param i_dim_sizes_outer outer sizes of the input tensor.
+     * @param i_strides strides of the input tensor.
+     * @return block sparsity.
+     **/
+    basic::block_sparsity block_sparsity( std::vector< int64_t >       const & i_dim_ids_blocks,
+                                          uint8_t                      const * i_mask_blocks,
+                                          std::map< int64_t, int64_t > const * i_dim_sizes_outer,
+                                          std::map< int64_t, int64_t > const & i_strides ) const;
+
+    /**
+     * Gets the fraction of the multiply-add operations which involve non-zero blocks of both input tensors.
+     *
+     * @return density of the contraction, 1 for dense input tensors.
+     **/
+    double density_blocks() const;
+
     /**
      * Virtual destructor.
      **/
@@ -347,6 +436,145 @@ class einsum_ir::backend::BinaryContraction {
                kernel_t                             i_ktype_last_touch,
                int64_t                              i_num_threads  );
 
+    /**
+     * Enables or disables dynamic scheduling of the shared tasks.
+     * Has to be called before compilation.
+     *
+     * @param i_dynamic true if the shared tasks are claimed dynamically by the threads.
+     **/
+    void set_dynamic_scheduling( bool i_dynamic );
+
+    /**
+     * Enables or disables the blocking of the outer iterations for the L3 cache.
+     * Has to be called before compilation.
+     *
+     * @param i_l3_blocking true if the outer iterations are blocked for the L3 cache.
+     **/
+    void set_l3_blocking( bool i_l3_blocking );
+
+    /**
+     * Sets the requantization of INT32 accumulators to INT8 or FP32 outputs.
+     * Has to be called before compilation.
+     *
+     * @param i_scales scales, one per entry of the channel dimension or a single one for the entire tensor.
+     * @param i_dim_id_channel id of the output tensor's channel dimension, -1 for a single scale.
+     * @param i_zero_point zero point which is added to INT8 outputs.
+     **/
+    void set_quant( float const * i_scales,
+                    int64_t       i_dim_id_channel,
+                    int32_t       i_zero_point );
+
+    /**
+     * Sets the parameters of the SCALE_SHIFT and CLAMP last-touch kernels.
+     * Has to be called before compilation.
+     *
+     * @param i_params parameters of the last-touch kernel.
+     **/
+    void set_last_touch_params( basic::last_touch_params const & i_params );
+
+    /**
+     * Sets elementwise kernels which are applied to the input tensors while packing them, e.g., a ReLU.
+     * The TPP backend packs the respective input tensors; the other backends fail to compile.
+     * Has to be called before compilation.
+     *
+     * @param i_ktype_left kernel applied to the left input tensor, UNDEFINED_KTYPE if none.
+     * @param i_ktype_right kernel applied to the right input tensor, UNDEFINED_KTYPE if none.
+     * @param i_params parameters of SCALE_SHIFT and CLAMP.
+     **/
+    void set_packing_prologue( kernel_t                         i_ktype_left,
+                               kernel_t                         i_ktype_right,
+                               basic::last_touch_params const & i_params );
+
+    /**
+     * Sets the block sparsity of the input tensors.
+     * The blocks are given by the indices of the block dimensions, i.e., the tensors are blocked by splitting dimensions.
+     * The masks hold one entry per block, zero if all values of the block are zero, and are row-major w.r.t. the block dimensions.
+     * The contraction skips zero blocks; the TPP backend disables packing and batch-reduce kernels for block-sparse inputs.
+     * Has to be called before compilation.
+     *
+     * @param i_dim_ids_blocks_left ids of the left input tensor's block dimensions.
+     * @param i_mask_blocks_left mask of the left input tensor's blocks, nullptr if dense.
+     * @param i_dim_ids_blocks_right ids of the right input tensor's block dimensions.
+     * @param i_mask_blocks_right mask of the right input tensor's blocks, nullptr if dense.
+     **/
+    void set_block_sparsity( std::vector< int64_t > const & i_dim_ids_blocks_left,
+                             uint8_t                const * i_mask_blocks_left,
+                             std::vector< int64_t > const & i_dim_ids_blocks_right,
+                             uint8_t                const * i_mask_blocks_right );
+
+    /**
+     * Restores the outcome of the contraction optimizer, e.g., from a serialized plan.
+     * Has to be called before compilation; the compilation then skips the optimizer.
+     *
+     * @param i_loops optimized loops.
+     * @param i_ktype_main main kernel type derived by the optimizer.
+     * @param i_num_threads_shared number of threads parallelizing the shared loops.
+     * @param i_num_threads_m number of threads parallelizing the m dimension.
+     * @param i_num_threads_n number of threads parallelizing the n dimension.
+     **/
+    void restore_loops_opt( std::vector< basic::iter_property > const & i_loops,
+                            basic::kernel_t                             i_ktype_main,
+                            int64_t                                     i_num_threads_shared,
+                            int64_t                                     i_num_threads_m,
+                            int64_t                                     i_num_threads_n );
+
+    /**
+     * Sets parameters of the contraction optimizer, e.g., selected by the autotuner.
+     * Has to be called before compilation; zero values keep the defaults of the backend.
+     *
+     * @param i_config parameters of the contraction optimizer.
+     **/
+    void set_optimizer_config( basic::optimizer_config const & i_config );
+
+    /**
+     * Derives the parameters of the contraction optimizer by overwriting the backend's defaults with the set ones.
+     * The set thread split is only used if it matches the number of threads.
+     *
+     * @param i_target_m default target size of the primitive m dimension.
+     * @param i_target_n default target size of the primitive n dimension.
+     * @param i_target_k default target size of the primitive k dimension.
+     * @param i_packing true if the backend supports packing of the input tensors.
+     * @return parameters of the contraction optimizer.
+     **/
+    basic::optimizer_config resolve_optimizer_config( int64_t i_target_m,
+                                                      int64_t i_target_n,
+                                                      int64_t i_target_k,
+                                                      bool    i_packing ) const;
+
+    /**
+     * Stores the outcome of the contraction optimizer.
+     * The thread split of the resolved optimizer configuration takes precedence over the one of the optimizer.
+     *
+     * @param i_config resolved parameters of the contraction optimizer.
+     * @param i_loops optimized loops.
+     * @param i_ktype_main main kernel type derived by the optimizer.
+     * @param io_num_threads_shared number of threads parallelizing the shared loops, overwritten by the configuration.
+     * @param io_num_threads_m number of threads parallelizing the m dimension, overwritten by the configuration.
+     * @param io_num_threads_n number of threads parallelizing the n dimension, overwritten by the configuration.
+     **/
+    void store_loops_opt( basic::optimizer_config             const & i_config,
+                          std::vector< basic::iter_property > const & i_loops,
+                          basic::kernel_t                             i_ktype_main,
+                          int64_t                                   & io_num_threads_shared,
+                          int64_t                                   & io_num_threads_m,
+                          int64_t                                   & io_num_threads_n );
+
+    /**
+     * Sets the GEMM performance model of the host CPU in the contraction optimizer.
+     * Nothing is set if no model matches the host or the data types, or if tuned kernel targets are set.
+     *
+     * @param io_optim contraction optimizer which uses the model to determine the kernel targets.
+     **/
+    void set_time_model( basic::ContractionOptimizer & io_optim ) const;
+
+    /**
+     * Gets a signature which identifies the contraction's shapes, data types, kernels and number of threads,
+     * e.g., to store tuned parameters.
+     *
+     * @return signature.
+     **/
+    std::string signature() const;
+
     /**
      * Compiles the base data.
      *
@@ -385,11 +613,39 @@ class einsum_ir::backend::BinaryContraction {
                            void const * i_tensor_out_aux,
                            void       * io_tensor_out ) = 0;
 
+    /**
+     * Zeroes the output tensor with the threads which write the respective parts in contractions.
+     * Places freshly allocated output tensors close to the writing threads.
+     * Backends without thread-to-data mapping leave the output tensor untouched.
+     *
+     * @param io_tensor_out output tensor.
+     **/
+    virtual void first_touch_out( void * io_tensor_out );
+
     /**
      * Gets the number of operations for a single contraction.
+     * Operations on zero blocks of block-sparse input tensors are not counted.
      **/
     int64_t num_ops();
 
+    /**
+     * Gets the number of operations for a contraction with the given fused dimension sizes.
+     *
+     * @param i_size_c combined size of all C dimensions.
+     * @param i_size_m combined size of all M dimensions.
+     * @param i_size_n combined size of all N dimensions.
+     * @param i_size_k combined size of all K dimensions.
+     * @param i_ktype_first_touch type of the first-touch kernel.
+     * @param i_ktype_main type of the main kernel.
+     * @return number of operations.
+     **/
+    static int64_t num_ops( int64_t  i_size_c,
+                            int64_t  i_size_m,
+                            int64_t  i_size_n,
+                            int64_t  i_size_k,
+                            kernel_t i_ktype_first_touch,
+                            kernel_t i_ktype_main );
+
 };
 
 #endif
\ No newline at end of file
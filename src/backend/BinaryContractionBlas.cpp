@@ -96,26 +96,49 @@ einsum_ir::err_t einsum_ir::backend::BinaryContractionBlas::compile() {
   basic::data_t l_dtype_out   = ce_dtype_to_basic(m_dtype_out);
 
   //optimize loops
-  einsum_ir::basic::ContractionOptimizer l_optim;
-
   int64_t l_num_threads_m = 1;
   int64_t l_num_threads_n = 1;
   int64_t l_num_threads_shared = m_num_threads;
-  l_optim.init(&l_loops,
-               &l_ktype_main,
-               m_target_prim_m,
-               m_target_prim_n,
-               m_target_prim_k,
-               true,
-               false,
-               false,
-               basic::packed_gemm_t::OUT_STRIDE_ONE,
-               ce_n_bytes(m_dtype_out),
-               m_l2_cache_size,
-               &l_num_threads_shared,
-               &l_num_threads_m,
-               &l_num_threads_n );
-  l_optim.optimize();
+  if( m_loops_opt_restored ) {
+    l_loops = m_loops_opt;
+    l_ktype_main = m_ktype_main_opt;
+    l_num_threads_shared = m_num_threads_shared_opt;
+    l_num_threads_m = m_num_threads_m_opt;
+    l_num_threads_n = m_num_threads_n_opt;
+  }
+  else {
+    basic::optimizer_config l_config = resolve_optimizer_config( m_target_prim_m,
+                                                                 m_target_prim_n,
+                                                                 m_target_prim_k,
+                                                                 false );
+
+    einsum_ir::basic::ContractionOptimizer l_optim;
+    l_optim.init(&l_loops,
+                 &l_ktype_main,
+                 l_config.target_m,
+                 l_config.target_n,
+                 l_config.target_k,
+                 l_config.generate_sfcs,
+                 false,
+                 l_config.packing,
+                 basic::packed_gemm_t::OUT_STRIDE_ONE,
+                 ce_n_bytes(m_dtype_out),
+                 l_config.l2_cache_size,
+                 &l_num_threads_shared,
+                 &l_num_threads_m,
+                 &l_num_threads_n );
+    l_optim.set_num_bytes_scalar_in( ce_n_bytes(m_dtype_left),
+                                     ce_n_bytes(m_dtype_right) );
+    l_optim.set_l3_blocking( m_l3_blocking );
+    l_optim.optimize();
+
+    store_loops_opt( l_config,
+                     l_loops,
+                     l_ktype_main,
+                     l_num_threads_shared,
+                     l_num_threads_m,
+                     l_num_threads_n );
+  }
 
   einsum_ir::basic::ContractionMemoryManager * l_contraction_memory = nullptr;
   if( m_memory != nullptr ){
@@ -136,6 +159,21 @@ einsum_ir::err_t einsum_ir::backend::BinaryContractionBlas::compile() {
                   l_num_threads_n,
                   l_contraction_memory );
 
+  if( m_dynamic_scheduling ) {
+    m_backend.set_scheduling( basic::sched_t::DYNAMIC );
+  }
+  m_backend.set_packing_prologue( ce_kernelt_to_basic( m_ktype_prologue_left ),
+                                  ce_kernelt_to_basic( m_ktype_prologue_right ),
+                                  m_prologue_params );
+  m_backend.set_block_sparsity( block_sparsity( m_dim_ids_blocks_left,
+                                                m_mask_blocks_left,
+                                                m_dim_sizes_outer_left,
+                                                l_strides_left ),
+                                block_sparsity( m_dim_ids_blocks_right,
+                                                m_mask_blocks_right,
+                                                m_dim_sizes_outer_right,
+                                                l_strides_right ) );
+
   l_err = ce_basic_err_to_err(m_backend.compile());
   if( l_err != err_t::SUCCESS ) {
     return l_err;
@@ -163,3 +201,6 @@ void einsum_ir::backend::BinaryContractionBlas::contract( void const * i_tensor_
                       io_tensor_out );
 }
 
+void einsum_ir::backend::BinaryContractionBlas::first_touch_out( void * io_tensor_out ) {
+  m_backend.first_touch_out( io_tensor_out );
+}
@@ -1,6 +1,7 @@
 #include "BinaryContractionFactory.h"
 
 #include "BinaryContractionScalar.h"
+#include "BinaryContractionSimd.h"
 
 #ifdef PP_EINSUM_IR_HAS_LIBXSMM
 #include "BinaryContractionTpp.h"
@@ -15,7 +16,8 @@
 #endif
 
 bool einsum_ir::backend::BinaryContractionFactory::supports( einsum_ir::backend_t i_backend ) {
-  if( i_backend == einsum_ir::backend_t::SCALAR ) {
+  if(    i_backend == einsum_ir::backend_t::SCALAR
+      || i_backend == einsum_ir::backend_t::SIMD ) {
     return true;
   }
 
@@ -45,6 +47,10 @@ einsum_ir::backend::BinaryContraction * einsum_ir::backend::BinaryContractionFac
     return new BinaryContractionScalar();
   }
 
+  if( i_backend == einsum_ir::backend_t::SIMD ) {
+    return new BinaryContractionSimd();
+  }
+
 #ifdef PP_EINSUM_IR_HAS_LIBXSMM
   if( i_backend == einsum_ir::backend_t::TPP ) {
     return new BinaryContractionTpp();
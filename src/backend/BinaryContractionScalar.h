@@ -80,6 +80,13 @@ class einsum_ir::backend::BinaryContractionScalar: public BinaryContraction {
                    void const * i_tensor_right,
                    void const * i_tensor_out_aux,
                    void       * io_tensor_out );
+
+    /**
+     * Zeroes the output tensor with the threads which write the respective parts in contractions.
+     *
+     * @param io_tensor_out output tensor.
+     **/
+    void first_touch_out( void * io_tensor_out );
 };
 
 #endif
@@ -9,6 +9,14 @@ einsum_ir::err_t einsum_ir::backend::BinaryContractionTblis::compile() {
     return einsum_ir::COMPILATION_FAILED;
   }
 
+  // abort if packing prologues or block-sparse inputs are used
+  if(    m_ktype_prologue_left  != kernel_t::UNDEFINED_KTYPE
+      || m_ktype_prologue_right != kernel_t::UNDEFINED_KTYPE
+      || m_mask_blocks_left     != nullptr
+      || m_mask_blocks_right    != nullptr ) {
+    return einsum_ir::COMPILATION_FAILED;
+  }
+
   // check that the same data type is used everywhere
   if(    m_dtype_comp != m_dtype_left
       || m_dtype_comp != m_dtype_right
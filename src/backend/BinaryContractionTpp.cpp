@@ -65,6 +65,11 @@ einsum_ir::err_t einsum_ir::backend::BinaryContractionTpp::compile() {
     l_loops[l_id].stride_out     = map_find_default<int64_t>(&l_strides_out,     l_dim_id, 0);
   }
 
+  // set CPX dimension correctly
+  if( m_ktype_main == einsum_ir::kernel_t::CPX_MADD ) {
+    l_loops[0].dim_type = basic::dim_t::CPX;
+  }
+
   //convert kernel to basic
   basic::kernel_t l_ktype_first_touch = ce_kernelt_to_basic(m_ktype_first_touch);
   basic::kernel_t l_ktype_main        = ce_kernelt_to_basic(m_ktype_main);
@@ -77,26 +82,67 @@ einsum_ir::err_t einsum_ir::backend::BinaryContractionTpp::compile() {
   basic::data_t l_dtype_out   = ce_dtype_to_basic(m_dtype_out);
 
   //optimize loops
-  einsum_ir::basic::ContractionOptimizer l_optim;
-
   int64_t l_num_threads_m = 1;
   int64_t l_num_threads_n = 1;
   int64_t l_num_threads_shared = m_num_threads;
-  l_optim.init(&l_loops,
-               &l_ktype_main,
-               m_target_prim_m,
-               m_target_prim_n,
-               m_target_prim_k,
-               true,
-               true,
-               true,
-               basic::packed_gemm_t::ALL_STRIDE_ONE,
-               ce_n_bytes(m_dtype_out),
-               m_l2_cache_size,
-               &l_num_threads_shared,
-               &l_num_threads_m,
-               &l_num_threads_n );
-  l_optim.optimize();
+  if( m_loops_opt_restored ) {
+    l_loops = m_loops_opt;
+    l_ktype_main = m_ktype_main_opt;
+    l_num_threads_shared = m_num_threads_shared_opt;
+    l_num_threads_m = m_num_threads_m_opt;
+    l_num_threads_n = m_num_threads_n_opt;
+  }
+  else {
+    // packed GEMMs are not available for reduced precision data types and complex contractions
+    basic::packed_gemm_t l_packed_gemm = basic::packed_gemm_t::ALL_STRIDE_ONE;
+    if(    m_ktype_main  == einsum_ir::kernel_t::CPX_MADD
+        || m_dtype_left  == BF16
+        || m_dtype_right == BF16
+        || m_dtype_left  == FP16
+        || m_dtype_right == FP16
+        || m_dtype_left  == I8
+        || m_dtype_right == I8 ) {
+      l_packed_gemm = basic::packed_gemm_t::NONE;
+    }
+
+    // block-sparse inputs are accessed in place by kernels which do not cross blocks
+    bool l_block_sparse = m_mask_blocks_left != nullptr || m_mask_blocks_right != nullptr;
+
+    basic::optimizer_config l_config = resolve_optimizer_config( m_target_prim_m,
+                                                                 m_target_prim_n,
+                                                                 m_target_prim_k,
+                                                                 !l_block_sparse );
+
+    einsum_ir::basic::ContractionOptimizer l_optim;
+    l_optim.init(&l_loops,
+                 &l_ktype_main,
+                 l_config.target_m,
+                 l_config.target_n,
+                 l_config.target_k,
+                 l_config.generate_sfcs,
+                 !l_block_sparse,
+                 l_config.packing,
+                 l_packed_gemm,
+                 ce_n_bytes(m_dtype_out),
+                 l_config.l2_cache_size,
+                 &l_num_threads_shared,
+                 &l_num_threads_m,
+                 &l_num_threads_n );
+    l_optim.set_num_bytes_scalar_in( ce_n_bytes(m_dtype_left),
+                                     ce_n_bytes(m_dtype_right) );
+    set_time_model( l_optim );
+    l_optim.force_packing( m_ktype_prologue_left  != kernel_t::UNDEFINED_KTYPE,
+                           m_ktype_prologue_right != kernel_t::UNDEFINED_KTYPE );
+    l_optim.set_l3_blocking( m_l3_blocking );
+    l_optim.optimize();
+
+    store_loops_opt( l_config,
+                     l_loops,
+                     l_ktype_main,
+                     l_num_threads_shared,
+                     l_num_threads_m,
+                     l_num_threads_n );
+  }
 
   einsum_ir::basic::ContractionMemoryManager * l_contraction_memory = nullptr;
   if( m_memory != nullptr ){
@@ -118,6 +164,25 @@ einsum_ir::err_t einsum_ir::backend::BinaryContractionTpp::compile() {
                   l_contraction_memory );
 
   
+  if( m_dynamic_scheduling ) {
+    m_backend.set_scheduling( basic::sched_t::DYNAMIC );
+  }
+  if( m_quant_scales != nullptr ) {
+    m_backend.set_quant( quant( l_strides_out ) );
+  }
+  m_backend.set_last_touch_params( m_last_touch_params );
+  m_backend.set_packing_prologue( ce_kernelt_to_basic( m_ktype_prologue_left ),
+                                  ce_kernelt_to_basic( m_ktype_prologue_right ),
+                                  m_prologue_params );
+  m_backend.set_block_sparsity( block_sparsity( m_dim_ids_blocks_left,
+                                                m_mask_blocks_left,
+                                                m_dim_sizes_outer_left,
+                                                l_strides_left ),
+                                block_sparsity( m_dim_ids_blocks_right,
+                                                m_mask_blocks_right,
+                                                m_dim_sizes_outer_right,
+                                                l_strides_right ) );
+
   l_err = ce_basic_err_to_err(m_backend.compile());
   if( l_err != err_t::SUCCESS ) {
     return l_err;
@@ -145,3 +210,6 @@ void einsum_ir::backend::BinaryContractionTpp::contract( void const * i_tensor_l
                       io_tensor_out );
 }
 
+void einsum_ir::backend::BinaryContractionTpp::first_touch_out( void * io_tensor_out ) {
+  m_backend.first_touch_out( io_tensor_out );
+}
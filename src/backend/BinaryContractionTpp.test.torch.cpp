@@ -919,4 +919,82 @@ TEST_CASE( "FP32 TPP-based binary contraction involving C, M, N and K dimensions
                        l_out_native.data_ptr() );
 
   REQUIRE( at::allclose( l_out_native, l_out_ref, 1E-3, 1E-5 )  );
-}
\ No newline at end of file
+}
+TEST_CASE( "FP32 TPP-based binary contraction with a block-sparse left input tensor.", "[binary_contraction_tpp]" ) {
+  // blocked storage of the left input tensor: K and M are split into blocks k0, m0 and indices k1, m1 within the blocks
+  std::map< int64_t, int64_t > l_dim_sizes;
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 0,  3 ) ); // m0
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 1, 32 ) ); // m1
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 2, 20 ) ); // n
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 3,  4 ) ); // k0
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 4, 16 ) ); // k1
+
+  int64_t l_dim_ids_left[4]  = { 3, 0, 4, 1 };
+  int64_t l_dim_ids_right[3] = { 2, 3, 4 };
+  int64_t l_dim_ids_out[3]   = { 2, 0, 1 };
+
+#ifdef _OPENMP
+  int64_t l_num_threads = omp_get_max_threads();
+#else
+  int64_t l_num_threads = 1;
+#endif
+
+  einsum_ir::backend::BinaryContractionTpp l_bin_cont;
+  l_bin_cont.init( 4,
+                   3,
+                   3,
+                   &l_dim_sizes,
+                   &l_dim_sizes,
+                   &l_dim_sizes,
+                   nullptr,
+                   &l_dim_sizes,
+                   l_dim_ids_left,
+                   l_dim_ids_right,
+                   l_dim_ids_out,
+                   einsum_ir::FP32,
+                   einsum_ir::FP32,
+                   einsum_ir::FP32,
+                   einsum_ir::FP32,
+                   einsum_ir::ZERO,
+                   einsum_ir::MADD,
+                   einsum_ir::UNDEFINED_KTYPE,
+                   l_num_threads );
+
+  // four of the twelve k0-m0 blocks hold data
+  uint8_t l_mask[12] = { 1, 0, 0,
+                         0, 1, 0,
+                         0, 0, 0,
+                         1, 0, 1 };
+  l_bin_cont.set_block_sparsity( { 3, 0 },
+                                 l_mask,
+                                 {},
+                                 nullptr );
+
+  at::Tensor l_mask_left = at::from_blob( l_mask,
+                                          {4, 3, 1, 1},
+                                          at::ScalarType::Byte ).to( at::ScalarType::Float );
+
+  //                                  k0 m0  k1  m1
+  at::Tensor l_left = at::randn( {4, 3, 16, 32} ) * l_mask_left;
+  //                                  n  k0  k1
+  at::Tensor l_right = at::randn( {20, 4, 16} );
+  //                                     n  m0  m1
+  at::Tensor l_out_ref = at::randn( {20, 3, 32} );
+  at::Tensor l_out_native = l_out_ref.clone();
+
+  // reference
+  l_out_ref = at::einsum( "abcd,eac->ebd",
+                          {l_left, l_right} );
+
+  einsum_ir::err_t l_err = l_bin_cont.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  l_bin_cont.contract( l_left.data_ptr(),
+                       l_right.data_ptr(),
+                       l_out_native.data_ptr() );
+
+  REQUIRE( at::allclose( l_out_native, l_out_ref, 1E-4, 1E-5 )  );
+
+  // a third of the multiply-adds is performed, the zero first touch saves one addition per output entry
+  REQUIRE( l_bin_cont.num_ops() == 2*96*20*64 / 3 - 96*20 );
+}
@@ -1,5 +1,6 @@
 #include "BinaryPrimitives.h"
 #include "BinaryContraction.h"
+#include "../basic/hardware.h"
 
 #include <algorithm>
 #include <math.h>
@@ -25,6 +26,45 @@ void einsum_ir::backend::BinaryPrimitives::init( int64_t i_size_cb_min,
 einsum_ir::err_t einsum_ir::backend::BinaryPrimitives::init( data_t    i_data_type,
                                                              backend_t i_backend_type ) {
   if( i_backend_type == backend_t::TPP ) {
+    if( i_data_type == data_t::FP32 ) {
+      init(  4,  16,
+            32, 128,
+            12,  64,
+            32, 512 );
+    }
+    else if( i_data_type == data_t::FP64 ){
+      init(  2,   8,
+            16,  64,
+             6,  32,
+            16, 256 );
+    }
+    // BF16: blocks span the same bytes in C and K as for FP32
+    else if( i_data_type == data_t::BF16 ){
+      init(  8,  32,
+            32, 128,
+            12,  64,
+            64, 1024 );
+    }
+    // FP16: same as BF16
+    else if( i_data_type == data_t::FP16 ){
+      init(  8,  32,
+            32, 128,
+            12,  64,
+            64, 1024 );
+    }
+    // INT8: blocks span the same bytes in C and K as for FP32
+    else if( i_data_type == data_t::I8 ){
+      init(  16,   64,
+             32,  128,
+             12,   64,
+            128, 2048 );
+    }
+    else {
+      return err_t::INVALID_DTYPE;
+    }
+  }
+  // SIMD: same blocking as the TPP backend
+  else if( i_backend_type == backend_t::SIMD ) {
     if( i_data_type == data_t::FP32 ) {
       init(  4,  16,
             32, 128,
@@ -81,6 +121,13 @@ einsum_ir::err_t einsum_ir::backend::BinaryPrimitives::init( data_t    i_data_ty
     return err_t::INVALID_BACKEND;
   }
 
+  // packed C blocks of the vectorized backends fill a vector register of the host
+  if(    i_backend_type == backend_t::TPP
+      || i_backend_type == backend_t::SIMD ) {
+    int64_t l_size_cb_simd = basic::get_hardware().simd_width / ce_n_bytes( i_data_type );
+    m_size_cb_max = std::max( m_size_cb_min, l_size_cb_simd );
+  }
+
   return err_t::SUCCESS;
 }
 
@@ -1736,7 +1783,8 @@ einsum_ir::err_t einsum_ir::backend::BinaryPrimitives::reorder( backend_t
 
   tenord_t l_tensor_ordering = tenord_t::UNDEFINED_TENORD;
 
-  if( i_backend_type == backend_t::TPP ) {
+  if(    i_backend_type == backend_t::TPP
+      || i_backend_type == backend_t::SIMD ) {
     l_tensor_ordering = tenord_t::LEFT_BC_BM_BK_BI_KB_MB_CB_RIGHT_BC_BN_BK_BJ_NB_KB_CB_OUT_NATIVE;
   }
   else if( i_backend_type == backend_t::BLAS ) {
@@ -284,6 +284,7 @@ class einsum_ir::backend::BinaryPrimitives {
 
     /**
      * Initializes the primitive blocking and reordering.
+     * The blocked C dimension of the TPP and SIMD backends is capped by the SIMD width of the host.
      *
      * @param i_data_type data type.
      * @param i_backend_type backend type.
@@ -0,0 +1,175 @@
+#include "ContractionTuner.h"
+#include "Tensor.h"
+#include <chrono>
+#include <limits>
+
+double einsum_ir::backend::ContractionTuner::time( basic::optimizer_config const & i_config ) {
+  BinaryContraction * l_cont = m_create();
+  l_cont->set_optimizer_config( i_config );
+
+  double l_time = -1;
+  if( l_cont->compile() == err_t::SUCCESS ) {
+    void const * l_out_aux = m_out_aux.empty() ? nullptr : m_out_aux.data();
+
+    // warm up
+    l_cont->contract( m_left.data(),
+                      m_right.data(),
+                      l_out_aux,
+                      m_out.data() );
+
+    l_time = std::numeric_limits< double >::max();
+    double l_time_total = 0;
+    for( int64_t l_re = 0; l_re < m_max_reps && l_time_total < m_time_candidate; l_re++ ) {
+      std::chrono::steady_clock::time_point l_tp0 = std::chrono::steady_clock::now();
+      l_cont->contract( m_left.data(),
+                        m_right.data(),
+                        l_out_aux,
+                        m_out.data() );
+      std::chrono::steady_clock::time_point l_tp1 = std::chrono::steady_clock::now();
+
+      double l_dur = std::chrono::duration_cast< std::chrono::duration< double > >( l_tp1 - l_tp0 ).count();
+      l_time = l_dur < l_time ? l_dur : l_time;
+      l_time_total += l_dur;
+    }
+  }
+
+  delete l_cont;
+
+  return l_time;
+}
+
+void einsum_ir::backend::ContractionTuner::init( std::function< BinaryContraction * () > const & i_create,
+                                                 double                                          i_time_candidate ) {
+  m_create = i_create;
+  m_time_candidate = i_time_candidate;
+
+  // derive the sizes of the scratch tensors
+  BinaryContraction * l_cont = m_create();
+  m_num_threads = l_cont->m_num_threads;
+
+  int64_t l_size_left = Tensor::size( ce_n_bytes( l_cont->m_dtype_left ),
+                                      l_cont->m_num_dims_left,
+                                      l_cont->m_dim_ids_left,
+                                      *l_cont->m_dim_sizes_outer_left );
+  int64_t l_size_right = Tensor::size( ce_n_bytes( l_cont->m_dtype_right ),
+                                       l_cont->m_num_dims_right,
+                                       l_cont->m_dim_ids_right,
+                                       *l_cont->m_dim_sizes_outer_right );
+  int64_t l_size_out = Tensor::size( ce_n_bytes( l_cont->m_dtype_out ),
+                                     l_cont->m_num_dims_out,
+                                     l_cont->m_dim_ids_out,
+                                     *l_cont->m_dim_sizes_outer_out );
+  int64_t l_size_out_aux = 0;
+  if( l_cont->m_dim_sizes_outer_out_aux != nullptr ) {
+    l_size_out_aux = Tensor::size( ce_n_bytes( l_cont->m_dtype_out ),
+                                   l_cont->m_num_dims_out,
+                                   l_cont->m_dim_ids_out,
+                                   *l_cont->m_dim_sizes_outer_out_aux );
+  }
+  else if(    l_cont->m_ktype_first_touch == kernel_t::ADD
+           || l_cont->m_ktype_first_touch == kernel_t::COPY ) {
+    l_size_out_aux = l_size_out;
+  }
+
+  delete l_cont;
+
+  m_left.assign( l_size_left, 0 );
+  m_right.assign( l_size_right, 0 );
+  m_out_aux.assign( l_size_out_aux, 0 );
+  m_out.assign( l_size_out, 0 );
+}
+
+std::vector< einsum_ir::basic::optimizer_config > einsum_ir::backend::ContractionTuner::thread_splits( int64_t i_num_threads ) {
+  std::vector< basic::optimizer_config > l_splits;
+
+  for( int64_t l_sh = 1; l_sh <= i_num_threads; l_sh++ ) {
+    if( i_num_threads % l_sh != 0 ) continue;
+    int64_t l_num_threads_sfc = i_num_threads / l_sh;
+
+    for( int64_t l_m = 1; l_m <= l_num_threads_sfc; l_m++ ) {
+      if( l_num_threads_sfc % l_m != 0 ) continue;
+
+      basic::optimizer_config l_split;
+      l_split.num_threads_shared = l_sh;
+      l_split.num_threads_m      = l_m;
+      l_split.num_threads_n      = l_num_threads_sfc / l_m;
+      l_splits.push_back( l_split );
+    }
+  }
+
+  return l_splits;
+}
+
+einsum_ir::err_t einsum_ir::backend::ContractionTuner::tune( basic::optimizer_config & o_config ) {
+  // defaults of the backend
+  basic::optimizer_config l_best;
+  double l_time_best = time( l_best );
+  if( l_time_best < 0 ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  int64_t const l_targets[5][3] = { {  8, 32, 128 },
+                                    { 16, 64, 256 },
+                                    { 32, 32, 256 },
+                                    { 32, 64, 512 },
+                                    { 64, 64, 128 } };
+  int64_t const l_l2_cache_sizes[3] = { 512 * 1024,
+                                        2 * 1024 * 1024,
+                                        8 * 1024 * 1024 };
+  std::vector< basic::optimizer_config > l_splits = thread_splits( m_num_threads );
+
+  for( int64_t l_gr = 0; l_gr < 4; l_gr++ ) {
+    std::vector< basic::optimizer_config > l_candidates;
+
+    if( l_gr == 0 ) {
+      for( int64_t l_ta = 0; l_ta < 5; l_ta++ ) {
+        basic::optimizer_config l_cand = l_best;
+        l_cand.target_m = l_targets[l_ta][0];
+        l_cand.target_n = l_targets[l_ta][1];
+        l_cand.target_k = l_targets[l_ta][2];
+        l_candidates.push_back( l_cand );
+      }
+    }
+    else if( l_gr == 1 ) {
+      for( int64_t l_ca = 0; l_ca < 3; l_ca++ ) {
+        basic::optimizer_config l_cand = l_best;
+        l_cand.l2_cache_size = l_l2_cache_sizes[l_ca];
+        l_candidates.push_back( l_cand );
+      }
+    }
+    else if( l_gr == 2 ) {
+      for( int64_t l_va = 0; l_va < 4; l_va++ ) {
+        basic::optimizer_config l_cand = l_best;
+        l_cand.generate_sfcs = (l_va & 1) == 0;
+        l_cand.packing       = (l_va & 2) == 0;
+        if(    l_cand.generate_sfcs != l_best.generate_sfcs
+            || l_cand.packing       != l_best.packing ) {
+          l_candidates.push_back( l_cand );
+        }
+      }
+    }
+    else if( m_num_threads > 1 ) {
+      for( std::size_t l_sp = 0; l_sp < l_splits.size(); l_sp++ ) {
+        basic::optimizer_config l_cand = l_best;
+        l_cand.num_threads_shared = l_splits[l_sp].num_threads_shared;
+        l_cand.num_threads_m      = l_splits[l_sp].num_threads_m;
+        l_cand.num_threads_n      = l_splits[l_sp].num_threads_n;
+        l_candidates.push_back( l_cand );
+      }
+    }
+
+    for( std::size_t l_ca = 0; l_ca < l_candidates.size(); l_ca++ ) {
+      double l_time = time( l_candidates[l_ca] );
+
+      // require a clear improvement, i.e., noise does not replace the defaults
+      if( l_time >= 0 && l_time < 0.98 * l_time_best ) {
+        l_best = l_candidates[l_ca];
+        l_time_best = l_time;
+      }
+    }
+  }
+
+  o_config = l_best;
+
+  return err_t::SUCCESS;
+}
@@ -0,0 +1,80 @@
+#ifndef EINSUM_IR_BACKEND_CONTRACTION_TUNER
+#define EINSUM_IR_BACKEND_CONTRACTION_TUNER
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "../constants.h"
+#include "BinaryContraction.h"
+
+namespace einsum_ir {
+  namespace backend {
+    class ContractionTuner;
+  }
+}
+
+/**
+ * Empirical autotuner of the contraction optimizer's parameters.
+ *
+ * Candidates are compiled and benchmarked on scratch tensors.
+ * The search space is explored by a greedy coordinate descent over groups of parameters:
+ *   targets of the primitive sizes, L2 cache size, SFCs and packing, thread split.
+ * Each group starts from the best parameters found so far, i.e., the number of benchmarks is bounded
+ * by the sum of the group sizes rather than their product.
+ **/
+class einsum_ir::backend::ContractionTuner {
+  private:
+    //! creates initialized but not compiled contractions
+    std::function< BinaryContraction * () > m_create;
+
+    //! time budget for benchmarking a single candidate in seconds
+    double m_time_candidate = 0.05;
+
+    //! maximum number of repetitions of a single candidate
+    int64_t m_max_reps = 100;
+
+    //! number of threads of the contraction
+    int64_t m_num_threads = 1;
+
+    //! scratch tensors
+    std::vector< char > m_left;
+    std::vector< char > m_right;
+    std::vector< char > m_out_aux;
+    std::vector< char > m_out;
+
+    /**
+     * Benchmarks a candidate.
+     *
+     * @param i_config parameters of the contraction optimizer.
+     * @return minimum time of a contraction in seconds, negative if the candidate failed to compile.
+     **/
+    double time( basic::optimizer_config const & i_config );
+
+  public:
+    /**
+     * Initializes the tuner.
+     *
+     * @param i_create function which returns a new initialized contraction, ownership is transferred to the tuner.
+     * @param i_time_candidate time budget for benchmarking a single candidate in seconds.
+     **/
+    void init( std::function< BinaryContraction * () > const & i_create,
+               double                                          i_time_candidate = 0.05 );
+
+    /**
+     * Derives the candidate thread splits (shared, m, n) which use all threads.
+     *
+     * @param i_num_threads number of threads.
+     * @return thread splits.
+     **/
+    static std::vector< basic::optimizer_config > thread_splits( int64_t i_num_threads );
+
+    /**
+     * Tunes the parameters of the contraction optimizer.
+     *
+     * @param o_config will be set to the fastest parameters.
+     * @return SUCCESS if successful, COMPILATION_FAILED if not even the default parameters compile.
+     **/
+    err_t tune( basic::optimizer_config & o_config );
+};
+
+#endif
@@ -0,0 +1,102 @@
+#include "catch.hpp"
+#include "ContractionTuner.h"
+#include "BinaryContractionSimd.h"
+
+TEST_CASE( "Thread splits of the contraction tuner.", "[contraction_tuner]" ) {
+  std::vector< einsum_ir::basic::optimizer_config > l_splits = einsum_ir::backend::ContractionTuner::thread_splits( 12 );
+
+  // ordered factorizations of 12 into three factors
+  REQUIRE( l_splits.size() == 18 );
+  for( std::size_t l_sp = 0; l_sp < l_splits.size(); l_sp++ ) {
+    REQUIRE( l_splits[l_sp].num_threads_shared * l_splits[l_sp].num_threads_m * l_splits[l_sp].num_threads_n == 12 );
+  }
+
+  REQUIRE( einsum_ir::backend::ContractionTuner::thread_splits( 1 ).size() == 1 );
+}
+
+TEST_CASE( "Tuning a matmul and applying the tuned parameters.", "[contraction_tuner]" ) {
+  // Test Case:
+  //
+  //     ___nm___
+  //    /        \
+  //  km          nk
+  //
+  // char   id   size
+  //    m    0     40
+  //    n    1     24
+  //    k    2     36
+  std::map< int64_t, int64_t > l_dim_sizes;
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 0, 40 ) );
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 1, 24 ) );
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 2, 36 ) );
+
+  int64_t l_dim_ids_left[2]  = { 2, 0 };
+  int64_t l_dim_ids_right[2] = { 1, 2 };
+  int64_t l_dim_ids_out[2]   = { 1, 0 };
+
+  auto l_create = [&]() {
+    einsum_ir::backend::BinaryContraction * l_cont = new einsum_ir::backend::BinaryContractionSimd;
+    l_cont->init( 2,
+                  2,
+                  2,
+                  &l_dim_sizes,
+                  &l_dim_sizes,
+                  &l_dim_sizes,
+                  nullptr,
+                  &l_dim_sizes,
+                  l_dim_ids_left,
+                  l_dim_ids_right,
+                  l_dim_ids_out,
+                  einsum_ir::FP32,
+                  einsum_ir::FP32,
+                  einsum_ir::FP32,
+                  einsum_ir::FP32,
+                  einsum_ir::ZERO,
+                  einsum_ir::MADD,
+                  einsum_ir::UNDEFINED_KTYPE,
+                  1 );
+    return l_cont;
+  };
+
+  einsum_ir::backend::ContractionTuner l_tuner;
+  l_tuner.init( l_create,
+                0.001 );
+
+  einsum_ir::basic::optimizer_config l_config;
+  REQUIRE( l_tuner.tune( l_config ) == einsum_ir::SUCCESS );
+
+  // data
+  std::vector< float > l_left(  36 * 40 );
+  std::vector< float > l_right( 24 * 36 );
+  std::vector< float > l_out_ref( 24 * 40, 0 );
+
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = ( (l_en * 7) % 13 ) / 6.0f - 1.0f;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = ( (l_en * 5) % 11 ) / 5.0f - 1.0f;
+  }
+
+  // reference
+  for( int64_t l_n = 0; l_n < 24; l_n++ ) {
+    for( int64_t l_m = 0; l_m < 40; l_m++ ) {
+      for( int64_t l_k = 0; l_k < 36; l_k++ ) {
+        l_out_ref[ l_n * 40 + l_m ] += l_left[ l_k * 40 + l_m ] * l_right[ l_n * 36 + l_k ];
+      }
+    }
+  }
+
+  einsum_ir::backend::BinaryContraction * l_cont = l_create();
+  l_cont->set_optimizer_config( l_config );
+  REQUIRE( l_cont->compile() == einsum_ir::SUCCESS );
+
+  std::vector< float > l_out( l_out_ref.size(), 1.0f );
+  l_cont->contract( l_left.data(),
+                    l_right.data(),
+                    l_out.data() );
+  delete l_cont;
+
+  for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+    REQUIRE( l_out[l_en] == Approx( l_out_ref[l_en] ) );
+  }
+}
@@ -3,8 +3,12 @@
 #include "Tensor.h"
 #include "BinaryContractionFactory.h"
 #include "BinaryPrimitives.h"
+#include "ContractionTuner.h"
+#include "TuningDatabase.h"
+#include "../basic/threading.h"
+#include "../basic/numa.h"
+#include "../basic/env.h"
 #include <algorithm>
-#include <cstdlib>
 
 einsum_ir::backend::EinsumNode::~EinsumNode() {
   if( m_unary != nullptr ) {
@@ -18,6 +22,37 @@ einsum_ir::backend::EinsumNode::~EinsumNode() {
   }
 }
 
+einsum_ir::data_t einsum_ir::backend::EinsumNode::dtype_comp( data_t i_dtype ) {
+  data_t l_dtype_comp = ce_dtype_comp( i_dtype );
+
+  // FP16 contractions may accumulate in FP16
+  std::string l_env = basic::env_string( "EINSUM_IR_DTYPE_COMP" );
+  if( i_dtype == data_t::FP16 ) {
+    if( l_env == "FP16" ) {
+      l_dtype_comp = data_t::FP16;
+    }
+    else if( l_env == "FP32" ) {
+      l_dtype_comp = data_t::FP32;
+    }
+  }
+
+  return l_dtype_comp;
+}
+
+std::vector< char const * > const & einsum_ir::backend::EinsumNode::env_vars() {
+  static std::vector< char const * > const l_env_vars = { "EINSUM_IR_BACKEND",
+                                                          "EINSUM_IR_REORDER_DIMS",
+                                                          "EINSUM_IR_PACK_INPUTS",
+                                                          "EINSUM_IR_INTER_OP",
+                                                          "EINSUM_IR_DYNAMIC_SCHEDULING",
+                                                          "EINSUM_IR_L3_BLOCKING",
+                                                          "EINSUM_IR_HUGE_PAGES",
+                                                          "EINSUM_IR_DTYPE_COMP",
+                                                          "EINSUM_IR_TUNING_DB",
+                                                          "EINSUM_IR_AUTOTUNE" };
+  return l_env_vars;
+}
+
 void einsum_ir::backend::EinsumNode::init( int64_t                              i_num_dims,
                                            int64_t                      const * i_dim_ids,
                                            std::map< int64_t, int64_t > const * i_dim_sizes_inner,
@@ -26,6 +61,7 @@ void einsum_ir::backend::EinsumNode::init( int64_t
                                            void                               * i_data_ptr,
                                            MemoryManager                      * i_memory ) {
   m_dtype               = i_dtype;
+  m_dtype_comp          = dtype_comp( i_dtype );
 
   m_ktype_first_touch   = kernel_t::UNDEFINED_KTYPE;
   m_ktype_main          = kernel_t::UNDEFINED_KTYPE;
@@ -58,52 +94,61 @@ void einsum_ir::backend::EinsumNode::init( int64_t
 
   m_btype_unary         = backend_t::AUTO;
   m_btype_binary        = backend_t::AUTO;
-  char * l_btype = std::getenv( "EINSUM_IR_BACKEND" );
-  if( l_btype == nullptr ) {}
-  else if( strcmp( l_btype, "AUTO") == 0 ) {
+  std::string l_btype = basic::env_string( "EINSUM_IR_BACKEND" );
+  if( l_btype == "AUTO" ) {
     m_btype_binary = backend_t::AUTO;
   }
-  else if( strcmp( l_btype, "TPP") == 0 ) {
+  else if( l_btype == "TPP" ) {
     m_btype_binary = backend_t::TPP;
   }
-  else if( strcmp( l_btype, "BLAS") == 0 ) {
+  else if( l_btype == "BLAS" ) {
     m_btype_binary = backend_t::BLAS;
   }
-  else if( strcmp( l_btype, "TBLIS") == 0 ) {
+  else if( l_btype == "TBLIS" ) {
     m_btype_binary = backend_t::TBLIS;
   }
-  else if( strcmp( l_btype, "SCALAR") == 0 ) {
+  else if( l_btype == "SCALAR" ) {
     m_btype_binary = backend_t::SCALAR;
   }
-
-  m_reorder_dims = true;
-  char * l_reorder_dims = std::getenv( "EINSUM_IR_REORDER_DIMS" );
-  if( l_reorder_dims != nullptr ) {
-    if( strcmp( l_reorder_dims, "1" ) == 0 ) {
-      m_reorder_dims = true;
-    }
-    else if( strcmp( l_reorder_dims, "true" ) == 0 ) {
-      m_reorder_dims = true;
-    }
-    else {
-      m_reorder_dims = false;
-    }
+  else if( l_btype == "SIMD" ) {
+    m_btype_binary = backend_t::SIMD;
   }
 
-  m_pack_inputs = false;
-  char * l_pack_inputs = std::getenv( "EINSUM_IR_PACK_INPUTS" );
-  if( l_pack_inputs != nullptr ) {
-    if( strcmp( l_pack_inputs, "1" ) == 0 ) {
-      m_pack_inputs = true;
-    }
-    else if( strcmp( l_pack_inputs, "true" ) == 0 ) {
-      m_pack_inputs = true;
-    }
-    else {
-      m_pack_inputs = false;
-    }
+  m_reorder_dims       = basic::env_flag( "EINSUM_IR_REORDER_DIMS",       true  );
+  m_pack_inputs        = basic::env_flag( "EINSUM_IR_PACK_INPUTS",        false );
+  m_inter_op           = basic::env_flag( "EINSUM_IR_INTER_OP",           true  );
+  m_dynamic_scheduling = basic::env_flag( "EINSUM_IR_DYNAMIC_SCHEDULING", false );
+  m_l3_blocking        = basic::env_flag( "EINSUM_IR_L3_BLOCKING",        false );
+  m_autotune           = basic::env_flag( "EINSUM_IR_AUTOTUNE",           false );
+  m_tuning_db          = basic::env_string( "EINSUM_IR_TUNING_DB" );
+
+  std::string l_huge_pages = basic::env_string( "EINSUM_IR_HUGE_PAGES" );
+  m_page_type = basic::page_t::BASE_PAGES;
+  if(    l_huge_pages == "1"
+      || l_huge_pages == "true"
+      || l_huge_pages == "thp" ) {
+    m_page_type = basic::page_t::THP_PAGES;
   }
+  else if( l_huge_pages == "hugetlb" ) {
+    m_page_type = basic::page_t::HUGETLB_PAGES;
+  }
+
+  m_team_sizes.clear();
+  m_concurrent = false;
+
+  m_swap_inputs = false;
+  m_packing_left.clear();
+  m_packing_right.clear();
+  m_plan_restored = false;
+  m_loops_plan.clear();
 
+  m_quant_scales         = nullptr;
+  m_quant_dim_id_channel = -1;
+  m_quant_zero_point     = 0;
+  m_last_touch_params    = basic::last_touch_params();
+  m_ktype_prologue_left  = kernel_t::UNDEFINED_KTYPE;
+  m_ktype_prologue_right = kernel_t::UNDEFINED_KTYPE;
+  m_prologue_params      = basic::last_touch_params();
 
   m_unary               = nullptr;
   m_cont                = nullptr;
@@ -187,16 +232,132 @@ void einsum_ir::backend::EinsumNode::init( int64_t
   m_children[0] = i_left;
   m_children[1] = i_right;
 
+  // INT8 inputs are accumulated in INT32
+  if( i_left->m_dtype == data_t::I8 ) {
+    m_dtype_comp = data_t::I32;
+  }
+
   m_num_threads = i_num_threads;
 }
+
+void einsum_ir::backend::EinsumNode::set_quant( float const * i_scales,
+                                                int64_t       i_dim_id_channel,
+                                                int32_t       i_zero_point ) {
+  m_quant_scales         = i_scales;
+  m_quant_dim_id_channel = i_dim_id_channel;
+  m_quant_zero_point     = i_zero_point;
+}
+
+void einsum_ir::backend::EinsumNode::set_dtype_comp( data_t i_dtype_comp ) {
+  m_dtype_comp = i_dtype_comp;
+}
+
+void einsum_ir::backend::EinsumNode::set_last_touch_params( basic::last_touch_params const & i_params ) {
+  m_last_touch_params = i_params;
+}
+
+void einsum_ir::backend::EinsumNode::set_packing_prologue( kernel_t                         i_ktype_left,
+                                                           kernel_t                         i_ktype_right,
+                                                           basic::last_touch_params const & i_params ) {
+  m_ktype_prologue_left  = i_ktype_left;
+  m_ktype_prologue_right = i_ktype_right;
+  m_prologue_params      = i_params;
+}
+
+einsum_ir::backend::BinaryContraction * einsum_ir::backend::EinsumNode::create_contraction( kernel_t        i_ktype_prologue_left,
+                                                                                           kernel_t        i_ktype_prologue_right,
+                                                                                           MemoryManager * i_memory ) {
+  BinaryContraction * l_cont = BinaryContractionFactory::create( m_btype_binary );
+  l_cont->init( m_children[0]->m_num_dims,
+                m_children[1]->m_num_dims,
+                m_num_dims,
+                m_dim_sizes_inner,
+                m_children[0]->m_dim_sizes_outer,
+                m_children[1]->m_dim_sizes_outer,
+                m_dim_sizes_aux_outer,
+                m_dim_sizes_outer,
+                nullptr,
+                m_children[0]->m_dim_ids_int.data(),
+                m_children[1]->m_dim_ids_int.data(),
+                m_dim_ids_int.data(),
+                m_packing_left.data(),
+                m_packing_right.data(),
+                i_memory,
+                m_children[0]->m_dtype,
+                m_children[1]->m_dtype,
+                m_dtype_comp,
+                m_dtype,
+                m_ktype_first_touch,
+                m_ktype_main,
+                m_ktype_last_touch,
+                m_num_threads );
+  l_cont->set_dynamic_scheduling( m_dynamic_scheduling );
+  l_cont->set_l3_blocking( m_l3_blocking );
+  if( m_quant_scales != nullptr ) {
+    l_cont->set_quant( m_quant_scales,
+                       m_quant_dim_id_channel,
+                       m_quant_zero_point );
+  }
+  l_cont->set_last_touch_params( m_last_touch_params );
+  l_cont->set_packing_prologue( i_ktype_prologue_left,
+                                i_ktype_prologue_right,
+                                m_prologue_params );
+
+  return l_cont;
+}
+
+einsum_ir::err_t einsum_ir::backend::EinsumNode::tune_contraction( kernel_t i_ktype_prologue_left,
+                                                                   kernel_t i_ktype_prologue_right ) {
+  TuningDatabase & l_db = TuningDatabase::get();
+  if( !m_tuning_db.empty() ) {
+    err_t l_err = l_db.open( m_tuning_db );
+    if( l_err != einsum_ir::SUCCESS ) {
+      return l_err;
+    }
+  }
+
+  std::string l_key = TuningDatabase::key( m_btype_binary,
+                                           m_cont->signature() );
+  basic::optimizer_config l_config;
+  if( !l_db.find( l_key, l_config ) ) {
+    if( !m_autotune ) {
+      return einsum_ir::SUCCESS;
+    }
+
+    // candidates allocate their own memory, i.e., the reservations of the tree are not affected
+    ContractionTuner l_tuner;
+    l_tuner.init( [&]() { return create_contraction( i_ktype_prologue_left,
+                                                     i_ktype_prologue_right,
+                                                     nullptr ); } );
+    err_t l_err = l_tuner.tune( l_config );
+    if( l_err != einsum_ir::SUCCESS ) {
+      return l_err;
+    }
+
+    l_db.insert( l_key, l_config );
+    if( !m_tuning_db.empty() ) {
+      l_db.store();
+    }
+  }
+  m_cont->set_optimizer_config( l_config );
+
+  return einsum_ir::SUCCESS;
+}
+
 einsum_ir::err_t einsum_ir::backend::EinsumNode::compile(){
   err_t l_err = err_t::UNDEFINED_ERROR;
+  derive_num_ops();
   l_err = compile_recursive();
   if( l_err != einsum_ir::SUCCESS ){
     return l_err;
   }
   compile_memory_usage();
-  m_memory->alloc_all_memory();
+  m_memory->set_page_type( m_page_type );
+  l_err = m_memory->alloc_all_memory();
+  if( l_err != einsum_ir::SUCCESS ){
+    return l_err;
+  }
+  first_touch();
 
   return einsum_ir::SUCCESS;
 }
@@ -206,20 +367,34 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
 
   // derive backend for binary contractions
   if( m_btype_binary == backend_t::AUTO ) {
-    if(    ce_cpx_op(m_ktype_first_touch)
-        || ce_cpx_op(m_ktype_main)
-        || ce_cpx_op(m_ktype_last_touch) ) {
-      m_btype_binary = backend_t::BLAS;
-    }
-    else if( BinaryContractionFactory::supports( backend_t::TPP ) ) {
+    if( BinaryContractionFactory::supports( backend_t::TPP ) ) {
       m_btype_binary = backend_t::TPP;
     }
+    // complex contractions are only supported by the TPP and BLAS backends
+    else if(    ce_cpx_op(m_ktype_first_touch)
+             || ce_cpx_op(m_ktype_main)
+             || ce_cpx_op(m_ktype_last_touch) ) {
+      m_btype_binary = backend_t::BLAS;
+    }
     else if( BinaryContractionFactory::supports( backend_t::TBLIS ) ) {
       m_btype_binary = backend_t::TBLIS;
     }
     else if( BinaryContractionFactory::supports( backend_t::BLAS ) ) {
       m_btype_binary = backend_t::BLAS;
     }
+    // the SIMD backend covers real-valued FP32 and FP64 contractions with simple touch kernels
+    else if(    ( m_dtype == data_t::FP32 || m_dtype == data_t::FP64 )
+             && m_dtype_comp == m_dtype
+             && m_ktype_main == kernel_t::MADD
+             && (    m_ktype_first_touch == kernel_t::UNDEFINED_KTYPE
+                  || m_ktype_first_touch == kernel_t::ZERO
+                  || m_ktype_first_touch == kernel_t::COPY )
+             && (    m_ktype_last_touch == kernel_t::UNDEFINED_KTYPE
+                  || m_ktype_last_touch == kernel_t::RELU )
+             && m_ktype_prologue_left  == kernel_t::UNDEFINED_KTYPE
+             && m_ktype_prologue_right == kernel_t::UNDEFINED_KTYPE ) {
+      m_btype_binary = backend_t::SIMD;
+    }
     else {
       m_btype_binary = backend_t::SCALAR;
     }
@@ -237,21 +412,26 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
   // compile contraction
   if( m_children.size() == 2 ) {
     // swap left and right if required by the primitives
-    bool l_swap_inputs = BinaryPrimitives::swap_inputs( m_children[0]->m_num_dims,
-                                                        m_children[1]->m_num_dims,
-                                                        m_num_dims,
-                                                        m_children[0]->m_dim_ids_ext,
-                                                        m_children[1]->m_dim_ids_ext,
-                                                        m_dim_ids_int.data() );
-    if( l_swap_inputs ) {
+    if( !m_plan_restored ) {
+      m_swap_inputs = BinaryPrimitives::swap_inputs( m_children[0]->m_num_dims,
+                                                     m_children[1]->m_num_dims,
+                                                     m_num_dims,
+                                                     m_children[0]->m_dim_ids_ext,
+                                                     m_children[1]->m_dim_ids_ext,
+                                                     m_dim_ids_int.data() );
+    }
+    kernel_t l_ktype_prologue_left  = m_ktype_prologue_left;
+    kernel_t l_ktype_prologue_right = m_ktype_prologue_right;
+    if( m_swap_inputs ) {
       std::swap( m_children[0],
                  m_children[1] );
+      std::swap( l_ktype_prologue_left,
+                 l_ktype_prologue_right );
     }
 
     // reorder dimensions of input tensors for the primitives
-    std::vector<int64_t> l_packing_left;
-    std::vector<int64_t> l_packing_right;
-    if( m_reorder_dims ) {
+    // restored plans already hold the reordered dimensions of the children
+    if( m_reorder_dims && !m_plan_restored ) {
       BinaryPrimitives l_bin_prims;
       l_bin_prims.init( m_dtype,
                         m_btype_binary );
@@ -271,13 +451,13 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
       //packing is only supported for TPP
       if( m_btype_binary == backend_t::TPP && m_pack_inputs ){
         if( m_children[0]->requires_permutation() ){
-          l_packing_left = m_children[0]->m_dim_ids_int;
+          m_packing_left = m_children[0]->m_dim_ids_int;
           std::copy(  m_children[0]->m_dim_ids_ext,
                       m_children[0]->m_dim_ids_ext + m_children[0]->m_num_dims,
                       m_children[0]->m_dim_ids_int.begin() );
         }
         if( m_children[1]->requires_permutation() ){
-          l_packing_right = m_children[1]->m_dim_ids_int;
+          m_packing_right = m_children[1]->m_dim_ids_int;
           std::copy(  m_children[1]->m_dim_ids_ext,
                       m_children[1]->m_dim_ids_ext + m_children[1]->m_num_dims,
                       m_children[1]->m_dim_ids_int.begin() );
@@ -285,30 +465,23 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
       }
     }
 
-    m_cont = BinaryContractionFactory::create( m_btype_binary );
-    m_cont->init( m_children[0]->m_num_dims,
-                  m_children[1]->m_num_dims,
-                  m_num_dims,
-                  m_dim_sizes_inner,
-                  m_children[0]->m_dim_sizes_outer,
-                  m_children[1]->m_dim_sizes_outer,
-                  m_dim_sizes_aux_outer,
-                  m_dim_sizes_outer,
-                  nullptr,
-                  m_children[0]->m_dim_ids_int.data(),
-                  m_children[1]->m_dim_ids_int.data(),
-                  m_dim_ids_int.data(),
-                  l_packing_left.data(),
-                  l_packing_right.data(),
-                  m_memory,
-                  m_children[0]->m_dtype,
-                  m_children[1]->m_dtype,
-                  m_dtype,
-                  m_dtype,
-                  m_ktype_first_touch,
-                  m_ktype_main,
-                  m_ktype_last_touch,
-                  m_num_threads );
+    m_cont = create_contraction( l_ktype_prologue_left,
+                                 l_ktype_prologue_right,
+                                 m_concurrent ? nullptr : m_memory );
+    if( m_plan_restored ) {
+      m_cont->restore_loops_opt( m_loops_plan,
+                                 m_ktype_main_plan,
+                                 m_num_threads_plan[0],
+                                 m_num_threads_plan[1],
+                                 m_num_threads_plan[2] );
+    }
+    else if( m_autotune || !m_tuning_db.empty() ) {
+      l_err = tune_contraction( l_ktype_prologue_left,
+                                l_ktype_prologue_right );
+      if( l_err != einsum_ir::SUCCESS ) {
+        return l_err;
+      }
+    }
 
     l_err = m_cont->compile();
     if( l_err != einsum_ir::SUCCESS ) {
@@ -398,6 +571,19 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
     m_req_mem = 0;
   }
 
+  // distribute the threads among the children
+  derive_teams();
+  for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+    if( m_team_sizes.size() == m_children.size() ) {
+      m_children[l_ch]->m_num_threads = m_team_sizes[l_ch];
+    }
+    else {
+      m_children[l_ch]->m_num_threads = std::min( m_children[l_ch]->m_num_threads,
+                                                  m_num_threads );
+    }
+    m_children[l_ch]->m_concurrent = m_concurrent || !m_team_sizes.empty();
+  }
+
   // compile children and determine best execution order
   if( m_children.size() > 1 ) {
     for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
@@ -421,6 +607,10 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
       m_mem_subtree = l_max_ch2;
       m_exec_order = {1,0};
     }
+    // concurrently evaluated children do not share memory
+    if( !m_team_sizes.empty() ){
+      m_mem_subtree = l_mem_ch1 + l_mem_ch2;
+    }
     m_mem_subtree = std::max(m_mem_subtree, m_req_mem + m_children[0]->m_req_mem + m_children[1]->m_req_mem);
   }
   else if( m_children.size() == 1 ) {
@@ -455,6 +645,161 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
 
 
 
+void einsum_ir::backend::EinsumNode::store_plan( std::vector< int64_t > & io_plan ) const {
+  io_plan.push_back( m_btype_binary );
+
+  io_plan.push_back( m_num_dims );
+  io_plan.insert( io_plan.end(),
+                  m_dim_ids_int.begin(),
+                  m_dim_ids_int.end() );
+
+  io_plan.push_back( m_swap_inputs );
+
+  io_plan.push_back( m_packing_left.size() );
+  io_plan.insert( io_plan.end(),
+                  m_packing_left.begin(),
+                  m_packing_left.end() );
+  io_plan.push_back( m_packing_right.size() );
+  io_plan.insert( io_plan.end(),
+                  m_packing_right.begin(),
+                  m_packing_right.end() );
+
+  // outcome of the contraction optimizer
+  if( m_cont == nullptr ) {
+    io_plan.push_back( 0 );
+    return;
+  }
+  io_plan.push_back( 1 );
+  io_plan.push_back( m_cont->m_ktype_main_opt );
+  io_plan.push_back( m_cont->m_num_threads_shared_opt );
+  io_plan.push_back( m_cont->m_num_threads_m_opt );
+  io_plan.push_back( m_cont->m_num_threads_n_opt );
+
+  io_plan.push_back( m_cont->m_loops_opt.size() );
+  for( std::size_t l_lo = 0; l_lo < m_cont->m_loops_opt.size(); l_lo++ ) {
+    basic::iter_property const & l_loop = m_cont->m_loops_opt[l_lo];
+    io_plan.push_back( l_loop.dim_type );
+    io_plan.push_back( l_loop.exec_type );
+    io_plan.push_back( l_loop.size );
+    io_plan.push_back( l_loop.stride_left );
+    io_plan.push_back( l_loop.stride_right );
+    io_plan.push_back( l_loop.stride_out_aux );
+    io_plan.push_back( l_loop.stride_out );
+    io_plan.push_back( l_loop.packing_stride_left );
+    io_plan.push_back( l_loop.packing_stride_right );
+  }
+}
+
+einsum_ir::err_t einsum_ir::backend::EinsumNode::restore_plan( std::vector< int64_t > const & i_plan,
+                                                               std::size_t                  & io_pos ) {
+  std::size_t l_pos = io_pos;
+
+  // checks if the plan holds the next entries
+  auto l_available = [&]( std::size_t i_num_entries ) {
+    return l_pos + i_num_entries <= i_plan.size();
+  };
+
+  if( !l_available( 2 ) ) return err_t::INVALID_PLAN;
+  backend_t l_btype_binary = (backend_t) i_plan[l_pos++];
+  if( i_plan[l_pos++] != m_num_dims ) return err_t::INVALID_PLAN;
+
+  // internal dimensions have to be a permutation of the external ones
+  if( !l_available( m_num_dims ) ) return err_t::INVALID_PLAN;
+  std::vector< int64_t > l_dim_ids_int( i_plan.begin() + l_pos,
+                                        i_plan.begin() + l_pos + m_num_dims );
+  l_pos += m_num_dims;
+  if( !std::is_permutation( l_dim_ids_int.begin(),
+                            l_dim_ids_int.end(),
+                            m_dim_ids_ext ) ) {
+    return err_t::INVALID_PLAN;
+  }
+
+  if( !l_available( 2 ) ) return err_t::INVALID_PLAN;
+  bool l_swap_inputs = i_plan[l_pos++] != 0;
+
+  std::vector< int64_t > l_packing[2];
+  for( int64_t l_in = 0; l_in < 2; l_in++ ) {
+    if( !l_available( 1 ) ) return err_t::INVALID_PLAN;
+    int64_t l_size = i_plan[l_pos++];
+    if( l_size < 0 || !l_available( l_size ) ) return err_t::INVALID_PLAN;
+    l_packing[l_in].assign( i_plan.begin() + l_pos,
+                            i_plan.begin() + l_pos + l_size );
+    l_pos += l_size;
+  }
+
+  if( !l_available( 1 ) ) return err_t::INVALID_PLAN;
+  bool l_has_cont = i_plan[l_pos++] != 0;
+  if( l_has_cont != (m_children.size() == 2) ) return err_t::INVALID_PLAN;
+
+  std::vector< basic::iter_property > l_loops;
+  basic::kernel_t l_ktype_main = basic::kernel_t::UNDEFINED_KTYPE;
+  int64_t l_num_threads[3] = { 1, 1, 1 };
+  if( l_has_cont ) {
+    if( !l_available( 5 ) ) return err_t::INVALID_PLAN;
+    l_ktype_main = (basic::kernel_t) i_plan[l_pos++];
+    for( int64_t l_th = 0; l_th < 3; l_th++ ) {
+      l_num_threads[l_th] = i_plan[l_pos++];
+      if( l_num_threads[l_th] < 1 ) return err_t::INVALID_PLAN;
+    }
+    int64_t l_num_loops = i_plan[l_pos++];
+    if( l_num_loops < 0 || !l_available( l_num_loops*9 ) ) return err_t::INVALID_PLAN;
+
+    l_loops.resize( l_num_loops );
+    for( int64_t l_lo = 0; l_lo < l_num_loops; l_lo++ ) {
+      l_loops[l_lo].dim_type             = (basic::dim_t)  i_plan[l_pos++];
+      l_loops[l_lo].exec_type            = (basic::exec_t) i_plan[l_pos++];
+      l_loops[l_lo].size                 = i_plan[l_pos++];
+      l_loops[l_lo].stride_left          = i_plan[l_pos++];
+      l_loops[l_lo].stride_right         = i_plan[l_pos++];
+      l_loops[l_lo].stride_out_aux       = i_plan[l_pos++];
+      l_loops[l_lo].stride_out           = i_plan[l_pos++];
+      l_loops[l_lo].packing_stride_left  = i_plan[l_pos++];
+      l_loops[l_lo].packing_stride_right = i_plan[l_pos++];
+    }
+  }
+
+  m_btype_binary = l_btype_binary;
+  m_dim_ids_int = l_dim_ids_int;
+  m_swap_inputs = l_swap_inputs;
+  m_packing_left = l_packing[0];
+  m_packing_right = l_packing[1];
+  m_loops_plan = l_loops;
+  m_ktype_main_plan = l_ktype_main;
+  m_num_threads_plan[0] = l_num_threads[0];
+  m_num_threads_plan[1] = l_num_threads[1];
+  m_num_threads_plan[2] = l_num_threads[2];
+  m_plan_restored = true;
+
+  io_pos = l_pos;
+
+  return err_t::SUCCESS;
+}
+
+void einsum_ir::backend::EinsumNode::first_touch() {
+  if( !m_team_sizes.empty() ) {
+    basic::execute_teams( m_team_sizes.size(),
+                          m_team_sizes.data(),
+                          [&]( int64_t i_team_id ) {
+                            m_children[i_team_id]->first_touch();
+                          } );
+  }
+  else {
+    for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+      m_children[m_exec_order[l_ch]]->first_touch();
+    }
+  }
+
+  // the first contraction writing to the memory determines the placement
+  if(    m_children.size() == 2
+      && m_mem_id != 0
+      && m_data_locked == false ) {
+    void * l_data = m_memory->get_mem_ptr( m_mem_id );
+    l_data = (char *) l_data + m_offset_bytes;
+
+    m_cont->first_touch_out( l_data );
+  }
+}
+
 einsum_ir::err_t einsum_ir::backend::EinsumNode::store_and_lock_data() {
   if( m_compiled == false ) {
     return err_t::CALLED_BEFORE_COMPILATION;
@@ -466,6 +811,8 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::store_and_lock_data() {
   // allocate memory for intermediate data if required
   if( m_data_ptr_int == nullptr ) {
     char * l_data = new char[m_size];
+    // locked data is read by all threads
+    basic::numa_interleave( l_data, m_size );
     m_data_ptr_int = l_data;
   }
 
@@ -494,8 +841,17 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::unlock_data() {
 }
 
 void einsum_ir::backend::EinsumNode::eval() {
-  for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
-    m_children[m_exec_order[l_ch]]->eval();
+  if( !m_team_sizes.empty() ) {
+    basic::execute_teams( m_team_sizes.size(),
+                          m_team_sizes.data(),
+                          [&]( int64_t i_team_id ) {
+                            m_children[i_team_id]->eval();
+                          } );
+  }
+  else {
+    for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+      m_children[m_exec_order[l_ch]]->eval();
+    }
   }
 
   if( m_data_locked ) {
@@ -539,6 +895,94 @@ void einsum_ir::backend::EinsumNode::eval() {
   }
 }
 
+void einsum_ir::backend::EinsumNode::derive_num_ops() {
+  m_num_ops_node = 0;
+  m_num_ops_children = 0;
+
+  for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+    m_children[l_ch]->derive_num_ops();
+    m_num_ops_children += m_children[l_ch]->num_ops();
+  }
+
+  if( m_children.size() == 2 ) {
+    int64_t l_sizes[4] = { 1, 1, 1, 1 };
+
+    // C: left, right, out; M: left, out; N: right, out; K: left, right
+    for( int64_t l_le = 0; l_le < m_children[0]->m_num_dims; l_le++ ) {
+      int64_t l_dim_id = m_children[0]->m_dim_ids_ext[l_le];
+      bool l_in_right = std::find( m_children[1]->m_dim_ids_ext,
+                                   m_children[1]->m_dim_ids_ext + m_children[1]->m_num_dims,
+                                   l_dim_id ) != m_children[1]->m_dim_ids_ext + m_children[1]->m_num_dims;
+      bool l_in_out = std::find( m_dim_ids_ext,
+                                 m_dim_ids_ext + m_num_dims,
+                                 l_dim_id ) != m_dim_ids_ext + m_num_dims;
+      int64_t l_size = m_dim_sizes_inner->at( l_dim_id );
+
+      if( l_in_right && l_in_out ) {
+        l_sizes[0] *= l_size;
+      }
+      else if( l_in_out ) {
+        l_sizes[1] *= l_size;
+      }
+      else if( l_in_right ) {
+        l_sizes[3] *= l_size;
+      }
+    }
+    for( int64_t l_ri = 0; l_ri < m_children[1]->m_num_dims; l_ri++ ) {
+      int64_t l_dim_id = m_children[1]->m_dim_ids_ext[l_ri];
+      bool l_in_left = std::find( m_children[0]->m_dim_ids_ext,
+                                  m_children[0]->m_dim_ids_ext + m_children[0]->m_num_dims,
+                                  l_dim_id ) != m_children[0]->m_dim_ids_ext + m_children[0]->m_num_dims;
+      bool l_in_out = std::find( m_dim_ids_ext,
+                                 m_dim_ids_ext + m_num_dims,
+                                 l_dim_id ) != m_dim_ids_ext + m_num_dims;
+
+      if( !l_in_left && l_in_out ) {
+        l_sizes[2] *= m_dim_sizes_inner->at( l_dim_id );
+      }
+    }
+
+    m_num_ops_node = BinaryContraction::num_ops( l_sizes[0],
+                                                 l_sizes[1],
+                                                 l_sizes[2],
+                                                 l_sizes[3],
+                                                 m_ktype_first_touch,
+                                                 m_ktype_main );
+  }
+}
+
+void einsum_ir::backend::EinsumNode::derive_teams() {
+  m_team_sizes.clear();
+
+  if(    m_children.size() != 2
+      || m_num_threads < 2
+      || m_inter_op == false
+      || basic::supports_thread_teams() == false ) {
+    return;
+  }
+
+  // only subtrees which contain contractions are worth a team
+  double l_num_ops_left  = m_children[0]->num_ops();
+  double l_num_ops_right = m_children[1]->num_ops();
+  if( l_num_ops_left <= 0 || l_num_ops_right <= 0 ) {
+    return;
+  }
+
+  // large subtrees use all threads one after another
+  double l_num_ops_min = l_num_ops_left < l_num_ops_right ? l_num_ops_left : l_num_ops_right;
+  if( l_num_ops_min >= (double) m_num_threads * m_min_ops_thread_inter_op ) {
+    return;
+  }
+
+  // team sizes are proportional to the number of operations
+  int64_t l_num_threads_left = (int64_t) ( m_num_threads * l_num_ops_left / (l_num_ops_left + l_num_ops_right) + 0.5 );
+  l_num_threads_left = std::max( l_num_threads_left, (int64_t) 1 );
+  l_num_threads_left = std::min( l_num_threads_left, m_num_threads - 1 );
+
+  m_team_sizes.push_back( l_num_threads_left );
+  m_team_sizes.push_back( m_num_threads - l_num_threads_left );
+}
+
 int64_t einsum_ir::backend::EinsumNode::num_ops( bool i_children ) {
   int64_t l_num_ops = m_num_ops_node;
 
@@ -560,9 +1004,15 @@ void  einsum_ir::backend::EinsumNode::cancel_memory_reservation() {
 void einsum_ir::backend::EinsumNode::compile_memory_usage(){
   // compile children
   m_memory->m_layer_id++;
+  if( !m_team_sizes.empty() ) {
+    m_memory->begin_concurrent_region();
+  }
   for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
     m_children[m_exec_order[l_ch]]->compile_memory_usage();
   }
+  if( !m_team_sizes.empty() ) {
+    m_memory->end_concurrent_region();
+  }
   m_memory->m_layer_id--;
 
   //reserve own mem
@@ -1,6 +1,7 @@
 #ifndef EINSUM_IR_BACKEND_EINSUM_NODE
 #define EINSUM_IR_BACKEND_EINSUM_NODE
 
+#include <string>
 #include <vector>
 #include "Unary.h"
 #include "BinaryContraction.h"
@@ -17,6 +18,8 @@ class einsum_ir::backend::EinsumNode {
   public:
     //! data type of the tensor
     data_t m_dtype = data_t::UNDEFINED_DTYPE;
+    //! data type used for the accumulation in the node's contraction
+    data_t m_dtype_comp = data_t::UNDEFINED_DTYPE;
 
     //! type of the first-touch kernel
     kernel_t m_ktype_first_touch = kernel_t::UNDEFINED_KTYPE;
@@ -122,11 +125,83 @@ class einsum_ir::backend::EinsumNode {
     //! number of threads for the evaluation
     int64_t m_num_threads = 1;
 
+    //! type of pages backing the intermediate tensors
+    basic::page_t m_page_type = basic::page_t::BASE_PAGES;
+
+    //! true if the shared tasks of the contraction are scheduled dynamically
+    bool m_dynamic_scheduling = false;
+
+    //! true if the outer iterations of the contraction are blocked for the L3 cache
+    bool m_l3_blocking = false;
+
+    //! path of the tuning database, empty if tuned parameters are not persisted
+    std::string m_tuning_db;
+    //! true if contractions without tuned parameters are autotuned
+    bool m_autotune = false;
+
+    //! true if independent children may be evaluated concurrently
+    bool m_inter_op = true;
+    //! minimum number of operations per thread before children are evaluated one after another by all threads
+    int64_t m_min_ops_thread_inter_op = 1048576;
+    //! number of threads of the teams which evaluate the children concurrently, empty if evaluated one after another
+    std::vector< int64_t > m_team_sizes;
+    //! true if the node is evaluated concurrently with other subtrees
+    bool m_concurrent = false;
+
+    //! true if the inputs of the contraction were swapped for the primitives
+    bool m_swap_inputs = false;
+    //! dimension ids of the left input before packing, empty if not packed
+    std::vector< int64_t > m_packing_left;
+    //! dimension ids of the right input before packing, empty if not packed
+    std::vector< int64_t > m_packing_right;
+
+    //! true if the node's plan was restored, i.e., the compilation skips dimension reordering and loop optimization
+    bool m_plan_restored = false;
+    //! restored loops of the contraction
+    std::vector< basic::iter_property > m_loops_plan;
+    //! restored main kernel type of the contraction
+    basic::kernel_t m_ktype_main_plan = basic::kernel_t::UNDEFINED_KTYPE;
+    //! restored numbers of threads parallelizing the shared loops, the m dimension and the n dimension
+    int64_t m_num_threads_plan[3] = { 1, 1, 1 };
+
+    //! scales of the requantization of INT32 accumulators, nullptr if not requantized
+    float const * m_quant_scales = nullptr;
+    //! id of the channel dimension of the requantization, -1 for a single scale
+    int64_t m_quant_dim_id_channel = -1;
+    //! zero point of INT8 outputs
+    int32_t m_quant_zero_point = 0;
+
+    //! parameters of the last-touch kernel
+    basic::last_touch_params m_last_touch_params;
+
+    //! elementwise kernels applied to the left and right children while packing
+    kernel_t m_ktype_prologue_left = kernel_t::UNDEFINED_KTYPE;
+    kernel_t m_ktype_prologue_right = kernel_t::UNDEFINED_KTYPE;
+    //! parameters of the packing prologues
+    basic::last_touch_params m_prologue_params;
+
     /**
      * Destructor.
      **/
     ~EinsumNode();
 
+    /**
+     * Gets the data type used for the accumulation in contractions of the given data type.
+     * FP16 contractions accumulate in FP32 unless EINSUM_IR_DTYPE_COMP is set to FP16.
+     * This is the default of the nodes which may be overwritten through set_dtype_comp().
+     *
+     * @param i_dtype data type of the tensors.
+     * @return data type of the accumulation.
+     **/
+    static data_t dtype_comp( data_t i_dtype );
+
+    /**
+     * Gets the names of the environment variables which configure the einsum nodes.
+     *
+     * @return names of the environment variables.
+     **/
+    static std::vector< char const * > const & env_vars();
+
     /**
      * Initializes an input node.
      *
@@ -207,6 +282,70 @@ class einsum_ir::backend::EinsumNode {
                MemoryManager                      * i_memory,
                int64_t                              i_num_threads );
 
+    /**
+     * Sets the requantization of the node's INT32 accumulators to INT8 or FP32 outputs.
+     * Has to be called after initialization and before compilation.
+     *
+     * @param i_scales scales, one per entry of the channel dimension or a single one for the entire tensor.
+     * @param i_dim_id_channel id of the channel dimension, -1 for a single scale.
+     * @param i_zero_point zero point which is added to INT8 outputs.
+     **/
+    void set_quant( float const * i_scales,
+                    int64_t       i_dim_id_channel,
+                    int32_t       i_zero_point );
+
+    /**
+     * Sets the data type of the accumulation, which overwrites the default derived during initialization.
+     * Has to be called after initialization and before compilation.
+     *
+     * @param i_dtype_comp data type of the accumulation.
+     **/
+    void set_dtype_comp( data_t i_dtype_comp );
+
+    /**
+     * Sets the parameters of the node's SCALE_SHIFT and CLAMP last-touch kernels.
+     * Has to be called after initialization and before compilation.
+     *
+     * @param i_params parameters of the last-touch kernel.
+     **/
+    void set_last_touch_params( basic::last_touch_params const & i_params );
+
+    /**
+     * Fuses elementwise kernels, e.g., a ReLU, into the node's contraction.
+     * The kernels are applied to the children's data while the TPP backend packs it.
+     * Has to be called after initialization and before compilation.
+     *
+     * @param i_ktype_left kernel applied to the left child, UNDEFINED_KTYPE if none.
+     * @param i_ktype_right kernel applied to the right child, UNDEFINED_KTYPE if none.
+     * @param i_params parameters of SCALE_SHIFT and CLAMP.
+     **/
+    void set_packing_prologue( kernel_t                         i_ktype_left,
+                               kernel_t                         i_ktype_right,
+                               basic::last_touch_params const & i_params = basic::last_touch_params() );
+
+    /**
+     * Creates and initializes the node's binary contraction without compiling it.
+     *
+     * @param i_ktype_prologue_left elementwise kernel applied to the left input while packing.
+     * @param i_ktype_prologue_right elementwise kernel applied to the right input while packing.
+     * @param i_memory memory manager of the contraction, nullptr if the contraction allocates its own memory.
+     * @return new binary contraction.
+     **/
+    BinaryContraction * create_contraction( kernel_t        i_ktype_prologue_left,
+                                            kernel_t        i_ktype_prologue_right,
+                                            MemoryManager * i_memory );
+
+    /**
+     * Sets the tuned parameters of the contraction optimizer for the node's contraction.
+     * The parameters are looked up in the tuning database; on a miss the contraction is autotuned if enabled.
+     *
+     * @param i_ktype_prologue_left elementwise kernel applied to the left input while packing.
+     * @param i_ktype_prologue_right elementwise kernel applied to the right input while packing.
+     * @return SUCCESS if successful, INVALID_PLAN if the file of the tuning database exists but is no tuning database, error code otherwise.
+     **/
+    err_t tune_contraction( kernel_t i_ktype_prologue_left,
+                            kernel_t i_ktype_prologue_right );
+
     /**
      * Compiles the contraction of the node and recursively those of all children.
      * 
@@ -221,6 +360,45 @@ class einsum_ir::backend::EinsumNode {
      **/    
     err_t compile_recursive();
 
+    /**
+     * Derives the number of operations of the node and all children from the dimension sizes.
+     * Used to size the thread teams before the contractions are compiled.
+     **/
+    void derive_num_ops();
+
+    /**
+     * Splits the node's threads into teams which evaluate the two children concurrently.
+     * Children are only evaluated concurrently if at least one of them is too small to use all threads efficiently.
+     **/
+    void derive_teams();
+
+    /**
+     * Appends the compiled plan of the node to a serialized plan.
+     * The plan covers the backend, input order, internal dimension order and optimized loops,
+     * i.e., everything derived by the optimizers. Has to be called after compilation.
+     *
+     * @param io_plan serialized plan which is extended.
+     **/
+    void store_plan( std::vector< int64_t > & io_plan ) const;
+
+    /**
+     * Restores the plan of the node from a serialized plan.
+     * Has to be called after initialization and before compilation.
+     *
+     * @param i_plan serialized plan.
+     * @param io_pos position of the node's plan, will be advanced to the end of the node's plan.
+     * @return SUCCESS if successful, INVALID_PLAN if the plan does not match the node.
+     **/
+    err_t restore_plan( std::vector< int64_t > const & i_plan,
+                        std::size_t                  & io_pos );
+
+    /**
+     * Touches the intermediate tensors of the node and all children for the first time.
+     * Pages are placed close to the threads of the contractions writing them.
+     * Has to be called after the memory was allocated.
+     **/
+    void first_touch();
+
     /**
      * Stores the provided data internally and locks it, i.e.,
      * the provided data pointer is ignored in future evaluations.
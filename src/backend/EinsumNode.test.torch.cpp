@@ -1268,4 +1268,193 @@ TEST_CASE( "Einsum expression without batch dimensions.", "[einsum_node]" ) {
 
 
   REQUIRE( at::allclose( l_data_iefgh_ref, l_data_iefgh ) );
-}
\ No newline at end of file
+}
+TEST_CASE( "INT8 matmul example with per-channel requantization to FP32.", "[einsum_node]" ) {
+  // test case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0     40
+  //    n    1     33
+  //    k    2     64
+  std::map< int64_t, int64_t > l_dim_sizes;
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 0, 40 ) );
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 1, 33 ) );
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 2, 64 ) );
+
+  int64_t l_dim_ids_in_left[2]  = { 2, 0 };
+  int64_t l_dim_ids_in_right[2] = { 1, 2 };
+  int64_t l_dim_ids_out[2]      = { 1, 0 };
+
+  // data
+  at::Tensor l_in_left  = at::randint( -128, 128, {64, 40} ).to( at::ScalarType::Char );
+  at::Tensor l_in_right = at::randint( -128, 128, {33, 64} ).to( at::ScalarType::Char );
+  at::Tensor l_out      = at::zeros( {33, 40} );
+
+  // one scale per entry of n
+  at::Tensor l_scales = at::rand( {33} ) * 1E-3;
+
+  // reference
+  at::Tensor l_out_ref = at::einsum( "km,nk->nm",
+                                     { l_in_left.to( at::ScalarType::Double ),
+                                       l_in_right.to( at::ScalarType::Double ) } );
+  l_out_ref = l_out_ref.to( at::ScalarType::Float ) * l_scales.unsqueeze( 1 );
+
+#ifdef _OPENMP
+  int64_t l_num_threads = omp_get_max_threads();
+#else
+  int64_t l_num_threads = 1;
+#endif
+
+  //Memory Manager
+  einsum_ir::backend::MemoryManager l_memory;
+
+  // einsum_ir
+  einsum_ir::backend::EinsumNode l_node_0;
+  einsum_ir::backend::EinsumNode l_node_1;
+  einsum_ir::backend::EinsumNode l_node_2;
+
+  l_node_0.init( 2,
+                 l_dim_ids_in_left,
+                 &l_dim_sizes,
+                 nullptr,
+                 einsum_ir::I8,
+                 l_in_left.data_ptr(),
+                 &l_memory );
+
+  l_node_1.init( 2,
+                 l_dim_ids_in_right,
+                 &l_dim_sizes,
+                 nullptr,
+                 einsum_ir::I8,
+                 l_in_right.data_ptr(),
+                 &l_memory );
+
+  l_node_2.init( 2,
+                 l_dim_ids_out,
+                 &l_dim_sizes,
+                 nullptr,
+                 nullptr,
+                 nullptr,
+                 nullptr,
+                 einsum_ir::FP32,
+                 nullptr,
+                 l_out.data_ptr(),
+                 einsum_ir::ZERO,
+                 einsum_ir::MADD,
+                 einsum_ir::UNDEFINED_KTYPE,
+                 &l_node_0,
+                 &l_node_1,
+                 &l_memory,
+                 l_num_threads );
+
+  l_node_2.set_quant( l_scales.data_ptr< float >(),
+                      1,
+                      0 );
+
+  // INT8 inputs are accumulated in INT32
+  REQUIRE( l_node_2.m_dtype_comp == einsum_ir::I32 );
+
+  einsum_ir::err_t l_err = l_node_2.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  l_node_2.eval();
+
+  // check results
+  REQUIRE( at::allclose( l_out, l_out_ref, 1E-5, 1E-5 ) );
+}
+
+TEST_CASE( "Matmul example with ReLU and tanh applied while packing the inputs.", "[einsum_node]" ) {
+  // test case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0     40
+  //    n    1     33
+  //    k    2    300
+  std::map< int64_t, int64_t > l_dim_sizes;
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 0, 40 ) );
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 1, 33 ) );
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 2, 300 ) );
+
+  int64_t l_dim_ids_in_left[2]  = { 2, 0 };
+  int64_t l_dim_ids_in_right[2] = { 1, 2 };
+  int64_t l_dim_ids_out[2]      = { 1, 0 };
+
+  // data
+  at::Tensor l_in_left  = at::randn( {300, 40} );
+  at::Tensor l_in_right = at::randn( {33, 300} );
+  at::Tensor l_out      = at::randn( {33, 40} );
+
+  // reference
+  at::Tensor l_out_ref = at::einsum( "km,nk->nm",
+                                     { at::relu( l_in_left ),
+                                       at::tanh( l_in_right ) } );
+
+#ifdef _OPENMP
+  int64_t l_num_threads = omp_get_max_threads();
+#else
+  int64_t l_num_threads = 1;
+#endif
+
+  //Memory Manager
+  einsum_ir::backend::MemoryManager l_memory;
+
+  // einsum_ir
+  einsum_ir::backend::EinsumNode l_node_0;
+  einsum_ir::backend::EinsumNode l_node_1;
+  einsum_ir::backend::EinsumNode l_node_2;
+
+  l_node_0.init( 2,
+                 l_dim_ids_in_left,
+                 &l_dim_sizes,
+                 nullptr,
+                 einsum_ir::FP32,
+                 l_in_left.data_ptr(),
+                 &l_memory );
+
+  l_node_1.init( 2,
+                 l_dim_ids_in_right,
+                 &l_dim_sizes,
+                 nullptr,
+                 einsum_ir::FP32,
+                 l_in_right.data_ptr(),
+                 &l_memory );
+
+  l_node_2.init( 2,
+                 l_dim_ids_out,
+                 &l_dim_sizes,
+                 nullptr,
+                 nullptr,
+                 nullptr,
+                 nullptr,
+                 einsum_ir::FP32,
+                 nullptr,
+                 l_out.data_ptr(),
+                 einsum_ir::ZERO,
+                 einsum_ir::MADD,
+                 einsum_ir::UNDEFINED_KTYPE,
+                 &l_node_0,
+                 &l_node_1,
+                 &l_memory,
+                 l_num_threads );
+
+  l_node_2.set_packing_prologue( einsum_ir::RELU,
+                                 einsum_ir::TANH );
+
+  einsum_ir::err_t l_err = l_node_2.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  // the inputs are not modified
+  l_node_2.eval();
+  l_node_2.eval();
+
+  // check results
+  REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-4 ) );
+}
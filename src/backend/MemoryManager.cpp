@@ -1,9 +1,10 @@
 #include "MemoryManager.h"
+#include "../basic/pages.h"
 
 einsum_ir::backend::MemoryManager::~MemoryManager() {
-  if(  m_memory_ptr != nullptr ) {
-    delete [] (char *)  m_memory_ptr;
-  }
+  basic::free_pages( m_memory_ptr,
+                     m_alloc_mem,
+                     m_page_size );
 }
 
 int64_t einsum_ir::backend::MemoryManager::reserve_memory( int64_t i_size ){
@@ -50,6 +51,11 @@ int64_t einsum_ir::backend::MemoryManager::reserve_memory( int64_t i_size ){
 }
 
 void einsum_ir::backend::MemoryManager::remove_reservation( int64_t i_id ){
+  //keep reservation until the concurrent region ends
+  if( m_num_concurrent_regions > 0 ){
+    m_deferred_removals.push_back(i_id);
+    return;
+  }
 
   //find offset and id in list of allocated and delete them
   std::list<int64_t>::iterator l_alloc_id_it;
@@ -78,18 +84,46 @@ void einsum_ir::backend::MemoryManager::remove_reservation( int64_t i_id ){
   }
 }
 
-void einsum_ir::backend::MemoryManager::alloc_all_memory(){
-  if( m_req_mem ){
-    //allocate memory 
-    m_memory_ptr = new char[m_req_mem + m_alignment_page];
+void einsum_ir::backend::MemoryManager::begin_concurrent_region(){
+  m_num_concurrent_regions++;
+}
 
-    //allign data in memory 
-    int64_t l_align_offset = (unsigned long)m_memory_ptr % m_alignment_page;
-    l_align_offset = l_align_offset ? m_alignment_page - l_align_offset : 0;
-    m_aligned_memory_ptr = m_memory_ptr + l_align_offset;
+void einsum_ir::backend::MemoryManager::end_concurrent_region(){
+  m_num_concurrent_regions--;
+
+  if( m_num_concurrent_regions == 0 ){
+    for( std::size_t l_re = 0; l_re < m_deferred_removals.size(); l_re++ ){
+      remove_reservation( m_deferred_removals[l_re] );
+    }
+    m_deferred_removals.clear();
+  }
+}
+
+void einsum_ir::backend::MemoryManager::set_page_type( basic::page_t i_page_type ){
+  m_page_type = i_page_type;
+  m_contraction_memory_manager.set_page_type( i_page_type );
+}
+
+int64_t einsum_ir::backend::MemoryManager::page_size(){
+  return m_page_size;
+}
+
+einsum_ir::err_t einsum_ir::backend::MemoryManager::alloc_all_memory(){
+  if( m_req_mem ){
+    //allocate page-aligned memory, pages are placed by the first touch
+    m_alloc_mem = m_req_mem;
+    m_memory_ptr = (char *) basic::alloc_pages( m_alloc_mem,
+                                                m_page_type,
+                                                &m_page_size );
+    m_aligned_memory_ptr = m_memory_ptr;
+    if( m_memory_ptr == nullptr ){
+      m_alloc_mem = 0;
+      return err_t::COMPILATION_FAILED;
+    }
   }
 
-  m_contraction_memory_manager.alloc_all_memory();
+  basic::err_t l_err = m_contraction_memory_manager.alloc_all_memory();
+  return ce_basic_err_to_err( l_err );
 }
 
 void * einsum_ir::backend::MemoryManager::get_mem_ptr( int64_t i_id ){
@@ -16,8 +16,13 @@ class einsum_ir::backend::MemoryManager{
   private:
     //! alignment of memory to cache lines in bytes 
     int64_t m_alignment_line = 128;
-    //! alignment of memory to pages in bytes 
-    int64_t m_alignment_page = 4096;
+
+    //! requested type of pages
+    basic::page_t m_page_type = basic::page_t::BASE_PAGES;
+    //! obtained page size in bytes
+    int64_t m_page_size = 0;
+    //! size of the allocated memory in bytes
+    int64_t m_alloc_mem = 0;
 
     //! pointer to the start of all allocated memory
     char * m_memory_ptr = nullptr;
@@ -41,6 +46,11 @@ class einsum_ir::backend::MemoryManager{
     //! memory manager for contractions
     einsum_ir::basic::ContractionMemoryManager m_contraction_memory_manager;
 
+    //! number of nested regions in which subtrees are evaluated concurrently
+    int64_t m_num_concurrent_regions = 0;
+    //! reservations which are removed at the end of the outermost concurrent region
+    std::vector<int64_t> m_deferred_removals;
+
   public:
     //! id of the current layer
     int64_t m_layer_id = 0;
@@ -66,10 +76,40 @@ class einsum_ir::backend::MemoryManager{
      **/
     void remove_reservation( int64_t i_size );
 
+    /**
+     * Begins a region in which subtrees are evaluated concurrently.
+     * Removed reservations are kept until the end of the outermost region,
+     * i.e., concurrently evaluated subtrees never share memory.
+     **/
+    void begin_concurrent_region();
+
+    /**
+     * Ends a region in which subtrees are evaluated concurrently.
+     **/
+    void end_concurrent_region();
+
+    /**
+     * Sets the type of pages backing the memory, has to be called before the allocation.
+     * Applies to the intermediate tensors and the thread specific memory of the contractions.
+     * Falls back to smaller pages if the requested type is unavailable.
+     *
+     * @param i_page_type requested type of pages.
+     **/
+    void set_page_type( basic::page_t i_page_type );
+
+    /**
+     * Gets the size of the pages obtained for the intermediate tensors.
+     *
+     * @return page size in bytes, 0 if no memory was allocated.
+     **/
+    int64_t page_size();
+
     /**
      * Allocates the required memory.
+     *
+     * @return SUCCESS if the memory was allocated, COMPILATION_FAILED otherwise.
      **/
-    void alloc_all_memory();
+    err_t alloc_all_memory();
 
     /**
      * returns a pointer to requested memory
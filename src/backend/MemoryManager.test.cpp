@@ -49,7 +49,8 @@ TEST_CASE( "A complex memory allocation test", "[memory_manager]" ) {
   REQUIRE( l_memory.m_req_mem >= ( 30 + 30 + 15 ) * 4 );
 
   //allocate memory and check some pointer
-  l_memory.alloc_all_memory();
+  einsum_ir::err_t l_err = l_memory.alloc_all_memory();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
   float * l_mem_1_ptr = (float*) l_memory.get_mem_ptr(l_mem_id_2);
   float * l_mem_2_ptr = (float*) l_memory.get_mem_ptr(l_mem_id_3);
   REQUIRE( l_mem_1_ptr != nullptr );
@@ -0,0 +1,144 @@
+#include "TuningDatabase.h"
+#include "../basic/hardware.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace {
+  //! magic string identifying tuning databases
+  char const g_magic[] = "EIR_TUNING";
+}
+
+einsum_ir::backend::TuningDatabase & einsum_ir::backend::TuningDatabase::get() {
+  static TuningDatabase l_db;
+  return l_db;
+}
+
+std::string einsum_ir::backend::TuningDatabase::key( backend_t           i_backend,
+                                                     std::string const & i_signature ) {
+  return basic::host_cpu() + "|" + std::to_string( i_backend ) + "|" + i_signature;
+}
+
+einsum_ir::err_t einsum_ir::backend::TuningDatabase::open( std::string const & i_path ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  if( i_path == m_path ) {
+    return err_t::SUCCESS;
+  }
+  m_path = i_path;
+  m_entries.clear();
+
+  std::ifstream l_file( i_path );
+  if( !l_file ) {
+    return err_t::SUCCESS;
+  }
+
+  // header
+  std::string l_magic;
+  int64_t l_version = 0;
+  if(    !( l_file >> l_magic >> l_version )
+      || l_magic != g_magic
+      || l_version != m_version ) {
+    // detach from the file, i.e., store() never overwrites it
+    m_path.clear();
+    return err_t::INVALID_PLAN;
+  }
+
+  // entries
+  std::string l_line;
+  while( std::getline( l_file, l_line ) ) {
+    std::size_t l_sep = l_line.rfind( '\t' );
+    if( l_sep == std::string::npos ) {
+      continue;
+    }
+
+    basic::optimizer_config l_config;
+    std::istringstream l_params( l_line.substr( l_sep + 1 ) );
+    if( l_params >> l_config.target_m
+                 >> l_config.target_n
+                 >> l_config.target_k
+                 >> l_config.l2_cache_size
+                 >> l_config.generate_sfcs
+                 >> l_config.packing
+                 >> l_config.num_threads_shared
+                 >> l_config.num_threads_m
+                 >> l_config.num_threads_n ) {
+      m_entries[ l_line.substr( 0, l_sep ) ] = l_config;
+    }
+  }
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::err_t einsum_ir::backend::TuningDatabase::store() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  if( m_path.empty() ) {
+    return err_t::INVALID_PLAN;
+  }
+
+  // write to a temporary file which replaces the database, i.e., readers never see partial files
+  std::string l_path_tmp = m_path + ".tmp";
+  {
+    std::ofstream l_file( l_path_tmp, std::ios::trunc );
+    if( !l_file ) {
+      return err_t::INVALID_PLAN;
+    }
+
+    l_file << g_magic << " " << m_version << "\n";
+    for( auto const & l_entry : m_entries ) {
+      basic::optimizer_config const & l_config = l_entry.second;
+      l_file << l_entry.first << "\t"
+             << l_config.target_m << " "
+             << l_config.target_n << " "
+             << l_config.target_k << " "
+             << l_config.l2_cache_size << " "
+             << l_config.generate_sfcs << " "
+             << l_config.packing << " "
+             << l_config.num_threads_shared << " "
+             << l_config.num_threads_m << " "
+             << l_config.num_threads_n << "\n";
+    }
+
+    if( !l_file ) {
+      return err_t::INVALID_PLAN;
+    }
+  }
+
+  if( std::rename( l_path_tmp.c_str(), m_path.c_str() ) != 0 ) {
+    std::remove( l_path_tmp.c_str() );
+    return err_t::INVALID_PLAN;
+  }
+
+  return err_t::SUCCESS;
+}
+
+bool einsum_ir::backend::TuningDatabase::find( std::string             const & i_key,
+                                               basic::optimizer_config       & o_config ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  auto l_entry = m_entries.find( i_key );
+  if( l_entry == m_entries.end() ) {
+    return false;
+  }
+  o_config = l_entry->second;
+
+  return true;
+}
+
+void einsum_ir::backend::TuningDatabase::insert( std::string             const & i_key,
+                                                 basic::optimizer_config const & i_config ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  m_entries[i_key] = i_config;
+}
+
+int64_t einsum_ir::backend::TuningDatabase::size() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_entries.size();
+}
+
+void einsum_ir::backend::TuningDatabase::clear() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  m_path.clear();
+  m_entries.clear();
+}
@@ -0,0 +1,106 @@
+#ifndef EINSUM_IR_BACKEND_TUNING_DATABASE
+#define EINSUM_IR_BACKEND_TUNING_DATABASE
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include "../constants.h"
+
+namespace einsum_ir {
+  namespace backend {
+    class TuningDatabase;
+  }
+}
+
+/**
+ * Process-wide, thread-safe database of tuned parameters of the contraction optimizer.
+ *
+ * Entries are keyed by the host CPU, the backend and the signature of a contraction.
+ * The database is persisted as a text file:
+ *   a header line "EIR_TUNING <version>",
+ *   followed by one line per entry: key, tab, parameters separated by spaces.
+ **/
+class einsum_ir::backend::TuningDatabase {
+  private:
+    //! protects the database's data structures
+    std::mutex m_mutex;
+
+    //! path of the file backing the database, empty if not persisted
+    std::string m_path;
+
+    //! tuned parameters of the contractions
+    std::map< std::string, basic::optimizer_config > m_entries;
+
+  public:
+    //! version of the file format, increased on every incompatible change
+    static int64_t const m_version = 1;
+
+    /**
+     * Gets the process-wide tuning database.
+     *
+     * @return tuning database.
+     **/
+    static TuningDatabase & get();
+
+    /**
+     * Derives the key of a contraction on the host CPU.
+     *
+     * @param i_backend backend of the contraction.
+     * @param i_signature signature of the contraction.
+     * @return key.
+     **/
+    static std::string key( backend_t           i_backend,
+                            std::string const & i_signature );
+
+    /**
+     * Backs the database by the given file and reads its entries.
+     * Nothing is done if the database is already backed by the file.
+     * Missing files are created when storing the database, invalid lines are skipped.
+     * Files which exist but are no tuning databases leave the database detached, i.e., they are never overwritten.
+     *
+     * @param i_path path of the file.
+     * @return SUCCESS if successful, INVALID_PLAN if the file exists but is no tuning database.
+     **/
+    err_t open( std::string const & i_path );
+
+    /**
+     * Writes all entries to the file backing the database.
+     *
+     * @return SUCCESS if successful, INVALID_PLAN if the file could not be written.
+     **/
+    err_t store();
+
+    /**
+     * Looks up the tuned parameters of a key.
+     *
+     * @param i_key key of the contraction.
+     * @param o_config will be set to the tuned parameters if found.
+     * @return true if an entry exists, false otherwise.
+     **/
+    bool find( std::string             const & i_key,
+               basic::optimizer_config       & o_config );
+
+    /**
+     * Inserts or replaces the tuned parameters of a key.
+     *
+     * @param i_key key of the contraction.
+     * @param i_config tuned parameters.
+     **/
+    void insert( std::string             const & i_key,
+                 basic::optimizer_config const & i_config );
+
+    /**
+     * Gets the number of entries.
+     *
+     * @return number of entries.
+     **/
+    int64_t size();
+
+    /**
+     * Removes all entries and detaches the database from its file.
+     **/
+    void clear();
+};
+
+#endif
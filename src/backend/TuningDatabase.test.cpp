@@ -0,0 +1,74 @@
+#include <cstdio>
+#include <fstream>
+#include "catch.hpp"
+#include "TuningDatabase.h"
+
+TEST_CASE( "Storing and reopening a tuning database.", "[tuning_database]" ) {
+  std::string l_path = "einsum_ir_tuning_database_test.txt";
+  std::remove( l_path.c_str() );
+
+  einsum_ir::backend::TuningDatabase & l_db = einsum_ir::backend::TuningDatabase::get();
+  l_db.clear();
+
+  // missing files start an empty database
+  REQUIRE( l_db.open( l_path ) == einsum_ir::SUCCESS );
+  REQUIRE( l_db.size() == 0 );
+
+  std::string l_key_0 = einsum_ir::backend::TuningDatabase::key( einsum_ir::SCALAR, "0:8/8,|1:4/4,|" );
+  std::string l_key_1 = einsum_ir::backend::TuningDatabase::key( einsum_ir::SIMD,   "0:8/8,|1:4/4,|" );
+  REQUIRE( l_key_0 != l_key_1 );
+
+  einsum_ir::basic::optimizer_config l_config;
+  l_config.target_m           = 32;
+  l_config.target_n           = 64;
+  l_config.target_k           = 512;
+  l_config.l2_cache_size      = 2097152;
+  l_config.generate_sfcs      = false;
+  l_config.packing            = true;
+  l_config.num_threads_shared = 2;
+  l_config.num_threads_m      = 3;
+  l_config.num_threads_n      = 1;
+
+  l_db.insert( l_key_0, l_config );
+  REQUIRE( l_db.store() == einsum_ir::SUCCESS );
+
+  // reread the stored file
+  l_db.clear();
+  REQUIRE( l_db.open( l_path ) == einsum_ir::SUCCESS );
+  REQUIRE( l_db.size() == 1 );
+
+  einsum_ir::basic::optimizer_config l_config_read;
+  REQUIRE( l_db.find( l_key_1, l_config_read ) == false );
+  REQUIRE( l_db.find( l_key_0, l_config_read ) == true );
+  REQUIRE( l_config_read.target_m           == 32 );
+  REQUIRE( l_config_read.target_n           == 64 );
+  REQUIRE( l_config_read.target_k           == 512 );
+  REQUIRE( l_config_read.l2_cache_size      == 2097152 );
+  REQUIRE( l_config_read.generate_sfcs      == false );
+  REQUIRE( l_config_read.packing            == true );
+  REQUIRE( l_config_read.num_threads_shared == 2 );
+  REQUIRE( l_config_read.num_threads_m      == 3 );
+  REQUIRE( l_config_read.num_threads_n      == 1 );
+
+  // files of another format are rejected
+  l_db.clear();
+  {
+    std::ofstream l_file( l_path, std::ios::trunc );
+    l_file << "EIR_PLAN 1\n";
+  }
+  REQUIRE( l_db.open( l_path ) == einsum_ir::INVALID_PLAN );
+  REQUIRE( l_db.size() == 0 );
+
+  // rejected files are not overwritten
+  l_db.insert( "key", l_config );
+  REQUIRE( l_db.store() == einsum_ir::INVALID_PLAN );
+  {
+    std::ifstream l_file( l_path );
+    std::string l_magic;
+    l_file >> l_magic;
+    REQUIRE( l_magic == "EIR_PLAN" );
+  }
+
+  l_db.clear();
+  std::remove( l_path.c_str() );
+}
@@ -30,7 +30,8 @@ einsum_ir::err_t einsum_ir::backend::UnaryTpp::compile() {
 
   l_optim.init( &l_loops ,
                 m_num_threads,
-                false );
+                false,
+                ce_n_bytes( m_dtype_in ) + ce_n_bytes( m_dtype_out ) );
   l_optim.optimize();
 
   //setup backend
@@ -0,0 +1,344 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+thread_local einsum_ir::basic::ThreadPool::team_t einsum_ir::basic::ThreadPool::t_team;
+
+namespace {
+  //! distribution of thread ids among fewer threads
+  struct strided_t {
+    void (* func)( void *, int64_t );
+    void * ctx;
+    int64_t num_ids;
+    int64_t stride;
+  };
+
+  void exec_strided( void    * i_ctx,
+                     int64_t   i_first ) {
+    strided_t * l_strided = static_cast< strided_t * >( i_ctx );
+    for( int64_t l_id = i_first; l_id < l_strided->num_ids; l_id += l_strided->stride ) {
+      l_strided->func( l_strided->ctx, l_id );
+    }
+  }
+}
+
+einsum_ir::basic::ThreadPool::~ThreadPool() {
+  m_stop.store( true );
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+  }
+  m_cond.notify_all();
+
+  for( std::size_t l_wo = 0; l_wo < m_workers.size(); l_wo++ ) {
+    m_workers[l_wo].join();
+  }
+}
+
+einsum_ir::basic::ThreadPool & einsum_ir::basic::ThreadPool::get() {
+  static ThreadPool l_pool;
+  return l_pool;
+}
+
+void einsum_ir::basic::ThreadPool::pause() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile( "yield" ::: "memory" );
+#endif
+}
+
+void einsum_ir::basic::ThreadPool::pin( int64_t i_thread_id ) {
+#if defined(__linux__)
+  cpu_set_t l_set_avail;
+  CPU_ZERO( &l_set_avail );
+  if( sched_getaffinity( 0, sizeof(l_set_avail), &l_set_avail ) != 0 ) {
+    return;
+  }
+
+  int64_t l_num_cpus = CPU_COUNT( &l_set_avail );
+  if( l_num_cpus < 2 ) {
+    return;
+  }
+
+  // select the i-th available cpu, thread 0 is the calling thread
+  int64_t l_target = i_thread_id % l_num_cpus;
+  int64_t l_count = 0;
+  for( int64_t l_cpu = 0; l_cpu < CPU_SETSIZE; l_cpu++ ) {
+    if( !CPU_ISSET( l_cpu, &l_set_avail ) ) {
+      continue;
+    }
+    if( l_count == l_target ) {
+      cpu_set_t l_set;
+      CPU_ZERO( &l_set );
+      CPU_SET( l_cpu, &l_set );
+      sched_setaffinity( 0, sizeof(l_set), &l_set );
+      return;
+    }
+    l_count++;
+  }
+#else
+  (void) i_thread_id;
+#endif
+}
+
+void einsum_ir::basic::ThreadPool::worker_loop( int64_t   i_worker_id,
+                                                slot_t  * i_slot,
+                                                bool      i_pin ) {
+  if( i_pin ) {
+    pin( i_worker_id + 1 );
+  }
+
+  int64_t l_gen_seen = 0;
+  while( true ) {
+    // spin until a new job is posted
+    int64_t l_spin_count = m_spin_count.load( std::memory_order_relaxed );
+    int64_t l_gen = i_slot->generation.load( std::memory_order_acquire );
+    for( int64_t l_it = 0; l_it < l_spin_count && l_gen == l_gen_seen; l_it++ ) {
+      if( m_stop.load( std::memory_order_relaxed ) ) {
+        return;
+      }
+      pause();
+      l_gen = i_slot->generation.load( std::memory_order_acquire );
+    }
+
+    // sleep until a new job is posted
+    if( l_gen == l_gen_seen ) {
+      std::unique_lock< std::mutex > l_lock( m_mutex );
+      m_num_sleeping.fetch_add( 1 );
+      while(    (l_gen = i_slot->generation.load()) == l_gen_seen
+             && !m_stop.load() ) {
+        m_cond.wait( l_lock );
+      }
+      m_num_sleeping.fetch_sub( 1 );
+    }
+
+    if( m_stop.load() ) {
+      return;
+    }
+
+    // execute job, the slot is not modified before the pending counter is decremented
+    l_gen_seen = l_gen;
+    std::atomic< int64_t > * l_pending = i_slot->pending;
+    t_team = i_slot->team;
+    i_slot->func( i_slot->ctx, i_slot->id );
+    t_team = team_t();
+    l_pending->fetch_sub( 1, std::memory_order_release );
+  }
+}
+
+void einsum_ir::basic::ThreadPool::grow( int64_t i_num_workers ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  bool l_pin = m_pin.load();
+  for( int64_t l_wo = m_workers.size(); l_wo < i_num_workers; l_wo++ ) {
+    m_slots.push_back( std::unique_ptr< slot_t >( new slot_t ) );
+    m_workers.push_back( std::thread( &ThreadPool::worker_loop,
+                                      this,
+                                      l_wo,
+                                      m_slots.back().get(),
+                                      l_pin ) );
+  }
+}
+
+bool einsum_ir::basic::ThreadPool::acquire( int64_t   i_num_workers,
+                                            team_t  & o_team ) {
+  // nested parallel region: use the team of the calling thread
+  if( t_team.active ) {
+    o_team = t_team;
+    return false;
+  }
+
+  // top-level parallel region: acquire the pool, wait if another thread runs a top-level job
+  o_team = team_t();
+  o_team.active = true;
+  if( m_busy.exchange( true ) ) {
+    std::unique_lock< std::mutex > l_lock( m_mutex_busy );
+    m_num_waiting.fetch_add( 1 );
+    while( m_busy.exchange( true ) ) {
+      m_cond_busy.wait( l_lock );
+    }
+    m_num_waiting.fetch_sub( 1 );
+  }
+  if( (int64_t) m_slots.size() < i_num_workers ) {
+    grow( i_num_workers );
+  }
+  o_team.size = i_num_workers;
+
+  return true;
+}
+
+void einsum_ir::basic::ThreadPool::release() {
+  m_busy.store( false );
+  if( m_num_waiting.load() > 0 ) {
+    {
+      std::lock_guard< std::mutex > l_lock( m_mutex_busy );
+    }
+    m_cond_busy.notify_one();
+  }
+}
+
+void einsum_ir::basic::ThreadPool::post( int64_t                  i_worker,
+                                         void                  (* i_func)( void *, int64_t ),
+                                         void                   * i_ctx,
+                                         int64_t                  i_id,
+                                         team_t                   i_team,
+                                         std::atomic< int64_t > & io_pending ) {
+  slot_t * l_slot = m_slots[i_worker].get();
+  l_slot->func = i_func;
+  l_slot->ctx = i_ctx;
+  l_slot->id = i_id;
+  l_slot->team = i_team;
+  l_slot->pending = &io_pending;
+
+  io_pending.fetch_add( 1, std::memory_order_relaxed );
+  l_slot->generation.fetch_add( 1 );
+}
+
+void einsum_ir::basic::ThreadPool::wake() {
+  if( m_num_sleeping.load() > 0 ) {
+    {
+      std::lock_guard< std::mutex > l_lock( m_mutex );
+    }
+    m_cond.notify_all();
+  }
+}
+
+void einsum_ir::basic::ThreadPool::wait( std::atomic< int64_t > const & i_pending ) {
+  int64_t l_spin_count = m_spin_count.load( std::memory_order_relaxed );
+  for( int64_t l_it = 0; i_pending.load( std::memory_order_acquire ) != 0; l_it++ ) {
+    if( l_it < l_spin_count ) {
+      pause();
+    }
+    else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void einsum_ir::basic::ThreadPool::set_spin_count( int64_t i_spin_count ) {
+  m_spin_count.store( i_spin_count );
+}
+
+void einsum_ir::basic::ThreadPool::set_pinning( bool i_pin ) {
+  m_pin.store( i_pin );
+}
+
+int64_t einsum_ir::basic::ThreadPool::num_workers() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_workers.size();
+}
+
+void einsum_ir::basic::ThreadPool::execute( int64_t   i_num_threads,
+                                            void   (* i_func)( void *, int64_t ),
+                                            void    * i_ctx ) {
+  if( i_num_threads <= 1 ) {
+    for( int64_t l_th = 0; l_th < i_num_threads; l_th++ ) {
+      i_func( i_ctx, l_th );
+    }
+    return;
+  }
+
+  team_t l_team;
+  bool l_release = acquire( i_num_threads - 1,
+                            l_team );
+  int64_t l_num_workers = std::min( i_num_threads - 1,
+                                    l_team.size );
+
+  // distribute the thread ids among the calling thread and the workers
+  strided_t l_strided;
+  l_strided.func = i_func;
+  l_strided.ctx = i_ctx;
+  l_strided.num_ids = i_num_threads;
+  l_strided.stride = l_num_workers + 1;
+
+  std::atomic< int64_t > l_pending{ 0 };
+  for( int64_t l_wo = 0; l_wo < l_num_workers; l_wo++ ) {
+    post( l_team.first + l_wo,
+          exec_strided,
+          &l_strided,
+          l_wo + 1,
+          team_t{ true, 0, 0 },
+          l_pending );
+  }
+  wake();
+
+  // calling thread executes thread id 0, nested regions are sequential
+  team_t l_team_caller = t_team;
+  t_team = team_t{ true, 0, 0 };
+  exec_strided( &l_strided, 0 );
+  t_team = l_team_caller;
+
+  wait( l_pending );
+
+  if( l_release ) {
+    release();
+  }
+}
+
+void einsum_ir::basic::ThreadPool::execute_teams( int64_t           i_num_teams,
+                                                  int64_t   const * i_team_sizes,
+                                                  void           (* i_func)( void *, int64_t ),
+                                                  void            * i_ctx ) {
+  int64_t l_num_threads = 0;
+  for( int64_t l_te = 0; l_te < i_num_teams; l_te++ ) {
+    l_num_threads += std::max( i_team_sizes[l_te], (int64_t) 1 );
+  }
+
+  team_t l_team;
+  bool l_release = acquire( l_num_threads - 1,
+                            l_team );
+  int64_t l_next = l_team.first;
+  int64_t l_end  = l_team.first + l_team.size;
+
+  // the calling thread leads the first team
+  team_t l_team_first{ true, l_next, 0 };
+  if( i_num_teams > 0 ) {
+    l_team_first.size = std::min( std::max( i_team_sizes[0] - 1, (int64_t) 0 ),
+                                  l_end - l_next );
+  }
+  l_next += l_team_first.size;
+
+  // workers lead the other teams
+  std::atomic< int64_t > l_pending{ 0 };
+  int64_t l_te_seq = i_num_teams;
+  for( int64_t l_te = 1; l_te < i_num_teams; l_te++ ) {
+    if( l_next >= l_end ) {
+      l_te_seq = l_te;
+      break;
+    }
+    int64_t l_leader = l_next++;
+    team_t l_team_worker{ true, l_next, 0 };
+    l_team_worker.size = std::min( std::max( i_team_sizes[l_te] - 1, (int64_t) 0 ),
+                                   l_end - l_next );
+    l_next += l_team_worker.size;
+
+    post( l_leader,
+          i_func,
+          i_ctx,
+          l_te,
+          l_team_worker,
+          l_pending );
+  }
+  wake();
+
+  // calling thread executes the first team and all teams without a leader
+  team_t l_team_caller = t_team;
+  t_team = l_team_first;
+  if( i_num_teams > 0 ) {
+    i_func( i_ctx, 0 );
+  }
+  for( int64_t l_te = l_te_seq; l_te < i_num_teams; l_te++ ) {
+    i_func( i_ctx, l_te );
+  }
+  t_team = l_team_caller;
+
+  wait( l_pending );
+
+  if( l_release ) {
+    release();
+  }
+}
@@ -0,0 +1,234 @@
+#ifndef EINSUM_IR_BASIC_THREAD_POOL
+#define EINSUM_IR_BASIC_THREAD_POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace einsum_ir {
+  namespace basic {
+    class ThreadPool;
+  }
+}
+
+/**
+ * Persistent pool of worker threads.
+ *
+ * The calling thread participates as thread 0, workers execute the remaining thread ids.
+ * Idle workers spin for a configurable number of iterations before they go to sleep.
+ * Every worker has its own job slot, i.e., only the workers which participate in a job are woken up.
+ * Completion is signaled through an atomic counter which the calling thread spins on.
+ *
+ * Independent tasks may be executed concurrently by disjoint teams of workers.
+ * Parallel regions inside such a task only use the workers of the task's team.
+ *
+ * The pool executes one top-level job at a time.
+ * Top-level calls of other threads block until the running job finished, i.e., every job gets all requested workers.
+ **/
+class einsum_ir::basic::ThreadPool {
+  private:
+    //! range of workers which is available to a thread for nested parallel regions
+    struct team_t {
+      //! true if the thread executes a job of the pool
+      bool active = false;
+      //! id of the first worker of the team
+      int64_t first = 0;
+      //! number of workers in the team
+      int64_t size = 0;
+    };
+
+    //! job slot of a worker, placed on its own cache line
+    struct alignas(128) slot_t {
+      //! generation of the last job which was posted to the worker
+      std::atomic< int64_t > generation{ 0 };
+      //! function which is executed by the worker
+      void (* func)( void *, int64_t ) = nullptr;
+      //! context passed to the function
+      void * ctx = nullptr;
+      //! id passed to the function
+      int64_t id = 0;
+      //! team of the worker while executing the job
+      team_t team;
+      //! counter which is decremented once the job is finished
+      std::atomic< int64_t > * pending = nullptr;
+    };
+
+    //! team of the calling thread
+    static thread_local team_t t_team;
+
+    //! worker threads
+    std::vector< std::thread > m_workers;
+    //! job slots of the workers
+    std::vector< std::unique_ptr< slot_t > > m_slots;
+
+    //! number of workers which are sleeping
+    std::atomic< int64_t > m_num_sleeping{ 0 };
+    //! true if the workers should terminate
+    std::atomic< bool > m_stop{ false };
+    //! true while a top-level job is executed
+    std::atomic< bool > m_busy{ false };
+    //! number of threads which wait for the running top-level job
+    std::atomic< int64_t > m_num_waiting{ 0 };
+    //! mutex and condition variable used by threads which wait for the running top-level job
+    std::mutex m_mutex_busy;
+    std::condition_variable m_cond_busy;
+
+    //! mutex and condition variable used by sleeping workers
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+
+    //! number of spin iterations before a worker goes to sleep
+    std::atomic< int64_t > m_spin_count{ 20000 };
+    //! true if workers are pinned to cores
+    std::atomic< bool > m_pin{ true };
+
+    /**
+     * Main loop of a worker.
+     *
+     * @param i_worker_id id of the worker, corresponds to thread id i_worker_id+1 of a job.
+     * @param i_slot job slot of the worker.
+     * @param i_pin true if the worker should be pinned to a core.
+     **/
+    void worker_loop( int64_t   i_worker_id,
+                      slot_t  * i_slot,
+                      bool      i_pin );
+
+    /**
+     * Pins the calling thread to a core of its affinity mask.
+     *
+     * @param i_thread_id id of the thread, used to select the core.
+     **/
+    static void pin( int64_t i_thread_id );
+
+    /**
+     * Creates workers until the pool has the given number of workers.
+     *
+     * @param i_num_workers number of workers.
+     **/
+    void grow( int64_t i_num_workers );
+
+    /**
+     * Acquires the workers for a job of the calling thread.
+     * Inside a job the team of the calling thread is used.
+     * Otherwise the pool is acquired and grown to the requested number of workers.
+     * If the pool is busy, the calling thread blocks until the running top-level job finished.
+     *
+     * @param i_num_workers number of requested workers.
+     * @param o_team will be set to the available workers.
+     * @return true if the pool was acquired and has to be released by the caller.
+     **/
+    bool acquire( int64_t   i_num_workers,
+                  team_t  & o_team );
+
+    /**
+     * Releases the pool after a top-level job and wakes up threads waiting for it.
+     **/
+    void release();
+
+    /**
+     * Posts a job to a worker.
+     *
+     * @param i_worker id of the worker.
+     * @param i_func function which is executed by the worker.
+     * @param i_ctx context passed to the function.
+     * @param i_id id passed to the function.
+     * @param i_team team of the worker while executing the job.
+     * @param io_pending counter which is incremented now and decremented once the job is finished.
+     **/
+    void post( int64_t                  i_worker,
+               void                  (* i_func)( void *, int64_t ),
+               void                   * i_ctx,
+               int64_t                  i_id,
+               team_t                   i_team,
+               std::atomic< int64_t > & io_pending );
+
+    /**
+     * Wakes up sleeping workers.
+     **/
+    void wake();
+
+    /**
+     * Waits until all jobs of a counter are finished.
+     *
+     * @param i_pending counter of the pending jobs.
+     **/
+    void wait( std::atomic< int64_t > const & i_pending );
+
+  public:
+    /**
+     * Destructor which terminates all workers.
+     **/
+    ~ThreadPool();
+
+    /**
+     * Gets the process-wide thread pool.
+     *
+     * @return thread pool.
+     **/
+    static ThreadPool & get();
+
+    /**
+     * Hints the CPU that the calling thread is spinning.
+     **/
+    static void pause();
+
+    /**
+     * Sets the number of spin iterations before idle workers go to sleep.
+     * A value of 0 lets workers sleep immediately.
+     *
+     * @param i_spin_count number of spin iterations.
+     **/
+    void set_spin_count( int64_t i_spin_count );
+
+    /**
+     * Enables or disables pinning of workers which are created afterwards.
+     *
+     * @param i_pin true if workers should be pinned.
+     **/
+    void set_pinning( bool i_pin );
+
+    /**
+     * Gets the number of workers in the pool.
+     *
+     * @return number of workers.
+     **/
+    int64_t num_workers();
+
+    /**
+     * Executes a function with the given number of threads.
+     * The function is called once for every thread id in [0, i_num_threads).
+     * Inside a team, the thread ids are distributed among the threads of the team.
+     * If no workers are available, e.g., for nested calls, the thread ids are executed sequentially by the calling thread.
+     * Top-level calls block while another thread executes a top-level job.
+     *
+     * @param i_num_threads number of threads.
+     * @param i_func function which is called with the context and thread id.
+     * @param i_ctx context which is passed to the function.
+     **/
+    void execute( int64_t   i_num_threads,
+                  void   (* i_func)( void *, int64_t ),
+                  void    * i_ctx );
+
+    /**
+     * Executes independent tasks concurrently on disjoint teams of threads.
+     * The function is called once for every team id in [0, i_num_teams) by the team's first thread.
+     * Parallel regions inside the function only use the threads of the respective team.
+     * If not enough threads are available, the remaining tasks are executed by the calling thread.
+     * Top-level calls block while another thread executes a top-level job.
+     *
+     * @param i_num_teams number of teams.
+     * @param i_team_sizes number of threads of every team.
+     * @param i_func function which is called with the context and team id.
+     * @param i_ctx context which is passed to the function.
+     **/
+    void execute_teams( int64_t           i_num_teams,
+                        int64_t   const * i_team_sizes,
+                        void           (* i_func)( void *, int64_t ),
+                        void            * i_ctx );
+};
+
+#endif
@@ -0,0 +1,136 @@
+#include "catch.hpp"
+#include "ThreadPool.h"
+#include "threading.h"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST_CASE( "Execution of all thread ids through the thread pool.", "[thread_pool]" ) {
+  einsum_ir::basic::ThreadPool & l_pool = einsum_ir::basic::ThreadPool::get();
+
+  int64_t l_num_threads[6] = { 0, 1, 2, 3, 8, 5 };
+
+  for( int64_t l_te = 0; l_te < 6; l_te++ ) {
+    std::vector< std::atomic< int64_t > > l_counts( 8 );
+    for( int64_t l_th = 0; l_th < 8; l_th++ ) {
+      l_counts[l_th].store( 0 );
+    }
+
+    l_pool.execute( l_num_threads[l_te],
+                    []( void * i_ctx, int64_t i_thread_id ) {
+                      std::vector< std::atomic< int64_t > > * l_counts_ctx = static_cast< std::vector< std::atomic< int64_t > > * >( i_ctx );
+                      (*l_counts_ctx)[i_thread_id].fetch_add( 1 );
+                    },
+                    &l_counts );
+
+    for( int64_t l_th = 0; l_th < 8; l_th++ ) {
+      REQUIRE( l_counts[l_th].load() == (l_th < l_num_threads[l_te] ? 1 : 0) );
+    }
+  }
+
+  REQUIRE( l_pool.num_workers() >= 7 );
+}
+
+TEST_CASE( "Repeated and nested execution through the thread pool.", "[thread_pool]" ) {
+  // repeated small jobs
+  std::atomic< int64_t > l_sum( 0 );
+  for( int64_t l_re = 0; l_re < 1000; l_re++ ) {
+    einsum_ir::basic::execute_threaded( 4, [&]( int64_t i_thread_id ) {
+      l_sum.fetch_add( i_thread_id + 1 );
+    });
+  }
+  REQUIRE( l_sum.load() == 1000 * (1+2+3+4) );
+
+  // nested jobs are executed sequentially by the inner caller
+  std::atomic< int64_t > l_num_inner( 0 );
+  einsum_ir::basic::execute_threaded( 4, [&]( int64_t ) {
+    einsum_ir::basic::execute_threaded( 3, [&]( int64_t ) {
+      l_num_inner.fetch_add( 1 );
+    });
+  });
+  REQUIRE( l_num_inner.load() == 4 * 3 );
+}
+
+TEST_CASE( "Thread pool with sleeping workers.", "[thread_pool]" ) {
+  einsum_ir::basic::ThreadPool & l_pool = einsum_ir::basic::ThreadPool::get();
+  l_pool.set_spin_count( 0 );
+
+  std::atomic< int64_t > l_sum( 0 );
+  for( int64_t l_re = 0; l_re < 100; l_re++ ) {
+    einsum_ir::basic::execute_threaded( 6, [&]( int64_t i_thread_id ) {
+      l_sum.fetch_add( i_thread_id );
+    });
+  }
+  REQUIRE( l_sum.load() == 100 * (0+1+2+3+4+5) );
+
+  l_pool.set_spin_count( 20000 );
+}
+
+TEST_CASE( "Concurrent execution of tasks by teams of threads.", "[thread_pool]" ) {
+  int64_t l_team_sizes[3] = { 3, 1, 4 };
+
+  std::atomic< int64_t > l_num_calls[3];
+  std::atomic< int64_t > l_sums[3];
+  for( int64_t l_te = 0; l_te < 3; l_te++ ) {
+    l_num_calls[l_te].store( 0 );
+    l_sums[l_te].store( 0 );
+  }
+
+  // every team executes a parallel region with twice its number of threads
+  einsum_ir::basic::execute_teams( 3,
+                                   l_team_sizes,
+                                   [&]( int64_t i_team_id ) {
+                                     l_num_calls[i_team_id].fetch_add( 1 );
+                                     einsum_ir::basic::execute_threaded( 2*l_team_sizes[i_team_id], [&]( int64_t i_thread_id ) {
+                                       l_sums[i_team_id].fetch_add( i_thread_id + 1 );
+                                     });
+                                   } );
+
+  for( int64_t l_te = 0; l_te < 3; l_te++ ) {
+    int64_t l_num_threads = 2*l_team_sizes[l_te];
+    REQUIRE( l_num_calls[l_te].load() == 1 );
+    REQUIRE( l_sums[l_te].load() == l_num_threads * (l_num_threads + 1) / 2 );
+  }
+
+  // nested teams
+  std::atomic< int64_t > l_num_leaves( 0 );
+  int64_t l_team_sizes_outer[2] = { 4, 4 };
+  int64_t l_team_sizes_inner[2] = { 2, 2 };
+  einsum_ir::basic::execute_teams( 2,
+                                   l_team_sizes_outer,
+                                   [&]( int64_t ) {
+                                     einsum_ir::basic::execute_teams( 2,
+                                                                      l_team_sizes_inner,
+                                                                      [&]( int64_t ) {
+                                                                        einsum_ir::basic::execute_threaded( 2, [&]( int64_t ) {
+                                                                          l_num_leaves.fetch_add( 1 );
+                                                                        });
+                                                                      } );
+                                   } );
+  REQUIRE( l_num_leaves.load() == 2 * 2 * 2 );
+}
+
+TEST_CASE( "Concurrent top-level calls of the thread pool.", "[thread_pool]" ) {
+  // callers wait for the running job, i.e., every call is executed by all requested threads
+  std::atomic< int64_t > l_num_parallel( 0 );
+  auto l_caller = [&]() {
+    for( int64_t l_re = 0; l_re < 50; l_re++ ) {
+      std::vector< std::thread::id > l_ids( 4 );
+      einsum_ir::basic::execute_threaded( 4, [&]( int64_t i_thread_id ) {
+        l_ids[i_thread_id] = std::this_thread::get_id();
+      });
+      if( std::set< std::thread::id >( l_ids.begin(), l_ids.end() ).size() == 4 ) {
+        l_num_parallel.fetch_add( 1 );
+      }
+    }
+  };
+
+  std::thread l_thread_0( l_caller );
+  std::thread l_thread_1( l_caller );
+  l_thread_0.join();
+  l_thread_1.join();
+
+  REQUIRE( l_num_parallel.load() == 2 * 50 );
+}
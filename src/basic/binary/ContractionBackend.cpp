@@ -1,7 +1,145 @@
 #include "ContractionBackend.h"
 #include "../unary/UnaryOptimizer.h"
+#include "../unary/UnaryBackendSimd.h"
+#ifdef PP_EINSUM_IR_HAS_LIBXSMM
+#include "../unary/UnaryBackendTpp.h"
+#endif
 #include "../threading.h"
+#include "../pages.h"
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+  /**
+   * Adds a strided row of a partial output tensor to the output tensor.
+   *
+   * @param i_size number of entries.
+   * @param i_stride stride of the entries in bytes.
+   * @param i_partial first entry of the partial output tensor, nullptr zeroes the output entries.
+   * @param io_out first entry of the output tensor.
+   **/
+  template< typename T >
+  void reduce_strided( int64_t              i_size,
+                       int64_t              i_stride,
+                       char         const * i_partial,
+                       char               * io_out ) {
+    if( i_partial == nullptr ){
+      for( int64_t l_en = 0; l_en < i_size; l_en++ ){
+        *(T *) (io_out + l_en * i_stride) = 0;
+      }
+    }
+    else if( i_stride == (int64_t) sizeof(T) ){
+      T       * l_out     = (T *) io_out;
+      T const * l_partial = (T const *) i_partial;
+      for( int64_t l_en = 0; l_en < i_size; l_en++ ){
+        l_out[l_en] += l_partial[l_en];
+      }
+    }
+    else{
+      for( int64_t l_en = 0; l_en < i_size; l_en++ ){
+        *(T *) (io_out + l_en * i_stride) += *(T const *) (i_partial + l_en * i_stride);
+      }
+    }
+  }
+
+  /**
+   * Converts a BF16 value to FP32.
+   *
+   * @param i_val bits of the BF16 value.
+   * @return FP32 value.
+   **/
+  float bf16_to_fp32( uint16_t i_val ) {
+    uint32_t l_bits = (uint32_t) i_val << 16;
+    float l_val = 0;
+    std::memcpy( &l_val, &l_bits, sizeof(float) );
+    return l_val;
+  }
+
+  /**
+   * Converts a FP32 value to BF16, rounding to nearest even.
+   *
+   * @param i_val FP32 value.
+   * @return bits of the BF16 value.
+   **/
+  uint16_t fp32_to_bf16( float i_val ) {
+    uint32_t l_bits = 0;
+    std::memcpy( &l_bits, &i_val, sizeof(float) );
+    if( std::isnan( i_val ) ){
+      return (uint16_t) ( (l_bits >> 16) | 0x0040 );
+    }
+    l_bits += 0x7FFF + ( (l_bits >> 16) & 1 );
+    return (uint16_t) (l_bits >> 16);
+  }
+
+  /**
+   * Converts a FP16 value to FP32.
+   *
+   * @param i_val bits of the FP16 value.
+   * @return FP32 value.
+   **/
+  float fp16_to_fp32( uint16_t i_val ) {
+    uint32_t l_sign = (uint32_t) (i_val & 0x8000) << 16;
+    uint32_t l_exp  = (i_val >> 10) & 0x1F;
+    uint32_t l_mant =  i_val        & 0x3FF;
+
+    // subnormals are multiples of 2^-24
+    if( l_exp == 0 ){
+      float l_val = std::ldexp( (float) l_mant, -24 );
+      return l_sign ? -l_val : l_val;
+    }
+
+    uint32_t l_bits = l_sign | (l_mant << 13);
+    if( l_exp == 0x1F ){
+      l_bits |= 0x7F800000;
+    }
+    else{
+      l_bits |= (l_exp + 112) << 23;
+    }
+    float l_val = 0;
+    std::memcpy( &l_val, &l_bits, sizeof(float) );
+    return l_val;
+  }
+
+  /**
+   * Converts a FP32 value to FP16, rounding to nearest even.
+   *
+   * @param i_val FP32 value.
+   * @return bits of the FP16 value.
+   **/
+  uint16_t fp32_to_fp16( float i_val ) {
+    uint32_t l_bits = 0;
+    std::memcpy( &l_bits, &i_val, sizeof(float) );
+    uint16_t l_sign = (uint16_t) ( (l_bits >> 16) & 0x8000 );
+    float l_abs = std::fabs( i_val );
+
+    if( std::isnan( i_val ) ){
+      return l_sign | 0x7E00;
+    }
+    // values which round to infinity
+    if( l_abs >= 65520.0f ){
+      return l_sign | 0x7C00;
+    }
+    // subnormals are multiples of 2^-24
+    if( l_abs < 6.103515625E-5f ){
+      return l_sign | (uint16_t) std::nearbyint( l_abs * 16777216.0f );
+    }
+
+    uint32_t l_abs_bits = l_bits & 0x7FFFFFFF;
+    uint32_t l_rem  = l_abs_bits & 0x1FFF;
+    uint16_t l_half = (uint16_t) ( ( ( (l_abs_bits >> 23) - 112 ) << 10 ) | ( (l_abs_bits >> 13) & 0x3FF ) );
+    if( l_rem > 0x1000 || ( l_rem == 0x1000 && (l_half & 1) ) ){
+      l_half++;
+    }
+    return l_sign | l_half;
+  }
+}
+
+einsum_ir::basic::ContractionBackend::~ContractionBackend() {
+  free_pages( m_acc,
+              m_size_acc,
+              m_page_size_acc );
+}
 
 void einsum_ir::basic::ContractionBackend::init( std::vector< dim_t >   const & i_dim_type,
                                                  std::vector< exec_t >  const & i_exec_type,
@@ -119,6 +257,38 @@ void einsum_ir::basic::ContractionBackend::init( std::vector< iter_property > co
   m_is_compiled = false;
 }
 
+void einsum_ir::basic::ContractionBackend::set_scheduling( sched_t i_sched_shared,
+                                                           int64_t i_chunk_size_shared ){
+  m_sched_shared      = i_sched_shared;
+  m_chunk_size_shared = i_chunk_size_shared;
+}
+
+void einsum_ir::basic::ContractionBackend::set_max_size_partials( int64_t i_max_size_partials ){
+  m_max_size_partials = i_max_size_partials;
+}
+
+void einsum_ir::basic::ContractionBackend::set_quant( quant_params const & i_quant ){
+  m_quant = i_quant;
+}
+
+void einsum_ir::basic::ContractionBackend::set_last_touch_params( last_touch_params const & i_params ){
+  m_last_touch_params = i_params;
+}
+
+void einsum_ir::basic::ContractionBackend::set_packing_prologue( kernel_t                  i_ktype_left,
+                                                                 kernel_t                  i_ktype_right,
+                                                                 last_touch_params const & i_params ){
+  m_ktype_prologue_left  = i_ktype_left;
+  m_ktype_prologue_right = i_ktype_right;
+  m_prologue_params      = i_params;
+}
+
+void einsum_ir::basic::ContractionBackend::set_block_sparsity( block_sparsity const & i_sparsity_left,
+                                                               block_sparsity const & i_sparsity_right ){
+  m_sparsity_left  = i_sparsity_left;
+  m_sparsity_right = i_sparsity_right;
+}
+
 einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
   err_t l_err = err_t::UNDEFINED_ERROR;
   if( m_is_compiled ){
@@ -131,14 +301,83 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
     return l_err;
   }
 
-  // compile kernel
+  // INT32 accumulators are requantized if the output has a different data type,
+  // reduced precision outputs are accumulated in FP32 and rounded in the last touch
+  m_dtype_acc = m_dtype_out;
+  m_requant = false;
+  m_load_acc = false;
+  if(    m_dtype_comp == I32
+      && m_dtype_out  != I32 ) {
+    if(    m_quant.scales == nullptr
+        || m_quant.num_scales < 1
+        || ( m_quant.num_scales > 1 && m_quant.stride_channel < 1 )
+        || ( m_dtype_out != I8 && m_dtype_out != FP32 )
+        || m_ktype_first_touch != kernel_t::ZERO ) {
+      return err_t::COMPILATION_FAILED;
+    }
+    m_dtype_acc = I32;
+    m_requant = true;
+  }
+  else if(    m_dtype_comp == FP32
+           && ( m_dtype_out == BF16 || m_dtype_out == FP16 ) ) {
+    m_dtype_acc = FP32;
+    m_requant = true;
+    m_load_acc =    m_ktype_first_touch == kernel_t::UNDEFINED_KTYPE
+                 || m_ktype_first_touch == kernel_t::ADD;
+  }
+
+  // compile kernel, which may select the VNNI format for the packed left input tensor
+  m_vnni_left = 1;
   l_err = compile_kernels();
   if( l_err != err_t::SUCCESS ) {
     return l_err;
   }
 
-  //update number of threads if loops are to small
+  //size of the data touched by the kernels
   int64_t l_num_iters = m_dim_type.size();
+  int64_t l_size_acc = 1;
+  for(int64_t l_id = 0; l_id < l_num_iters; l_id++){
+    l_size_acc += (m_dim_sizes[l_id] - 1) * m_strides_out[l_id];
+  }
+  l_size_acc *= ce_n_bytes(m_dtype_acc);
+
+  //shared K loops split the reduction, the partial output tensors are summed up in the supported data types
+  m_split_k = false;
+  for(int64_t l_id = 0; l_id < l_num_iters; l_id++){
+    if(    m_exec_type.at(l_id) == exec_t::OMP
+        && m_dim_type.at(l_id)  == dim_t::K ){
+      if(    m_dtype_acc == FP32
+          || m_dtype_acc == FP64
+          || m_dtype_acc == I32 ){
+        m_split_k = true;
+      }
+      else{
+        m_exec_type.at(l_id) = exec_t::SEQ;
+      }
+    }
+  }
+
+  //every thread holds a partial output tensor, fewer threads split the reduction if the partial tensors exceed the memory limit
+  if( m_split_k ){
+    int64_t l_num_partials_max = m_max_size_partials / l_size_acc;
+    int64_t l_num_threads_sfc  = m_num_threads_sfc_m * m_num_threads_sfc_n;
+    int64_t l_num_threads_shared_max = l_num_partials_max / l_num_threads_sfc;
+
+    if( l_num_threads_shared_max < 2 ){
+      for(int64_t l_id = 0; l_id < l_num_iters; l_id++){
+        if(    m_exec_type.at(l_id) == exec_t::OMP
+            && m_dim_type.at(l_id)  == dim_t::K ){
+          m_exec_type.at(l_id) = exec_t::SEQ;
+        }
+      }
+      m_split_k = false;
+    }
+    else{
+      m_num_threads_shared = std::min( m_num_threads_shared, l_num_threads_shared_max );
+    }
+  }
+
+  //update number of threads if loops are to small
   int64_t l_size_shared = 1;
   int64_t l_size_sfc_m  = 1;
   int64_t l_size_sfc_n  = 1;
@@ -163,34 +402,121 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
   m_num_threads_sfc_n  = std::min(m_num_threads_sfc_n,  l_size_sfc_n);
   m_num_threads_shared = std::min(m_num_threads_shared, l_size_shared);
   m_num_threads = m_num_threads_sfc_m * m_num_threads_sfc_n * m_num_threads_shared;
+  m_num_tasks_shared = l_size_shared;
+
+  //setup dynamic scheduling, shared loops have to be the outermost loops
+  m_task_counters.reset();
+  if(    m_sched_shared == sched_t::DYNAMIC
+      && m_num_threads_shared > 1
+      && m_exec_type.at(0) == exec_t::OMP
+      && !m_split_k ){
+    if( m_chunk_size_shared <= 0 ){
+      m_chunk_size_shared = std::max( m_num_tasks_shared / (4 * m_num_threads_shared), (int64_t)1 );
+    }
+    m_task_counters.reset( new task_counter_t[ m_num_threads_sfc_m * m_num_threads_sfc_n ] );
+  }
 
   //check if first and last touch exists
-  m_has_first_touch = m_ktype_first_touch != kernel_t::UNDEFINED_KTYPE;
-  m_has_last_touch = m_ktype_last_touch != kernel_t::UNDEFINED_KTYPE;
+  m_has_first_touch = m_ktype_first_touch != kernel_t::UNDEFINED_KTYPE || m_load_acc;
+  m_has_last_touch = m_ktype_last_touch != kernel_t::UNDEFINED_KTYPE || m_requant;
+
+  //allocate the accumulators, which share the layout of the output tensor
+  if( m_requant ){
+    if( l_size_acc != m_size_acc ){
+      free_pages( m_acc,
+                  m_size_acc,
+                  m_page_size_acc );
+      m_size_acc = l_size_acc;
+      m_acc = (char *) alloc_pages( m_size_acc,
+                                    page_t::BASE_PAGES,
+                                    &m_page_size_acc );
+      if( m_acc == nullptr ){
+        m_size_acc = 0;
+        return err_t::COMPILATION_FAILED;
+      }
+    }
+  }
 
   //create packing
-  create_packing( m_packing_left_id,
-                  m_size_packing_left,
-                  m_unary_left,
-                  m_strides_left,
-                  m_packing_strides_left);
+  m_unary_left  = create_unary_packing();
+  m_unary_right = create_unary_packing();
+  l_err = create_packing( m_packing_left_id,
+                          m_size_packing_left,
+                          *m_unary_left,
+                          m_strides_left,
+                          m_packing_strides_left,
+                          m_dtype_left,
+                          m_ktype_prologue_left,
+                          m_vnni_left );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
   m_size_packing_left *= ce_n_bytes(m_dtype_left);
   
-  create_packing( m_packing_right_id,
-                  m_size_packing_right,
-                  m_unary_right,
-                  m_strides_right,
-                  m_packing_strides_right);
+  l_err = create_packing( m_packing_right_id,
+                          m_size_packing_right,
+                          *m_unary_right,
+                          m_strides_right,
+                          m_packing_strides_right,
+                          m_dtype_right,
+                          m_ktype_prologue_right,
+                          1 );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
   m_size_packing_right *= ce_n_bytes(m_dtype_right);
 
+  //block-sparse input tensors are accessed in place
+  l_err = check_block_sparsity( m_sparsity_left,
+                                m_strides_left,
+                                m_packing_left_id );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+  l_err = check_block_sparsity( m_sparsity_right,
+                                m_strides_right,
+                                m_packing_right_id );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+  m_block_sparse = m_sparsity_left.mask != nullptr || m_sparsity_right.mask != nullptr;
+
   //multiply strides by size of datatype 
   for(int64_t l_id = 0; l_id < l_num_iters; l_id++){
     m_strides_left[l_id]    *= ce_n_bytes(m_dtype_left );
     m_strides_right[l_id]   *= ce_n_bytes(m_dtype_right);
-    m_strides_out[l_id]     *= ce_n_bytes(m_dtype_out  );
+    m_strides_out[l_id]     *= ce_n_bytes(m_dtype_acc  );
     m_strides_out_aux[l_id] *= ce_n_bytes(m_dtype_out  );
   }
-  
+
+  //the reduction of split-K execution touches the output blocks of the kernels
+  m_sizes_blocks_reduce.clear();
+  m_strides_out_blocks_reduce.clear();
+  m_strides_out_aux_blocks_reduce.clear();
+  m_sizes_block_reduce.clear();
+  m_strides_block_reduce.clear();
+  m_num_blocks_reduce = 1;
+  m_size_partial = 0;
+  if( m_split_k ){
+    for(int64_t l_id = 0; l_id < l_num_iters; l_id++){
+      if( m_strides_out[l_id] == 0 ){
+        continue;
+      }
+      if( m_exec_type[l_id] == exec_t::PRIM ){
+        m_sizes_block_reduce.push_back(   m_dim_sizes[l_id]   );
+        m_strides_block_reduce.push_back( m_strides_out[l_id] );
+      }
+      else{
+        m_sizes_blocks_reduce.push_back(           m_dim_sizes[l_id]       );
+        m_strides_out_blocks_reduce.push_back(     m_strides_out[l_id]     );
+        m_strides_out_aux_blocks_reduce.push_back( m_strides_out_aux[l_id] );
+        m_num_blocks_reduce *= m_dim_sizes[l_id];
+      }
+    }
+    m_size_partial = l_size_acc;
+  }
+  m_partials.assign( m_split_k ? m_num_threads : 0, nullptr );
+
   // init iteration spaces
   m_iter.init( &m_dim_type,
                &m_exec_type,
@@ -213,12 +539,20 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
   m_num_cached_ptrs_left = m_iter.get_caching_size();
   m_num_cached_ptrs_right = m_iter.get_caching_size();
 
-  //reserve memory for packing
+  //reserve memory for packing and the partial output tensor of split-K execution
   int64_t l_reserved_size = m_size_packing_left * m_num_cached_ptrs_left + m_size_packing_right * m_num_cached_ptrs_right;
+  m_offset_partial = 0;
+  if( m_split_k ){
+    m_offset_partial = (l_reserved_size + 127) / 128 * 128;
+    l_reserved_size = m_offset_partial + m_size_partial;
+  }
   if( m_memory == nullptr ){
     m_memory = &m_personal_memory;
     m_memory->reserve_thread_memory( l_reserved_size, m_num_threads );
-    m_memory->alloc_all_memory();
+    l_err = m_memory->alloc_all_memory();
+    if( l_err != err_t::SUCCESS ){
+      return l_err;
+    }
   }
   else{
     m_memory->reserve_thread_memory( l_reserved_size, m_num_threads );
@@ -252,32 +586,63 @@ void einsum_ir::basic::ContractionBackend::contract( void const * i_tensor_left,
                                                      void const * i_tensor_right,
                                                      void const * i_tensor_out_aux,
                                                      void       * io_tensor_out ) {
+  //reset task counters of dynamic scheduling
+  if( m_task_counters ){
+    for( int64_t l_gr = 0; l_gr < m_num_threads_sfc_m * m_num_threads_sfc_n; l_gr++ ){
+      m_task_counters[l_gr].next.store( 0, std::memory_order_relaxed );
+    }
+  }
+
+  //requantized contractions accumulate in the buffer
+  char * l_tensor_acc = (char *) io_tensor_out;
+  if( m_requant ){
+    m_tensor_out_requant = (char *) io_tensor_out;
+    l_tensor_acc = m_acc;
+  }
+
+  //block-sparse inputs derive the blocks from the offsets
+  m_tensor_left_sparse  = (char const *) i_tensor_left;
+  m_tensor_right_sparse = (char const *) i_tensor_right;
+
   execute_threaded( m_num_threads, [&](int64_t l_thread_id) {
     thread_info * l_thread_inf = &m_thread_infos[l_thread_id];
     //get packing memory
     if( m_size_packing_left || m_size_packing_right ){
       l_thread_inf->memory_left  = m_memory->get_thread_memory( l_thread_id );
       l_thread_inf->memory_right = l_thread_inf->memory_left + m_size_packing_left * m_num_cached_ptrs_left;
-      l_thread_inf->cached_ptrs_left.resize(  m_num_cached_ptrs_left,  nullptr );
-      l_thread_inf->cached_ptrs_right.resize( m_num_cached_ptrs_right, nullptr );
+      //packed data of previous contractions is stale, even if the tensors did not move
+      l_thread_inf->cached_ptrs_left.assign(  m_num_cached_ptrs_left,  nullptr );
+      l_thread_inf->cached_ptrs_right.assign( m_num_cached_ptrs_right, nullptr );
     }
 
     //add thread offset
     char * l_tensor_left    = (char *) i_tensor_left    + l_thread_inf->offset_left;
     char * l_tensor_right   = (char *) i_tensor_right   + l_thread_inf->offset_right;
     char * l_tensor_out_aux = (char *) i_tensor_out_aux + l_thread_inf->offset_out_aux;
-    char * l_tensor_out     = (char *) io_tensor_out    + l_thread_inf->offset_out;
+    char * l_tensor_out     = l_tensor_acc              + l_thread_inf->offset_out;
+
+    //split-K execution accumulates in the thread's partial output tensor, touched in the reduction
+    bool l_first_touch = m_has_first_touch;
+    bool l_last_touch  = m_has_last_touch;
+    if( m_split_k ){
+      char * l_partial = m_memory->get_thread_memory( l_thread_id ) + m_offset_partial;
+      m_partials[l_thread_id] = l_partial;
+      std::memset( l_partial, 0, m_size_partial );
+      l_tensor_out  = l_partial + l_thread_inf->offset_out;
+      l_first_touch = false;
+      l_last_touch  = false;
+    }
 
 
     //pack left tensor
     if( m_packing_left_id == 0)  {
-      m_unary_left.eval(l_tensor_left, l_thread_inf->memory_left);
+      m_unary_left->eval(l_tensor_left, l_thread_inf->memory_left);
       l_tensor_left = l_thread_inf->memory_left;
     }
 
     //pack right tensor
     if( m_packing_right_id == 0 )  {
-      m_unary_right.eval(l_tensor_right, l_thread_inf->memory_right);
+      m_unary_right->eval(l_tensor_right, l_thread_inf->memory_right);
       l_tensor_right = l_thread_inf->memory_right;
     }
 
@@ -288,11 +653,188 @@ void einsum_ir::basic::ContractionBackend::contract( void const * i_tensor_left,
                                  l_tensor_right,
                                  l_tensor_out_aux,
                                  l_tensor_out,
-                                 m_has_first_touch,
-                                 m_has_last_touch );
+                                 l_first_touch,
+                                 l_last_touch );
+  });
+
+  if( m_split_k ){
+    execute_threaded( m_num_threads, [&](int64_t l_thread_id) {
+      reduce_partials( l_thread_id,
+                       (char const *) i_tensor_out_aux,
+                       l_tensor_acc );
+    });
+  }
+}
+
+void einsum_ir::basic::ContractionBackend::reduce_partials( int64_t              i_thread_id,
+                                                            char         const * i_tensor_out_aux,
+                                                            char               * io_tensor_out ) {
+  //static range of the thread's blocks
+  int64_t l_blocks_per_thread = (m_num_blocks_reduce + m_num_threads - 1) / m_num_threads;
+  int64_t l_start = std::min( i_thread_id * l_blocks_per_thread, m_num_blocks_reduce );
+  int64_t l_end   = std::min( l_start     + l_blocks_per_thread, m_num_blocks_reduce );
+
+  for( int64_t l_bl = l_start; l_bl < l_end; l_bl++ ){
+    int64_t l_offset_out     = 0;
+    int64_t l_offset_out_aux = 0;
+    int64_t l_id_block = l_bl;
+    for( int64_t l_loop = (int64_t) m_sizes_blocks_reduce.size() - 1; l_loop >= 0; l_loop-- ){
+      int64_t l_it = l_id_block % m_sizes_blocks_reduce[l_loop];
+      l_id_block   = l_id_block / m_sizes_blocks_reduce[l_loop];
+      l_offset_out     += l_it * m_strides_out_blocks_reduce[l_loop];
+      l_offset_out_aux += l_it * m_strides_out_aux_blocks_reduce[l_loop];
+    }
+
+    //pairwise tree over the partial output tensors
+    for( int64_t l_dist = 1; l_dist < m_num_threads; l_dist *= 2 ){
+      for( int64_t l_th = 0; l_th + l_dist < m_num_threads; l_th += 2 * l_dist ){
+        reduce_block( 0,
+                      m_partials[l_th + l_dist] + l_offset_out,
+                      m_partials[l_th]          + l_offset_out );
+      }
+    }
+
+    //fused first touch, final sum and last touch
+    char const * l_ptr_out_aux = i_tensor_out_aux + l_offset_out_aux;
+    char       * l_ptr_out     = io_tensor_out    + l_offset_out;
+    if( m_has_first_touch ){
+      if( m_load_acc ){
+        kernel_load_acc( l_ptr_out );
+      }
+      kernel_first_touch( l_ptr_out_aux,
+                          l_ptr_out );
+    }
+    reduce_block( 0,
+                  m_partials[0] + l_offset_out,
+                  l_ptr_out );
+    if( m_has_last_touch ){
+      kernel_last_touch( l_ptr_out_aux,
+                         l_ptr_out );
+      if( m_requant ){
+        kernel_requant( l_ptr_out );
+      }
+    }
+  }
+}
+
+void einsum_ir::basic::ContractionBackend::reduce_block( std::size_t         i_id_loop,
+                                                         char        const * i_ptr_partial,
+                                                         char              * io_ptr_out ) {
+  //innermost loop, blocks without output loops consist of a single entry
+  if( i_id_loop + 1 >= m_sizes_block_reduce.size() ){
+    int64_t l_size   = m_sizes_block_reduce.empty() ? 1 : m_sizes_block_reduce.back();
+    int64_t l_stride = m_sizes_block_reduce.empty() ? 0 : m_strides_block_reduce.back();
+    if( m_dtype_acc == FP32 ){
+      reduce_strided< float >( l_size, l_stride, i_ptr_partial, io_ptr_out );
+    }
+    else if( m_dtype_acc == FP64 ){
+      reduce_strided< double >( l_size, l_stride, i_ptr_partial, io_ptr_out );
+    }
+    else{
+      reduce_strided< int32_t >( l_size, l_stride, i_ptr_partial, io_ptr_out );
+    }
+    return;
+  }
+
+  int64_t l_stride = m_strides_block_reduce[i_id_loop];
+  for( int64_t l_it = 0; l_it < m_sizes_block_reduce[i_id_loop]; l_it++ ){
+    reduce_block( i_id_loop + 1,
+                  i_ptr_partial ? i_ptr_partial + l_it * l_stride : nullptr,
+                  io_ptr_out + l_it * l_stride );
+  }
+}
+
+void einsum_ir::basic::ContractionBackend::first_touch_out( void * io_tensor_out ) {
+  if( !m_is_compiled ){
+    return;
+  }
+
+  //requantized contractions touch the accumulators
+  char * l_tensor_acc = m_requant ? m_acc : (char *) io_tensor_out;
+
+  //split-K execution writes the output tensor in the reduction
+  if( m_split_k ){
+    execute_threaded( m_num_threads, [&](int64_t l_thread_id) {
+      int64_t l_blocks_per_thread = (m_num_blocks_reduce + m_num_threads - 1) / m_num_threads;
+      int64_t l_start = std::min( l_thread_id * l_blocks_per_thread, m_num_blocks_reduce );
+      int64_t l_end   = std::min( l_start     + l_blocks_per_thread, m_num_blocks_reduce );
+
+      for( int64_t l_bl = l_start; l_bl < l_end; l_bl++ ){
+        int64_t l_offset_out = 0;
+        int64_t l_id_block = l_bl;
+        for( int64_t l_loop = (int64_t) m_sizes_blocks_reduce.size() - 1; l_loop >= 0; l_loop-- ){
+          l_offset_out += (l_id_block % m_sizes_blocks_reduce[l_loop]) * m_strides_out_blocks_reduce[l_loop];
+          l_id_block    =  l_id_block / m_sizes_blocks_reduce[l_loop];
+        }
+        reduce_block( 0,
+                      nullptr,
+                      l_tensor_acc + l_offset_out );
+      }
+    });
+    return;
+  }
+
+  execute_threaded( m_num_threads, [&](int64_t l_thread_id) {
+    thread_info const * l_thread_inf = &m_thread_infos[l_thread_id];
+    first_touch_iter( l_thread_inf,
+                      0,
+                      l_tensor_acc + l_thread_inf->offset_out );
   });
 }
 
+void einsum_ir::basic::ContractionBackend::first_touch_iter( thread_info const * i_thread_info,
+                                                             int64_t             i_id_loop,
+                                                             char              * i_ptr_out ) {
+  int64_t l_num_iters = m_dim_sizes.size();
+
+  // zero a single entry of the output tensor
+  if( i_id_loop == l_num_iters ){
+    for( int64_t l_by = 0; l_by < ce_n_bytes(m_dtype_acc); l_by++ ){
+      i_ptr_out[l_by] = 0;
+    }
+  }
+  // shared loops: static range of the thread
+  else if( m_exec_type[i_id_loop] == exec_t::OMP ){
+    int64_t l_id_next_loop = i_id_loop + m_num_shared_loops;
+    for( int64_t l_it = i_thread_info->id_shared_loop_start; l_it < i_thread_info->id_shared_loop_end; l_it++ ) {
+      char * l_ptr_out = i_ptr_out;
+
+      int64_t l_it_all_loops = l_it;
+      for( int64_t l_loop = l_id_next_loop - 1; l_loop >= i_id_loop; l_loop-- ) {
+        l_ptr_out     += (l_it_all_loops % m_dim_sizes[l_loop]) * m_strides_out[l_loop];
+        l_it_all_loops = l_it_all_loops / m_dim_sizes[l_loop];
+      }
+
+      first_touch_iter( i_thread_info,
+                        l_id_next_loop,
+                        l_ptr_out );
+    }
+  }
+  // sfc loops: thread-local sfc
+  else if( m_exec_type[i_id_loop] == exec_t::SFC ){
+    int64_t l_id_next_loop = i_id_loop + m_num_sfc_loops;
+    for( std::size_t l_it = 0; l_it < i_thread_info->movement_ids.size(); l_it++ ) {
+      first_touch_iter( i_thread_info,
+                        l_id_next_loop,
+                        i_ptr_out );
+
+      sfc_t   l_move      = i_thread_info->movement_ids[l_it];
+      int64_t l_direction = 1 - ( (int64_t)(l_move & 1) << 1 );
+      i_ptr_out += l_direction * m_strides_out[ l_move >> 1 ];
+    }
+  }
+  // sequential and primitive loops, dimensions without output stride (e.g., K) are touched once
+  else {
+    int64_t l_size = (m_strides_out[i_id_loop] == 0) ? 1 : m_dim_sizes[i_id_loop];
+    for( int64_t l_it = 0; l_it < l_size; l_it++ ) {
+      first_touch_iter( i_thread_info,
+                        i_id_loop + 1,
+                        i_ptr_out );
+      i_ptr_out += m_strides_out[ i_id_loop ];
+    }
+  }
+}
+
 void einsum_ir::basic::ContractionBackend::contract_iter( thread_info   * i_thread_info,
                                                           int64_t         i_id_loop,
                                                           char    const * i_ptr_left,
@@ -319,14 +861,14 @@ void einsum_ir::basic::ContractionBackend::contract_iter( thread_info   * i_thre
     const char * l_ptr_left_active = i_ptr_left;
     if( m_packing_left_id == l_id_next_loop )  {
       l_ptr_left_active = i_thread_info->memory_left;
-      m_unary_left.eval(i_ptr_left, (void *)l_ptr_left_active);
+      m_unary_left->eval(i_ptr_left, (void *)l_ptr_left_active);
     }
 
     //pack right tensor
     const char * l_ptr_right_active = i_ptr_right;
     if( m_packing_right_id == l_id_next_loop )  {
       l_ptr_right_active = i_thread_info->memory_right;
-      m_unary_right.eval(i_ptr_right, (void *)l_ptr_right_active);
+      m_unary_right->eval(i_ptr_right, (void *)l_ptr_right_active);
     }
   
     //recursive function call
@@ -356,58 +898,75 @@ void einsum_ir::basic::ContractionBackend::contract_iter_shared( thread_info   *
                                                                  bool            i_first_access,
                                                                  bool            i_last_access ) {
 
-  // issue loop iterations
   int64_t l_id_next_loop = i_id_loop + m_num_shared_loops;
+
+  //static scheduling executes a fixed range, dynamic scheduling claims chunks of the threads' sfc group
+  std::atomic< int64_t > * l_counter = nullptr;
   int64_t l_start = i_thread_info->id_shared_loop_start;
   int64_t l_end   = i_thread_info->id_shared_loop_end;
-  for( int64_t l_it = l_start; l_it < l_end; l_it++ ) {
-
-    char const * l_ptr_left    = i_ptr_left;
-    char const * l_ptr_right   = i_ptr_right;
-    char const * l_ptr_out_aux = i_ptr_out_aux;
-    char       * l_ptr_out     = i_ptr_out;
-
-    int64_t l_it_all_loops   = l_it;
-    int64_t l_it_single_loop = 0;
-    for( int64_t l_loop = i_id_loop + m_num_shared_loops - 1; l_loop >= i_id_loop; l_loop-- ) {
-      l_it_single_loop = l_it_all_loops % m_dim_sizes[l_loop];
-      l_it_all_loops   = l_it_all_loops / m_dim_sizes[l_loop];
+  if( m_task_counters ){
+    l_counter = &m_task_counters[i_thread_info->id_sfc_group].next;
+    l_start = l_counter->fetch_add( m_chunk_size_shared, std::memory_order_relaxed );
+    l_end   = std::min( l_start + m_chunk_size_shared, m_num_tasks_shared );
+  }
 
-      //update pointer
-      l_ptr_left    = l_ptr_left    + l_it_single_loop * m_strides_left[    l_loop ];
-      l_ptr_right   = l_ptr_right   + l_it_single_loop * m_strides_right[   l_loop ];
-      l_ptr_out_aux = l_ptr_out_aux + l_it_single_loop * m_strides_out_aux[ l_loop ];
-      l_ptr_out     = l_ptr_out     + l_it_single_loop * m_strides_out[     l_loop ];
-    }
+  while( l_start < l_end ) {
+    // issue loop iterations
+    for( int64_t l_it = l_start; l_it < l_end; l_it++ ) {
+
+      char const * l_ptr_left    = i_ptr_left;
+      char const * l_ptr_right   = i_ptr_right;
+      char const * l_ptr_out_aux = i_ptr_out_aux;
+      char       * l_ptr_out     = i_ptr_out;
+
+      int64_t l_it_all_loops   = l_it;
+      int64_t l_it_single_loop = 0;
+      for( int64_t l_loop = i_id_loop + m_num_shared_loops - 1; l_loop >= i_id_loop; l_loop-- ) {
+        l_it_single_loop = l_it_all_loops % m_dim_sizes[l_loop];
+        l_it_all_loops   = l_it_all_loops / m_dim_sizes[l_loop];
+
+        //update pointer
+        l_ptr_left    = l_ptr_left    + l_it_single_loop * m_strides_left[    l_loop ];
+        l_ptr_right   = l_ptr_right   + l_it_single_loop * m_strides_right[   l_loop ];
+        l_ptr_out_aux = l_ptr_out_aux + l_it_single_loop * m_strides_out_aux[ l_loop ];
+        l_ptr_out     = l_ptr_out     + l_it_single_loop * m_strides_out[     l_loop ];
+      }
 
-    //pack left tensor
-    if( m_packing_left_id == l_id_next_loop )  {
-      if( l_ptr_left != i_thread_info->cached_ptrs_left[0] ){
-        m_unary_left.eval(l_ptr_left, i_thread_info->memory_left);
-        i_thread_info->cached_ptrs_left[0] = l_ptr_left;
+      //pack left tensor
+      if( m_packing_left_id == l_id_next_loop )  {
+        if( l_ptr_left != i_thread_info->cached_ptrs_left[0] ){
+          m_unary_left->eval(l_ptr_left, i_thread_info->memory_left);
+          i_thread_info->cached_ptrs_left[0] = l_ptr_left;
+        }
+        l_ptr_left = i_thread_info->memory_left;
       }
-      l_ptr_left = i_thread_info->memory_left;
-    }
 
-    //pack right tensor
-    if( m_packing_right_id == l_id_next_loop )  {
-      if( l_ptr_right != i_thread_info->cached_ptrs_right[0]){
-        m_unary_right.eval(l_ptr_right, i_thread_info->memory_right);
-        i_thread_info->cached_ptrs_right[0] = l_ptr_right;
+      //pack right tensor
+      if( m_packing_right_id == l_id_next_loop )  {
+        if( l_ptr_right != i_thread_info->cached_ptrs_right[0]){
+          m_unary_right->eval(l_ptr_right, i_thread_info->memory_right);
+          i_thread_info->cached_ptrs_right[0] = l_ptr_right;
+        }
+        l_ptr_right = i_thread_info->memory_right;
       }
-      l_ptr_right = i_thread_info->memory_right;
-    }
 
 
-    //recursive function call
-    (this->*(m_loop_functs[l_id_next_loop]))( i_thread_info,
-                                              l_id_next_loop,
-                                              l_ptr_left,
-                                              l_ptr_right,
-                                              l_ptr_out_aux,
-                                              l_ptr_out,
-                                              i_first_access,
-                                              i_last_access );
+      //recursive function call
+      (this->*(m_loop_functs[l_id_next_loop]))( i_thread_info,
+                                                l_id_next_loop,
+                                                l_ptr_left,
+                                                l_ptr_right,
+                                                l_ptr_out_aux,
+                                                l_ptr_out,
+                                                i_first_access,
+                                                i_last_access );
+    }
+
+    if( l_counter == nullptr ){
+      break;
+    }
+    l_start = l_counter->fetch_add( m_chunk_size_shared, std::memory_order_relaxed );
+    l_end   = std::min( l_start + m_chunk_size_shared, m_num_tasks_shared );
   }
 }
 
@@ -453,7 +1012,7 @@ void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info   * i_
       int64_t l_id = l_id_m % m_num_cached_ptrs_left;
       l_ptr_left_active = i_thread_info->memory_left + l_id * m_size_packing_left;
       if( i_ptr_left != i_thread_info->cached_ptrs_left[l_id] ){
-        m_unary_left.eval(i_ptr_left, (void *)l_ptr_left_active);
+        m_unary_left->eval(i_ptr_left, (void *)l_ptr_left_active);
         i_thread_info->cached_ptrs_left[l_id] = i_ptr_left;
       }
     }
@@ -464,7 +1023,7 @@ void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info   * i_
       int64_t l_id = l_id_n % m_num_cached_ptrs_right;
       l_ptr_right_active = i_thread_info->memory_right + l_id * m_size_packing_right;
       if( i_ptr_right != i_thread_info->cached_ptrs_right[l_id]){
-        m_unary_right.eval(i_ptr_right, (void *)l_ptr_right_active);
+        m_unary_right->eval(i_ptr_right, (void *)l_ptr_right_active);
         i_thread_info->cached_ptrs_right[l_id] = i_ptr_right;
       }
     }
@@ -501,19 +1060,141 @@ void einsum_ir::basic::ContractionBackend::contract_iter_kernel( thread_info   *
                                                                  bool            i_first_access,
                                                                  bool            i_last_access ) {
   if( i_first_access ) {
+    if( m_load_acc ) {
+      kernel_load_acc( i_ptr_out );
+    }
     kernel_first_touch( i_ptr_out_aux,
                         i_ptr_out );
   }
-  kernel_main( i_ptr_left,
-               i_ptr_right,
-               i_ptr_out );
+  //blocks of zeros do not contribute
+  if(    !m_block_sparse
+      || !(    zero_block( m_sparsity_left,  m_tensor_left_sparse,  i_ptr_left,  m_dtype_left  )
+            || zero_block( m_sparsity_right, m_tensor_right_sparse, i_ptr_right, m_dtype_right ) ) ) {
+    kernel_main( i_ptr_left,
+                 i_ptr_right,
+                 i_ptr_out );
+  }
   
   if( i_last_access ) {
     kernel_last_touch( i_ptr_out_aux,
                        i_ptr_out );
+    if( m_requant ) {
+      kernel_requant( i_ptr_out );
+    }
   }                                                             
 }
 
+void einsum_ir::basic::ContractionBackend::kernel_requant( char const * i_ptr_acc ) {
+  //the accumulators and the output share the layout
+  int64_t l_offset = (i_ptr_acc - m_acc) / ce_n_bytes(m_dtype_acc);
+  int64_t l_ldc = m_ldc;
+
+  //FP32 accumulators of reduced precision outputs
+  if( m_dtype_acc == FP32 ) {
+    float    const * l_acc = (float const *) i_ptr_acc;
+    uint16_t       * l_out = (uint16_t *) m_tensor_out_requant + l_offset;
+    for( int64_t l_n = 0; l_n < (int64_t) m_n; l_n++ ) {
+      for( int64_t l_m = 0; l_m < (int64_t) m_m; l_m++ ) {
+        int64_t l_id = l_n * l_ldc + l_m;
+        l_out[l_id] = (m_dtype_out == BF16) ? fp32_to_bf16( l_acc[l_id] )
+                                            : fp32_to_fp16( l_acc[l_id] );
+      }
+    }
+    return;
+  }
+
+  int32_t const * l_acc = (int32_t const *) i_ptr_acc;
+
+  for( int64_t l_n = 0; l_n < (int64_t) m_n; l_n++ ) {
+    for( int64_t l_m = 0; l_m < (int64_t) m_m; l_m++ ) {
+      int64_t l_id = l_n * l_ldc + l_m;
+
+      float l_scale = m_quant.scales[0];
+      if( m_quant.num_scales > 1 ) {
+        l_scale = m_quant.scales[ ( (l_offset + l_id) / m_quant.stride_channel ) % m_quant.num_scales ];
+      }
+      float l_val = l_scale * (float) l_acc[l_id];
+
+      if( m_dtype_out == I8 ) {
+        float l_quant = std::nearbyint( l_val ) + (float) m_quant.zero_point;
+        l_quant = std::min( std::max( l_quant, -128.0f ), 127.0f );
+        ( (int8_t *) m_tensor_out_requant )[l_offset + l_id] = (int8_t) l_quant;
+      }
+      else {
+        ( (float *) m_tensor_out_requant )[l_offset + l_id] = l_val;
+      }
+    }
+  }
+}
+
+void einsum_ir::basic::ContractionBackend::kernel_load_acc( char * o_ptr_acc ) {
+  float          * l_acc = (float *) o_ptr_acc;
+  int64_t l_offset = (o_ptr_acc - m_acc) / ce_n_bytes(m_dtype_acc);
+  uint16_t const * l_out = (uint16_t const *) m_tensor_out_requant + l_offset;
+  int64_t l_ldc = m_ldc;
+
+  for( int64_t l_n = 0; l_n < (int64_t) m_n; l_n++ ) {
+    for( int64_t l_m = 0; l_m < (int64_t) m_m; l_m++ ) {
+      int64_t l_id = l_n * l_ldc + l_m;
+      l_acc[l_id] = (m_dtype_out == BF16) ? bf16_to_fp32( l_out[l_id] )
+                                          : fp16_to_fp32( l_out[l_id] );
+    }
+  }
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::check_block_sparsity( block_sparsity         const & i_sparsity,
+                                                                                    std::vector< int64_t > const & i_strides,
+                                                                                    int64_t                        i_packing_id ) const {
+  if( i_sparsity.mask == nullptr ){
+    return err_t::SUCCESS;
+  }
+
+  int64_t l_num_dims_block = i_sparsity.strides.size();
+  if(    (int64_t) i_sparsity.sizes.size()        != l_num_dims_block
+      || (int64_t) i_sparsity.strides_mask.size() != l_num_dims_block
+      || i_packing_id != -1 ){
+    return err_t::COMPILATION_FAILED;
+  }
+
+  //a primitive loop crosses blocks if it covers the stride of a block dimension
+  for( std::size_t l_id = 0; l_id < m_dim_sizes.size(); l_id++ ){
+    int64_t l_stride = std::abs( i_strides[l_id] );
+    if(    m_exec_type[l_id] != exec_t::PRIM
+        || m_dim_sizes[l_id] < 2
+        || l_stride == 0 ){
+      continue;
+    }
+
+    for( int64_t l_bl = 0; l_bl < l_num_dims_block; l_bl++ ){
+      if(    i_sparsity.sizes[l_bl] > 1
+          && i_sparsity.strides[l_bl] >= l_stride
+          && i_sparsity.strides[l_bl] <  l_stride * m_dim_sizes[l_id] ){
+        return err_t::COMPILATION_FAILED;
+      }
+    }
+  }
+
+  return err_t::SUCCESS;
+}
+
+bool einsum_ir::basic::ContractionBackend::zero_block( block_sparsity const & i_sparsity,
+                                                       char           const * i_tensor,
+                                                       char           const * i_ptr,
+                                                       data_t                 i_dtype ) {
+  if( i_sparsity.mask == nullptr ){
+    return false;
+  }
+
+  //the dense layout of the tensor gives the indices of the block dimensions
+  int64_t l_offset = (i_ptr - i_tensor) / ce_n_bytes(i_dtype);
+  int64_t l_id_mask = 0;
+  for( std::size_t l_bl = 0; l_bl < i_sparsity.strides.size(); l_bl++ ){
+    int64_t l_idx = ( l_offset / i_sparsity.strides[l_bl] ) % i_sparsity.sizes[l_bl];
+    l_id_mask += l_idx * i_sparsity.strides_mask[l_bl];
+  }
+
+  return i_sparsity.mask[l_id_mask] == 0;
+}
 
 einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::set_kernel_shape( ){
   //check that there are enough primitive dimensions
@@ -677,11 +1358,22 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::set_kernel_shape(
   return err_t::SUCCESS;
 }
 
+std::unique_ptr< einsum_ir::basic::UnaryBackend > einsum_ir::basic::ContractionBackend::create_unary_packing(){
+#ifdef PP_EINSUM_IR_HAS_LIBXSMM
+  return std::make_unique< UnaryBackendTpp >();
+#else
+  return std::make_unique< UnaryBackendSimd >();
+#endif
+}
+
 einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::create_packing( int64_t              & o_packing_id,
                                                                               int64_t              & o_size_packing,
-                                                                              UnaryBackendTpp      & o_unary,
+                                                                              UnaryBackend         & o_unary,
                                                                               std::vector<int64_t> & i_strides,
-                                                                              std::vector<int64_t> & i_packing_strides ){
+                                                                              std::vector<int64_t> & i_packing_strides,
+                                                                              data_t                 i_dtype,
+                                                                              kernel_t               i_ktype_prologue,
+                                                                              int64_t                i_vnni ){
   //determine size of and iteration id of packing
   o_packing_id = -1;
   for( std::size_t l_id = 0; l_id < i_packing_strides.size(); l_id++ ) {
@@ -701,11 +1393,19 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::create_packing( in
   if( o_packing_id >= 0 ){
     o_size_packing  = (o_size_packing  + 1); 
   }
+  // prologues are applied while packing
+  else if( i_ktype_prologue != kernel_t::UNDEFINED_KTYPE ){
+    return err_t::COMPILATION_FAILED;
+  }
 
   //create packing kernel
   if( o_packing_id >= 0 ){
     //setup data structure for packing
+    //the VNNI transformation uses the main kernel's k and m dimensions as primitive dimensions
+    std::size_t l_id_k = m_dim_sizes.size() - 1;
+    std::size_t l_id_m = m_dim_sizes.size() - 3;
     std::vector< iter_property > l_packing_iters;
+    std::vector< iter_property > l_packing_iters_vnni;
     l_packing_iters.reserve( i_packing_strides.size() );
     for( std::size_t l_id = 0; l_id < i_packing_strides.size(); l_id++ ) {
       if(i_packing_strides[l_id] != 0){
@@ -714,20 +1414,43 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::create_packing( in
         iter_prop.size          = m_dim_sizes[l_id];
         iter_prop.stride_left   = i_packing_strides[l_id];
         iter_prop.stride_out    = i_strides[l_id];
-        l_packing_iters.push_back( iter_prop );
+        if( i_vnni > 1 && ( l_id == l_id_k || l_id == l_id_m ) ){
+          iter_prop.exec_type = exec_t::PRIM;
+          if( l_id == l_id_m ){
+            iter_prop.stride_left = 1;
+            iter_prop.stride_out  = 1;
+          }
+          l_packing_iters_vnni.push_back( iter_prop );
+        }
+        else{
+          l_packing_iters.push_back( iter_prop );
+        }
       }
     }
-    //optimize packing iters
-    UnaryOptimizer l_unary_opt;
-    l_unary_opt.init( &l_packing_iters, 1 , false);
+
     err_t l_err = err_t::UNDEFINED_ERROR;
-    l_err = l_unary_opt.optimize();
-    if( l_err != err_t::SUCCESS ) {
-      return l_err;
+    if( i_vnni > 1 ){
+      if( l_packing_iters_vnni.size() != 2 ){
+        return err_t::COMPILATION_FAILED;
+      }
+      l_packing_iters.push_back( l_packing_iters_vnni[1] );
+      l_packing_iters.push_back( l_packing_iters_vnni[0] );
+    }
+    else{
+      //optimize packing iters
+      UnaryOptimizer l_unary_opt;
+      l_unary_opt.init( &l_packing_iters, 1 , false);
+      l_err = l_unary_opt.optimize();
+      if( l_err != err_t::SUCCESS ) {
+        return l_err;
+      }
     }
 
     //init and compile kernel
-    o_unary.init(l_packing_iters, m_dtype_left, m_dtype_comp, m_dtype_out, kernel_t::COPY, 1);
+    o_unary.init(l_packing_iters, i_dtype, i_dtype, i_dtype, kernel_t::COPY, 1);
+    o_unary.set_eltwise( i_ktype_prologue,
+                         m_prologue_params );
+    o_unary.set_vnni( i_vnni );
     l_err = o_unary.compile();
     if( l_err != err_t::SUCCESS ) {
       return l_err;
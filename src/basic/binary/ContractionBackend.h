@@ -1,12 +1,14 @@
 #ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_BACKEND
 #define EINSUM_IR_BASIC_BINARY_CONTRACTION_BACKEND
 
+#include <atomic>
+#include <memory>
 #include <vector>
 
 #include "../constants.h"
 #include "IterationSpace.h"
 #include "ContractionMemoryManager.h"
-#include "../unary/UnaryBackendTpp.h"
+#include "../unary/UnaryBackend.h"
 
 
 namespace einsum_ir {
@@ -67,20 +69,86 @@ class einsum_ir::basic::ContractionBackend {
     int64_t m_size_packing_right = 0;
 
     //! unary packing backend for left input tensor
-    UnaryBackendTpp m_unary_left;
+    std::unique_ptr< UnaryBackend > m_unary_left;
     //! unary packing backend for right input tensor
-    UnaryBackendTpp m_unary_right;
+    std::unique_ptr< UnaryBackend > m_unary_right;
 
     //! id of the left packing loop
     int64_t m_packing_left_id  = -1;
     //! id of the right packing loop;
     int64_t m_packing_right_id = -1;
 
+    //! elementwise kernel applied to the left input tensor while packing
+    kernel_t m_ktype_prologue_left = kernel_t::UNDEFINED_KTYPE;
+    //! elementwise kernel applied to the right input tensor while packing
+    kernel_t m_ktype_prologue_right = kernel_t::UNDEFINED_KTYPE;
+    //! parameters of the packing prologues
+    last_touch_params m_prologue_params;
+
     //! number of cached pointers for left input tensor
     int64_t m_num_cached_ptrs_left  = 1;
     //! number of cached pointers for right input tensor
     int64_t m_num_cached_ptrs_right = 1;
 
+    //! counter of the next shared task, placed on its own cache line
+    struct alignas(128) task_counter_t {
+      std::atomic< int64_t > next{ 0 };
+    };
+
+    //! scheduling of the shared tasks
+    sched_t m_sched_shared = sched_t::STATIC;
+    //! number of shared tasks claimed at once by dynamic scheduling, 0 for automatic selection
+    int64_t m_chunk_size_shared = 0;
+    //! total number of shared tasks
+    int64_t m_num_tasks_shared = 1;
+    //! task counters of the threads groups which share an sfc partition
+    std::unique_ptr< task_counter_t[] > m_task_counters;
+
+    //! requantization parameters of the INT32 accumulators
+    quant_params m_quant;
+    //! true if the accumulators are kept in a separate buffer and written to the output in the last touch
+    bool m_requant = false;
+    //! true if the first touch loads the output tensor to the FP32 accumulators
+    bool m_load_acc = false;
+    //! buffer holding the accumulators of the whole output tensor
+    char * m_acc = nullptr;
+    //! size of the accumulator buffer in bytes
+    int64_t m_size_acc = 0;
+    //! page size of the accumulator buffer
+    int64_t m_page_size_acc = 0;
+    //! output tensor of the running contraction, only used for requantization
+    char * m_tensor_out_requant = nullptr;
+
+    //! true if the main kernel is skipped for blocks of zeros
+    bool m_block_sparse = false;
+
+    //! true if shared K loops split the reduction among the threads
+    bool m_split_k = false;
+    //! offset of a thread's partial output tensor in its thread memory in bytes
+    int64_t m_offset_partial = 0;
+    //! size of a partial output tensor in bytes
+    int64_t m_size_partial = 0;
+    //! maximum size of all partial output tensors in bytes
+    int64_t m_max_size_partials = int64_t(1) << 30;
+    //! partial output tensors of the threads, set by the threads in every contraction since the memory manager may allocate after compilation
+    std::vector< char * > m_partials;
+    //! number of output blocks touched by the reduction of the partial output tensors
+    int64_t m_num_blocks_reduce = 0;
+    //! sizes of the loops which enumerate the output blocks
+    std::vector< int64_t > m_sizes_blocks_reduce;
+    //! output strides in bytes of the loops which enumerate the output blocks
+    std::vector< int64_t > m_strides_out_blocks_reduce;
+    //! auxiliary output strides in bytes of the loops which enumerate the output blocks
+    std::vector< int64_t > m_strides_out_aux_blocks_reduce;
+    //! sizes of the primitive loops spanning an output block
+    std::vector< int64_t > m_sizes_block_reduce;
+    //! output strides in bytes of the primitive loops spanning an output block
+    std::vector< int64_t > m_strides_block_reduce;
+    //! left input tensor of the running contraction, only used for block-sparse inputs
+    char const * m_tensor_left_sparse = nullptr;
+    //! right input tensor of the running contraction, only used for block-sparse inputs
+    char const * m_tensor_right_sparse = nullptr;
+
   protected:
     //! datatype of the left input
     data_t m_dtype_left = UNDEFINED_DTYPE;
@@ -94,6 +162,20 @@ class einsum_ir::basic::ContractionBackend {
     //! datatype used during the computations
     data_t m_dtype_comp = UNDEFINED_DTYPE;
 
+    //! datatype of the data touched by the kernels, i.e., the accumulators if kept in a separate buffer and the output otherwise
+    data_t m_dtype_acc = UNDEFINED_DTYPE;
+
+    //! block sparsity of the left input tensor
+    block_sparsity m_sparsity_left;
+    //! block sparsity of the right input tensor
+    block_sparsity m_sparsity_right;
+
+    //! VNNI factor of the packed left input tensor, i.e., number of interleaved k values, 1 for the flat format
+    int64_t m_vnni_left = 1;
+
+    //! parameters of the last-touch kernel
+    last_touch_params m_last_touch_params;
+
 
     //! vector with dimension types of all loops
     std::vector< dim_t >   m_dim_type;
@@ -188,6 +270,11 @@ class einsum_ir::basic::ContractionBackend {
                                               bool) > m_loop_functs;
     
   public:
+    /**
+     * Destructor.
+     **/
+    virtual ~ContractionBackend();
+
     /**
      * Initializes the class.
      *
@@ -263,6 +350,66 @@ class einsum_ir::basic::ContractionBackend {
                int64_t                              i_num_threads_sfc_n,
                ContractionMemoryManager           * i_contraction_mem );
 
+    /**
+     * Sets the scheduling of the shared tasks, has to be called before compilation.
+     * Dynamic scheduling is only applied if the shared loops are the outermost loops and do not split K.
+     * Every chunk of shared tasks is executed in the SFC order of the claiming thread.
+     *
+     * @param i_sched_shared scheduling of the shared tasks.
+     * @param i_chunk_size_shared number of shared tasks claimed at once, 0 for automatic selection.
+     **/
+    void set_scheduling( sched_t i_sched_shared,
+                         int64_t i_chunk_size_shared = 0 );
+
+    /**
+     * Sets the maximum size of the partial output tensors of split-K execution, has to be called before compilation.
+     * Every thread sharing the reduction holds a partial output tensor.
+     * If the partial tensors of all threads exceed the limit, fewer threads split the reduction or the K loops are executed sequentially.
+     *
+     * @param i_max_size_partials maximum size of all partial output tensors in bytes.
+     **/
+    void set_max_size_partials( int64_t i_max_size_partials );
+
+    /**
+     * Sets the requantization of the INT32 accumulators, has to be called before compilation.
+     * Applies if the computations are performed in INT32 and the output is INT8 or FP32.
+     * The accumulators are kept in a separate buffer and written to the output in the last touch.
+     *
+     * @param i_quant requantization parameters.
+     **/
+    void set_quant( quant_params const & i_quant );
+
+    /**
+     * Sets the parameters of the SCALE_SHIFT and CLAMP last-touch kernels, has to be called before compilation.
+     *
+     * @param i_params parameters of the last-touch kernel.
+     **/
+    void set_last_touch_params( last_touch_params const & i_params );
+
+    /**
+     * Sets elementwise kernels which are applied to the input tensors while packing them.
+     * Supported are RELU, GELU, SIGMOID, TANH, SCALE_SHIFT and CLAMP; the input tensors have to be packed.
+     * Has to be called before compilation.
+     *
+     * @param i_ktype_left kernel applied to the left input tensor, UNDEFINED_KTYPE if none.
+     * @param i_ktype_right kernel applied to the right input tensor, UNDEFINED_KTYPE if none.
+     * @param i_params parameters of SCALE_SHIFT and CLAMP.
+     **/
+    void set_packing_prologue( kernel_t                  i_ktype_left,
+                               kernel_t                  i_ktype_right,
+                               last_touch_params const & i_params );
+
+    /**
+     * Sets the block sparsity of the input tensors, has to be called before compilation.
+     * The main kernel is skipped for all blocks which are marked as zero in the masks.
+     * Block-sparse input tensors are not packed and the primitive loops may not iterate over block dimensions.
+     *
+     * @param i_sparsity_left block sparsity of the left input tensor, no mask if dense.
+     * @param i_sparsity_right block sparsity of the right input tensor, no mask if dense.
+     **/
+    void set_block_sparsity( block_sparsity const & i_sparsity_left,
+                             block_sparsity const & i_sparsity_right );
+
     /**
      * Compiles the contraction loop interface.
      *
@@ -282,6 +429,51 @@ class einsum_ir::basic::ContractionBackend {
                    void const * i_tensor_right,
                    void const * i_tensor_out_aux,
                    void       * io_tensor_out );
+
+    /**
+     * Zeroes the output tensor with the same thread-to-data mapping as the contraction.
+     * If called on freshly allocated memory, the pages of the output tensor are placed
+     * close to the threads writing them (first-touch policy).
+     * Shared loops follow the static distribution of the tasks, split-K execution the distribution of the reduction.
+     *
+     * @param io_tensor_out output tensor.
+     **/
+    void first_touch_out( void * io_tensor_out );
+
+    /**
+     * Reduces the partial output tensors of split-K execution and applies the first and last touch.
+     * The output blocks are distributed statically among the threads.
+     * Every block sums the partial tensors in a pairwise tree with a fixed order, i.e., results are deterministic.
+     *
+     * @param i_thread_id id of the executing thread.
+     * @param i_tensor_out_aux auxiliary output tensor.
+     * @param io_tensor_out output tensor or accumulators if requantized.
+     **/
+    void reduce_partials( int64_t              i_thread_id,
+                          char         const * i_tensor_out_aux,
+                          char               * io_tensor_out );
+
+    /**
+     * Recursive loop implementation which adds a block of a partial output tensor to a block of the output tensor.
+     *
+     * @param i_id_loop id of the block's loop which is executed.
+     * @param i_ptr_partial pointer to the partial output tensor's data, nullptr zeroes the output block.
+     * @param io_ptr_out pointer to the output tensor's data.
+     **/
+    void reduce_block( std::size_t         i_id_loop,
+                       char        const * i_ptr_partial,
+                       char              * io_ptr_out );
+
+    /**
+     * Recursive loop implementation of the output tensor's first touch.
+     *
+     * @param i_thread_info information for the executing thread.
+     * @param i_id_loop dimension id of the loop which is executed.
+     * @param i_ptr_out pointer to the output tensor's data.
+     **/
+    void first_touch_iter( thread_info const * i_thread_info,
+                           int64_t             i_id_loop,
+                           char              * i_ptr_out );
     
     /**
      * General purpose loop implementation featuring first and last touch operations.
@@ -369,6 +561,47 @@ class einsum_ir::basic::ContractionBackend {
                                bool            i_first_access,
                                bool            i_last_access );
 
+    /**
+     * Writes a block of accumulators to the output tensor.
+     * INT32 accumulators are requantized, FP32 accumulators are rounded to the output's datatype.
+     *
+     * @param i_ptr_acc pointer to the accumulators of the block.
+     **/
+    void kernel_requant( char const * i_ptr_acc );
+
+    /**
+     * Loads a block of the reduced precision output tensor to the FP32 accumulators.
+     *
+     * @param o_ptr_acc pointer to the accumulators of the block.
+     **/
+    void kernel_load_acc( char * o_ptr_acc );
+
+    /**
+     * Checks that the kernels of a block-sparse input tensor do not cross blocks.
+     *
+     * @param i_sparsity block sparsity of the input tensor.
+     * @param i_strides strides of the input tensor.
+     * @param i_packing_id id of the input tensor's packing loop.
+     * @return SUCCESS if the block sparsity is supported, otherwise an appropiate error code.
+     **/
+    err_t check_block_sparsity( block_sparsity         const & i_sparsity,
+                                std::vector< int64_t > const & i_strides,
+                                int64_t                        i_packing_id ) const;
+
+    /**
+     * Checks if the block of an input tensor which is accessed by the kernel is zero.
+     *
+     * @param i_sparsity block sparsity of the input tensor.
+     * @param i_tensor input tensor of the running contraction.
+     * @param i_ptr pointer to the data which is accessed by the kernel.
+     * @param i_dtype datatype of the input tensor.
+     * @return true if the block is zero.
+     **/
+    static bool zero_block( block_sparsity const & i_sparsity,
+                            char           const * i_tensor,
+                            char           const * i_ptr,
+                            data_t                 i_dtype );
+
     /**
      * calculates the shape of the kernel i.e. m, n, k, lda, ldb, ldc, ...
      *
@@ -384,14 +617,28 @@ class einsum_ir::basic::ContractionBackend {
      * @param o_unary compiled unary backend used for packing.
      * @param i_strides strides of the input tensor.
      * @param i_packing_strides strides of the packing tensor.
+     * @param i_dtype data type of the tensor.
+     * @param i_ktype_prologue elementwise kernel applied while packing, UNDEFINED_KTYPE if none.
+     * @param i_vnni VNNI factor of the packed tensor, i.e., number of interleaved k values of the main kernel, 1 for the flat format.
      *
      * @return SUCCESS if packing was created successfully, otherwise an appropiate error code.
      **/
     err_t create_packing( int64_t              & o_packing_id,
                           int64_t              & o_size_packing,
-                          UnaryBackendTpp      & o_unary,
+                          UnaryBackend         & o_unary,
                           std::vector<int64_t> & i_strides,
-                          std::vector<int64_t> & i_packing_strides );
+                          std::vector<int64_t> & i_packing_strides,
+                          data_t                 i_dtype,
+                          kernel_t               i_ktype_prologue,
+                          int64_t                i_vnni );
+
+    /**
+     * Creates the unary backend which packs an input tensor.
+     * By default, TPPs are used if libxsmm is available and the in-tree SIMD kernels otherwise.
+     *
+     * @return unary packing backend.
+     **/
+    virtual std::unique_ptr< UnaryBackend > create_unary_packing();
 
     /**
      * Kernel applied to the output tensor before the main primitive touches the memory.
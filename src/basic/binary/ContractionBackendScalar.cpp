@@ -47,9 +47,10 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
     return err_t::COMPILATION_FAILED;
   }
 
-  // determine if all dtypes are FP32 or FP64
+  // determine if all dtypes are FP32 or FP64, or if INT8 inputs are accumulated in INT32
   bool l_dtype_all_fp32 = false;
   bool l_dtype_all_fp64 = false;
+  bool l_dtype_int8     = false;
 
   if(    m_dtype_left  == FP32
       && m_dtype_right == FP32
@@ -63,6 +64,12 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
            && m_dtype_out   == FP64 ) {
     l_dtype_all_fp64 = true;
   }
+  else if(    m_dtype_left  == I8
+           && m_dtype_right == I8
+           && m_dtype_comp  == I32
+           && m_dtype_acc   == I32 ) {
+    l_dtype_int8 = true;
+  }
   else {
     return err_t::COMPILATION_FAILED;
   }
@@ -75,6 +82,9 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
     else if( l_dtype_all_fp64 ) {
       m_kernel_first_touch = &kernel_zero< double >;
     }
+    else if( l_dtype_int8 ) {
+      m_kernel_first_touch = &kernel_zero< int32_t >;
+    }
   }
   else if( m_ktype_first_touch == kernel_t::COPY ) {
     if( l_dtype_all_fp32 ) {
@@ -83,6 +93,9 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
     else if( l_dtype_all_fp64 ) {
       m_kernel_first_touch = &kernel_copy< double >;
     }
+    else if( l_dtype_int8 ) {
+      m_kernel_first_touch = &kernel_copy< int32_t >;
+    }
   }
   else if( m_ktype_first_touch != kernel_t::UNDEFINED_KTYPE ) {
     return err_t::COMPILATION_FAILED;
@@ -96,6 +109,9 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
     else if( l_dtype_all_fp64 ) {
       m_kernel_main = &kernel_madd< double, double, double >;
     }
+    else if( l_dtype_int8 ) {
+      m_kernel_main = &kernel_madd< int8_t, int8_t, int32_t >;
+    }
   }
   else {
     return err_t::COMPILATION_FAILED;
@@ -109,6 +125,9 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
     else if( l_dtype_all_fp64 ) {
       m_kernel_last_touch = &kernel_relu< double >;
     }
+    else if( l_dtype_int8 ) {
+      m_kernel_last_touch = &kernel_relu< int32_t >;
+    }
   }
   else if( m_ktype_last_touch != UNDEFINED_KTYPE ) {
     return err_t::COMPILATION_FAILED;
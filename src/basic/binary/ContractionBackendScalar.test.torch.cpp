@@ -626,3 +626,251 @@ TEST_CASE( "Binary contraction involving C, M, N and K dimensions using FP64, ze
 
   REQUIRE( at::allclose( l_out, l_out_ref )  );
 }
+
+TEST_CASE( "Batched FP32 matmul with dynamically scheduled shared tasks using the Scalar contraction backend implementation.", "[contraction_backend_scalar]" ) {
+  // Test Case:
+  //
+  //    ____cnm___
+  //   /          \
+  // ckm          cnk
+  //
+  // char   id   size
+  //    c    0      7
+  //    m    1      2
+  //    n    2      3
+  //    k    3      4
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::C,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::OMP,
+                                             exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                 c, m, n, k mp,np,kp
+  std::vector< int64_t > l_loop_sizes            = { 7, 2, 3, 4, 1, 1, 1 };
+  std::vector< int64_t > l_loop_strides_left     = { 8, 1, 0, 2, 1, 0, 1 };
+  std::vector< int64_t > l_loop_strides_right    = {12, 0, 4, 1, 0, 1, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = { 0, 0, 0, 0, 0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 6, 1, 2, 0, 1, 1, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_in_left  = at::rand( {7, 4, 2} );
+  at::Tensor l_in_right = at::rand( {7, 3, 4} );
+  at::Tensor l_out_ref  = at::rand( {7, 3, 2} );
+
+  // reference
+  at::Tensor l_out_init = l_out_ref.clone();
+  l_out_ref += at::einsum( "ckm,cnk->cnm",
+                           {l_in_left, l_in_right} );
+
+  int64_t l_chunk_sizes[3] = { 0, 1, 3 };
+
+  for( int64_t l_ch = 0; l_ch < 3; l_ch++ ) {
+    ContractionBackendScalar l_bin_cont;
+    l_bin_cont.init( l_loop_dim_type,
+                     l_loop_exec_type,
+                     l_loop_sizes,
+                     l_loop_strides_left,
+                     l_loop_strides_right,
+                     l_loop_strides_out_aux,
+                     l_loop_strides_out,
+                     l_packing_strides_left,
+                     l_packing_strides_right,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     kernel_t::UNDEFINED_KTYPE,
+                     kernel_t::MADD,
+                     kernel_t::UNDEFINED_KTYPE,
+                     3,
+                     1,
+                     1,
+                     nullptr );
+    l_bin_cont.set_scheduling( sched_t::DYNAMIC,
+                               l_chunk_sizes[l_ch] );
+
+    err_t l_err = l_bin_cont.compile();
+    REQUIRE( l_err == err_t::SUCCESS );
+
+    // repeated contractions reuse the task counters
+    for( int64_t l_re = 0; l_re < 2; l_re++ ) {
+      at::Tensor l_out = l_out_init.clone();
+      l_bin_cont.contract( l_in_left.data_ptr(),
+                           l_in_right.data_ptr(),
+                           nullptr,
+                           l_out.data_ptr() );
+
+      REQUIRE( at::allclose( l_out, l_out_ref )  );
+    }
+  }
+}
+
+TEST_CASE( "First touch of the output tensor using the Scalar contraction backend implementation.", "[contraction_backend_scalar]" ) {
+  // Test Case:
+  //
+  //    ____cnm___
+  //   /          \
+  // ckm          cnk
+  //
+  // char   id   size
+  //    c    0      5
+  //    m    1      6
+  //    n    2      7
+  //    k    3      3
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::C,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::OMP,
+                                             exec_t::SFC,
+                                             exec_t::SFC,
+                                             exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                 c, m, n, k mp,np,kp
+  std::vector< int64_t > l_loop_sizes            = { 5, 6, 7, 3, 1, 1, 1 };
+  std::vector< int64_t > l_loop_strides_left     = {18, 1, 0, 6, 1, 0, 1 };
+  std::vector< int64_t > l_loop_strides_right    = {21, 0, 3, 1, 0, 1, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = { 0, 0, 0, 0, 0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = {42, 1, 6, 0, 1, 1, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  ContractionBackendScalar l_bin_cont;
+  l_bin_cont.init( l_loop_dim_type,
+                   l_loop_exec_type,
+                   l_loop_sizes,
+                   l_loop_strides_left,
+                   l_loop_strides_right,
+                   l_loop_strides_out_aux,
+                   l_loop_strides_out,
+                   l_packing_strides_left,
+                   l_packing_strides_right,
+                   data_t::FP32,
+                   data_t::FP32,
+                   data_t::FP32,
+                   data_t::FP32,
+                   kernel_t::UNDEFINED_KTYPE,
+                   kernel_t::MADD,
+                   kernel_t::UNDEFINED_KTYPE,
+                   2,
+                   2,
+                   3,
+                   nullptr );
+
+  err_t l_err = l_bin_cont.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  at::Tensor l_out = at::rand( {5, 7, 6} ) + 1;
+  l_bin_cont.first_touch_out( l_out.data_ptr() );
+
+  REQUIRE( at::equal( l_out, at::zeros( {5, 7, 6} ) ) );
+}
+
+TEST_CASE( "INT8 matmul with per-channel requantization to INT8 using the Scalar contraction backend implementation.", "[contraction_backend_scalar]" ) {
+  // Test Case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0      5
+  //    n    1      3
+  //    k    2      7
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                 m, n, k mp,np,kp
+  std::vector< int64_t > l_loop_sizes            = { 5, 3, 7, 1, 1, 1 };
+  std::vector< int64_t > l_loop_strides_left     = { 1, 0, 5, 1, 0, 1 };
+  std::vector< int64_t > l_loop_strides_right    = { 0, 7, 1, 0, 1, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = { 0, 0, 0, 0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 1, 5, 0, 1, 1, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  ContractionBackendScalar l_bin_cont;
+  l_bin_cont.init( l_loop_dim_type,
+                   l_loop_exec_type,
+                   l_loop_sizes,
+                   l_loop_strides_left,
+                   l_loop_strides_right,
+                   l_loop_strides_out_aux,
+                   l_loop_strides_out,
+                   l_packing_strides_left,
+                   l_packing_strides_right,
+                   data_t::I8,
+                   data_t::I8,
+                   data_t::I32,
+                   data_t::I8,
+                   kernel_t::ZERO,
+                   kernel_t::MADD,
+                   kernel_t::UNDEFINED_KTYPE,
+                   1,
+                   1,
+                   1,
+                   nullptr );
+
+  // data
+  at::Tensor l_in_left  = at::randint( -128, 128, {7, 5} ).to( at::ScalarType::Char );
+  at::Tensor l_in_right = at::randint( -128, 128, {3, 7} ).to( at::ScalarType::Char );
+  at::Tensor l_out      = at::zeros( {3, 5}, at::ScalarType::Char );
+
+  // one scale per entry of n
+  at::Tensor l_scales = at::rand( {3} ) * 1E-3;
+
+  quant_params l_quant;
+  l_quant.scales         = l_scales.data_ptr< float >();
+  l_quant.num_scales     = 3;
+  l_quant.stride_channel = 5;
+  l_quant.zero_point     = -2;
+  l_bin_cont.set_quant( l_quant );
+
+  // reference
+  at::Tensor l_out_ref = at::einsum( "km,nk->nm",
+                                     { l_in_left.to( at::ScalarType::Float ),
+                                       l_in_right.to( at::ScalarType::Float ) } );
+  l_out_ref = at::clamp( at::round( l_out_ref * l_scales.unsqueeze( 1 ) ) - 2, -128, 127 );
+
+  einsum_ir::basic::err_t l_err = l_bin_cont.compile();
+  REQUIRE( l_err == einsum_ir::basic::err_t::SUCCESS );
+
+  l_bin_cont.contract( l_in_left.data_ptr(),
+                       l_in_right.data_ptr(),
+                       nullptr,
+                       l_out.data_ptr() );
+
+  REQUIRE( at::allclose( l_out.to( at::ScalarType::Float ), l_out_ref, 0, 1 ) );
+}
@@ -0,0 +1,534 @@
+#include "ContractionBackendSimd.h"
+#include "../unary/UnaryBackendSimd.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define EINSUM_IR_SIMD_VECTOR_EXTENSIONS
+#define EINSUM_IR_SIMD_INLINE inline __attribute__((always_inline))
+#define EINSUM_IR_SIMD_UNROLL _Pragma("GCC unroll 16")
+#else
+#define EINSUM_IR_SIMD_INLINE inline
+#define EINSUM_IR_SIMD_UNROLL
+#endif
+
+#if defined(EINSUM_IR_SIMD_VECTOR_EXTENSIONS) && ( defined(__x86_64__) || defined(__i386__) )
+#define EINSUM_IR_SIMD_X86
+#endif
+
+namespace {
+  typedef einsum_ir::basic::ContractionBackendSimd::kernel_args kernel_args;
+
+  /**
+   * Reference kernel which supports all layouts of the input tensors.
+   *
+   * @param_t T datatype.
+   * @param i_args arguments of the kernel.
+   * @param i_a left input matrices.
+   * @param i_b right input matrices.
+   * @param io_c output matrix.
+   **/
+  template< typename T >
+  EINSUM_IR_SIMD_INLINE void gemm_ref( kernel_args const & i_args,
+                                       T           const * i_a,
+                                       T           const * i_b,
+                                       T                 * io_c ) {
+    for( int64_t l_br = 0; l_br < i_args.br; l_br++ ) {
+      T const * l_a = i_a + l_br * i_args.br_stride_a;
+      T const * l_b = i_b + l_br * i_args.br_stride_b;
+      for( int64_t l_n = 0; l_n < i_args.n; l_n++ ) {
+        for( int64_t l_k = 0; l_k < i_args.k; l_k++ ) {
+          T l_val_b = l_b[ l_k * i_args.stride_k_b + l_n * i_args.stride_n_b ];
+          for( int64_t l_m = 0; l_m < i_args.m; l_m++ ) {
+            io_c[ l_m + l_n * i_args.ldc ] += l_a[ l_m * i_args.stride_m_a + l_k * i_args.stride_k_a ] * l_val_b;
+          }
+        }
+      }
+    }
+  }
+
+#ifdef EINSUM_IR_SIMD_VECTOR_EXTENSIONS
+  //! vector of W values, the instructions are derived from the target of the calling kernel
+  template< typename T,
+            int64_t  W >
+  struct vec {
+    typedef T type __attribute__(( vector_size( W * sizeof(T) ) ));
+  };
+
+  //! signed integers with the size of the floating point type
+  template< typename T >
+  struct bits;
+  template<>
+  struct bits< float > {
+    typedef int32_t type;
+  };
+  template<>
+  struct bits< double > {
+    typedef int64_t type;
+  };
+
+  /**
+   * Register-blocked micro-kernel which updates MR vectors of rows and NR columns of the output matrix.
+   * The rows of the left input matrices have to be contiguous.
+   *
+   * @param_t T datatype.
+   * @param_t W number of values per vector.
+   * @param_t MR number of vectors in the m dimension.
+   * @param_t NR number of columns in the n dimension.
+   * @param i_args arguments of the kernel.
+   * @param i_a left input matrices.
+   * @param i_b right input matrices.
+   * @param io_c output matrix.
+   **/
+  template< typename T,
+            int64_t  W,
+            int64_t  MR,
+            int64_t  NR >
+  EINSUM_IR_SIMD_INLINE void gemm_micro( kernel_args const & i_args,
+                                         T           const * i_a,
+                                         T           const * i_b,
+                                         T                 * io_c ) {
+    typedef typename vec< T, W >::type vec_t;
+
+    vec_t l_acc[MR][NR];
+    EINSUM_IR_SIMD_UNROLL
+    for( int64_t l_nr = 0; l_nr < NR; l_nr++ ) {
+      EINSUM_IR_SIMD_UNROLL
+      for( int64_t l_mr = 0; l_mr < MR; l_mr++ ) {
+        std::memcpy( &l_acc[l_mr][l_nr], io_c + l_mr * W + l_nr * i_args.ldc, sizeof(vec_t) );
+      }
+    }
+
+    for( int64_t l_br = 0; l_br < i_args.br; l_br++ ) {
+      T const * l_a = i_a + l_br * i_args.br_stride_a;
+      T const * l_b = i_b + l_br * i_args.br_stride_b;
+      for( int64_t l_k = 0; l_k < i_args.k; l_k++ ) {
+        vec_t l_vec_a[MR];
+        EINSUM_IR_SIMD_UNROLL
+        for( int64_t l_mr = 0; l_mr < MR; l_mr++ ) {
+          std::memcpy( &l_vec_a[l_mr], l_a + l_mr * W + l_k * i_args.stride_k_a, sizeof(vec_t) );
+        }
+        EINSUM_IR_SIMD_UNROLL
+        for( int64_t l_nr = 0; l_nr < NR; l_nr++ ) {
+          T l_val_b = l_b[ l_k * i_args.stride_k_b + l_nr * i_args.stride_n_b ];
+          EINSUM_IR_SIMD_UNROLL
+          for( int64_t l_mr = 0; l_mr < MR; l_mr++ ) {
+            l_acc[l_mr][l_nr] += l_vec_a[l_mr] * l_val_b;
+          }
+        }
+      }
+    }
+
+    EINSUM_IR_SIMD_UNROLL
+    for( int64_t l_nr = 0; l_nr < NR; l_nr++ ) {
+      EINSUM_IR_SIMD_UNROLL
+      for( int64_t l_mr = 0; l_mr < MR; l_mr++ ) {
+        std::memcpy( io_c + l_mr * W + l_nr * i_args.ldc, &l_acc[l_mr][l_nr], sizeof(vec_t) );
+      }
+    }
+  }
+
+  /**
+   * Updates NR columns of the output matrix.
+   *
+   * @param_t T datatype.
+   * @param_t W number of values per vector.
+   * @param_t MR number of vectors in the m dimension of the micro-kernel.
+   * @param_t NR number of columns in the n dimension.
+   * @param i_args arguments of the kernel.
+   * @param i_a left input matrices.
+   * @param i_b right input matrices.
+   * @param io_c output matrix.
+   **/
+  template< typename T,
+            int64_t  W,
+            int64_t  MR,
+            int64_t  NR >
+  EINSUM_IR_SIMD_INLINE void gemm_columns( kernel_args const & i_args,
+                                           T           const * i_a,
+                                           T           const * i_b,
+                                           T                 * io_c ) {
+    int64_t l_m = 0;
+    for( ; l_m + MR * W <= i_args.m; l_m += MR * W ) {
+      gemm_micro< T, W, MR, NR >( i_args, i_a + l_m, i_b, io_c + l_m );
+    }
+    for( ; l_m + W <= i_args.m; l_m += W ) {
+      gemm_micro< T, W, 1, NR >( i_args, i_a + l_m, i_b, io_c + l_m );
+    }
+
+    // remaining rows
+    if( l_m < i_args.m ) {
+      kernel_args l_args = i_args;
+      l_args.m = i_args.m - l_m;
+      l_args.n = NR;
+      gemm_ref< T >( l_args, i_a + l_m, i_b, io_c + l_m );
+    }
+  }
+
+  /**
+   * Vectorized kernel, the rows of the left input matrices have to be contiguous.
+   *
+   * @param_t T datatype.
+   * @param_t W number of values per vector.
+   * @param_t MR number of vectors in the m dimension of the micro-kernel.
+   * @param_t NR number of columns in the n dimension of the micro-kernel.
+   * @param i_args arguments of the kernel.
+   * @param i_a left input matrices.
+   * @param i_b right input matrices.
+   * @param io_c output matrix.
+   **/
+  template< typename T,
+            int64_t  W,
+            int64_t  MR,
+            int64_t  NR >
+  EINSUM_IR_SIMD_INLINE void gemm( kernel_args const & i_args,
+                                   void        const * i_a,
+                                   void        const * i_b,
+                                   void              * io_c ) {
+    T const * l_a = (T const *) i_a;
+    T const * l_b = (T const *) i_b;
+    T       * l_c = (T       *) io_c;
+
+    int64_t l_n = 0;
+    for( ; l_n + NR <= i_args.n; l_n += NR ) {
+      gemm_columns< T, W, MR, NR >( i_args, l_a, l_b + l_n * i_args.stride_n_b, l_c + l_n * i_args.ldc );
+    }
+    for( ; l_n < i_args.n; l_n++ ) {
+      gemm_columns< T, W, MR, 1 >( i_args, l_a, l_b + l_n * i_args.stride_n_b, l_c + l_n * i_args.ldc );
+    }
+  }
+
+  /**
+   * Vectorized ReLU.
+   *
+   * @param_t T datatype.
+   * @param_t W number of values per vector.
+   * @param i_args arguments of the kernel.
+   * @param io_out output matrix.
+   **/
+  template< typename T,
+            int64_t  W >
+  EINSUM_IR_SIMD_INLINE void relu( kernel_args const & i_args,
+                                   void        const *,
+                                   void              * io_out ) {
+    typedef typename vec< T, W >::type vec_t;
+    typedef typename vec< typename bits< T >::type, W >::type vec_bits_t;
+
+    vec_t l_zero = {};
+    for( int64_t l_n = 0; l_n < i_args.n; l_n++ ) {
+      T * l_out = (T *) io_out + l_n * i_args.ldc;
+
+      int64_t l_m = 0;
+      for( ; l_m + W <= i_args.m; l_m += W ) {
+        vec_t l_val;
+        vec_bits_t l_bits;
+        std::memcpy( &l_val, l_out + l_m, sizeof(vec_t) );
+        std::memcpy( &l_bits, &l_val, sizeof(vec_t) );
+        l_bits &= (vec_bits_t) ( l_val > l_zero );
+        std::memcpy( l_out + l_m, &l_bits, sizeof(vec_t) );
+      }
+      for( ; l_m < i_args.m; l_m++ ) {
+        l_out[l_m] = std::max( l_out[l_m], T(0) );
+      }
+    }
+  }
+#endif
+
+  /**
+   * Reference ReLU.
+   *
+   * @param_t T datatype.
+   * @param i_args arguments of the kernel.
+   * @param io_out output matrix.
+   **/
+  template< typename T >
+  void relu_ref( kernel_args const & i_args,
+                 void        const *,
+                 void              * io_out ) {
+    for( int64_t l_n = 0; l_n < i_args.n; l_n++ ) {
+      T * l_out = (T *) io_out + l_n * i_args.ldc;
+      for( int64_t l_m = 0; l_m < i_args.m; l_m++ ) {
+        l_out[l_m] = std::max( l_out[l_m], T(0) );
+      }
+    }
+  }
+
+  /**
+   * Zero kernel.
+   *
+   * @param_t T datatype.
+   * @param i_args arguments of the kernel.
+   * @param o_out output matrix.
+   **/
+  template< typename T >
+  void zero( kernel_args const & i_args,
+             void        const *,
+             void              * o_out ) {
+    for( int64_t l_n = 0; l_n < i_args.n; l_n++ ) {
+      std::memset( (T *) o_out + l_n * i_args.ldc, 0, i_args.m * sizeof(T) );
+    }
+  }
+
+  /**
+   * Copy kernel, broadcasts the auxiliary tensor if its m stride is zero.
+   *
+   * @param_t T datatype.
+   * @param i_args arguments of the kernel.
+   * @param i_out_aux auxiliary output matrix.
+   * @param o_out output matrix.
+   **/
+  template< typename T >
+  void copy( kernel_args const & i_args,
+             void        const * i_out_aux,
+             void              * o_out ) {
+    for( int64_t l_n = 0; l_n < i_args.n; l_n++ ) {
+      T const * l_aux = (T const *) i_out_aux + l_n * i_args.stride_n_aux;
+      T       * l_out = (T       *) o_out     + l_n * i_args.ldc;
+
+      if( i_args.stride_m_aux == 1 ) {
+        std::memcpy( l_out, l_aux, i_args.m * sizeof(T) );
+      }
+      else {
+        for( int64_t l_m = 0; l_m < i_args.m; l_m++ ) {
+          l_out[l_m] = l_aux[ l_m * i_args.stride_m_aux ];
+        }
+      }
+    }
+  }
+
+  template< typename T >
+  void gemm_ref_typed( kernel_args const & i_args,
+                       void        const * i_a,
+                       void        const * i_b,
+                       void              * io_c ) {
+    gemm_ref< T >( i_args, (T const *) i_a, (T const *) i_b, (T *) io_c );
+  }
+
+  // kernels of the 128-bit baseline: SSE2 on x86-64, NEON on AArch64
+#ifdef EINSUM_IR_SIMD_VECTOR_EXTENSIONS
+#ifdef __aarch64__
+  constexpr int64_t g_mr_vec128 = 4;
+#else
+  constexpr int64_t g_mr_vec128 = 2;
+#endif
+
+  void gemm_vec128_fp32( kernel_args const & i_args, void const * i_a, void const * i_b, void * io_c ) {
+    gemm< float, 4, g_mr_vec128, 4 >( i_args, i_a, i_b, io_c );
+  }
+  void gemm_vec128_fp64( kernel_args const & i_args, void const * i_a, void const * i_b, void * io_c ) {
+    gemm< double, 2, g_mr_vec128, 4 >( i_args, i_a, i_b, io_c );
+  }
+  void relu_vec128_fp32( kernel_args const & i_args, void const * i_aux, void * io_out ) {
+    relu< float, 4 >( i_args, i_aux, io_out );
+  }
+  void relu_vec128_fp64( kernel_args const & i_args, void const * i_aux, void * io_out ) {
+    relu< double, 2 >( i_args, i_aux, io_out );
+  }
+#else
+  void gemm_vec128_fp32( kernel_args const & i_args, void const * i_a, void const * i_b, void * io_c ) {
+    gemm_ref_typed< float >( i_args, i_a, i_b, io_c );
+  }
+  void gemm_vec128_fp64( kernel_args const & i_args, void const * i_a, void const * i_b, void * io_c ) {
+    gemm_ref_typed< double >( i_args, i_a, i_b, io_c );
+  }
+  void relu_vec128_fp32( kernel_args const & i_args, void const * i_aux, void * io_out ) {
+    relu_ref< float >( i_args, i_aux, io_out );
+  }
+  void relu_vec128_fp64( kernel_args const & i_args, void const * i_aux, void * io_out ) {
+    relu_ref< double >( i_args, i_aux, io_out );
+  }
+#endif
+
+  // kernels of AVX2 and AVX-512, 12 and 16 accumulator registers
+#ifdef EINSUM_IR_SIMD_X86
+  __attribute__((target("avx2,fma"))) void gemm_avx2_fp32( kernel_args const & i_args, void const * i_a, void const * i_b, void * io_c ) {
+    gemm< float, 8, 3, 4 >( i_args, i_a, i_b, io_c );
+  }
+  __attribute__((target("avx2,fma"))) void gemm_avx2_fp64( kernel_args const & i_args, void const * i_a, void const * i_b, void * io_c ) {
+    gemm< double, 4, 3, 4 >( i_args, i_a, i_b, io_c );
+  }
+  __attribute__((target("avx2,fma"))) void relu_avx2_fp32( kernel_args const & i_args, void const * i_aux, void * io_out ) {
+    relu< float, 8 >( i_args, i_aux, io_out );
+  }
+  __attribute__((target("avx2,fma"))) void relu_avx2_fp64( kernel_args const & i_args, void const * i_aux, void * io_out ) {
+    relu< double, 4 >( i_args, i_aux, io_out );
+  }
+
+  __attribute__((target("avx512f"))) void gemm_avx512_fp32( kernel_args const & i_args, void const * i_a, void const * i_b, void * io_c ) {
+    gemm< float, 16, 2, 8 >( i_args, i_a, i_b, io_c );
+  }
+  __attribute__((target("avx512f"))) void gemm_avx512_fp64( kernel_args const & i_args, void const * i_a, void const * i_b, void * io_c ) {
+    gemm< double, 8, 2, 8 >( i_args, i_a, i_b, io_c );
+  }
+  __attribute__((target("avx512f"))) void relu_avx512_fp32( kernel_args const & i_args, void const * i_aux, void * io_out ) {
+    relu< float, 16 >( i_args, i_aux, io_out );
+  }
+  __attribute__((target("avx512f"))) void relu_avx512_fp64( kernel_args const & i_args, void const * i_aux, void * io_out ) {
+    relu< double, 8 >( i_args, i_aux, io_out );
+  }
+#endif
+}
+
+einsum_ir::basic::isa_t einsum_ir::basic::ContractionBackendSimd::detect_isa() {
+#ifdef EINSUM_IR_SIMD_X86
+  __builtin_cpu_init();
+  if( __builtin_cpu_supports( "avx512f" ) ) {
+    return isa_t::AVX512;
+  }
+  if(    __builtin_cpu_supports( "avx2" )
+      && __builtin_cpu_supports( "fma" ) ) {
+    return isa_t::AVX2;
+  }
+#endif
+  return isa_t::VEC128;
+}
+
+void einsum_ir::basic::ContractionBackendSimd::set_isa( isa_t i_isa ) {
+  m_isa = i_isa;
+}
+
+std::unique_ptr< einsum_ir::basic::UnaryBackend > einsum_ir::basic::ContractionBackendSimd::create_unary_packing() {
+  return std::make_unique< UnaryBackendSimd >();
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendSimd::compile_kernels() {
+  // only FP32 and FP64 contractions without packed dimensions are supported
+  bool l_dtype_all_fp32 = false;
+
+  if(    m_dtype_left  == FP32
+      && m_dtype_right == FP32
+      && m_dtype_comp  == FP32
+      && m_dtype_out   == FP32 ) {
+    l_dtype_all_fp32 = true;
+  }
+  else if(    m_dtype_left  == FP64
+           && m_dtype_right == FP64
+           && m_dtype_comp  == FP64
+           && m_dtype_out   == FP64 ) {
+    l_dtype_all_fp32 = false;
+  }
+  else {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  if( m_r != 1 ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  // the requested instruction set has to be supported by the processor
+  isa_t l_isa_detected = detect_isa();
+  if( m_isa == isa_t::UNDEFINED_ISA ) {
+    m_isa = l_isa_detected;
+  }
+  if(    m_isa != isa_t::VEC128
+      && m_isa != isa_t::AVX2
+      && m_isa != isa_t::AVX512 ) {
+    return err_t::COMPILATION_FAILED;
+  }
+  if( m_isa > l_isa_detected ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  // kernel arguments
+  m_args.m  = m_m;
+  m_args.n  = m_n;
+  m_args.k  = m_k;
+  m_args.br = m_br;
+
+  m_args.stride_m_a = m_trans_a ? m_lda : 1;
+  m_args.stride_k_a = m_trans_a ? 1     : m_lda;
+  m_args.stride_k_b = m_trans_b ? m_ldb : 1;
+  m_args.stride_n_b = m_trans_b ? 1     : m_ldb;
+
+  m_args.br_stride_a = m_br_stride_a;
+  m_args.br_stride_b = m_br_stride_b;
+
+  m_args.ldc          = m_ldc;
+  m_args.stride_m_aux = m_stride_m_out_aux;
+  m_args.stride_n_aux = m_stride_n_out_aux;
+
+  // first-touch kernel
+  m_kernel_first_touch = nullptr;
+  if( m_ktype_first_touch == kernel_t::ZERO ) {
+    m_kernel_first_touch = l_dtype_all_fp32 ? &zero< float > : &zero< double >;
+  }
+  else if( m_ktype_first_touch == kernel_t::COPY ) {
+    m_kernel_first_touch = l_dtype_all_fp32 ? &copy< float > : &copy< double >;
+  }
+  else if( m_ktype_first_touch != kernel_t::UNDEFINED_KTYPE ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  // main kernel
+  if(    m_ktype_main != kernel_t::MADD
+      && m_ktype_main != kernel_t::BR_MADD ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  if( m_args.stride_m_a != 1 ) {
+    // the vectorized kernels require contiguous rows in the left tensor
+    m_kernel_main = l_dtype_all_fp32 ? &gemm_ref_typed< float > : &gemm_ref_typed< double >;
+  }
+  else if( m_isa == isa_t::VEC128 ) {
+    m_kernel_main = l_dtype_all_fp32 ? &gemm_vec128_fp32 : &gemm_vec128_fp64;
+  }
+#ifdef EINSUM_IR_SIMD_X86
+  else if( m_isa == isa_t::AVX2 ) {
+    m_kernel_main = l_dtype_all_fp32 ? &gemm_avx2_fp32 : &gemm_avx2_fp64;
+  }
+  else if( m_isa == isa_t::AVX512 ) {
+    m_kernel_main = l_dtype_all_fp32 ? &gemm_avx512_fp32 : &gemm_avx512_fp64;
+  }
+#endif
+  else {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  // last-touch kernel
+  m_kernel_last_touch = nullptr;
+  if( m_ktype_last_touch == kernel_t::RELU ) {
+    if( m_isa == isa_t::VEC128 ) {
+      m_kernel_last_touch = l_dtype_all_fp32 ? &relu_vec128_fp32 : &relu_vec128_fp64;
+    }
+#ifdef EINSUM_IR_SIMD_X86
+    else if( m_isa == isa_t::AVX2 ) {
+      m_kernel_last_touch = l_dtype_all_fp32 ? &relu_avx2_fp32 : &relu_avx2_fp64;
+    }
+    else if( m_isa == isa_t::AVX512 ) {
+      m_kernel_last_touch = l_dtype_all_fp32 ? &relu_avx512_fp32 : &relu_avx512_fp64;
+    }
+#endif
+  }
+  else if( m_ktype_last_touch != kernel_t::UNDEFINED_KTYPE ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  return err_t::SUCCESS;
+}
+
+void einsum_ir::basic::ContractionBackendSimd::kernel_first_touch( void const * i_out_aux,
+                                                                   void       * io_out ) {
+  if( m_kernel_first_touch != nullptr ) {
+    m_kernel_first_touch( m_args,
+                          i_out_aux,
+                          io_out );
+  }
+}
+
+void einsum_ir::basic::ContractionBackendSimd::kernel_main( void const * i_left,
+                                                            void const * i_right,
+                                                            void       * io_out ) {
+  m_kernel_main( m_args,
+                 i_left,
+                 i_right,
+                 io_out );
+}
+
+void einsum_ir::basic::ContractionBackendSimd::kernel_last_touch( void const * i_out_aux,
+                                                                  void       * io_out ) {
+  if( m_kernel_last_touch != nullptr ) {
+    m_kernel_last_touch( m_args,
+                         i_out_aux,
+                         io_out );
+  }
+}
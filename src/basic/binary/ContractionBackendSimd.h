@@ -0,0 +1,137 @@
+#ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_BACKEND_SIMD
+#define EINSUM_IR_BASIC_BINARY_CONTRACTION_BACKEND_SIMD
+
+#include "ContractionBackend.h"
+
+namespace einsum_ir {
+  namespace basic {
+    class ContractionBackendSimd;
+  }
+}
+
+/**
+ * Contraction backend with in-tree SIMD micro-kernels, used if libxsmm is unavailable.
+ * The kernels are compiled for AVX-512, AVX2 and the 128-bit baseline (SSE2 or NEON);
+ * the instruction set is selected at runtime.
+ * Supported are FP32 and FP64 MADD and BR_MADD main kernels,
+ * ZERO and COPY first-touch kernels and RELU last-touch kernels.
+ * Input tensors are packed by the in-tree SIMD unary kernels, a RELU may be applied while packing.
+ * Transposed left operands are not vectorized and fall back to a scalar loop.
+ **/
+class einsum_ir::basic::ContractionBackendSimd: public ContractionBackend {
+  public:
+    //! arguments of the kernels
+    struct kernel_args {
+      int64_t m = 0;
+      int64_t n = 0;
+      int64_t k = 0;
+      int64_t br = 1;
+      //! strides of the left tensor in the m and k dimension
+      int64_t stride_m_a = 0;
+      int64_t stride_k_a = 0;
+      //! strides of the right tensor in the k and n dimension
+      int64_t stride_k_b = 0;
+      int64_t stride_n_b = 0;
+      //! batch-reduce strides
+      int64_t br_stride_a = 0;
+      int64_t br_stride_b = 0;
+      //! leading dimension of the output tensor
+      int64_t ldc = 0;
+      //! strides of the auxiliary output tensor
+      int64_t stride_m_aux = 0;
+      int64_t stride_n_aux = 0;
+    };
+
+  private:
+    //! instruction set of the kernels
+    isa_t m_isa = UNDEFINED_ISA;
+
+    //! arguments of the kernels
+    kernel_args m_args;
+
+    //! first-touch kernel
+    void (* m_kernel_first_touch)( kernel_args const &,
+                                   void        const *,
+                                   void              * ) = nullptr;
+
+    //! main kernel
+    void (* m_kernel_main)( kernel_args const &,
+                            void        const *,
+                            void        const *,
+                            void              * ) = nullptr;
+
+    //! last-touch kernel
+    void (* m_kernel_last_touch)( kernel_args const &,
+                                  void        const *,
+                                  void              * ) = nullptr;
+
+  public:
+    /**
+     * Detects the widest instruction set supported by the executing processor.
+     *
+     * @return instruction set.
+     **/
+    static isa_t detect_isa();
+
+    /**
+     * Sets the instruction set of the kernels, has to be called before compilation.
+     * By default, the detected instruction set is used.
+     *
+     * @param i_isa instruction set.
+     **/
+    void set_isa( isa_t i_isa );
+
+    /**
+     * Gets the instruction set of the compiled kernels.
+     *
+     * @return instruction set.
+     **/
+    isa_t get_isa() const {
+      return m_isa;
+    }
+
+    /**
+     * Creates the SIMD-based unary backend which packs an input tensor.
+     *
+     * @return unary packing backend.
+     **/
+    std::unique_ptr< UnaryBackend > create_unary_packing();
+
+    /**
+     * Executes the first touch kernel on the given data section of the tensor.
+     *
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    void kernel_first_touch( void const * i_out_aux,
+                             void       * io_out );
+
+    /**
+     * Executes the main kernel on the given data sections of the tensors.
+     *
+     * @param i_left pointer to a data section of the left tensor.
+     * @param i_right pointer to a data section of the right tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    void kernel_main( void const * i_left,
+                      void const * i_right,
+                      void       * io_out );
+
+    /**
+     * Executes the last touch kernel on the given data section of the tensor.
+     *
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    void kernel_last_touch( void const * i_out_aux,
+                            void       * io_out );
+
+    /**
+     * Compiles all kernels
+     *
+     * @return SUCCESS if the compilation was successful, otherwise an appropiate error code.
+     **/
+    err_t compile_kernels();
+};
+
+#endif
@@ -0,0 +1,548 @@
+#include "catch.hpp"
+#include "ContractionBackendSimd.h"
+#include <algorithm>
+#include <cmath>
+
+TEST_CASE( "Batch-reduce matmul with zero first touch and ReLU last touch using the SIMD contraction backend.", "[contraction_backend_simd]" ) {
+  // Test Case:
+  //
+  //      ______cnm______
+  //     /               \
+  // cbkm                 cnbk
+  //
+  // char   id   size
+  //    c    0      2
+  //    b    1      3
+  //    m    2     37
+  //    n    3     11
+  //    k    4      5
+  using namespace einsum_ir::basic;
+
+  int64_t l_size_c = 2;
+  int64_t l_size_b = 3;
+  int64_t l_size_m = 37;
+  int64_t l_size_n = 11;
+  int64_t l_size_k = 5;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::C,
+                                             dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  std::vector< int64_t > l_loop_sizes            = { l_size_c, l_size_b, l_size_m, l_size_n, l_size_k };
+  std::vector< int64_t > l_loop_strides_left     = { l_size_b * l_size_k * l_size_m, l_size_k * l_size_m, 1, 0, l_size_m };
+  std::vector< int64_t > l_loop_strides_right    = { l_size_n * l_size_b * l_size_k, l_size_k, 0, l_size_b * l_size_k, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = { 0, 0, 0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { l_size_n * l_size_m, 0, 1, l_size_m, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  // data
+  std::vector< float > l_left(  l_size_c * l_size_b * l_size_k * l_size_m );
+  std::vector< float > l_right( l_size_c * l_size_n * l_size_b * l_size_k );
+  std::vector< float > l_out_ref( l_size_c * l_size_n * l_size_m, 0 );
+
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = ( (l_en * 7) % 13 ) / 6.0f - 1.0f;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = ( (l_en * 5) % 11 ) / 5.0f - 1.0f;
+  }
+
+  // reference
+  for( int64_t l_c = 0; l_c < l_size_c; l_c++ ) {
+    for( int64_t l_n = 0; l_n < l_size_n; l_n++ ) {
+      for( int64_t l_m = 0; l_m < l_size_m; l_m++ ) {
+        float l_sum = 0;
+        for( int64_t l_b = 0; l_b < l_size_b; l_b++ ) {
+          for( int64_t l_k = 0; l_k < l_size_k; l_k++ ) {
+            l_sum +=   l_left[  ( (l_c * l_size_b + l_b) * l_size_k + l_k ) * l_size_m + l_m ]
+                     * l_right[ ( (l_c * l_size_n + l_n) * l_size_b + l_b ) * l_size_k + l_k ];
+          }
+        }
+        l_out_ref[ (l_c * l_size_n + l_n) * l_size_m + l_m ] = std::max( l_sum, 0.0f );
+      }
+    }
+  }
+
+  std::vector< isa_t > l_isas = { isa_t::VEC128,
+                                  ContractionBackendSimd::detect_isa() };
+
+  for( isa_t l_isa : l_isas ) {
+    ContractionBackendSimd l_bin_cont;
+    l_bin_cont.init( l_loop_dim_type,
+                     l_loop_exec_type,
+                     l_loop_sizes,
+                     l_loop_strides_left,
+                     l_loop_strides_right,
+                     l_loop_strides_out_aux,
+                     l_loop_strides_out,
+                     l_packing_strides_left,
+                     l_packing_strides_right,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     kernel_t::ZERO,
+                     kernel_t::BR_MADD,
+                     kernel_t::RELU,
+                     1,
+                     1,
+                     1,
+                     nullptr );
+    l_bin_cont.set_isa( l_isa );
+
+    REQUIRE( l_bin_cont.compile() == err_t::SUCCESS );
+    REQUIRE( l_bin_cont.get_isa() == l_isa );
+
+    std::vector< float > l_out( l_out_ref.size(), 1.0f );
+    l_bin_cont.contract( l_left.data(),
+                         l_right.data(),
+                         nullptr,
+                         l_out.data() );
+
+    for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+      REQUIRE( l_out[l_en] == Approx( l_out_ref[l_en] ) );
+    }
+  }
+}
+
+TEST_CASE( "FP64 matmul with bias and transposed A using the SIMD contraction backend.", "[contraction_backend_simd]" ) {
+  // Test Case:
+  //
+  //     ___nm___
+  //    /        \
+  //  mk          nk
+  //
+  // char   id   size
+  //    m    0     19
+  //    n    1      6
+  //    k    2      7
+  //
+  // the bias is broadcast in the m dimension
+  using namespace einsum_ir::basic;
+
+  int64_t l_size_m = 19;
+  int64_t l_size_n = 6;
+  int64_t l_size_k = 7;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  std::vector< int64_t > l_loop_sizes            = { l_size_m, l_size_n, l_size_k };
+  std::vector< int64_t > l_loop_strides_left     = { l_size_k, 0, 1 };
+  std::vector< int64_t > l_loop_strides_right    = { 0, l_size_k, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = { 0, 1, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 1, l_size_m, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  // data
+  std::vector< double > l_left(  l_size_m * l_size_k );
+  std::vector< double > l_right( l_size_n * l_size_k );
+  std::vector< double > l_bias(  l_size_n );
+  std::vector< double > l_out_ref( l_size_n * l_size_m );
+
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = ( (l_en * 7) % 13 ) / 6.0 - 1.0;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = ( (l_en * 5) % 11 ) / 5.0 - 1.0;
+  }
+  for( int64_t l_n = 0; l_n < l_size_n; l_n++ ) {
+    l_bias[l_n] = l_n - 2.5;
+  }
+
+  // reference
+  for( int64_t l_n = 0; l_n < l_size_n; l_n++ ) {
+    for( int64_t l_m = 0; l_m < l_size_m; l_m++ ) {
+      double l_sum = l_bias[l_n];
+      for( int64_t l_k = 0; l_k < l_size_k; l_k++ ) {
+        l_sum += l_left[ l_m * l_size_k + l_k ] * l_right[ l_n * l_size_k + l_k ];
+      }
+      l_out_ref[ l_n * l_size_m + l_m ] = l_sum;
+    }
+  }
+
+  ContractionBackendSimd l_bin_cont;
+  l_bin_cont.init( l_loop_dim_type,
+                   l_loop_exec_type,
+                   l_loop_sizes,
+                   l_loop_strides_left,
+                   l_loop_strides_right,
+                   l_loop_strides_out_aux,
+                   l_loop_strides_out,
+                   l_packing_strides_left,
+                   l_packing_strides_right,
+                   data_t::FP64,
+                   data_t::FP64,
+                   data_t::FP64,
+                   data_t::FP64,
+                   kernel_t::COPY,
+                   kernel_t::MADD,
+                   kernel_t::UNDEFINED_KTYPE,
+                   1,
+                   1,
+                   1,
+                   nullptr );
+
+  REQUIRE( l_bin_cont.compile() == err_t::SUCCESS );
+
+  std::vector< double > l_out( l_out_ref.size(), 1.0 );
+  l_bin_cont.contract( l_left.data(),
+                       l_right.data(),
+                       l_bias.data(),
+                       l_out.data() );
+
+  for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+    REQUIRE( l_out[l_en] == Approx( l_out_ref[l_en] ) );
+  }
+}
+
+TEST_CASE( "Split-K matmul with bias and ReLU last touch using the SIMD contraction backend.", "[contraction_backend_simd]" ) {
+  // Test Case:
+  //
+  //     ___nm___
+  //    /        \
+  //  km          nk
+  //
+  // char   id   size
+  //    m    0     26
+  //    n    1      5
+  //    k    2     56
+  //
+  // the outer K loop is shared among the threads, the bias is broadcast in the m dimension
+  using namespace einsum_ir::basic;
+
+  int64_t l_size_m = 26;
+  int64_t l_size_n = 5;
+  int64_t l_size_k = 56;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::K,
+                                             dim_t::M,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::OMP,
+                                             exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  std::vector< int64_t > l_loop_sizes            = { 8, 2, 13, l_size_n, 7 };
+  std::vector< int64_t > l_loop_strides_left     = { 7 * l_size_m, 13, 1, 0, l_size_m };
+  std::vector< int64_t > l_loop_strides_right    = { 7, 0, 0, l_size_k, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = { 0, 0, 0, 1, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 0, 13, 1, l_size_m, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  // data
+  std::vector< float > l_left(  l_size_k * l_size_m );
+  std::vector< float > l_right( l_size_n * l_size_k );
+  std::vector< float > l_bias(  l_size_n );
+  std::vector< float > l_out_ref( l_size_n * l_size_m );
+
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = ( (l_en * 7) % 13 ) / 6.0f - 1.0f;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = ( (l_en * 5) % 11 ) / 5.0f - 1.0f;
+  }
+  for( int64_t l_n = 0; l_n < l_size_n; l_n++ ) {
+    l_bias[l_n] = l_n - 2.5f;
+  }
+
+  // reference
+  for( int64_t l_n = 0; l_n < l_size_n; l_n++ ) {
+    for( int64_t l_m = 0; l_m < l_size_m; l_m++ ) {
+      float l_sum = l_bias[l_n];
+      for( int64_t l_k = 0; l_k < l_size_k; l_k++ ) {
+        l_sum += l_left[ l_k * l_size_m + l_m ] * l_right[ l_n * l_size_k + l_k ];
+      }
+      l_out_ref[ l_n * l_size_m + l_m ] = std::max( l_sum, 0.0f );
+    }
+  }
+
+  ContractionBackendSimd l_bin_cont;
+  l_bin_cont.init( l_loop_dim_type,
+                   l_loop_exec_type,
+                   l_loop_sizes,
+                   l_loop_strides_left,
+                   l_loop_strides_right,
+                   l_loop_strides_out_aux,
+                   l_loop_strides_out,
+                   l_packing_strides_left,
+                   l_packing_strides_right,
+                   data_t::FP32,
+                   data_t::FP32,
+                   data_t::FP32,
+                   data_t::FP32,
+                   kernel_t::COPY,
+                   kernel_t::MADD,
+                   kernel_t::RELU,
+                   4,
+                   1,
+                   1,
+                   nullptr );
+
+  REQUIRE( l_bin_cont.compile() == err_t::SUCCESS );
+
+  std::vector< float > l_out( l_out_ref.size(), 1.0f );
+  l_bin_cont.first_touch_out( l_out.data() );
+  for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+    REQUIRE( l_out[l_en] == 0.0f );
+  }
+
+  l_bin_cont.contract( l_left.data(),
+                       l_right.data(),
+                       l_bias.data(),
+                       l_out.data() );
+
+  for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+    REQUIRE( l_out[l_en] == Approx( l_out_ref[l_en] ) );
+  }
+
+  // the reduction of the partial results is deterministic
+  std::vector< float > l_out_rep( l_out_ref.size(), 1.0f );
+  l_bin_cont.contract( l_left.data(),
+                       l_right.data(),
+                       l_bias.data(),
+                       l_out_rep.data() );
+
+  for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+    REQUIRE( l_out_rep[l_en] == l_out[l_en] );
+  }
+
+  // memory limits of the partial output tensors, which allow three threads or sequential execution of the K loop
+  int64_t l_size_partial = l_size_n * l_size_m * sizeof(float);
+  std::vector< int64_t > l_max_sizes_partials = { 3 * l_size_partial,
+                                                  l_size_partial };
+
+  for( int64_t l_max_size_partials : l_max_sizes_partials ) {
+    ContractionBackendSimd l_bin_cont_limited;
+    l_bin_cont_limited.init( l_loop_dim_type,
+                             l_loop_exec_type,
+                             l_loop_sizes,
+                             l_loop_strides_left,
+                             l_loop_strides_right,
+                             l_loop_strides_out_aux,
+                             l_loop_strides_out,
+                             l_packing_strides_left,
+                             l_packing_strides_right,
+                             data_t::FP32,
+                             data_t::FP32,
+                             data_t::FP32,
+                             data_t::FP32,
+                             kernel_t::COPY,
+                             kernel_t::MADD,
+                             kernel_t::RELU,
+                             4,
+                             1,
+                             1,
+                             nullptr );
+    l_bin_cont_limited.set_max_size_partials( l_max_size_partials );
+
+    REQUIRE( l_bin_cont_limited.compile() == err_t::SUCCESS );
+
+    std::vector< float > l_out_limited( l_out_ref.size(), 1.0f );
+    l_bin_cont_limited.contract( l_left.data(),
+                                 l_right.data(),
+                                 l_bias.data(),
+                                 l_out_limited.data() );
+
+    for( std::size_t l_en = 0; l_en < l_out_limited.size(); l_en++ ) {
+      REQUIRE( l_out_limited[l_en] == Approx( l_out_ref[l_en] ) );
+    }
+  }
+}
+
+TEST_CASE( "Matmul with packing of the transposed left tensor and a ReLU prologue using the SIMD contraction backend.", "[contraction_backend_simd]" ) {
+  // Test Case:
+  //
+  //      ____cnmnm____
+  //     /             \
+  // cmmk               cnnk
+  //
+  // char   id   size
+  //    c    0      3
+  //    m    1      4
+  //    n    2      2
+  //    m    3     20
+  //    n    4      7
+  //    k    5     13
+  //
+  // k is the fastest dimension of the left tensor, packing makes the rows of the main kernel contiguous
+  using namespace einsum_ir::basic;
+
+  int64_t l_size_c  = 3;
+  int64_t l_size_m1 = 4;
+  int64_t l_size_n1 = 2;
+  int64_t l_size_m0 = 20;
+  int64_t l_size_n0 = 7;
+  int64_t l_size_k  = 13;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::C,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  std::vector< int64_t > l_loop_sizes            = { l_size_c, l_size_m1, l_size_n1, l_size_m0, l_size_n0, l_size_k };
+  std::vector< int64_t > l_loop_strides_left     = { l_size_m1 * l_size_m0 * l_size_k, l_size_m0 * l_size_k, 0, 1, 0, l_size_m0 };
+  std::vector< int64_t > l_loop_strides_right    = { l_size_n1 * l_size_n0 * l_size_k, 0, l_size_n0 * l_size_k, 0, l_size_k, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = { 0, 0, 0, 0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { l_size_n1 * l_size_m1 * l_size_n0 * l_size_m0,
+                                                     l_size_n0 * l_size_m0,
+                                                     l_size_m1 * l_size_n0 * l_size_m0,
+                                                     1,
+                                                     l_size_m0,
+                                                     0 };
+  std::vector< int64_t > l_packing_strides_left  = { 0, 0, 0, l_size_k, 0, 1 };
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  // data
+  std::vector< float > l_left(  l_size_c * l_size_m1 * l_size_m0 * l_size_k );
+  std::vector< float > l_right( l_size_c * l_size_n1 * l_size_n0 * l_size_k );
+  std::vector< float > l_out_ref( l_size_c * l_size_n1 * l_size_m1 * l_size_n0 * l_size_m0 );
+
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = ( (l_en * 7) % 13 ) / 6.0f - 1.0f;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = ( (l_en * 5) % 11 ) / 5.0f - 1.0f;
+  }
+
+  // reference
+  for( int64_t l_c = 0; l_c < l_size_c; l_c++ ) {
+    for( int64_t l_n1 = 0; l_n1 < l_size_n1; l_n1++ ) {
+      for( int64_t l_m1 = 0; l_m1 < l_size_m1; l_m1++ ) {
+        for( int64_t l_n0 = 0; l_n0 < l_size_n0; l_n0++ ) {
+          for( int64_t l_m0 = 0; l_m0 < l_size_m0; l_m0++ ) {
+            float l_sum = 0;
+            for( int64_t l_k = 0; l_k < l_size_k; l_k++ ) {
+              l_sum +=   std::max( l_left[ ( (l_c * l_size_m1 + l_m1) * l_size_m0 + l_m0 ) * l_size_k + l_k ], 0.0f )
+                       * l_right[ ( (l_c * l_size_n1 + l_n1) * l_size_n0 + l_n0 ) * l_size_k + l_k ];
+            }
+            l_out_ref[ ( ( (l_c * l_size_n1 + l_n1) * l_size_m1 + l_m1 ) * l_size_n0 + l_n0 ) * l_size_m0 + l_m0 ] = l_sum;
+          }
+        }
+      }
+    }
+  }
+
+  ContractionBackendSimd l_bin_cont;
+  l_bin_cont.init( l_loop_dim_type,
+                   l_loop_exec_type,
+                   l_loop_sizes,
+                   l_loop_strides_left,
+                   l_loop_strides_right,
+                   l_loop_strides_out_aux,
+                   l_loop_strides_out,
+                   l_packing_strides_left,
+                   l_packing_strides_right,
+                   data_t::FP32,
+                   data_t::FP32,
+                   data_t::FP32,
+                   data_t::FP32,
+                   kernel_t::ZERO,
+                   kernel_t::MADD,
+                   kernel_t::UNDEFINED_KTYPE,
+                   1,
+                   1,
+                   1,
+                   nullptr );
+  l_bin_cont.set_packing_prologue( kernel_t::RELU,
+                                   kernel_t::UNDEFINED_KTYPE,
+                                   last_touch_params() );
+
+  REQUIRE( l_bin_cont.compile() == err_t::SUCCESS );
+
+  std::vector< float > l_out( l_out_ref.size(), 1.0f );
+  l_bin_cont.contract( l_left.data(),
+                       l_right.data(),
+                       nullptr,
+                       l_out.data() );
+
+  for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+    REQUIRE( l_out[l_en] == Approx( l_out_ref[l_en] ) );
+  }
+}
+
+TEST_CASE( "Unsupported configurations of the SIMD contraction backend.", "[contraction_backend_simd]" ) {
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::M, dim_t::N, dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::PRIM, exec_t::PRIM, exec_t::PRIM };
+  std::vector< int64_t > l_loop_sizes            = { 8, 4, 2 };
+  std::vector< int64_t > l_loop_strides_left     = { 1, 0, 8 };
+  std::vector< int64_t > l_loop_strides_right    = { 0, 2, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = { 0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 1, 8, 0 };
+  std::vector< int64_t > l_packing_strides       = {};
+
+  // mixed data types
+  ContractionBackendSimd l_bin_cont_dtype;
+  l_bin_cont_dtype.init( l_loop_dim_type,
+                         l_loop_exec_type,
+                         l_loop_sizes,
+                         l_loop_strides_left,
+                         l_loop_strides_right,
+                         l_loop_strides_out_aux,
+                         l_loop_strides_out,
+                         l_packing_strides,
+                         l_packing_strides,
+                         data_t::FP32,
+                         data_t::FP64,
+                         data_t::FP64,
+                         data_t::FP64,
+                         kernel_t::ZERO,
+                         kernel_t::MADD,
+                         kernel_t::UNDEFINED_KTYPE,
+                         1,
+                         1,
+                         1,
+                         nullptr );
+  REQUIRE( l_bin_cont_dtype.compile() == err_t::COMPILATION_FAILED );
+
+  // unsupported last-touch kernel
+  ContractionBackendSimd l_bin_cont_ktype;
+  l_bin_cont_ktype.init( l_loop_dim_type,
+                         l_loop_exec_type,
+                         l_loop_sizes,
+                         l_loop_strides_left,
+                         l_loop_strides_right,
+                         l_loop_strides_out_aux,
+                         l_loop_strides_out,
+                         l_packing_strides,
+                         l_packing_strides,
+                         data_t::FP32,
+                         data_t::FP32,
+                         data_t::FP32,
+                         data_t::FP32,
+                         kernel_t::ZERO,
+                         kernel_t::MADD,
+                         kernel_t::GELU,
+                         1,
+                         1,
+                         1,
+                         nullptr );
+  REQUIRE( l_bin_cont_ktype.compile() == err_t::COMPILATION_FAILED );
+}
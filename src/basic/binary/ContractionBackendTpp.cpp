@@ -1,4 +1,11 @@
 #include "ContractionBackendTpp.h"
+#include "../unary/UnaryBackendTpp.h"
+#include <algorithm>
+
+namespace {
+  //! thread-local scratch buffer of the SiLU last touch
+  thread_local std::vector< char > g_last_touch_scratch;
+}
 
 libxsmm_datatype einsum_ir::basic::ContractionBackendTpp::dtype_to_libxsmm( data_t i_dtype ) {
   if( i_dtype == FP32 ) {
@@ -7,13 +14,25 @@ libxsmm_datatype einsum_ir::basic::ContractionBackendTpp::dtype_to_libxsmm( data
   else if( i_dtype == FP64 ) {
     return libxsmm_datatype::LIBXSMM_DATATYPE_F64;
   }
+  else if( i_dtype == BF16 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_BF16;
+  }
+  else if( i_dtype == FP16 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_F16;
+  }
+  else if( i_dtype == I8 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_I8;
+  }
+  else if( i_dtype == I32 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_I32;
+  }
 
   return libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED;
 }
 
 
-void einsum_ir::basic::ContractionBackendTpp::kernel_first_touch( void const * i_out_aux,
-                                                                  void       * io_out ){
+void einsum_ir::basic::ContractionBackendTpp::kernel_first_touch_part( void const * i_out_aux,
+                                                                       void       * io_out ){
 
   if( m_xmm_kernel_first_touch_unary != nullptr ) {
     libxsmm_meltw_unary_param l_param;
@@ -30,28 +49,81 @@ void einsum_ir::basic::ContractionBackendTpp::kernel_first_touch( void const * i
   }
 }
 
+void einsum_ir::basic::ContractionBackendTpp::kernel_first_touch( void const * i_out_aux,
+                                                                  void       * io_out ){
+  kernel_first_touch_part( i_out_aux,
+                           io_out );
+  if( m_cpx ) {
+    kernel_first_touch_part( (char const *) i_out_aux + m_cpx_stride_out_aux_bytes,
+                             (char       *) io_out    + m_cpx_stride_out_bytes );
+  }
+}
 
-void einsum_ir::basic::ContractionBackendTpp::kernel_last_touch( void const * i_out_aux,
-                                                                 void       * io_out ){
+
+void einsum_ir::basic::ContractionBackendTpp::kernel_last_touch_part( void const * i_out_aux,
+                                                                      void       * io_out ){
+  // auxiliary output, e.g., the bias of ADD_RELU
+  if( m_xmm_kernel_last_touch_binary != nullptr ) {
+    libxsmm_meltw_binary_param l_param;
+    l_param.in0.primary = (void *) io_out;
+    l_param.in1.primary = (void *) i_out_aux;
+    l_param.out.primary =          io_out;
+    m_xmm_kernel_last_touch_binary( &l_param );
+  }
+
+  // activation in place
   if( m_xmm_kernel_last_touch_unary != nullptr ) {
     libxsmm_meltw_unary_param l_param;
     l_param.in.primary = io_out;
     l_param.out.primary = io_out;
     m_xmm_kernel_last_touch_unary( &l_param );
   }
-  else if( m_xmm_kernel_last_touch_binary != nullptr ) {
-    libxsmm_meltw_binary_param l_param;
-    l_param.in0.primary = (void *) io_out;
-    l_param.in1.primary = (void *) i_out_aux;
-    l_param.out.primary =          io_out;
-    m_xmm_kernel_last_touch_binary( &l_param );
+
+  // SiLU: out = out * sigmoid( out )
+  if( m_xmm_kernel_last_touch_sigmoid != nullptr ) {
+    if( (int64_t) g_last_touch_scratch.size() < m_size_last_touch_scratch ) {
+      g_last_touch_scratch.resize( m_size_last_touch_scratch );
+    }
+
+    libxsmm_meltw_unary_param l_param_sigmoid;
+    l_param_sigmoid.in.primary  = io_out;
+    l_param_sigmoid.out.primary = g_last_touch_scratch.data();
+    m_xmm_kernel_last_touch_sigmoid( &l_param_sigmoid );
+
+    libxsmm_meltw_binary_param l_param_mul;
+    l_param_mul.in0.primary = io_out;
+    l_param_mul.in1.primary = g_last_touch_scratch.data();
+    l_param_mul.out.primary = io_out;
+    m_xmm_kernel_last_touch_mul( &l_param_mul );
+  }
+
+  // scalar operations of SCALE_SHIFT and CLAMP
+  int64_t l_n_bytes_scalar = m_last_touch_scalars.size() / 2;
+  for( int64_t l_sc = 0; l_sc < 2; l_sc++ ) {
+    if( m_xmm_kernel_last_touch_scalar[l_sc] != nullptr ) {
+      libxsmm_meltw_binary_param l_param;
+      l_param.in0.primary = io_out;
+      l_param.in1.primary = m_last_touch_scalars.data() + l_sc * l_n_bytes_scalar;
+      l_param.out.primary = io_out;
+      m_xmm_kernel_last_touch_scalar[l_sc]( &l_param );
+    }
   }
 }
 
+void einsum_ir::basic::ContractionBackendTpp::kernel_last_touch( void const * i_out_aux,
+                                                                 void       * io_out ){
+  kernel_last_touch_part( i_out_aux,
+                          io_out );
+  if( m_cpx ) {
+    kernel_last_touch_part( (char const *) i_out_aux + m_cpx_stride_out_aux_bytes,
+                            (char       *) io_out    + m_cpx_stride_out_bytes );
+  }
+}
 
-void einsum_ir::basic::ContractionBackendTpp::kernel_main( void const * i_left,
-                                                           void const * i_right,
-                                                           void       * io_out ){
+
+void einsum_ir::basic::ContractionBackendTpp::kernel_main_part( void const * i_left,
+                                                                void const * i_right,
+                                                                void       * io_out ){
   libxsmm_gemm_param l_param;
   l_param.a.primary = (void *) i_left;
   l_param.b.primary = (void *) i_right;
@@ -61,22 +133,103 @@ void einsum_ir::basic::ContractionBackendTpp::kernel_main( void const * i_left,
   m_xmm_kernel_main( &l_param );
 }
 
+void einsum_ir::basic::ContractionBackendTpp::kernel_main( void const * i_left,
+                                                           void const * i_right,
+                                                           void       * io_out ){
+  if( !m_cpx ) {
+    kernel_main_part( i_left,
+                      i_right,
+                      io_out );
+    return;
+  }
+
+  char const * l_left_real  = (char const *) i_left;
+  char const * l_left_imag  = l_left_real  + m_cpx_stride_in_left_bytes;
+  char const * l_right_real = (char const *) i_right;
+  char const * l_right_imag = l_right_real + m_cpx_stride_in_right_bytes;
+  char       * l_out_real   = (char       *) io_out;
+  char       * l_out_imag   = l_out_real   + m_cpx_stride_out_bytes;
+
+  // real -= imag * imag, the GEMMs only accumulate, i.e., the real part is negated before and after
+  libxsmm_meltw_unary_param l_param_negate;
+  l_param_negate.in.primary  = l_out_real;
+  l_param_negate.out.primary = l_out_real;
+
+  m_xmm_kernel_negate( &l_param_negate );
+  kernel_main_part( l_left_imag,
+                    l_right_imag,
+                    l_out_real );
+  m_xmm_kernel_negate( &l_param_negate );
+
+  // real += real * real
+  kernel_main_part( l_left_real,
+                    l_right_real,
+                    l_out_real );
+  // imag += real * imag
+  kernel_main_part( l_left_real,
+                    l_right_imag,
+                    l_out_imag );
+  // imag += imag * real
+  kernel_main_part( l_left_imag,
+                    l_right_real,
+                    l_out_imag );
+}
+
+
+std::unique_ptr< einsum_ir::basic::UnaryBackend > einsum_ir::basic::ContractionBackendTpp::create_unary_packing(){
+  return std::make_unique< UnaryBackendTpp >();
+}
 
 einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels(){
 
   // libxsmm data types
   libxsmm_datatype l_xmm_dtype_left  = dtype_to_libxsmm( m_dtype_left  );
   libxsmm_datatype l_xmm_dtype_right = dtype_to_libxsmm( m_dtype_right );
-  libxsmm_datatype l_xmm_dtype_out   = dtype_to_libxsmm( m_dtype_out   );
+  libxsmm_datatype l_xmm_dtype_out   = dtype_to_libxsmm( m_dtype_acc   );
+  libxsmm_datatype l_xmm_dtype_aux   = dtype_to_libxsmm( m_dtype_out   );
   libxsmm_datatype l_xmm_dtype_comp  = dtype_to_libxsmm( m_dtype_comp );
 
   if(    l_xmm_dtype_left  == libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED
       || l_xmm_dtype_right == libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED
       || l_xmm_dtype_comp  == libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED
-      || l_xmm_dtype_out   == libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED ) {
+      || l_xmm_dtype_out   == libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED
+      || l_xmm_dtype_aux   == libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED ) {
     return err_t::COMPILATION_FAILED;
   }
 
+  // complex contractions apply real TPPs to the real and imaginary parts
+  m_cpx = m_ktype_main == kernel_t::CPX_MADD;
+  kernel_t l_ktype_first_touch = m_ktype_first_touch;
+  kernel_t l_ktype_last_touch  = m_ktype_last_touch;
+  if( m_cpx ) {
+    if(    m_dtype_left  != m_dtype_comp
+        || m_dtype_right != m_dtype_comp
+        || m_dtype_out   != m_dtype_comp
+        || ( m_dtype_comp != FP32 && m_dtype_comp != FP64 ) ) {
+      return err_t::COMPILATION_FAILED;
+    }
+
+    if( m_ktype_first_touch == kernel_t::CPX_ZERO ) {
+      l_ktype_first_touch = kernel_t::ZERO;
+    }
+    else if( m_ktype_first_touch == kernel_t::CPX_COPY ) {
+      l_ktype_first_touch = kernel_t::COPY;
+    }
+    else if( m_ktype_first_touch == kernel_t::CPX_ADD ) {
+      l_ktype_first_touch = kernel_t::ADD;
+    }
+    else if( m_ktype_first_touch != kernel_t::UNDEFINED_KTYPE ) {
+      return err_t::COMPILATION_FAILED;
+    }
+
+    if( m_ktype_last_touch == kernel_t::CPX_ADD ) {
+      l_ktype_last_touch = kernel_t::ADD;
+    }
+    else if( m_ktype_last_touch != kernel_t::UNDEFINED_KTYPE ) {
+      return err_t::COMPILATION_FAILED;
+    }
+  }
+
   // setup bcast 
   libxsmm_bitfield l_flag_out_aux_unary  = LIBXSMM_MELTW_FLAG_UNARY_NONE;
   libxsmm_bitfield l_flag_out_aux_binary = LIBXSMM_MELTW_FLAG_BINARY_NONE;
@@ -107,15 +260,16 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                                                                      m_ldc,
                                                                                      l_xmm_dtype_out,
                                                                                      l_xmm_dtype_out,
-                                                                                     l_xmm_dtype_out );
+                                                                                     l_xmm_dtype_comp );
   
+  // the auxiliary output has the output's datatype, which differs from the accumulators' one if kept in a separate buffer
   libxsmm_meltw_unary_shape l_shape_single_touch_aux_unary = libxsmm_create_meltw_unary_shape( m_m * m_r,
                                                                                                m_n,
                                                                                                m_stride_n_out_aux,
                                                                                                m_ldc,
+                                                                                               l_xmm_dtype_aux,
                                                                                                l_xmm_dtype_out,
-                                                                                               l_xmm_dtype_out,
-                                                                                               l_xmm_dtype_out );
+                                                                                               l_xmm_dtype_comp );
 
   libxsmm_meltw_binary_shape l_shape_single_touch_aux_binary = libxsmm_create_meltw_binary_shape( m_m * m_r,
                                                                                                   m_n,
@@ -123,43 +277,180 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                                                                                   m_stride_n_out_aux,
                                                                                                   m_ldc,
                                                                                                   l_xmm_dtype_out,
+                                                                                                  l_xmm_dtype_aux,
                                                                                                   l_xmm_dtype_out,
-                                                                                                  l_xmm_dtype_out,
-                                                                                                  l_xmm_dtype_out );
+                                                                                                  l_xmm_dtype_comp );
 
   //first touch kernel
-  if( m_ktype_first_touch == kernel_t::ZERO ) {
+  if( l_ktype_first_touch == kernel_t::ZERO ) {
     m_xmm_kernel_first_touch_unary = libxsmm_dispatch_meltw_unary( LIBXSMM_MELTW_TYPE_UNARY_XOR,
                                                                    l_shape_single_touch,
                                                                    LIBXSMM_MELTW_FLAG_UNARY_NONE );
   }
-  else if( m_ktype_first_touch == kernel_t::COPY ) {
+  else if( l_ktype_first_touch == kernel_t::COPY ) {
     m_xmm_kernel_first_touch_unary = libxsmm_dispatch_meltw_unary( LIBXSMM_MELTW_TYPE_UNARY_IDENTITY,
                                                                    l_shape_single_touch_aux_unary,
                                                                    l_flag_out_aux_unary );
   }
-  else if( m_ktype_first_touch == kernel_t::ADD ) {
+  else if( l_ktype_first_touch == kernel_t::ADD ) {
     m_xmm_kernel_first_touch_binary = libxsmm_dispatch_meltw_binary( LIBXSMM_MELTW_TYPE_BINARY_ADD,
                                                                      l_shape_single_touch_aux_binary,
                                                                      l_flag_out_aux_binary );
   }
-  else if( m_ktype_first_touch != kernel_t::UNDEFINED_KTYPE ) {
+  else if( l_ktype_first_touch != kernel_t::UNDEFINED_KTYPE ) {
     return err_t::COMPILATION_FAILED;
   }
 
-  // last touch kernel
-  if( m_ktype_last_touch == kernel_t::RELU ) {
-    m_xmm_kernel_last_touch_unary = libxsmm_dispatch_meltw_unary( LIBXSMM_MELTW_TYPE_UNARY_RELU,
-                                                                  l_shape_single_touch,
-                                                                  LIBXSMM_MELTW_FLAG_UNARY_NONE );
+  // last touch kernel: optional addition of the auxiliary output followed by an optional activation
+  bool l_last_touch_add = false;
+  libxsmm_meltw_unary_type l_last_touch_act = LIBXSMM_MELTW_TYPE_UNARY_NONE;
+  bool l_last_touch_silu = false;
+
+  if( l_ktype_last_touch == kernel_t::ADD ) {
+    l_last_touch_add = true;
+  }
+  else if( l_ktype_last_touch == kernel_t::RELU ) {
+    l_last_touch_act = LIBXSMM_MELTW_TYPE_UNARY_RELU;
+  }
+  else if( l_ktype_last_touch == kernel_t::GELU ) {
+    l_last_touch_act = LIBXSMM_MELTW_TYPE_UNARY_GELU;
   }
-  else if( m_ktype_last_touch == kernel_t::ADD ) {
+  else if( l_ktype_last_touch == kernel_t::SIGMOID ) {
+    l_last_touch_act = LIBXSMM_MELTW_TYPE_UNARY_SIGMOID;
+  }
+  else if( l_ktype_last_touch == kernel_t::TANH ) {
+    l_last_touch_act = LIBXSMM_MELTW_TYPE_UNARY_TANH;
+  }
+  else if( l_ktype_last_touch == kernel_t::SILU ) {
+    l_last_touch_silu = true;
+  }
+  else if( l_ktype_last_touch == kernel_t::ADD_RELU ) {
+    l_last_touch_add = true;
+    l_last_touch_act = LIBXSMM_MELTW_TYPE_UNARY_RELU;
+  }
+  else if( l_ktype_last_touch == kernel_t::ADD_GELU ) {
+    l_last_touch_add = true;
+    l_last_touch_act = LIBXSMM_MELTW_TYPE_UNARY_GELU;
+  }
+  else if( l_ktype_last_touch == kernel_t::ADD_SILU ) {
+    l_last_touch_add = true;
+    l_last_touch_silu = true;
+  }
+  else if(    l_ktype_last_touch != kernel_t::SCALE_SHIFT
+           && l_ktype_last_touch != kernel_t::CLAMP
+           && l_ktype_last_touch != kernel_t::UNDEFINED_KTYPE ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  if( l_last_touch_add ) {
     m_xmm_kernel_last_touch_binary = libxsmm_dispatch_meltw_binary( LIBXSMM_MELTW_TYPE_BINARY_ADD,
                                                                     l_shape_single_touch_aux_binary,
                                                                     l_flag_out_aux_binary );
+    if( m_xmm_kernel_last_touch_binary == nullptr ) {
+      return err_t::COMPILATION_FAILED;
+    }
   }
-  else if( m_ktype_last_touch != kernel_t::UNDEFINED_KTYPE ) {
-    return err_t::COMPILATION_FAILED;
+
+  if( l_last_touch_act != LIBXSMM_MELTW_TYPE_UNARY_NONE ) {
+    m_xmm_kernel_last_touch_unary = libxsmm_dispatch_meltw_unary( l_last_touch_act,
+                                                                  l_shape_single_touch,
+                                                                  LIBXSMM_MELTW_FLAG_UNARY_NONE );
+    if( m_xmm_kernel_last_touch_unary == nullptr ) {
+      return err_t::COMPILATION_FAILED;
+    }
+  }
+
+  if( l_last_touch_silu ) {
+    // the sigmoid is written densely to the scratch buffer
+    libxsmm_meltw_unary_shape l_shape_sigmoid = libxsmm_create_meltw_unary_shape( m_m * m_r,
+                                                                                  m_n,
+                                                                                  m_ldc,
+                                                                                  m_m * m_r,
+                                                                                  l_xmm_dtype_out,
+                                                                                  l_xmm_dtype_out,
+                                                                                  l_xmm_dtype_comp );
+    libxsmm_meltw_binary_shape l_shape_mul = libxsmm_create_meltw_binary_shape( m_m * m_r,
+                                                                                m_n,
+                                                                                m_ldc,
+                                                                                m_m * m_r,
+                                                                                m_ldc,
+                                                                                l_xmm_dtype_out,
+                                                                                l_xmm_dtype_out,
+                                                                                l_xmm_dtype_out,
+                                                                                l_xmm_dtype_comp );
+
+    m_xmm_kernel_last_touch_sigmoid = libxsmm_dispatch_meltw_unary( LIBXSMM_MELTW_TYPE_UNARY_SIGMOID,
+                                                                    l_shape_sigmoid,
+                                                                    LIBXSMM_MELTW_FLAG_UNARY_NONE );
+    m_xmm_kernel_last_touch_mul = libxsmm_dispatch_meltw_binary( LIBXSMM_MELTW_TYPE_BINARY_MUL,
+                                                                 l_shape_mul,
+                                                                 LIBXSMM_MELTW_FLAG_BINARY_NONE );
+    if(    m_xmm_kernel_last_touch_sigmoid == nullptr
+        || m_xmm_kernel_last_touch_mul     == nullptr ) {
+      return err_t::COMPILATION_FAILED;
+    }
+
+    m_size_last_touch_scratch = m_m * m_r * m_n * ce_n_bytes( m_dtype_acc );
+  }
+
+  if(    l_ktype_last_touch == kernel_t::SCALE_SHIFT
+      || l_ktype_last_touch == kernel_t::CLAMP ) {
+    libxsmm_meltw_binary_type l_types_scalar[2];
+    double l_scalars[2];
+    if( l_ktype_last_touch == kernel_t::SCALE_SHIFT ) {
+      l_types_scalar[0] = LIBXSMM_MELTW_TYPE_BINARY_MUL;
+      l_types_scalar[1] = LIBXSMM_MELTW_TYPE_BINARY_ADD;
+      l_scalars[0] = m_last_touch_params.scale;
+      l_scalars[1] = m_last_touch_params.shift;
+    }
+    else {
+      l_types_scalar[0] = LIBXSMM_MELTW_TYPE_BINARY_MAX;
+      l_types_scalar[1] = LIBXSMM_MELTW_TYPE_BINARY_MIN;
+      l_scalars[0] = m_last_touch_params.clamp_min;
+      l_scalars[1] = m_last_touch_params.clamp_max;
+    }
+
+    // scalars are stored in the output's datatype
+    m_last_touch_scalars.resize( 2 * ce_n_bytes( m_dtype_acc ) );
+    for( int64_t l_sc = 0; l_sc < 2; l_sc++ ) {
+      if( m_dtype_acc == FP32 ) {
+        ( (float *) m_last_touch_scalars.data() )[l_sc] = (float) l_scalars[l_sc];
+      }
+      else if( m_dtype_acc == FP64 ) {
+        ( (double *) m_last_touch_scalars.data() )[l_sc] = l_scalars[l_sc];
+      }
+      else {
+        return err_t::COMPILATION_FAILED;
+      }
+    }
+
+    libxsmm_meltw_binary_shape l_shape_scalar = libxsmm_create_meltw_binary_shape( m_m * m_r,
+                                                                                   m_n,
+                                                                                   m_ldc,
+                                                                                   1,
+                                                                                   m_ldc,
+                                                                                   l_xmm_dtype_out,
+                                                                                   l_xmm_dtype_out,
+                                                                                   l_xmm_dtype_out,
+                                                                                   l_xmm_dtype_comp );
+    for( int64_t l_sc = 0; l_sc < 2; l_sc++ ) {
+      m_xmm_kernel_last_touch_scalar[l_sc] = libxsmm_dispatch_meltw_binary( l_types_scalar[l_sc],
+                                                                            l_shape_scalar,
+                                                                            LIBXSMM_MELTW_FLAG_BINARY_BCAST_SCALAR_IN_1 );
+      if( m_xmm_kernel_last_touch_scalar[l_sc] == nullptr ) {
+        return err_t::COMPILATION_FAILED;
+      }
+    }
+  }
+
+  // negation of the real part of complex outputs
+  if( m_cpx ) {
+    m_xmm_kernel_negate = libxsmm_dispatch_meltw_unary( LIBXSMM_MELTW_TYPE_UNARY_NEGATE,
+                                                        l_shape_single_touch,
+                                                        LIBXSMM_MELTW_FLAG_UNARY_NONE );
+    if( m_xmm_kernel_negate == nullptr ) {
+      return err_t::COMPILATION_FAILED;
+    }
   }
 
 
@@ -173,6 +464,58 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
   m_ldb /= m_r; 
   m_ldc /= m_r;
 
+  //BF16 and INT8 GEMMs expect the left operand in the VNNI format, i.e., 2 or 4 consecutive k values are interleaved.
+  //the left operand is transformed once while packing, unpacked operands are packed densely in front of the kernel.
+  //odd k, transposed and block-sparse left operands are used in the flat format
+  int64_t l_vnni = 1;
+  if( m_dtype_left == BF16 ) {
+    l_vnni = 2;
+  }
+  else if( m_dtype_left == I8 ) {
+    l_vnni = 4;
+  }
+
+  if(    l_vnni > 1
+      && !m_trans_a
+      && m_k % l_vnni == 0
+      && m_sparsity_left.mask == nullptr
+      && (    m_ktype_main == kernel_t::MADD
+           || m_ktype_main == kernel_t::BR_MADD ) ){
+    int64_t l_id_br = m_dim_sizes.size() - 4;
+    int64_t l_id_m  = m_dim_sizes.size() - 3;
+    int64_t l_id_k  = m_dim_sizes.size() - 1;
+
+    bool l_packed = std::any_of( m_packing_strides_left.begin(),
+                                 m_packing_strides_left.end(),
+                                 []( int64_t i_stride ){ return i_stride != 0; } );
+    if( !l_packed ) {
+      m_packing_strides_left[l_id_m] = 1;
+      m_packing_strides_left[l_id_k] = m_strides_left[l_id_k];
+      m_strides_left[l_id_m] = 1;
+      m_strides_left[l_id_k] = m_m;
+      m_lda = m_m;
+      if( m_ktype_main == kernel_t::BR_MADD ) {
+        m_packing_strides_left[l_id_br] = m_strides_left[l_id_br];
+        m_strides_left[l_id_br] = m_m * m_k;
+        m_br_stride_a = m_m * m_k;
+      }
+    }
+
+    if(    m_packing_strides_left[l_id_m] != 0
+        && m_packing_strides_left[l_id_k] != 0
+        && ( m_m == 1 || m_strides_left[l_id_m] == 1 )
+        && m_lda >= m_m ) {
+      m_vnni_left     = l_vnni;
+      l_flags_brgemm |= LIBXSMM_GEMM_FLAG_VNNI_A;
+    }
+  }
+
+  //set br stride in bytes
+  if( m_ktype_main == kernel_t::BR_MADD ){
+    m_br_stride_a *= ce_n_bytes(m_dtype_left);
+    m_br_stride_b *= ce_n_bytes(m_dtype_right);
+  }
+
   //create main kernel shape
   libxsmm_gemm_shape l_shape_brgemm;
   l_shape_brgemm = libxsmm_create_gemm_shape( m_m,
@@ -186,12 +529,10 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                               l_xmm_dtype_out,
                                               l_xmm_dtype_comp );
 
-  //set br type and scale br strides
+  //set br type
   libxsmm_gemm_batch_reduce_type l_br_type = LIBXSMM_GEMM_BATCH_REDUCE_NONE;
   if( m_ktype_main == kernel_t::BR_MADD ){
     l_br_type = LIBXSMM_GEMM_BATCH_REDUCE_STRIDE;
-    m_br_stride_a *= ce_n_bytes(m_dtype_left);
-    m_br_stride_b *= ce_n_bytes(m_dtype_right);
   }
 
   //set br config
@@ -204,7 +545,8 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
 
   //create main kernel
   if( m_ktype_main == kernel_t::BR_MADD ||
-      m_ktype_main == kernel_t::MADD       ){
+      m_ktype_main == kernel_t::MADD    ||
+      m_ktype_main == kernel_t::CPX_MADD   ){
     m_xmm_kernel_main = libxsmm_dispatch_brgemm( l_shape_brgemm,
                                                  l_flags_brgemm,
                                                  l_prefetch_flags_brgemm,
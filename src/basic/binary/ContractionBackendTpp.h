@@ -2,6 +2,7 @@
 #define EINSUM_IR_BASIC_BINARY_CONTRACTION_BACKEND_TPP
 
 #include <libxsmm.h>
+#include <vector>
 #include "ContractionBackend.h"
 
 namespace einsum_ir {
@@ -28,14 +29,71 @@ class einsum_ir::basic::ContractionBackendTpp: public ContractionBackend {
     //! LIBXSMM-based binary last-touch TPP
     libxsmm_meltwfunction_binary m_xmm_kernel_last_touch_binary = nullptr;
 
+    //! LIBXSMM-based TPP which writes the sigmoid of the output to a scratch buffer (SiLU last touch)
+    libxsmm_meltwfunction_unary m_xmm_kernel_last_touch_sigmoid = nullptr;
+
+    //! LIBXSMM-based TPP which multiplies the output by the scratch buffer (SiLU last touch)
+    libxsmm_meltwfunction_binary m_xmm_kernel_last_touch_mul = nullptr;
+
+    //! LIBXSMM-based TPPs which combine the output with the scalars of the SCALE_SHIFT and CLAMP last touches
+    libxsmm_meltwfunction_binary m_xmm_kernel_last_touch_scalar[2] = { nullptr, nullptr };
+
+    //! scalars of the SCALE_SHIFT and CLAMP last touches in the output's datatype
+    std::vector< char > m_last_touch_scalars;
+
+    //! size of the scratch buffer of the SiLU last touch in bytes
+    int64_t m_size_last_touch_scratch = 0;
+
+    //! LIBXSMM-based TPP which negates the real part of complex outputs in place
+    libxsmm_meltwfunction_unary m_xmm_kernel_negate = nullptr;
+
+    //! true if the main TPP is a complex matmul, i.e., every kernel touches the real and imaginary parts
+    bool m_cpx = false;
+
     /**
      * converts internal datatypes to libxsmm datatypes
      *
      * @return libxsmm datatype.
      **/
     libxsmm_datatype dtype_to_libxsmm( data_t i_dtype );
-    
+
+    /**
+     * Applies the first-touch TPP to a single real matrix.
+     *
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    void kernel_first_touch_part( void const * i_out_aux,
+                                  void       * io_out );
+
+    /**
+     * Applies the last-touch TPP to a single real matrix.
+     *
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    void kernel_last_touch_part( void const * i_out_aux,
+                                 void       * io_out );
+
+    /**
+     * Applies the (batch-reduce) GEMM TPP to a single real matrix.
+     *
+     * @param i_left pointer to a data section of the left tensor.
+     * @param i_right pointer to a data section of the right tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    void kernel_main_part( void const * i_left,
+                           void const * i_right,
+                           void       * io_out );
+
   public:
+    /**
+     * Creates the TPP-based unary backend which packs an input tensor, the left one possibly in VNNI format.
+     *
+     * @return unary packing backend.
+     **/
+    std::unique_ptr< UnaryBackend > create_unary_packing();
+
     /**
      * Kernel applied to the output tensor before the main primitive touches the memory.
      *
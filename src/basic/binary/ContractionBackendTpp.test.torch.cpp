@@ -749,4 +749,541 @@ TEST_CASE( "Tensor contraction with packing of both tensors and SFC parallelisat
                           { l_left, l_right } );
 
   REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
-}
\ No newline at end of file
+}
+TEST_CASE( "BF16 batch-reduce matmul with FP32 accumulation.", "[contraction_backend]" ) {
+  //example: [k2,k1,m1],[n1,k2,k1]->[n1,m1]
+  //sizes:   [ 3,16,20],[47, 3,16]->[47,20]
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                  k2,m1,n1,k1
+  std::vector< int64_t > l_loop_sizes            = {   3,20,47,16 };
+  std::vector< int64_t > l_loop_strides_left     = { 320, 1, 0,20 };
+  std::vector< int64_t > l_loop_strides_right    = {  16, 0,48, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {   0, 0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = {   0, 1,20, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_left    = at::randn( { 3,16,20 } ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_right   = at::randn( { 47,3,16 } ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_out     = at::randn( { 47,20   } ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_out_ref = l_out.to( at::ScalarType::Float );
+
+  ContractionBackendTpp l_cont;
+
+  l_cont.init( l_loop_dim_type,
+               l_loop_exec_type,
+               l_loop_sizes,
+               l_loop_strides_left,
+               l_loop_strides_right,
+               l_loop_strides_out_aux,
+               l_loop_strides_out,
+               l_packing_strides_left,
+               l_packing_strides_right,
+               data_t::BF16,
+               data_t::BF16,
+               data_t::FP32,
+               data_t::BF16,
+               kernel_t::UNDEFINED_KTYPE,
+               kernel_t::BR_MADD,
+               kernel_t::UNDEFINED_KTYPE,
+               1,
+               1,
+               1,
+               nullptr );
+
+  err_t l_err = l_cont.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_cont.contract( l_left.data_ptr(),
+                   l_right.data_ptr(),
+                   nullptr,
+                   l_out.data_ptr() );
+
+  l_out_ref += at::einsum( "yxb,ayx->ab",
+                           { l_left.to( at::ScalarType::Float ),
+                             l_right.to( at::ScalarType::Float ) } );
+  REQUIRE( at::allclose( l_out.to( at::ScalarType::Float ), l_out_ref, 1E-2, 5E-2 ) );
+}
+
+TEST_CASE( "BF16 matmul with odd K, zero first touch and ReLU last touch.", "[contraction_backend]" ) {
+  //example: [c1,k1,m1],[c1,n1,k1]->[c1,n1,m1]
+  //sizes:   [17,13,20],[17,47,13]->[17,47,20]
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::C,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                  c1,m1,n1,k1
+  std::vector< int64_t > l_loop_sizes            = {  17,20,47,13 };
+  std::vector< int64_t > l_loop_strides_left     = { 260, 1, 0,20 };
+  std::vector< int64_t > l_loop_strides_right    = { 611, 0,13, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {   0, 0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 940, 1,20, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_left  = at::randn( { 17,13,20 } ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_right = at::randn( { 17,47,13 } ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_out   = at::randn( { 17,47,20 } ).to( at::ScalarType::BFloat16 );
+
+  ContractionBackendTpp l_cont;
+
+  l_cont.init( l_loop_dim_type,
+               l_loop_exec_type,
+               l_loop_sizes,
+               l_loop_strides_left,
+               l_loop_strides_right,
+               l_loop_strides_out_aux,
+               l_loop_strides_out,
+               l_packing_strides_left,
+               l_packing_strides_right,
+               data_t::BF16,
+               data_t::BF16,
+               data_t::FP32,
+               data_t::BF16,
+               kernel_t::ZERO,
+               kernel_t::MADD,
+               kernel_t::RELU,
+               2,
+               2,
+               2,
+               nullptr );
+
+  err_t l_err = l_cont.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_cont.contract( l_left.data_ptr(),
+                   l_right.data_ptr(),
+                   nullptr,
+                   l_out.data_ptr() );
+
+  at::Tensor l_out_ref = at::einsum( "xcb,xac->xab",
+                                     { l_left.to( at::ScalarType::Float ),
+                                       l_right.to( at::ScalarType::Float ) } );
+  l_out_ref = at::relu( l_out_ref );
+  REQUIRE( at::allclose( l_out.to( at::ScalarType::Float ), l_out_ref, 1E-2, 5E-2 ) );
+}
+
+TEST_CASE( "BF16 matmul with FP32 accumulation across sequential K loops.", "[contraction_backend]" ) {
+  //example: [k2,k1,m1],[n1,k2,k1]->[n1,m1]
+  //sizes:   [64,32,32],[16,64,32]->[16,32]
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                    k2,m1,  n1,k1
+  std::vector< int64_t > l_loop_sizes            = {   64,32,  16,32 };
+  std::vector< int64_t > l_loop_strides_left     = { 1024, 1,   0,32 };
+  std::vector< int64_t > l_loop_strides_right    = {   32, 0,2048, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {    0, 0,   0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = {    0, 1,  32, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_left    = at::randn( { 64,32,32 } ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_right   = at::randn( { 16,64,32 } ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_out     = at::randn( { 16,32    } ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_out_ref = l_out.to( at::ScalarType::Float );
+
+  ContractionBackendTpp l_cont;
+
+  l_cont.init( l_loop_dim_type,
+               l_loop_exec_type,
+               l_loop_sizes,
+               l_loop_strides_left,
+               l_loop_strides_right,
+               l_loop_strides_out_aux,
+               l_loop_strides_out,
+               l_packing_strides_left,
+               l_packing_strides_right,
+               data_t::BF16,
+               data_t::BF16,
+               data_t::FP32,
+               data_t::BF16,
+               kernel_t::UNDEFINED_KTYPE,
+               kernel_t::MADD,
+               kernel_t::UNDEFINED_KTYPE,
+               1,
+               1,
+               1,
+               nullptr );
+
+  err_t l_err = l_cont.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_cont.contract( l_left.data_ptr(),
+                   l_right.data_ptr(),
+                   nullptr,
+                   l_out.data_ptr() );
+
+  // the output is rounded to BF16 once after all 64 K blocks
+  l_out_ref += at::einsum( "yxb,ayx->ab",
+                           { l_left.to( at::ScalarType::Float ),
+                             l_right.to( at::ScalarType::Float ) } );
+  REQUIRE( at::allclose( l_out.to( at::ScalarType::Float ), l_out_ref, 1E-2, 5E-2 ) );
+}
+
+TEST_CASE( "FP16 matmul with FP32 and FP16 accumulation.", "[contraction_backend]" ) {
+  //example: [k1,m1],[n1,k1]->[n1,m1]
+  //sizes:   [24,32],[17,24]->[17,32]
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                  m1,n1,k1
+  std::vector< int64_t > l_loop_sizes            = {  32,17,24 };
+  std::vector< int64_t > l_loop_strides_left     = {   1, 0,32 };
+  std::vector< int64_t > l_loop_strides_right    = {   0,24, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {   0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = {   1,32, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  data_t l_dtypes_comp[2] = { data_t::FP32,
+                              data_t::FP16 };
+
+  for( int64_t l_dc = 0; l_dc < 2; l_dc++ ) {
+    at::Tensor l_left    = at::randn( { 24,32 } ).to( at::ScalarType::Half );
+    at::Tensor l_right   = at::randn( { 17,24 } ).to( at::ScalarType::Half );
+    at::Tensor l_out     = at::randn( { 17,32 } ).to( at::ScalarType::Half );
+    at::Tensor l_out_ref = l_out.to( at::ScalarType::Float );
+
+    ContractionBackendTpp l_cont;
+
+    l_cont.init( l_loop_dim_type,
+                 l_loop_exec_type,
+                 l_loop_sizes,
+                 l_loop_strides_left,
+                 l_loop_strides_right,
+                 l_loop_strides_out_aux,
+                 l_loop_strides_out,
+                 l_packing_strides_left,
+                 l_packing_strides_right,
+                 data_t::FP16,
+                 data_t::FP16,
+                 l_dtypes_comp[l_dc],
+                 data_t::FP16,
+                 kernel_t::UNDEFINED_KTYPE,
+                 kernel_t::MADD,
+                 kernel_t::UNDEFINED_KTYPE,
+                 1,
+                 1,
+                 1,
+                 nullptr );
+
+    err_t l_err = l_cont.compile();
+    REQUIRE( l_err == err_t::SUCCESS );
+
+    l_cont.contract( l_left.data_ptr(),
+                     l_right.data_ptr(),
+                     nullptr,
+                     l_out.data_ptr() );
+
+    l_out_ref += at::einsum( "kb,ak->ab",
+                             { l_left.to( at::ScalarType::Float ),
+                               l_right.to( at::ScalarType::Float ) } );
+    REQUIRE( at::allclose( l_out.to( at::ScalarType::Float ), l_out_ref, 1E-2, 5E-2 ) );
+  }
+}
+
+TEST_CASE( "INT8 matmul with INT32 accumulation and requantization.", "[contraction_backend]" ) {
+  //example: [k1,m1],[n1,k1]->[n1,m1]
+  //sizes:   [32,24],[17,32]->[17,24]
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                  m1,n1,k1
+  std::vector< int64_t > l_loop_sizes            = {  24,17,32 };
+  std::vector< int64_t > l_loop_strides_left     = {   1, 0,24 };
+  std::vector< int64_t > l_loop_strides_right    = {   0,32, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {   0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = {   1,24, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_left  = at::randint( -128, 128, { 32,24 } ).to( at::ScalarType::Char );
+  at::Tensor l_right = at::randint( -128, 128, { 17,32 } ).to( at::ScalarType::Char );
+
+  // exact reference of the INT32 accumulators
+  at::Tensor l_acc_ref = at::einsum( "kb,ak->ab",
+                                     { l_left.to( at::ScalarType::Double ),
+                                       l_right.to( at::ScalarType::Double ) } );
+
+  // per-channel scales of the n1 dimension
+  at::Tensor l_scales = at::rand( { 17 } ) * 1E-3;
+
+  data_t l_dtypes_out[3] = { data_t::I32,
+                             data_t::I8,
+                             data_t::FP32 };
+
+  for( int64_t l_do = 0; l_do < 3; l_do++ ) {
+    ContractionBackendTpp l_cont;
+
+    l_cont.init( l_loop_dim_type,
+                 l_loop_exec_type,
+                 l_loop_sizes,
+                 l_loop_strides_left,
+                 l_loop_strides_right,
+                 l_loop_strides_out_aux,
+                 l_loop_strides_out,
+                 l_packing_strides_left,
+                 l_packing_strides_right,
+                 data_t::I8,
+                 data_t::I8,
+                 data_t::I32,
+                 l_dtypes_out[l_do],
+                 kernel_t::ZERO,
+                 kernel_t::MADD,
+                 kernel_t::UNDEFINED_KTYPE,
+                 1,
+                 1,
+                 1,
+                 nullptr );
+
+    quant_params l_quant;
+    l_quant.scales = l_scales.data_ptr< float >();
+    if( l_dtypes_out[l_do] == data_t::I8 ) {
+      l_quant.zero_point = 5;
+    }
+    else if( l_dtypes_out[l_do] == data_t::FP32 ) {
+      l_quant.num_scales     = 17;
+      l_quant.stride_channel = 24;
+    }
+    l_cont.set_quant( l_quant );
+
+    err_t l_err = l_cont.compile();
+    REQUIRE( l_err == err_t::SUCCESS );
+
+    if( l_dtypes_out[l_do] == data_t::I32 ) {
+      at::Tensor l_out = at::zeros( { 17,24 }, at::ScalarType::Int );
+      l_cont.contract( l_left.data_ptr(),
+                       l_right.data_ptr(),
+                       nullptr,
+                       l_out.data_ptr() );
+      REQUIRE( at::equal( l_out.to( at::ScalarType::Double ), l_acc_ref ) );
+    }
+    else if( l_dtypes_out[l_do] == data_t::I8 ) {
+      at::Tensor l_out = at::zeros( { 17,24 }, at::ScalarType::Char );
+      l_cont.contract( l_left.data_ptr(),
+                       l_right.data_ptr(),
+                       nullptr,
+                       l_out.data_ptr() );
+
+      at::Tensor l_out_ref = at::clamp( at::round( l_acc_ref.to( at::ScalarType::Float ) * l_scales[0] ) + 5, -128, 127 );
+      REQUIRE( at::allclose( l_out.to( at::ScalarType::Float ), l_out_ref, 0, 1 ) );
+    }
+    else {
+      at::Tensor l_out = at::zeros( { 17,24 } );
+      l_cont.contract( l_left.data_ptr(),
+                       l_right.data_ptr(),
+                       nullptr,
+                       l_out.data_ptr() );
+
+      at::Tensor l_out_ref = l_acc_ref.to( at::ScalarType::Float ) * l_scales.unsqueeze( 1 );
+      REQUIRE( at::allclose( l_out, l_out_ref, 1E-5, 1E-5 ) );
+    }
+  }
+}
+
+TEST_CASE( "Batch-outer complex matmul with complex first touch and last touch.", "[contraction_backend]" ) {
+  //example: [x,k1,m1],[x,n1,k1]->[x,n1,m1], x: real and imaginary part
+  //sizes:   [2,12,20],[2,17,12]->[2,17,20]
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::CPX,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                  x1,m1,n1,k1
+  std::vector< int64_t > l_loop_sizes            = {   2,20,17,12 };
+  std::vector< int64_t > l_loop_strides_left     = { 240, 1, 0,20 };
+  std::vector< int64_t > l_loop_strides_right    = { 204, 0,12, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = { 340, 1,20, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 340, 1,20, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_left    = at::randn( { 2,12,20 } );
+  at::Tensor l_right   = at::randn( { 2,17,12 } );
+  at::Tensor l_out_aux = at::randn( { 2,17,20 } );
+  at::Tensor l_out     = at::randn( { 2,17,20 } );
+
+  ContractionBackendTpp l_cont;
+
+  l_cont.init( l_loop_dim_type,
+               l_loop_exec_type,
+               l_loop_sizes,
+               l_loop_strides_left,
+               l_loop_strides_right,
+               l_loop_strides_out_aux,
+               l_loop_strides_out,
+               l_packing_strides_left,
+               l_packing_strides_right,
+               data_t::FP32,
+               data_t::FP32,
+               data_t::FP32,
+               data_t::FP32,
+               kernel_t::CPX_COPY,
+               kernel_t::CPX_MADD,
+               kernel_t::CPX_ADD,
+               1,
+               1,
+               1,
+               nullptr );
+
+  err_t l_err = l_cont.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_cont.contract( l_left.data_ptr(),
+                   l_right.data_ptr(),
+                   l_out_aux.data_ptr(),
+                   l_out.data_ptr() );
+
+  // reference
+  at::Tensor l_left_cpx    = at::view_as_complex( l_left.permute( { 1, 2, 0 } ).contiguous() );
+  at::Tensor l_right_cpx   = at::view_as_complex( l_right.permute( { 1, 2, 0 } ).contiguous() );
+  at::Tensor l_out_aux_cpx = at::view_as_complex( l_out_aux.permute( { 1, 2, 0 } ).contiguous() );
+
+  at::Tensor l_out_ref = at::einsum( "kb,ak->ab",
+                                     { l_left_cpx,
+                                       l_right_cpx } );
+  l_out_ref += 2 * l_out_aux_cpx;
+
+  at::Tensor l_out_cpx = at::view_as_complex( l_out.permute( { 1, 2, 0 } ).contiguous() );
+  REQUIRE( at::allclose( l_out_cpx, l_out_ref, 1E-4, 1E-5 ) );
+}
+
+TEST_CASE( "FP32 matmul with fused activation and epilogue last touches.", "[contraction_backend]" ) {
+  //example: [c1,k1,m1],[c1,n1,k1]->[c1,n1,m1], bias: [c1,m1]
+  //sizes:   [3,64,20],[3,17,64]->[3,17,20]
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::C,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                  c1,m1,n1,k1
+  std::vector< int64_t > l_loop_sizes            = {   3,20,17,64 };
+  std::vector< int64_t > l_loop_strides_left     = {1280, 1, 0,20 };
+  std::vector< int64_t > l_loop_strides_right    = {1088, 0,64, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {  20, 1, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 340, 1,20, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_left  = at::randn( { 3,64,20 } );
+  at::Tensor l_right = at::randn( { 3,17,64 } );
+  at::Tensor l_bias  = at::randn( { 3,20    } );
+
+  at::Tensor l_out_mm = at::einsum( "xcb,xac->xab",
+                                    { l_left, l_right } );
+  at::Tensor l_out_bias = l_out_mm + l_bias.unsqueeze( 1 );
+
+  last_touch_params l_params;
+  l_params.scale     =  0.5;
+  l_params.shift     = -1.0;
+  l_params.clamp_min = -2.0;
+  l_params.clamp_max =  3.0;
+
+  std::vector< kernel_t > l_ktypes = { kernel_t::GELU,
+                                       kernel_t::SILU,
+                                       kernel_t::SIGMOID,
+                                       kernel_t::TANH,
+                                       kernel_t::CLAMP,
+                                       kernel_t::SCALE_SHIFT,
+                                       kernel_t::ADD_RELU,
+                                       kernel_t::ADD_GELU,
+                                       kernel_t::ADD_SILU };
+
+  std::vector< at::Tensor > l_outs_ref = { at::gelu( l_out_mm ),
+                                           at::silu( l_out_mm ),
+                                           at::sigmoid( l_out_mm ),
+                                           at::tanh( l_out_mm ),
+                                           at::clamp( l_out_mm, -2.0, 3.0 ),
+                                           0.5 * l_out_mm - 1.0,
+                                           at::relu( l_out_bias ),
+                                           at::gelu( l_out_bias ),
+                                           at::silu( l_out_bias ) };
+
+  for( std::size_t l_ke = 0; l_ke < l_ktypes.size(); l_ke++ ) {
+    at::Tensor l_out = at::randn( { 3,17,20 } );
+
+    ContractionBackendTpp l_cont;
+
+    l_cont.init( l_loop_dim_type,
+                 l_loop_exec_type,
+                 l_loop_sizes,
+                 l_loop_strides_left,
+                 l_loop_strides_right,
+                 l_loop_strides_out_aux,
+                 l_loop_strides_out,
+                 l_packing_strides_left,
+                 l_packing_strides_right,
+                 data_t::FP32,
+                 data_t::FP32,
+                 data_t::FP32,
+                 data_t::FP32,
+                 kernel_t::ZERO,
+                 kernel_t::MADD,
+                 l_ktypes[l_ke],
+                 2,
+                 2,
+                 2,
+                 nullptr );
+    l_cont.set_last_touch_params( l_params );
+
+    err_t l_err = l_cont.compile();
+    REQUIRE( l_err == err_t::SUCCESS );
+
+    l_cont.contract( l_left.data_ptr(),
+                     l_right.data_ptr(),
+                     l_bias.data_ptr(),
+                     l_out.data_ptr() );
+
+    REQUIRE( at::allclose( l_out, l_outs_ref[l_ke], 1E-3, 1E-4 ) );
+  }
+}
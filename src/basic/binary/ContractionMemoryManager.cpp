@@ -1,41 +1,63 @@
+#include <atomic>
 #include "ContractionMemoryManager.h"
-
-#ifdef _OPENMP
-#include <omp.h>
-#endif
+#include "../threading.h"
+#include "../pages.h"
 
 einsum_ir::basic::ContractionMemoryManager::~ContractionMemoryManager() {
   for( std::size_t l_id = 0; l_id < m_thread_memory.size(); l_id++ ){
-    if( m_thread_memory[l_id] != nullptr ){
-      delete [] (char *) m_thread_memory[l_id];
+    free_pages( m_thread_memory[l_id],
+                m_alloc_thread_mem,
+                m_thread_page_sizes[l_id] );
+  }
+}
+
+void einsum_ir::basic::ContractionMemoryManager::set_page_type( page_t i_page_type ){
+  m_page_type = i_page_type;
+}
+
+int64_t einsum_ir::basic::ContractionMemoryManager::page_size(){
+  int64_t l_page_size = 0;
+  for( std::size_t l_id = 0; l_id < m_thread_page_sizes.size(); l_id++ ){
+    if( l_page_size == 0 || m_thread_page_sizes[l_id] < l_page_size ){
+      l_page_size = m_thread_page_sizes[l_id];
     }
   }
+  return l_page_size;
 }
 
-void einsum_ir::basic::ContractionMemoryManager::alloc_all_memory(){
+einsum_ir::basic::err_t einsum_ir::basic::ContractionMemoryManager::alloc_all_memory(){
+  std::atomic< bool > l_failed( false );
+
   if( m_req_thread_mem ){
     m_thread_memory.resize( m_num_threads, nullptr );
     m_aligned_thread_memory.resize(m_num_threads, nullptr);
+    m_thread_page_sizes.resize( m_num_threads, 0 );
+    m_alloc_thread_mem = m_req_thread_mem + m_alignment_line;
 
-#ifdef _OPENMP
-#pragma omp parallel for num_threads(m_num_threads)
-#endif
-    for( int64_t l_thread_id = 0; l_thread_id < m_num_threads; l_thread_id++ ){
-      //allocate memory
-      char * l_ptr = new char[ m_req_thread_mem + m_alignment_line ];
+    // every thread allocates and touches its own memory
+    execute_threaded( m_num_threads, [&]( int64_t l_thread_id ){
+      //allocate page-aligned memory
+      char * l_ptr = (char *) alloc_pages( m_alloc_thread_mem,
+                                           m_page_type,
+                                           &m_thread_page_sizes[l_thread_id] );
       m_thread_memory[l_thread_id] = l_ptr;
-
-      //allign data in memory
-      int64_t l_align_offset = (unsigned long)l_ptr % m_alignment_line;
-      l_align_offset = l_align_offset ? m_alignment_line - l_align_offset : 0;
-      m_aligned_thread_memory[l_thread_id] = l_ptr + l_align_offset;
+      m_aligned_thread_memory[l_thread_id] = l_ptr;
+      if( l_ptr == nullptr ){
+        l_failed.store( true );
+        return;
+      }
 
       //first touch policy
       for( int64_t l_mem_id = 0; l_mem_id <= m_req_thread_mem; l_mem_id++ ){
         m_aligned_thread_memory[l_thread_id][l_mem_id] = 0;
       }
-    }
+    });
+  }
+
+  if( l_failed.load() ){
+    return err_t::COMPILATION_FAILED;
   }
+  return err_t::SUCCESS;
 }
 
 void einsum_ir::basic::ContractionMemoryManager::reserve_thread_memory( int64_t i_size, 
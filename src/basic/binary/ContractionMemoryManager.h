@@ -24,6 +24,13 @@ class einsum_ir::basic::ContractionMemoryManager{
     int64_t m_req_thread_mem = 0;
     //! number of threads
     int64_t m_num_threads = 1;
+
+    //! requested type of pages
+    page_t m_page_type = page_t::BASE_PAGES;
+    //! obtained page sizes of the thread specific memory
+    std::vector<int64_t> m_thread_page_sizes;
+    //! allocated memory per thread in bytes
+    int64_t m_alloc_thread_mem = 0;
     
   public:
     /**
@@ -31,10 +38,27 @@ class einsum_ir::basic::ContractionMemoryManager{
      **/
     ~ContractionMemoryManager();
 
+    /**
+     * Sets the type of pages backing the memory, has to be called before the allocation.
+     * Falls back to smaller pages if the requested type is unavailable.
+     *
+     * @param i_page_type requested type of pages.
+     **/
+    void set_page_type( page_t i_page_type );
+
+    /**
+     * Gets the size of the pages obtained for the thread specific memory.
+     *
+     * @return smallest page size of all threads in bytes, 0 if no memory was allocated.
+     **/
+    int64_t page_size();
+
     /**
      * Allocates the required memory.
+     *
+     * @return SUCCESS if the memory of all threads was allocated, COMPILATION_FAILED otherwise.
      **/
-    void alloc_all_memory();
+    err_t alloc_all_memory();
 
     /**
      * Reserves thread specific memory for intermediate data in contractions. 
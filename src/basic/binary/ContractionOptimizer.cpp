@@ -1,4 +1,5 @@
 #include "ContractionOptimizer.h"
+#include "../hardware.h"
 #include <algorithm>
 #include <cmath>
 
@@ -31,7 +32,10 @@ void einsum_ir::basic::ContractionOptimizer::init( std::vector< iter_property >
   m_packed_gemm_support = i_packed_gemm_support;
 
   m_num_bytes_scalar_out = i_num_bytes_scalar_out;
-  m_l2_cache_size = i_l2_cache_size;
+  m_num_bytes_scalar_left = i_num_bytes_scalar_out;
+  m_num_bytes_scalar_right = i_num_bytes_scalar_out;
+  m_l2_cache_size = i_l2_cache_size > 0 ? i_l2_cache_size : get_hardware().l2_cache_size;
+  m_l3_cache_size = get_hardware().l3_cache_size;
 
   m_num_threads_sfc_m   = io_num_threads_sfc_m;
   m_num_threads_sfc_n   = io_num_threads_sfc_n;
@@ -40,8 +44,44 @@ void einsum_ir::basic::ContractionOptimizer::init( std::vector< iter_property >
   m_num_threads = *m_num_threads_sfc_m * *m_num_threads_sfc_n * *m_num_threads_shared;
 
   //small power of 2 to avoid extra overhead and still utilise the stride one dimension to some extend
-  //heuristic right now, could choose this parameter architecture dependent
+  //at least one vector register of the output data type
   m_target_extra_packing = 8;
+  if( m_num_bytes_scalar_out > 0 ){
+    m_target_extra_packing = std::max< int64_t >( m_target_extra_packing,
+                                                  get_hardware().simd_width / m_num_bytes_scalar_out );
+  }
+
+  m_force_packing_left  = false;
+  m_force_packing_right = false;
+
+  m_time_model = nullptr;
+  m_bandwidth = 0;
+}
+
+void einsum_ir::basic::ContractionOptimizer::force_packing( bool i_left,
+                                                            bool i_right ){
+  m_force_packing_left  = i_left;
+  m_force_packing_right = i_right;
+}
+
+void einsum_ir::basic::ContractionOptimizer::set_num_bytes_scalar_in( int64_t i_num_bytes_scalar_left,
+                                                                      int64_t i_num_bytes_scalar_right ){
+  m_num_bytes_scalar_left  = i_num_bytes_scalar_left;
+  m_num_bytes_scalar_right = i_num_bytes_scalar_right;
+}
+
+void einsum_ir::basic::ContractionOptimizer::set_l3_cache_size( int64_t i_l3_cache_size ){
+  m_l3_cache_size = i_l3_cache_size;
+}
+
+void einsum_ir::basic::ContractionOptimizer::set_l3_blocking( bool i_l3_blocking ){
+  m_l3_blocking = i_l3_blocking;
+}
+
+void einsum_ir::basic::ContractionOptimizer::set_time_model( std::function< double( int64_t, int64_t, int64_t, bool, bool ) > const & i_time_model,
+                                                             double                                                                   i_bandwidth ){
+  m_time_model = i_time_model;
+  m_bandwidth  = i_bandwidth;
 }
 
 einsum_ir::basic::err_t einsum_ir::basic::ContractionOptimizer::optimize(){
@@ -206,10 +246,17 @@ void einsum_ir::basic::ContractionOptimizer::set_kernel_targets_heuristic( int64
         io_kernel_targets[ PRIM_BR ]  = m_target_extra_packing;
     }
 
-  //reduce kernel targets when parallelism is low
+  //reduce kernel targets when parallelism is low, outer K iterations are split among the threads if needed
   int64_t l_size_m, l_size_n;
   get_size_all_m_n( l_size_m, l_size_n );
-  int64_t l_possible_parallelism = l_size_m * l_size_n;
+  int64_t l_size_k = 1;
+  for( std::vector<iter_property>::iterator l_it = m_iter_space->begin(); l_it < m_iter_space->end(); l_it++ ){
+    if( l_it->dim_type == dim_t::K ){
+      l_size_k *= l_it->size;
+    }
+  }
+  int64_t l_size_outer_k = l_size_k / (io_kernel_targets[PRIM_K] * io_kernel_targets[PRIM_BR]);
+  int64_t l_possible_parallelism = l_size_m * l_size_n * std::max( l_size_outer_k, (int64_t) 1 );
   while( l_possible_parallelism / (io_kernel_targets[PRIM_M] * io_kernel_targets[PRIM_N]) < m_num_threads &&
          io_kernel_targets[PRIM_M] * io_kernel_targets[PRIM_N] > 1 ){
     if(io_kernel_targets[PRIM_M] < io_kernel_targets[PRIM_N]){
@@ -228,6 +275,88 @@ void einsum_ir::basic::ContractionOptimizer::set_kernel_targets_heuristic( int64
 
 }
 
+void einsum_ir::basic::ContractionOptimizer::set_kernel_targets_model( int64_t * i_potential_kernel_size,
+                                                                       int64_t * io_kernel_targets,
+                                                                       bool      i_transpose_a,
+                                                                       bool      i_transpose_b,
+                                                                       bool      i_packing_left,
+                                                                       bool      i_packing_right ){
+  //enum                                  { PRIM_BR, PRIM_C, PRIM_M, PRIM_N, PRIM_K };
+  int64_t const l_max_kernel_size[] = {        1,      1,    256,    256,    512 };
+
+  //candidate splits of the m, n and k dimensions
+  std::vector<int64_t> l_candidates[5];
+  for( int64_t l_prim_id = PRIM_M; l_prim_id <= PRIM_K; l_prim_id++ ){
+    for( int64_t l_target = 1; l_target <= l_max_kernel_size[l_prim_id]; l_target *= 2 ){
+      int64_t l_split = find_split( i_potential_kernel_size[l_prim_id], l_target );
+      if(    l_split <= l_max_kernel_size[l_prim_id]
+          && std::find( l_candidates[l_prim_id].begin(), l_candidates[l_prim_id].end(), l_split ) == l_candidates[l_prim_id].end() ){
+        l_candidates[l_prim_id].push_back( l_split );
+      }
+    }
+  }
+
+  //sizes of the iteration space
+  int64_t l_size_m, l_size_n;
+  get_size_all_m_n( l_size_m, l_size_n );
+  double l_size_c = 1;
+  double l_size_k = 1;
+  for( std::vector<iter_property>::iterator l_it = m_iter_space->begin(); l_it < m_iter_space->end(); l_it++ ){
+    if( l_it->dim_type == dim_t::C ){
+      l_size_c *= l_it->size;
+    }
+    else if( l_it->dim_type == dim_t::K ){
+      l_size_k *= l_it->size;
+    }
+  }
+
+  int64_t l_br = io_kernel_targets[ PRIM_BR ] > 1 ? find_split( i_potential_kernel_size[ PRIM_BR ], io_kernel_targets[ PRIM_BR ] ) : 1;
+  double l_best_time = -1;
+
+  for( int64_t l_m : l_candidates[ PRIM_M ] ){
+    for( int64_t l_n : l_candidates[ PRIM_N ] ){
+      for( int64_t l_k : l_candidates[ PRIM_K ] ){
+        //the kernel's blocks have to fit into the L2 cache
+        int64_t l_kernel_bytes =   ( l_m * m_num_bytes_scalar_left + l_n * m_num_bytes_scalar_right ) * l_k * l_br
+                                 + l_m * l_n * m_num_bytes_scalar_out;
+        if( m_l2_cache_size > 0 && l_kernel_bytes > m_l2_cache_size ){
+          continue;
+        }
+
+        //gemm calls of a thread: tasks of the m, n and c dimensions are distributed, k is split if there are too few tasks
+        double l_num_tasks =   l_size_c
+                             * (double) ( (l_size_m + l_m - 1) / l_m )
+                             * (double) ( (l_size_n + l_n - 1) / l_n );
+        double l_num_blocks_k = l_size_k / ( l_k * l_br );
+        double l_split_k = 1;
+        if( l_num_tasks < m_num_threads ){
+          l_split_k = std::max( std::min( std::ceil( m_num_threads / l_num_tasks ), std::floor( l_num_blocks_k ) ), 1.0 );
+        }
+        double l_num_calls = std::ceil( l_num_tasks * l_split_k / m_num_threads ) * ( l_num_blocks_k / l_split_k );
+
+        double l_time_call = l_br * m_time_model( l_m, l_n, l_k, i_transpose_a, i_transpose_b );
+        if( m_bandwidth > 0 ){
+          double l_bytes_packing = 0;
+          if( i_packing_left ){
+            l_bytes_packing += 2.0 * l_m * l_k * l_br * m_num_bytes_scalar_left;
+          }
+          if( i_packing_right ){
+            l_bytes_packing += 2.0 * l_n * l_k * l_br * m_num_bytes_scalar_right;
+          }
+          l_time_call += l_bytes_packing / ( m_bandwidth * 1.0E9 );
+        }
+
+        double l_time = l_num_calls * l_time_call;
+        if( l_time > 0 && ( l_best_time < 0 || l_time < l_best_time ) ){
+          l_best_time = l_time;
+          io_kernel_targets[ PRIM_M ] = l_m;
+          io_kernel_targets[ PRIM_N ] = l_n;
+          io_kernel_targets[ PRIM_K ] = l_k;
+        }
+      }
+    }
+  }
+}
 
 einsum_ir::basic::err_t einsum_ir::basic::ContractionOptimizer::set_primitive_iters(){
   //The Algorithm consits of three steps:
@@ -474,10 +603,29 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionOptimizer::set_primitive_it
       && l_potential_kernel_iter[ PRIM_N ]->stride_right % 2048 == 0 ){
     l_packing_right = m_packing_support;
   }
+  if( m_force_packing_left ){
+    l_packing_left = m_packing_support;
+  }
+  if( m_force_packing_right ){
+    l_packing_right = m_packing_support;
+  }
 
   //addapts the kernel targets depending on the potential kernel size
   set_kernel_targets_heuristic( l_potential_kernel_size, l_kernel_targets, l_iter_required );
 
+  //refine the m, n and k targets through the performance model, packed gemms and complex kernels are not modeled
+  if(    m_time_model
+      && l_kernel_targets[ PRIM_C ] <= 1
+      && l_complex_iter_prop.dim_type != dim_t::CPX ){
+    // packed inputs are stored in the kernel's order: A is not transposed, B is transposed
+    set_kernel_targets_model( l_potential_kernel_size,
+                              l_kernel_targets,
+                              l_transpose_a && !l_packing_left,
+                              l_transpose_b || l_packing_right,
+                              l_packing_left,
+                              l_packing_right );
+  }
+
 
   //------------------------------------------
   // Step 3: Split potential kernel iterations
@@ -600,10 +748,26 @@ void einsum_ir::basic::ContractionOptimizer::reorder_and_parallelize_iters(){
   }
 
   int64_t l_kernel_size_out = 1;
+  int64_t l_kernel_size_m = 1;
+  int64_t l_kernel_size_n = 1;
+  int64_t l_kernel_size_k = 1;
+  int64_t l_kernel_size_c = 1;
   for( l_it = l_kernel_iters.begin(); l_it < l_kernel_iters.end(); l_it++ ){
     if( l_it->dim_type != dim_t::K ){
       l_kernel_size_out *= l_it->size;
     }
+    if( l_it->dim_type == dim_t::M ){
+      l_kernel_size_m *= l_it->size;
+    }
+    else if( l_it->dim_type == dim_t::N ){
+      l_kernel_size_n *= l_it->size;
+    }
+    else if( l_it->dim_type == dim_t::K ){
+      l_kernel_size_k *= l_it->size;
+    }
+    else if( l_it->dim_type == dim_t::C ){
+      l_kernel_size_c *= l_it->size;
+    }
   }
 
   //use about half of the L2 cache for C blocking (A and B tend to be a lot smaller because of SFC blocking in M and N)
@@ -629,6 +793,7 @@ void einsum_ir::basic::ContractionOptimizer::reorder_and_parallelize_iters(){
 
   //add parallel dimension
   std::vector<iter_property> l_blocking_iters;
+  int64_t l_size_parallel_m, l_size_parallel_n;
   if( m_generate_sfcs ) {
     m_size_sfc_n = move_iters_until( &l_blocking_iters, 
                                     l_target_parallel_n,
@@ -638,25 +803,55 @@ void einsum_ir::basic::ContractionOptimizer::reorder_and_parallelize_iters(){
                                     l_target_parallel_m,
                                     dim_t::M,
                                     exec_t::SFC);
+    l_size_parallel_n = m_size_sfc_n;
+    l_size_parallel_m = m_size_sfc_m;
   }
   else{
-    move_iters_until( &l_blocking_iters, 
-                      l_target_parallel_n,
-                      dim_t::N,
-                      exec_t::OMP);
-    move_iters_until( &l_blocking_iters, 
-                      l_target_parallel_m,
-                      dim_t::M,
-                      exec_t::OMP);
+    l_size_parallel_n = move_iters_until( &l_blocking_iters, 
+                                          l_target_parallel_n,
+                                          dim_t::N,
+                                          exec_t::OMP);
+    l_size_parallel_m = move_iters_until( &l_blocking_iters, 
+                                          l_target_parallel_m,
+                                          dim_t::M,
+                                          exec_t::OMP);
     m_size_sfc_n = 1;
     m_size_sfc_m = 1;
   }
 
+  //split K among the threads if the parallel tasks of the output cannot occupy them, e.g., for tall-skinny contractions
+  int64_t l_size_parallel_c = 1;
+  for( l_it = m_iter_space->begin(); l_it < m_iter_space->end(); l_it++ ){
+    if( l_it->dim_type == dim_t::C ){
+      l_size_parallel_c *= l_it->size;
+    }
+  }
+  l_size_parallel_c = std::min( l_size_parallel_c, l_target_parallel_c );
+  int64_t l_size_parallel = l_size_parallel_m * l_size_parallel_n * l_size_parallel_c;
+  std::vector<iter_property> l_split_k_iters;
+  if( l_size_parallel < m_num_threads ){
+    move_iters_until( &l_split_k_iters,
+                      (m_num_threads + l_size_parallel - 1) / l_size_parallel,
+                      dim_t::K,
+                      exec_t::OMP );
+  }
+
   //add sequential K dimension for L3 blocking
-  move_iters_until( &l_blocking_iters, 
-                    64,
-                    dim_t::K,
-                    exec_t::SEQ);
+  //the blocks of A and B of all parallel tasks for a block of K iterations use about half of the threads' L3 cache
+  int64_t l_target_blocking_k = 64;
+  int64_t l_bytes_k = (  l_size_parallel_m * l_kernel_size_m * m_num_bytes_scalar_left
+                       + l_size_parallel_n * l_kernel_size_n * m_num_bytes_scalar_right )
+                      * l_kernel_size_c * l_kernel_size_k;
+  if( m_l3_blocking && m_l3_cache_size > 0 && l_bytes_k > 0 ){
+    l_target_blocking_k = m_l3_cache_size * m_num_threads / 2 / l_bytes_k;
+    if( l_target_blocking_k < 1 ){
+      l_target_blocking_k = 1;
+    }
+  }
+  int64_t l_size_blocking_k = move_iters_until( &l_blocking_iters,
+                                                l_target_blocking_k,
+                                                dim_t::K,
+                                                exec_t::SEQ);
   
   //add parallel C dimension
   move_iters_until( &l_blocking_iters, 
@@ -672,7 +867,55 @@ void einsum_ir::basic::ContractionOptimizer::reorder_and_parallelize_iters(){
                 bool l_smaller_stride = l_stride_a > l_stride_b;
                 return l_smaller_stride;
              });
+
+  //traverse the remaining K dimensions inside the other dimensions, i.e., the blocks of C stay in cache while K is traversed
+  if( m_l3_blocking ){
+    std::stable_partition( m_iter_space->begin(), m_iter_space->end(),
+                           [](iter_property const & l_iter) -> bool {
+                             return l_iter.dim_type != dim_t::K;
+                           });
+  }
+
+  //block the outer M or N iterations for the L3 cache, i.e., traverse them inside the outer K iterations
+  //the K block of the other input is reused from the L3 cache, which pays off if the K block is larger than the parallel block
+  bool l_outer_k = m_l3_blocking && std::any_of( m_iter_space->begin(), m_iter_space->end(),
+                                                 [](iter_property const & l_iter) -> bool {
+                                                   return l_iter.dim_type == dim_t::K;
+                                                 });
+  int64_t l_size_block_k = l_size_blocking_k * l_kernel_size_k;
+  int64_t l_size_block_m = l_size_parallel_m * l_kernel_size_m;
+  int64_t l_size_block_n = l_size_parallel_n * l_kernel_size_n;
+  dim_t l_dims_l3[2] = { dim_t::M, dim_t::N };
+  int64_t l_sizes_block_l3[2] = { l_size_block_m, l_size_block_n };
+  if( l_size_block_n < l_size_block_m ){
+    std::swap( l_dims_l3[0], l_dims_l3[1] );
+    std::swap( l_sizes_block_l3[0], l_sizes_block_l3[1] );
+  }
+  for( int64_t l_di = 0; l_di < 2 && l_outer_k; l_di++ ){
+    dim_t l_dim_type = l_dims_l3[l_di];
+    bool l_outer_dim = std::any_of( m_iter_space->begin(), m_iter_space->end(),
+                                    [l_dim_type](iter_property const & l_iter) -> bool {
+                                      return l_iter.dim_type == l_dim_type;
+                                    });
+    if( l_outer_dim && l_size_block_k > l_sizes_block_l3[l_di] ){
+      std::stable_partition( m_iter_space->begin(), m_iter_space->end(),
+                             [l_dim_type](iter_property const & l_iter) -> bool {
+                               return l_iter.dim_type != l_dim_type;
+                             });
+      break;
+    }
+  }
   
+  //shared loops are next to each other, split K is the outermost one
+  l_it = std::find_if( l_blocking_iters.begin(), l_blocking_iters.end(),
+                       [](iter_property const & l_iter) -> bool {
+                         return l_iter.exec_type == exec_t::OMP;
+                       });
+  if( l_it == l_blocking_iters.end() ){
+    l_it = l_blocking_iters.begin();
+  }
+  l_blocking_iters.insert( l_it, l_split_k_iters.begin(), l_split_k_iters.end() );
+
   //add iterations from local data structures
   m_iter_space->insert(m_iter_space->end(), l_blocking_iters.begin(), l_blocking_iters.end() );
   m_iter_space->insert(m_iter_space->end(), l_kernel_iters.begin(), l_kernel_iters.end() );
@@ -1,6 +1,7 @@
 #ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_OPTIMIZER
 #define EINSUM_IR_BASIC_BINARY_CONTRACTION_OPTIMIZER
 
+#include <functional>
 #include <vector>
 #include "../constants.h"
 
@@ -34,9 +35,21 @@ class einsum_ir::basic::ContractionOptimizer {
     //! number of bytes for scalar data types in output tensor
     int64_t m_num_bytes_scalar_out = 0;
 
+    //! number of bytes for scalar data types in left input tensor
+    int64_t m_num_bytes_scalar_left = 0;
+
+    //! number of bytes for scalar data types in right input tensor
+    int64_t m_num_bytes_scalar_right = 0;
+
     //! size of L2 cache in bytes
     int64_t m_l2_cache_size = 0;
 
+    //! share of a single core of the L3 cache in bytes, 0 if not present
+    int64_t m_l3_cache_size = 0;
+
+    //! true if the outer iterations are blocked for the L3 cache, otherwise a fixed sequential K block is used
+    bool m_l3_blocking = false;
+
     //! target size for extra packing dimensions
     int64_t m_target_extra_packing = 0;
 
@@ -55,6 +68,12 @@ class einsum_ir::basic::ContractionOptimizer {
     //! indicates if backend supports packing
     bool m_packing_support = true;
 
+    //! true if the left input tensor is packed regardless of its strides
+    bool m_force_packing_left = false;
+
+    //! true if the right input tensor is packed regardless of its strides
+    bool m_force_packing_right = false;
+
     //! indicates if backend supports packed gemms
     packed_gemm_t m_packed_gemm_support = packed_gemm_t::NONE;
 
@@ -73,6 +92,12 @@ class einsum_ir::basic::ContractionOptimizer {
     //! size of the sfc in n dimension
     int64_t m_size_sfc_n = 1;
 
+    //! predicted time in seconds of a GEMM primitive with the given m, n, k sizes and transpositions of A and B, empty if the heuristic is used
+    std::function< double( int64_t, int64_t, int64_t, bool, bool ) > m_time_model;
+
+    //! bandwidth in GB/s which is used to predict the time of packing the input tensors
+    double m_bandwidth = 0;
+
     /**
       * Finds all iters with a specific stride in the iteration space.
       *
@@ -119,6 +144,25 @@ class einsum_ir::basic::ContractionOptimizer {
                                        int64_t * io_kernel_targets,
                                        bool    * i_iter_required );
 
+    /**
+      * Sets the m, n and k kernel targets to the candidate split with the smallest predicted time.
+      * The time is the number of GEMM calls per thread times the modeled time of a GEMM plus the time of packing the inputs.
+      * Candidates are the splits of the potential kernel sizes which are closest to powers of two.
+      *
+      * @param i_potential_kernel_size potential kernel size for each dimension.
+      * @param io_kernel_targets kernel targets for each dimension, the BR target is kept.
+      * @param i_transpose_a true if the kernel's A matrix is transposed.
+      * @param i_transpose_b true if the kernel's B matrix is transposed.
+      * @param i_packing_left true if the left input tensor is packed.
+      * @param i_packing_right true if the right input tensor is packed.
+      **/
+    void set_kernel_targets_model( int64_t * i_potential_kernel_size,
+                                   int64_t * io_kernel_targets,
+                                   bool      i_transpose_a,
+                                   bool      i_transpose_b,
+                                   bool      i_packing_left,
+                                   bool      i_packing_right );
+
     /**
      * Splits an iteration depending on a target size.
      *
@@ -183,7 +227,7 @@ class einsum_ir::basic::ContractionOptimizer {
      * @param i_packing_support true if backend supports packing
      * @param i_packed_gemm_support indicates the support level for packed gemms
      * @param i_num_bytes_scalar_out number of bytes for scalar data types in output tensor
-     * @param i_l2_cache_size size of L2 cache in bytes
+     * @param i_l2_cache_size size of L2 cache in bytes, 0 uses the L2 cache of the host.
      * @param io_num_threads_shared number of threads used for shared parallelization.
      * @param io_num_threads_sfc_m number of threads used for sfc m parallelization.
      * @param io_num_threads_sfc_n number of threads used for sfc n parallelization.
@@ -202,6 +246,53 @@ class einsum_ir::basic::ContractionOptimizer {
                int64_t                      * io_num_threads_shared,
                int64_t                      * io_num_threads_sfc_m,
                int64_t                      * io_num_threads_sfc_n );    
+
+    /**
+     * Packs the input tensors regardless of their strides, e.g., to apply a prologue while packing.
+     * Has to be called before the optimization; has no effect if the backend does not support packing.
+     *
+     * @param i_left true if the left input tensor is packed.
+     * @param i_right true if the right input tensor is packed.
+     **/
+    void force_packing( bool i_left,
+                        bool i_right );
+
+    /**
+     * Sets the sizes of the scalar data types of the input tensors, which are used for sizing the blocks of A and B.
+     * Has to be called before the optimization; by default the size of the output's data type is used.
+     *
+     * @param i_num_bytes_scalar_left number of bytes for scalar data types in left input tensor.
+     * @param i_num_bytes_scalar_right number of bytes for scalar data types in right input tensor.
+     **/
+    void set_num_bytes_scalar_in( int64_t i_num_bytes_scalar_left,
+                                  int64_t i_num_bytes_scalar_right );
+
+    /**
+     * Overwrites the L3 cache size of the host which is used for blocking the K dimension.
+     * Has to be called before the optimization.
+     *
+     * @param i_l3_cache_size share of a single core of the L3 cache in bytes, 0 if not present.
+     **/
+    void set_l3_cache_size( int64_t i_l3_cache_size );
+
+    /**
+     * Enables or disables the blocking of the outer iterations for the L3 cache.
+     * If disabled, a fixed sequential K block of 64 iterations is used and the remaining iterations are sorted by their strides.
+     * Has to be called before the optimization.
+     *
+     * @param i_l3_blocking true if the outer iterations are blocked for the L3 cache.
+     **/
+    void set_l3_blocking( bool i_l3_blocking );
+
+    /**
+     * Sets a performance model which determines the kernel targets instead of the heuristic.
+     * Has to be called before the optimization; the heuristic is used for packed GEMMs and complex contractions.
+     *
+     * @param i_time_model predicted time in seconds of a GEMM with the given m, n, k sizes and transpositions of A and B.
+     * @param i_bandwidth bandwidth in GB/s which is used to predict the time of packing the input tensors.
+     **/
+    void set_time_model( std::function< double( int64_t, int64_t, int64_t, bool, bool ) > const & i_time_model,
+                         double                                                                   i_bandwidth );
   
     /**
      * Optimizes the iters.
@@ -234,6 +325,13 @@ class einsum_ir::basic::ContractionOptimizer {
 
     /**
      * Reorders iters, splits iters and determines parallel iters.
+     * If the M, N and C tasks cannot occupy all threads, an outermost shared K iteration splits the reduction.
+     * The remaining iterations are blocked for the cache hierarchy:
+     *   L2: the blocks of C of a thread's parallel tasks use about half of the L2 cache,
+     *   L3 (if enabled): a sequential K block keeps the blocks of A and B of all parallel tasks in about half of the threads' L3 cache.
+     *       If the K block is larger than the parallel block of M (N), the outer M (N) iterations are traversed inside the
+     *       outer K iterations, i.e., the K block of B (A) is reused from the L3 cache and the blocks of C are accessed once per K block.
+     *       Otherwise, the outer K iterations are traversed inside the other outer iterations such that the blocks of C stay in cache.
      **/
     void reorder_and_parallelize_iters();
 
@@ -246,4 +246,333 @@ TEST_CASE( "Test of Contraction Optimizer for transposed kernel", "[contraction_
   REQUIRE( l_size_before[1] == l_size_after[1] );
   REQUIRE( l_size_before[2] == l_size_after[2] );
   REQUIRE( l_size_before[3] == l_size_after[3] );
-}
\ No newline at end of file
+}
+TEST_CASE( "Forced packing of the left input tensor in the Contraction Optimizer", "[contraction_optimizer]" ) {
+  using namespace einsum_ir::basic;
+
+  std::vector< iter_property > l_iters = { {dim_t::N, exec_t::SEQ, 96,  0, 100, 0, 100},
+                                           {dim_t::K, exec_t::SEQ, 100, 100,  1, 0,   0},
+                                           {dim_t::M, exec_t::SEQ, 100,   1,  0, 0,   1}};
+
+  ContractionOptimizer l_opt;
+  kernel_t l_kernel_main = kernel_t::MADD;
+
+  int64_t l_num_threads_m = 1;
+  int64_t l_num_threads_n = 1;
+  int64_t l_num_threads_omp = 1;
+  l_opt.init( &l_iters,
+              &l_kernel_main,
+              16,
+              64,
+              256,
+              false,
+              false,
+              true,
+              packed_gemm_t::NONE,
+              4,
+              1024 * 1024,
+              &l_num_threads_m,
+              &l_num_threads_n,
+              &l_num_threads_omp );
+  l_opt.force_packing( true,
+                       false );
+
+  l_opt.optimize();
+
+  //check that only the left tensor is packed
+  bool l_packed_left = false;
+  for( std::size_t l_id = 0; l_id < l_iters.size(); l_id++ ){
+    if( l_iters[l_id].packing_stride_left > 0 ){
+      l_packed_left = true;
+    }
+    REQUIRE( l_iters[l_id].packing_stride_right == 0 );
+  }
+  REQUIRE( l_packed_left );
+}
+
+TEST_CASE( "Kernel targets of the Contraction Optimizer derived through a performance model", "[contraction_optimizer]" ) {
+  using namespace einsum_ir::basic;
+
+  std::vector< iter_property > l_iters = { {dim_t::N, exec_t::SEQ, 512,   0, 512, 0, 512},
+                                           {dim_t::K, exec_t::SEQ, 512, 512,   1, 0,   0},
+                                           {dim_t::M, exec_t::SEQ, 512,   1,   0, 0,   1}};
+
+  ContractionOptimizer l_opt;
+  kernel_t l_kernel_main = kernel_t::MADD;
+
+  int64_t l_num_threads_m = 1;
+  int64_t l_num_threads_n = 1;
+  int64_t l_num_threads_omp = 1;
+  l_opt.init( &l_iters,
+              &l_kernel_main,
+              16,
+              64,
+              256,
+              false,
+              false,
+              false,
+              packed_gemm_t::NONE,
+              4,
+              1024 * 1024,
+              &l_num_threads_m,
+              &l_num_threads_n,
+              &l_num_threads_omp );
+
+  // model which favors 32x16x64 kernels without transpositions
+  l_opt.set_time_model( []( int64_t i_m,
+                            int64_t i_n,
+                            int64_t i_k,
+                            bool    i_trans_a,
+                            bool    i_trans_b ) {
+                          double l_gflops = 10;
+                          if( i_m == 32 && i_n == 16 && i_k == 64 && !i_trans_a && !i_trans_b ) {
+                            l_gflops = 100;
+                          }
+                          return 2.0 * i_m * i_n * i_k / ( l_gflops * 1.0E9 );
+                        },
+                        0 );
+
+  REQUIRE( l_opt.optimize() == einsum_ir::basic::SUCCESS );
+
+  int64_t l_num_iters = l_iters.size();
+  REQUIRE( l_num_iters > 3 );
+  REQUIRE( l_iters[l_num_iters - 3].exec_type == exec_t::PRIM );
+  REQUIRE( l_iters[l_num_iters - 3].dim_type  == dim_t::M );
+  REQUIRE( l_iters[l_num_iters - 3].size      == 32 );
+  REQUIRE( l_iters[l_num_iters - 2].exec_type == exec_t::PRIM );
+  REQUIRE( l_iters[l_num_iters - 2].dim_type  == dim_t::N );
+  REQUIRE( l_iters[l_num_iters - 2].size      == 16 );
+  REQUIRE( l_iters[l_num_iters - 1].exec_type == exec_t::PRIM );
+  REQUIRE( l_iters[l_num_iters - 1].dim_type  == dim_t::K );
+  REQUIRE( l_iters[l_num_iters - 1].size      == 64 );
+}
+
+TEST_CASE( "Kernel targets of the Contraction Optimizer for narrow input types", "[contraction_optimizer]" ) {
+  using namespace einsum_ir::basic;
+
+  for( int64_t l_num_bytes_in : { 4, 1 } ) {
+    std::vector< iter_property > l_iters = { {dim_t::N, exec_t::SEQ, 512,   0, 512, 0, 512},
+                                             {dim_t::K, exec_t::SEQ, 512, 512,   1, 0,   0},
+                                             {dim_t::M, exec_t::SEQ, 512,   1,   0, 0,   1}};
+
+    ContractionOptimizer l_opt;
+    kernel_t l_kernel_main = kernel_t::MADD;
+
+    int64_t l_num_threads_m = 1;
+    int64_t l_num_threads_n = 1;
+    int64_t l_num_threads_omp = 1;
+    l_opt.init( &l_iters,
+                &l_kernel_main,
+                16,
+                64,
+                256,
+                false,
+                false,
+                false,
+                packed_gemm_t::NONE,
+                4,
+                1024 * 1024,
+                &l_num_threads_m,
+                &l_num_threads_n,
+                &l_num_threads_omp );
+    l_opt.set_num_bytes_scalar_in( l_num_bytes_in,
+                                   l_num_bytes_in );
+
+    // model which favors 256x256x512 kernels
+    l_opt.set_time_model( []( int64_t i_m,
+                              int64_t i_n,
+                              int64_t i_k,
+                              bool    ,
+                              bool    ) {
+                            double l_gflops = 10;
+                            if( i_m == 256 && i_n == 256 && i_k == 512 ) {
+                              l_gflops = 100;
+                            }
+                            return 2.0 * i_m * i_n * i_k / ( l_gflops * 1.0E9 );
+                          },
+                          0 );
+
+    REQUIRE( l_opt.optimize() == einsum_ir::basic::SUCCESS );
+
+    // blocks of A, B and C: (256 + 256) * 512 * 4 + 256 * 256 * 4 bytes exceed 1 MiB of L2
+    int64_t l_num_iters = l_iters.size();
+    REQUIRE( l_iters[l_num_iters - 1].exec_type == exec_t::PRIM );
+    REQUIRE( l_iters[l_num_iters - 1].dim_type  == dim_t::K );
+    bool l_favored =    l_iters[l_num_iters - 3].size == 256
+                     && l_iters[l_num_iters - 2].size == 256
+                     && l_iters[l_num_iters - 1].size == 512;
+    REQUIRE( l_favored == ( l_num_bytes_in == 1 ) );
+  }
+}
+
+TEST_CASE( "L3 blocking of the K dimension in the Contraction Optimizer", "[contraction_optimizer]" ) {
+  using namespace einsum_ir::basic;
+
+  for( int64_t l_l3_cache_size : { 0, 2 * 1024 * 1024 } ) {
+    for( bool l_l3_blocking : { false, true } ) {
+      std::vector< iter_property > l_iters = { {dim_t::N, exec_t::SEQ, 8192,    0, 8192, 0, 8192},
+                                               {dim_t::K, exec_t::SEQ, 8192, 8192,    1, 0,    0},
+                                               {dim_t::M, exec_t::SEQ, 8192,    1,    0, 0,    1}};
+
+      ContractionOptimizer l_opt;
+      kernel_t l_kernel_main = kernel_t::MADD;
+
+      int64_t l_num_threads_m = 4;
+      int64_t l_num_threads_n = 1;
+      int64_t l_num_threads_omp = 1;
+      l_opt.init( &l_iters,
+                  &l_kernel_main,
+                  64,
+                  64,
+                  256,
+                  true,
+                  false,
+                  false,
+                  packed_gemm_t::NONE,
+                  4,
+                  1024 * 1024,
+                  &l_num_threads_m,
+                  &l_num_threads_n,
+                  &l_num_threads_omp );
+      l_opt.set_l3_cache_size( l_l3_cache_size );
+      l_opt.set_l3_blocking( l_l3_blocking );
+
+      REQUIRE( l_opt.optimize() == einsum_ir::basic::SUCCESS );
+
+      // 64x64x256 kernels, 8x16 SFC tasks
+      int64_t l_num_iters = l_iters.size();
+      REQUIRE( l_iters[l_num_iters - 1].exec_type == exec_t::PRIM );
+      REQUIRE( l_iters[l_num_iters - 1].size      == 256 );
+      REQUIRE( l_iters[l_num_iters - 4].exec_type == exec_t::SFC );
+      REQUIRE( l_iters[l_num_iters - 5].exec_type == exec_t::SFC );
+      REQUIRE( l_iters[l_num_iters - 4].size * l_iters[l_num_iters - 5].size == 128 );
+
+      // sequential K block in front of the SFC
+      REQUIRE( l_iters[l_num_iters - 6].exec_type == exec_t::SEQ );
+      REQUIRE( l_iters[l_num_iters - 6].dim_type  == dim_t::K );
+      if( l_l3_cache_size == 0 || !l_l3_blocking ) {
+        // default block of 64 is limited by the 32 remaining K iterations
+        REQUIRE( l_num_iters == 8 );
+        REQUIRE( l_iters[l_num_iters - 6].size == 32 );
+      }
+      else {
+        // A and B of a K iteration: (512 + 1024) * 256 * 4 bytes, threads' L3: 4 * 2 MiB
+        REQUIRE( l_num_iters == 9 );
+        REQUIRE( l_iters[l_num_iters - 6].size == 2 );
+
+        // outer K iterations inside the outer M and N iterations
+        REQUIRE( l_iters[2].exec_type == exec_t::SEQ );
+        REQUIRE( l_iters[2].dim_type  == dim_t::K );
+        REQUIRE( l_iters[2].size      == 16 );
+        REQUIRE( l_iters[0].dim_type  != dim_t::K );
+        REQUIRE( l_iters[1].dim_type  != dim_t::K );
+      }
+    }
+  }
+}
+
+TEST_CASE( "L3 blocking of the M and N dimensions in the Contraction Optimizer", "[contraction_optimizer]" ) {
+  using namespace einsum_ir::basic;
+
+  // 4-byte inputs with 8 MiB L3 and 1-byte inputs with 2 MiB L3 give a K block of 8
+  for( int64_t l_num_bytes_in : { 4, 1 } ) {
+    std::vector< iter_property > l_iters = { {dim_t::N, exec_t::SEQ, 8192,    0, 8192, 0, 8192},
+                                             {dim_t::K, exec_t::SEQ, 8192, 8192,    1, 0,    0},
+                                             {dim_t::M, exec_t::SEQ, 8192,    1,    0, 0,    1}};
+
+    ContractionOptimizer l_opt;
+    kernel_t l_kernel_main = kernel_t::MADD;
+
+    int64_t l_num_threads_m = 4;
+    int64_t l_num_threads_n = 1;
+    int64_t l_num_threads_omp = 1;
+    l_opt.init( &l_iters,
+                &l_kernel_main,
+                64,
+                64,
+                256,
+                true,
+                false,
+                false,
+                packed_gemm_t::NONE,
+                4,
+                1024 * 1024,
+                &l_num_threads_m,
+                &l_num_threads_n,
+                &l_num_threads_omp );
+    l_opt.set_num_bytes_scalar_in( l_num_bytes_in,
+                                   l_num_bytes_in );
+    l_opt.set_l3_cache_size( l_num_bytes_in == 4 ? 8 * 1024 * 1024 : 2 * 1024 * 1024 );
+    l_opt.set_l3_blocking( true );
+
+    REQUIRE( l_opt.optimize() == einsum_ir::basic::SUCCESS );
+
+    int64_t l_num_iters = l_iters.size();
+    REQUIRE( l_num_iters == 9 );
+    REQUIRE( l_iters[l_num_iters - 4].exec_type == exec_t::SFC );
+    REQUIRE( l_iters[l_num_iters - 5].exec_type == exec_t::SFC );
+    REQUIRE( l_iters[l_num_iters - 6].exec_type == exec_t::SEQ );
+    REQUIRE( l_iters[l_num_iters - 6].dim_type  == dim_t::K );
+    REQUIRE( l_iters[l_num_iters - 6].size      == 8 );
+
+    // K block of 8*256 exceeds the M block of 8*64: outer M iterations inside the outer K iterations
+    REQUIRE( l_iters[0].dim_type  == dim_t::N );
+    REQUIRE( l_iters[1].exec_type == exec_t::SEQ );
+    REQUIRE( l_iters[1].dim_type  == dim_t::K );
+    REQUIRE( l_iters[1].size      == 4 );
+    REQUIRE( l_iters[2].exec_type == exec_t::SEQ );
+    REQUIRE( l_iters[2].dim_type  == dim_t::M );
+    REQUIRE( l_iters[2].size      == 16 );
+  }
+}
+
+TEST_CASE( "Split-K parallelization of a tall-skinny contraction in the Contraction Optimizer", "[contraction_optimizer]" ) {
+  using namespace einsum_ir::basic;
+
+  // 64x32 output, 65536 K iterations
+  std::vector< iter_property > l_iters = { {dim_t::N, exec_t::SEQ,    32,  0, 65536, 0, 64},
+                                           {dim_t::K, exec_t::SEQ, 65536, 64,     1, 0,  0},
+                                           {dim_t::M, exec_t::SEQ,    64,  1,     0, 0,  1}};
+
+  ContractionOptimizer l_opt;
+  kernel_t l_kernel_main = kernel_t::MADD;
+
+  int64_t l_num_threads_shared = 4;
+  int64_t l_num_threads_m = 1;
+  int64_t l_num_threads_n = 1;
+  l_opt.init( &l_iters,
+              &l_kernel_main,
+              64,
+              64,
+              256,
+              true,
+              false,
+              false,
+              packed_gemm_t::NONE,
+              4,
+              1024 * 1024,
+              &l_num_threads_shared,
+              &l_num_threads_m,
+              &l_num_threads_n );
+  l_opt.set_l3_cache_size( 0 );
+
+  REQUIRE( l_opt.optimize() == einsum_ir::basic::SUCCESS );
+
+  // the kernel covers the whole output
+  int64_t l_num_iters = l_iters.size();
+  REQUIRE( l_iters[l_num_iters - 3].exec_type == exec_t::PRIM );
+  REQUIRE( l_iters[l_num_iters - 3].size      == 64 );
+  REQUIRE( l_iters[l_num_iters - 2].exec_type == exec_t::PRIM );
+  REQUIRE( l_iters[l_num_iters - 2].size      == 32 );
+
+  // outermost K loop is shared among all threads
+  REQUIRE( l_iters[0].dim_type  == dim_t::K );
+  REQUIRE( l_iters[0].exec_type == exec_t::OMP );
+  REQUIRE( l_iters[0].size      == 4 );
+  REQUIRE( l_num_threads_shared == 4 );
+  REQUIRE( l_num_threads_m      == 1 );
+  REQUIRE( l_num_threads_n      == 1 );
+  for( int64_t l_id = 1; l_id < l_num_iters; l_id++ ) {
+    REQUIRE( l_iters[l_id].exec_type != exec_t::OMP );
+  }
+}
@@ -0,0 +1,327 @@
+#ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_STATIC
+#define EINSUM_IR_BASIC_BINARY_CONTRACTION_STATIC
+
+#include <algorithm>
+#include <vector>
+#include "../constants.h"
+
+namespace einsum_ir {
+  namespace basic {
+    template< dim_t   DIM_TYPE,
+              exec_t  EXEC_TYPE,
+              int64_t SIZE,
+              int64_t STRIDE_LEFT,
+              int64_t STRIDE_RIGHT,
+              int64_t STRIDE_OUT_AUX,
+              int64_t STRIDE_OUT >
+    struct static_iter;
+
+    template< typename T,
+              kernel_t KTYPE_FIRST_TOUCH,
+              kernel_t KTYPE_MAIN,
+              kernel_t KTYPE_LAST_TOUCH,
+              typename... ITERS >
+    class ContractionStatic;
+  }
+}
+
+/**
+ * Iteration whose properties are known at compile time.
+ * The template parameters follow the members of iter_property; strides are given in elements.
+ **/
+template< einsum_ir::basic::dim_t  DIM_TYPE,
+          einsum_ir::basic::exec_t EXEC_TYPE,
+          int64_t                  SIZE,
+          int64_t                  STRIDE_LEFT,
+          int64_t                  STRIDE_RIGHT,
+          int64_t                  STRIDE_OUT_AUX,
+          int64_t                  STRIDE_OUT >
+struct einsum_ir::basic::static_iter {
+  /**
+   * Gets the properties of the iteration.
+   *
+   * @return properties of the iteration.
+   **/
+  static constexpr iter_property property() {
+    return { DIM_TYPE,
+             EXEC_TYPE,
+             SIZE,
+             STRIDE_LEFT,
+             STRIDE_RIGHT,
+             STRIDE_OUT_AUX,
+             STRIDE_OUT,
+             0,
+             0 };
+  }
+};
+
+/**
+ * Binary contraction whose loop nest is fixed at compile time.
+ * All sizes and strides are template parameters, thus the compiler unrolls and vectorizes the
+ * loops; neither a compile step nor a runtime dispatch is required.
+ *
+ * The iterations are given as static_iter types, ordered from the outermost to the innermost loop.
+ * Similar to ContractionBackend, the trailing PRIM iterations form the kernel:
+ *   MADD:    M, N, K
+ *   BR_MADD: K, M, N, K
+ * All other iterations have to be SEQ iterations.
+ * Supported are the first-touch kernels ZERO and COPY and the last-touch kernel RELU.
+ *
+ * Example: C[n][m] = A[k][m] * B[n][k] with m=4, n=3 and k=2:
+ *   ContractionStatic< float, ZERO, MADD, UNDEFINED_KTYPE,
+ *                      static_iter< M, PRIM, 4, 1, 0, 0, 1 >,
+ *                      static_iter< N, PRIM, 3, 0, 2, 0, 4 >,
+ *                      static_iter< K, PRIM, 2, 4, 1, 0, 0 > >::contract( a, b, c );
+ *
+ * @param_t T datatype of all tensors.
+ * @param_t KTYPE_FIRST_TOUCH type of the first-touch kernel.
+ * @param_t KTYPE_MAIN type of the main kernel.
+ * @param_t KTYPE_LAST_TOUCH type of the last-touch kernel.
+ * @param_t ITERS iterations of the loop nest.
+ **/
+template< typename                   T,
+          einsum_ir::basic::kernel_t KTYPE_FIRST_TOUCH,
+          einsum_ir::basic::kernel_t KTYPE_MAIN,
+          einsum_ir::basic::kernel_t KTYPE_LAST_TOUCH,
+          typename...                ITERS >
+class einsum_ir::basic::ContractionStatic {
+  private:
+    //! number of iterations
+    static constexpr int64_t m_num_iters = sizeof...(ITERS);
+
+    //! properties of the iterations
+    static constexpr iter_property m_iters[ sizeof...(ITERS) ] = { ITERS::property()... };
+
+    /**
+     * Derives the number of trailing primitive iterations.
+     *
+     * @return number of primitive iterations.
+     **/
+    static constexpr int64_t num_prims() {
+      int64_t l_num_prims = 0;
+      for( int64_t l_id = m_num_iters - 1; l_id >= 0; l_id-- ) {
+        if( m_iters[l_id].exec_type != exec_t::PRIM ) {
+          break;
+        }
+        l_num_prims++;
+      }
+      return l_num_prims;
+    }
+
+    /**
+     * Checks the types of the iterations.
+     *
+     * @return true if the loop nest is supported, false otherwise.
+     **/
+    static constexpr bool valid_iters() {
+      int64_t l_num_prims = num_prims();
+      int64_t l_num_prims_req = KTYPE_MAIN == kernel_t::BR_MADD ? 4 : 3;
+      if( l_num_prims != l_num_prims_req ) {
+        return false;
+      }
+
+      if(    m_iters[m_num_iters-3].dim_type != dim_t::M
+          || m_iters[m_num_iters-2].dim_type != dim_t::N
+          || m_iters[m_num_iters-1].dim_type != dim_t::K ) {
+        return false;
+      }
+      if(    KTYPE_MAIN == kernel_t::BR_MADD
+          && m_iters[m_num_iters-4].dim_type != dim_t::K ) {
+        return false;
+      }
+
+      for( int64_t l_id = 0; l_id < m_num_iters - l_num_prims; l_id++ ) {
+        if(    m_iters[l_id].exec_type != exec_t::SEQ
+            || (    m_iters[l_id].dim_type != dim_t::C
+                 && m_iters[l_id].dim_type != dim_t::M
+                 && m_iters[l_id].dim_type != dim_t::N
+                 && m_iters[l_id].dim_type != dim_t::K ) ) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    /**
+     * Executes the kernel on the given data sections of the tensors.
+     *
+     * @param i_first true if this is the first contribution to the output block.
+     * @param i_last true if this is the last contribution to the output block.
+     * @param i_left pointer to a data section of the left tensor.
+     * @param i_right pointer to a data section of the right tensor.
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    static void kernel( bool         i_first,
+                        bool         i_last,
+                        T    const * i_left,
+                        T    const * i_right,
+                        T    const * i_out_aux,
+                        T          * io_out ) {
+      constexpr iter_property l_iter_m = m_iters[m_num_iters-3];
+      constexpr iter_property l_iter_n = m_iters[m_num_iters-2];
+      constexpr iter_property l_iter_k = m_iters[m_num_iters-1];
+      constexpr iter_property l_iter_br = KTYPE_MAIN == kernel_t::BR_MADD ? m_iters[m_num_iters-4]
+                                                                           : iter_property{ dim_t::K, exec_t::PRIM, 1 };
+
+      // the columns of the output block are accumulated in local arrays, which do not alias the inputs
+      for( int64_t l_n = 0; l_n < l_iter_n.size; l_n++ ) {
+        T * l_out = io_out + l_n * l_iter_n.stride_out;
+        T l_acc[ l_iter_m.size ];
+
+        // first touch
+        if( KTYPE_FIRST_TOUCH == kernel_t::ZERO && i_first ) {
+          for( int64_t l_m = 0; l_m < l_iter_m.size; l_m++ ) {
+            l_acc[l_m] = T(0);
+          }
+        }
+        else if( KTYPE_FIRST_TOUCH == kernel_t::COPY && i_first ) {
+          for( int64_t l_m = 0; l_m < l_iter_m.size; l_m++ ) {
+            l_acc[l_m] = i_out_aux[ l_m * l_iter_m.stride_out_aux + l_n * l_iter_n.stride_out_aux ];
+          }
+        }
+        else {
+          for( int64_t l_m = 0; l_m < l_iter_m.size; l_m++ ) {
+            l_acc[l_m] = l_out[ l_m * l_iter_m.stride_out ];
+          }
+        }
+
+        // main kernel, m is the innermost loop to vectorize over the output's leading dimension
+        for( int64_t l_br = 0; l_br < l_iter_br.size; l_br++ ) {
+          for( int64_t l_k = 0; l_k < l_iter_k.size; l_k++ ) {
+            T const * l_left = i_left + l_br * l_iter_br.stride_left + l_k * l_iter_k.stride_left;
+            T l_right = i_right[   l_br * l_iter_br.stride_right
+                                 + l_n  * l_iter_n.stride_right
+                                 + l_k  * l_iter_k.stride_right ];
+            for( int64_t l_m = 0; l_m < l_iter_m.size; l_m++ ) {
+              l_acc[l_m] += l_left[ l_m * l_iter_m.stride_left ] * l_right;
+            }
+          }
+        }
+
+        // last touch
+        if( KTYPE_LAST_TOUCH == kernel_t::RELU && i_last ) {
+          for( int64_t l_m = 0; l_m < l_iter_m.size; l_m++ ) {
+            l_acc[l_m] = std::max( l_acc[l_m], T(0) );
+          }
+        }
+
+        for( int64_t l_m = 0; l_m < l_iter_m.size; l_m++ ) {
+          l_out[ l_m * l_iter_m.stride_out ] = l_acc[l_m];
+        }
+      }
+    }
+
+    /**
+     * Recursively executes the sequential iterations.
+     *
+     * @param_t ID id of the iteration.
+     * @param i_first true if all outer K iterations are in their first iteration.
+     * @param i_last true if all outer K iterations are in their last iteration.
+     * @param i_left pointer to a data section of the left tensor.
+     * @param i_right pointer to a data section of the right tensor.
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    template< int64_t ID >
+    static void contract_iter( bool         i_first,
+                               bool         i_last,
+                               T    const * i_left,
+                               T    const * i_right,
+                               T    const * i_out_aux,
+                               T          * io_out ) {
+      if constexpr( ID < m_num_iters - num_prims() ) {
+        constexpr iter_property l_iter = m_iters[ID];
+
+        for( int64_t l_it = 0; l_it < l_iter.size; l_it++ ) {
+          bool l_first = i_first;
+          bool l_last  = i_last;
+          if constexpr( l_iter.dim_type == dim_t::K ) {
+            l_first = i_first && l_it == 0;
+            l_last  = i_last  && l_it == l_iter.size - 1;
+          }
+
+          T const * l_out_aux = i_out_aux;
+          if constexpr( KTYPE_FIRST_TOUCH == kernel_t::COPY ) {
+            l_out_aux += l_it * l_iter.stride_out_aux;
+          }
+
+          contract_iter< ID+1 >( l_first,
+                                 l_last,
+                                 i_left  + l_it * l_iter.stride_left,
+                                 i_right + l_it * l_iter.stride_right,
+                                 l_out_aux,
+                                 io_out  + l_it * l_iter.stride_out );
+        }
+      }
+      else {
+        kernel( i_first,
+                i_last,
+                i_left,
+                i_right,
+                i_out_aux,
+                io_out );
+      }
+    }
+
+  public:
+    /**
+     * Gets the iterations of the loop nest, e.g., to initialize a contraction backend with the same loops.
+     *
+     * @return iterations.
+     **/
+    static std::vector< iter_property > iters() {
+      return { ITERS::property()... };
+    }
+
+    /**
+     * Performs the contraction on the given data.
+     *
+     * @param i_tensor_left left input tensor.
+     * @param i_tensor_right right input tensor.
+     * @param i_tensor_out_aux auxiliary output tensor, required for COPY first touches.
+     * @param io_tensor_out output tensor.
+     **/
+    static void contract( T const * i_tensor_left,
+                          T const * i_tensor_right,
+                          T const * i_tensor_out_aux,
+                          T       * io_tensor_out ) {
+      static_assert( KTYPE_MAIN == kernel_t::MADD || KTYPE_MAIN == kernel_t::BR_MADD,
+                     "the main kernel has to be MADD or BR_MADD" );
+      static_assert(    KTYPE_FIRST_TOUCH == kernel_t::UNDEFINED_KTYPE
+                     || KTYPE_FIRST_TOUCH == kernel_t::ZERO
+                     || KTYPE_FIRST_TOUCH == kernel_t::COPY,
+                     "the first-touch kernel has to be ZERO, COPY or UNDEFINED_KTYPE" );
+      static_assert(    KTYPE_LAST_TOUCH == kernel_t::UNDEFINED_KTYPE
+                     || KTYPE_LAST_TOUCH == kernel_t::RELU,
+                     "the last-touch kernel has to be RELU or UNDEFINED_KTYPE" );
+      static_assert( valid_iters(),
+                     "the loop nest has to consist of SEQ iterations followed by the PRIM iterations of the main kernel" );
+
+      contract_iter< 0 >( true,
+                          true,
+                          i_tensor_left,
+                          i_tensor_right,
+                          i_tensor_out_aux,
+                          io_tensor_out );
+    }
+
+    /**
+     * Performs the contraction on the given data.
+     *
+     * @param i_tensor_left left input tensor.
+     * @param i_tensor_right right input tensor.
+     * @param io_tensor_out output tensor.
+     **/
+    static void contract( T const * i_tensor_left,
+                          T const * i_tensor_right,
+                          T       * io_tensor_out ) {
+      contract( i_tensor_left,
+                i_tensor_right,
+                nullptr,
+                io_tensor_out );
+    }
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "catch.hpp"
+#include "ContractionStatic.h"
+#include "ContractionBackendSimd.h"
+
+TEST_CASE( "Batch-reduce matmul with sequential K and C dimensions using the static contraction.", "[contraction_static]" ) {
+  // Test Case:
+  //
+  //      _____cnm_____
+  //     /             \
+  // ckbm               cnkb
+  //
+  // char   id   size
+  //    c    0      2
+  //    k    1      3
+  //    b    2      2
+  //    m    3     13
+  //    n    4      5
+  //    l    5      4  (primitive k)
+  //
+  // the left tensor is stored as c k b l m, the right one as c n k b l
+  using namespace einsum_ir::basic;
+
+  typedef ContractionStatic< float,
+                             kernel_t::ZERO,
+                             kernel_t::BR_MADD,
+                             kernel_t::RELU,
+                             static_iter< dim_t::C, exec_t::SEQ,   2, 3*2*4*13, 5*3*2*4, 0, 5*13 >,
+                             static_iter< dim_t::K, exec_t::SEQ,   3,   2*4*13,     2*4, 0,    0 >,
+                             static_iter< dim_t::K, exec_t::PRIM,  2,     4*13,       4, 0,    0 >,
+                             static_iter< dim_t::M, exec_t::PRIM, 13,        1,       0, 0,    1 >,
+                             static_iter< dim_t::N, exec_t::PRIM,  5,        0,   3*2*4, 0,   13 >,
+                             static_iter< dim_t::K, exec_t::PRIM,  4,       13,       1, 0,    0 > > contraction_t;
+
+  // data
+  std::vector< float > l_left(  2*3*2*4*13 );
+  std::vector< float > l_right( 2*5*3*2*4 );
+  std::vector< float > l_out_ref( 2*5*13, 0 );
+
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = ( (l_en * 7) % 13 ) / 6.0f - 1.0f;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = ( (l_en * 5) % 11 ) / 5.0f - 1.0f;
+  }
+
+  // reference
+  for( int64_t l_c = 0; l_c < 2; l_c++ ) {
+    for( int64_t l_n = 0; l_n < 5; l_n++ ) {
+      for( int64_t l_m = 0; l_m < 13; l_m++ ) {
+        float l_sum = 0;
+        for( int64_t l_k = 0; l_k < 3; l_k++ ) {
+          for( int64_t l_b = 0; l_b < 2; l_b++ ) {
+            for( int64_t l_l = 0; l_l < 4; l_l++ ) {
+              l_sum +=   l_left[  (((l_c * 3 + l_k) * 2 + l_b) * 4 + l_l) * 13 + l_m ]
+                       * l_right[ (((l_c * 5 + l_n) * 3 + l_k) * 2 + l_b) * 4 + l_l ];
+            }
+          }
+        }
+        l_out_ref[ (l_c * 5 + l_n) * 13 + l_m ] = std::max( l_sum, 0.0f );
+      }
+    }
+  }
+
+  std::vector< float > l_out( l_out_ref.size(), 1.0f );
+  contraction_t::contract( l_left.data(),
+                           l_right.data(),
+                           l_out.data() );
+
+  for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+    REQUIRE( l_out[l_en] == Approx( l_out_ref[l_en] ).margin( 1E-5 ) );
+  }
+
+  // the iterations initialize a runtime backend with the same loop nest
+  std::vector< iter_property > l_iters = contraction_t::iters();
+  REQUIRE( l_iters.size() == 6 );
+  REQUIRE( l_iters[1].dim_type == dim_t::K );
+  REQUIRE( l_iters[1].size == 3 );
+  REQUIRE( l_iters[4].stride_right == 3*2*4 );
+
+  ContractionBackendSimd l_backend;
+  l_backend.init( l_iters,
+                  data_t::FP32,
+                  data_t::FP32,
+                  data_t::FP32,
+                  data_t::FP32,
+                  kernel_t::ZERO,
+                  kernel_t::BR_MADD,
+                  kernel_t::RELU,
+                  1,
+                  1,
+                  1,
+                  nullptr );
+  REQUIRE( l_backend.compile() == err_t::SUCCESS );
+
+  std::vector< float > l_out_backend( l_out_ref.size(), 1.0f );
+  l_backend.contract( l_left.data(),
+                      l_right.data(),
+                      nullptr,
+                      l_out_backend.data() );
+
+  for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+    REQUIRE( l_out_backend[l_en] == Approx( l_out[l_en] ).margin( 1E-5 ) );
+  }
+}
+
+TEST_CASE( "FP64 matmul with bias and transposed A using the static contraction.", "[contraction_static]" ) {
+  // Test Case:
+  //
+  //     ___nm___
+  //    /        \
+  //  mk          nk
+  //
+  // char   id   size
+  //    m    0      7
+  //    n    1      3
+  //    k    2      5
+  //
+  // the bias is broadcast in the m dimension
+  using namespace einsum_ir::basic;
+
+  typedef ContractionStatic< double,
+                             kernel_t::COPY,
+                             kernel_t::MADD,
+                             kernel_t::UNDEFINED_KTYPE,
+                             static_iter< dim_t::M, exec_t::PRIM, 7, 5, 0, 0, 1 >,
+                             static_iter< dim_t::N, exec_t::PRIM, 3, 0, 5, 1, 7 >,
+                             static_iter< dim_t::K, exec_t::PRIM, 5, 1, 1, 0, 0 > > contraction_t;
+
+  // data
+  std::vector< double > l_left(  7*5 );
+  std::vector< double > l_right( 3*5 );
+  std::vector< double > l_bias(  3 );
+  std::vector< double > l_out_ref( 3*7 );
+
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = ( (l_en * 7) % 13 ) / 6.0 - 1.0;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = ( (l_en * 5) % 11 ) / 5.0 - 1.0;
+  }
+  for( int64_t l_n = 0; l_n < 3; l_n++ ) {
+    l_bias[l_n] = l_n - 1.5;
+  }
+
+  // reference
+  for( int64_t l_n = 0; l_n < 3; l_n++ ) {
+    for( int64_t l_m = 0; l_m < 7; l_m++ ) {
+      double l_sum = l_bias[l_n];
+      for( int64_t l_k = 0; l_k < 5; l_k++ ) {
+        l_sum += l_left[ l_m * 5 + l_k ] * l_right[ l_n * 5 + l_k ];
+      }
+      l_out_ref[ l_n * 7 + l_m ] = l_sum;
+    }
+  }
+
+  std::vector< double > l_out( l_out_ref.size(), 1.0 );
+  contraction_t::contract( l_left.data(),
+                           l_right.data(),
+                           l_bias.data(),
+                           l_out.data() );
+
+  for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+    REQUIRE( l_out[l_en] == Approx( l_out_ref[l_en] ) );
+  }
+}
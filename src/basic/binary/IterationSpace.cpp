@@ -41,9 +41,6 @@ einsum_ir::basic::err_t einsum_ir::basic::IterationSpace::setup( std::vector< in
       }
       m_shared_tasks *= m_sizes->at(l_id);
       m_shared_loops.end = l_id + 1;
-      if( m_dim_types->at(l_id) == dim_t::K ){
-        return err_t::COMPILATION_FAILED;
-      }
     }
     if( m_exec_types->at(l_id) == exec_t::SFC ){
       l_num_sfc_loops++;
@@ -125,6 +122,7 @@ einsum_ir::basic::err_t einsum_ir::basic::IterationSpace::setup( std::vector< in
     l_end_shared   = l_end_shared   <= m_shared_tasks ? l_end_shared   : m_shared_tasks;
     io_thread_infos[l_thread_id].id_shared_loop_start = l_begin_shared;
     io_thread_infos[l_thread_id].id_shared_loop_end   = l_end_shared;
+    io_thread_infos[l_thread_id].id_sfc_group         = l_thread_id_m + l_thread_id_n * m_num_threads_m;
     
     //set start ids
     int64_t l_id_sfc_m_old = l_begin_m;
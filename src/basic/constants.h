@@ -19,6 +19,15 @@ namespace einsum_ir {
       BR_MADD         = 12,
       PACKED_MADD     = 13,
       CPX_PACKED_MADD = 14,
+      GELU            = 15,
+      SILU            = 16,
+      SIGMOID         = 17,
+      TANH            = 18,
+      CLAMP           = 19,
+      SCALE_SHIFT     = 20,
+      ADD_RELU        = 21,
+      ADD_GELU        = 22,
+      ADD_SILU        = 23,
       UNDEFINED_KTYPE = 99
     } kernel_t;
 
@@ -43,6 +52,10 @@ namespace einsum_ir {
     typedef enum {
       FP32            = 0,
       FP64            = 1,
+      BF16            = 2,
+      FP16            = 3,
+      I8              = 4,
+      I32             = 5,
       UNDEFINED_DTYPE = 99
     } data_t;
 
@@ -54,12 +67,32 @@ namespace einsum_ir {
       UNDEFINED_EXECTYPE = 99
     } exec_t;
 
+    typedef enum {
+      STATIC  = 0, // every thread executes a fixed range of shared tasks
+      DYNAMIC = 1, // threads claim chunks of shared tasks at runtime
+      UNDEFINED_SCHEDTYPE = 99
+    } sched_t;
+
+    typedef enum {
+      BASE_PAGES         = 0, // base pages of the system, e.g., 4 KiB
+      THP_PAGES          = 1, // transparent huge pages, e.g., 2 MiB
+      HUGETLB_PAGES      = 2, // explicit huge pages of the hugetlbfs pool
+      UNDEFINED_PAGETYPE = 99
+    } page_t;
+
     typedef enum {
       NONE           = 0, // no packed gemm
       ALL_STRIDE_ONE = 1, // all dimensions have stride one
       OUT_STRIDE_ONE = 2  // output dimension has stride one
     } packed_gemm_t;
 
+    typedef enum {
+      VEC128          = 0, // 128-bit vectors of the baseline instruction set, e.g., SSE2 or NEON
+      AVX2            = 1, // 256-bit vectors with fused multiply-adds
+      AVX512          = 2, // 512-bit vectors
+      UNDEFINED_ISA   = 99
+    } isa_t;
+
     typedef uint8_t sfc_t;
 
     struct thread_info {
@@ -72,6 +105,7 @@ namespace einsum_ir {
 
       int64_t id_shared_loop_start = 0;
       int64_t id_shared_loop_end   = 0;
+      int64_t id_sfc_group         = 0;
 
       int64_t sfc_size_m = 0;
       int64_t sfc_size_n = 0;
@@ -94,9 +128,50 @@ namespace einsum_ir {
       int64_t packing_stride_right = 0;
     };
 
+    // requantization of INT32 accumulators: out = scale * acc (+ zero_point for INT8 outputs)
+    struct quant_params {
+      float const * scales         = nullptr; // one scale per channel or a single scale for the tensor
+      int64_t       num_scales     = 1;       // number of scales, 1 for per-tensor scaling
+      int64_t       stride_channel = 0;       // stride of the channel dimension in the output tensor
+      int32_t       zero_point     = 0;       // zero point of INT8 outputs
+    };
+
+    // parameters of the last-touch kernels SCALE_SHIFT (out = scale * out + shift) and CLAMP (out = min( max( out, clamp_min ), clamp_max ))
+    struct last_touch_params {
+      double scale     = 1.0;
+      double shift     = 0.0;
+      double clamp_min = 0.0;
+      double clamp_max = 6.0;
+    };
+
+    // block sparsity of an input tensor: a mask over the blocks, which are given by the indices of the block dimensions
+    struct block_sparsity {
+      uint8_t const *        mask = nullptr; // one entry per block, zero if all values of the block are zero
+      std::vector< int64_t > strides;        // strides of the block dimensions in the tensor
+      std::vector< int64_t > sizes;          // sizes of the block dimensions in the tensor
+      std::vector< int64_t > strides_mask;   // strides of the block dimensions in the mask
+    };
+
+    // parameters of the contraction optimizer, e.g., selected by an autotuner; zero values keep the backend's defaults
+    struct optimizer_config {
+      int64_t target_m           = 0;     // target size of the primitive m dimension
+      int64_t target_n           = 0;     // target size of the primitive n dimension
+      int64_t target_k           = 0;     // target size of the primitive k dimension
+      int64_t l2_cache_size      = 0;     // size of the L2 cache in bytes
+      bool    generate_sfcs      = true;  // parallelizes the m and n dimensions through SFCs instead of shared loops
+      bool    packing            = true;  // allows packing of the input tensors if supported by the backend
+      int64_t num_threads_shared = 0;     // threads of the shared loops, zero if the thread split is derived by the optimizer
+      int64_t num_threads_m      = 0;     // threads of the m dimension's SFC
+      int64_t num_threads_n      = 0;     // threads of the n dimension's SFC
+    };
+
     constexpr int64_t ce_n_bytes( data_t i_dtype ) {
       if(      i_dtype == FP32 )  return 4;
       else if( i_dtype == FP64 )  return 8;
+      else if( i_dtype == BF16 )  return 2;
+      else if( i_dtype == FP16 )  return 2;
+      else if( i_dtype == I8   )  return 1;
+      else if( i_dtype == I32  )  return 4;
       else                        return -1;
     }
   }
@@ -0,0 +1,43 @@
+#ifndef EINSUM_IR_BASIC_ENV
+#define EINSUM_IR_BASIC_ENV
+
+#include <cstdlib>
+#include <string>
+
+namespace einsum_ir {
+  namespace basic {
+
+    /**
+     * @brief Read a string from the environment
+     *
+     * @param i_name name of the environment variable.
+     * @return value of the variable, empty if not set
+     **/
+    inline std::string env_string( char const * i_name ) {
+      char const * l_value = std::getenv( i_name );
+      return l_value != nullptr ? std::string( l_value ) : std::string();
+    }
+
+    /**
+     * @brief Read a boolean flag from the environment
+     *
+     * The values "1" and "true" enable the flag, all other values disable it.
+     *
+     * @param i_name name of the environment variable.
+     * @param i_default value of the flag if the variable is not set.
+     * @return value of the flag
+     **/
+    inline bool env_flag( char const * i_name,
+                          bool         i_default ) {
+      char const * l_value = std::getenv( i_name );
+      if( l_value == nullptr ) {
+        return i_default;
+      }
+      std::string l_str( l_value );
+      return l_str == "1" || l_str == "true";
+    }
+
+  }
+}
+
+#endif
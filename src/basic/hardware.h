@@ -0,0 +1,392 @@
+#ifndef EINSUM_IR_BASIC_HARDWARE
+#define EINSUM_IR_BASIC_HARDWARE
+
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <string>
+#include "numa.h"
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#if defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#include <sys/prctl.h>
+#include <asm/hwcap.h>
+#endif
+
+namespace einsum_ir {
+  namespace basic {
+
+    /**
+     * @brief Get a description of the host CPU
+     *
+     * x86 reports the model name, arm the implementer and part of the first processor.
+     * Plans and tuning results are only valid on the CPU they were derived for.
+     *
+     * @return Description of the host CPU
+     **/
+    inline std::string host_cpu() {
+      std::string l_arch = "unknown";
+#if defined(__x86_64__)
+      l_arch = "x86_64";
+#elif defined(__aarch64__)
+      l_arch = "aarch64";
+#endif
+
+      std::string l_model = "";
+      std::ifstream l_cpuinfo( "/proc/cpuinfo" );
+      std::string l_line;
+      while( std::getline( l_cpuinfo, l_line ) ) {
+        if(    l_line.rfind( "model name", 0 ) == 0
+            || l_line.rfind( "CPU implementer", 0 ) == 0
+            || l_line.rfind( "CPU part", 0 ) == 0 ) {
+          std::size_t l_sep = l_line.find( ':' );
+          if( l_sep != std::string::npos ) {
+            l_model += "|" + l_line.substr( l_sep + 1 );
+          }
+        }
+        // first processor only
+        if( l_line.empty() && !l_model.empty() ) {
+          break;
+        }
+      }
+
+      return l_arch + l_model;
+    }
+
+    /**
+     * @brief Get the micro-architecture of the host CPU if a GEMM performance model exists for it
+     *
+     * Zen5 is identified by AMD's family 26, Cortex-A76 by ARM's part 0xd0b and M4 by the brand string.
+     * The names match the models of the performance model library.
+     *
+     * @return "zen5", "m4" or "a76", empty if no model matches the host
+     **/
+    inline std::string host_uarch() {
+#if defined(__APPLE__)
+      char l_brand[256] = { 0 };
+      std::size_t l_size = sizeof(l_brand) - 1;
+      if(    sysctlbyname( "machdep.cpu.brand_string", l_brand, &l_size, nullptr, 0 ) == 0
+          && std::string( l_brand ).find( "Apple M4" ) != std::string::npos ) {
+        return "m4";
+      }
+      return "";
+#else
+      std::string l_vendor = "";
+      std::string l_family = "";
+      std::string l_implementer = "";
+      std::string l_part = "";
+
+      std::ifstream l_cpuinfo( "/proc/cpuinfo" );
+      std::string l_line;
+      while( std::getline( l_cpuinfo, l_line ) ) {
+        std::size_t l_sep = l_line.find( ':' );
+        if( l_sep == std::string::npos ) {
+          // first processor only
+          if( l_line.empty() && ( !l_vendor.empty() || !l_implementer.empty() ) ) {
+            break;
+          }
+          continue;
+        }
+        std::size_t l_begin = l_line.find_first_not_of( " \t", l_sep + 1 );
+        std::string l_value = l_begin == std::string::npos ? "" : l_line.substr( l_begin );
+
+        if(      l_line.rfind( "vendor_id", 0 ) == 0 )       l_vendor = l_value;
+        else if( l_line.rfind( "cpu family", 0 ) == 0 )      l_family = l_value;
+        else if( l_line.rfind( "CPU implementer", 0 ) == 0 ) l_implementer = l_value;
+        else if( l_line.rfind( "CPU part", 0 ) == 0 )        l_part = l_value;
+      }
+
+      if( l_vendor == "AuthenticAMD" && l_family == "26" ) {
+        return "zen5";
+      }
+      if( l_implementer == "0x41" && l_part == "0xd0b" ) {
+        return "a76";
+      }
+      return "";
+#endif
+    }
+
+    /**
+     * Properties of the host which seed the defaults of the optimizers.
+     * Cache sizes are the share of a single core, i.e., the size of a cache instance divided by the number of cores using it.
+     **/
+    struct hardware_info {
+      int64_t l1d_cache_size     = 32 * 1024;   // L1 data cache in bytes
+      int64_t l2_cache_size      = 1024 * 1024; // L2 cache in bytes
+      int64_t l3_cache_size      = 0;           // L3 cache in bytes, 0 if not present
+      int64_t simd_width         = 16;          // width of the vector registers in bytes
+      int64_t num_smt_siblings   = 1;           // hardware threads per core
+      int64_t num_cores          = 1;           // physical cores
+      int64_t num_cores_affinity = 0;           // physical cores in the affinity mask of the process, 0 if unknown
+      int64_t num_ccxs           = 1;           // groups of cores sharing the last level cache
+      int64_t num_sockets        = 1;           // sockets
+      int64_t num_numa_nodes     = 1;           // NUMA nodes
+    };
+
+    /**
+     * @brief Read the first line of a sysfs file
+     *
+     * @param i_path path of the file
+     * @return first line, empty if the file does not exist
+     **/
+    inline std::string sysfs_read( std::string const & i_path ) {
+      std::ifstream l_file( i_path );
+      std::string l_line;
+      std::getline( l_file, l_line );
+      return l_line;
+    }
+
+    /**
+     * @brief Parse a sysfs size, e.g., "48K"
+     *
+     * @param i_value size with an optional K, M or G suffix
+     * @return size in bytes, 0 if the value could not be parsed
+     **/
+    inline int64_t sysfs_size( std::string const & i_value ) {
+      std::size_t l_end = 0;
+      int64_t l_size = 0;
+      try {
+        l_size = std::stoll( i_value, &l_end );
+      }
+      catch( ... ) {
+        return 0;
+      }
+      if( l_end < i_value.size() ) {
+        char l_suffix = i_value[l_end];
+        if(      l_suffix == 'K' ) l_size *= 1024;
+        else if( l_suffix == 'M' ) l_size *= 1024 * 1024;
+        else if( l_suffix == 'G' ) l_size *= 1024 * 1024 * 1024;
+      }
+      return l_size;
+    }
+
+    /**
+     * @brief Parse a sysfs CPU list, e.g., "0-3,8-11"
+     *
+     * @param i_list CPU list
+     * @return ids of the listed CPUs
+     **/
+    inline std::set< int64_t > sysfs_cpu_list( std::string const & i_list ) {
+      std::set< int64_t > l_cpus;
+      std::size_t l_pos = 0;
+      while( l_pos < i_list.size() ) {
+        std::size_t l_sep = i_list.find( ',', l_pos );
+        if( l_sep == std::string::npos ) {
+          l_sep = i_list.size();
+        }
+        std::string l_range = i_list.substr( l_pos, l_sep - l_pos );
+        std::size_t l_dash = l_range.find( '-' );
+        try {
+          int64_t l_first = std::stoll( l_range.substr( 0, l_dash ) );
+          int64_t l_last = l_dash == std::string::npos ? l_first : std::stoll( l_range.substr( l_dash + 1 ) );
+          for( int64_t l_cpu = l_first; l_cpu <= l_last; l_cpu++ ) {
+            l_cpus.insert( l_cpu );
+          }
+        }
+        catch( ... ) {}
+        l_pos = l_sep + 1;
+      }
+      return l_cpus;
+    }
+
+    /**
+     * @brief Query the caches, SIMD width and topology of the host
+     *
+     * Linux is queried through sysfs, x86 falls back to cpuid if sysfs does not expose the caches.
+     * macOS reports the performance cores.
+     * Values which cannot be queried keep the defaults of hardware_info.
+     *
+     * @return properties of the host
+     **/
+    inline hardware_info query_hardware() {
+      hardware_info l_hw;
+
+#if defined(__APPLE__)
+      auto l_sysctl = []( char const * i_name ) {
+        int64_t l_value = 0;
+        std::size_t l_size = sizeof(l_value);
+        if( sysctlbyname( i_name, &l_value, &l_size, nullptr, 0 ) != 0 ) {
+          return int64_t(0);
+        }
+        return l_size == sizeof(int32_t) ? int64_t( *reinterpret_cast< int32_t * >( &l_value ) ) : l_value;
+      };
+
+      int64_t l_num_cores = l_sysctl( "hw.perflevel0.physicalcpu" );
+      if( l_num_cores > 0 ) {
+        l_hw.num_cores = l_num_cores;
+      }
+      int64_t l_l1d = l_sysctl( "hw.perflevel0.l1dcachesize" );
+      if( l_l1d > 0 ) {
+        l_hw.l1d_cache_size = l_l1d;
+      }
+      int64_t l_l2 = l_sysctl( "hw.perflevel0.l2cachesize" );
+      int64_t l_cpus_per_l2 = l_sysctl( "hw.perflevel0.cpusperl2" );
+      if( l_l2 > 0 ) {
+        l_hw.l2_cache_size = l_l2 / ( l_cpus_per_l2 > 0 ? l_cpus_per_l2 : 1 );
+        l_hw.num_ccxs = l_cpus_per_l2 > 0 ? ( l_hw.num_cores + l_cpus_per_l2 - 1 ) / l_cpus_per_l2 : 1;
+      }
+      int64_t l_num_sockets = l_sysctl( "hw.packages" );
+      if( l_num_sockets > 0 ) {
+        l_hw.num_sockets = l_num_sockets;
+      }
+#else
+      std::string l_dir_cpu = "/sys/devices/system/cpu/";
+      std::set< int64_t > l_cpus = sysfs_cpu_list( sysfs_read( l_dir_cpu + "online" ) );
+      std::string l_dir_cpu0 = l_dir_cpu + "cpu" + std::to_string( l_cpus.empty() ? 0 : *l_cpus.begin() ) + "/";
+
+      // SMT siblings and sockets
+      std::set< int64_t > l_siblings = sysfs_cpu_list( sysfs_read( l_dir_cpu0 + "topology/thread_siblings_list" ) );
+      if( !l_siblings.empty() ) {
+        l_hw.num_smt_siblings = l_siblings.size();
+      }
+      std::set< std::string > l_packages;
+      for( int64_t l_cpu : l_cpus ) {
+        std::string l_package = sysfs_read( l_dir_cpu + "cpu" + std::to_string( l_cpu ) + "/topology/physical_package_id" );
+        if( !l_package.empty() ) {
+          l_packages.insert( l_package );
+        }
+      }
+      if( !l_packages.empty() ) {
+        l_hw.num_sockets = l_packages.size();
+      }
+      if( !l_cpus.empty() ) {
+        l_hw.num_cores = l_cpus.size() / l_hw.num_smt_siblings;
+        if( l_hw.num_cores < 1 ) {
+          l_hw.num_cores = 1;
+        }
+      }
+      l_hw.num_ccxs = l_hw.num_sockets;
+
+  #if defined(__linux__)
+      // physical cores in the affinity mask, i.e., SMT siblings are counted once
+      cpu_set_t l_mask;
+      CPU_ZERO( &l_mask );
+      if( sched_getaffinity( 0, sizeof(l_mask), &l_mask ) == 0 ) {
+        std::set< int64_t > l_cores;
+        for( int64_t l_cpu = 0; l_cpu < CPU_SETSIZE; l_cpu++ ) {
+          if( CPU_ISSET( l_cpu, &l_mask ) ) {
+            std::set< int64_t > l_siblings_cpu = sysfs_cpu_list( sysfs_read( l_dir_cpu + "cpu" + std::to_string( l_cpu ) + "/topology/thread_siblings_list" ) );
+            l_cores.insert( l_siblings_cpu.empty() ? l_cpu : *l_siblings_cpu.begin() );
+          }
+        }
+        l_hw.num_cores_affinity = l_cores.size();
+      }
+  #endif
+
+      // caches
+      bool l_found_caches = false;
+      for( int64_t l_id = 0; l_id < 16; l_id++ ) {
+        std::string l_dir_cache = l_dir_cpu0 + "cache/index" + std::to_string( l_id ) + "/";
+        std::string l_level = sysfs_read( l_dir_cache + "level" );
+        if( l_level.empty() ) {
+          break;
+        }
+        if( sysfs_read( l_dir_cache + "type" ) == "Instruction" ) {
+          continue;
+        }
+
+        int64_t l_size = sysfs_size( sysfs_read( l_dir_cache + "size" ) );
+        int64_t l_num_sharing = sysfs_cpu_list( sysfs_read( l_dir_cache + "shared_cpu_list" ) ).size();
+        int64_t l_num_cores_sharing = l_num_sharing / l_hw.num_smt_siblings;
+        if( l_num_cores_sharing < 1 ) {
+          l_num_cores_sharing = 1;
+        }
+        if( l_size <= 0 ) {
+          continue;
+        }
+        l_found_caches = true;
+
+        if( l_level == "1" ) {
+          l_hw.l1d_cache_size = l_size;
+        }
+        else if( l_level == "2" ) {
+          l_hw.l2_cache_size = l_size / l_num_cores_sharing;
+        }
+        else if( l_level == "3" ) {
+          l_hw.l3_cache_size = l_size / l_num_cores_sharing;
+          l_hw.num_ccxs = ( l_hw.num_cores + l_num_cores_sharing - 1 ) / l_num_cores_sharing;
+        }
+      }
+
+  #if defined(__x86_64__)
+      // deterministic cache parameters: leaf 4 on Intel, 0x8000001D on AMD
+      unsigned int l_eax, l_ebx, l_ecx, l_edx;
+      unsigned int l_leaf = 4;
+      if(    __get_cpuid( 0, &l_eax, &l_ebx, &l_ecx, &l_edx )
+          && l_ebx == 0x68747541 ) { // "Auth"enticAMD
+        l_leaf = 0x8000001D;
+      }
+      for( unsigned int l_sub = 0; !l_found_caches && l_sub < 16; l_sub++ ) {
+        if(    __get_cpuid_max( l_leaf & 0x80000000, nullptr ) < l_leaf
+            || !__get_cpuid_count( l_leaf, l_sub, &l_eax, &l_ebx, &l_ecx, &l_edx ) ) {
+          break;
+        }
+        unsigned int l_type = l_eax & 0x1F;
+        if( l_type == 0 ) {
+          break;
+        }
+        if( l_type == 2 ) {
+          continue;
+        }
+        unsigned int l_level = (l_eax >> 5) & 0x7;
+        int64_t l_size = int64_t( (l_ebx >> 22) + 1 )
+                       * int64_t( ((l_ebx >> 12) & 0x3FF) + 1 )
+                       * int64_t( (l_ebx & 0xFFF) + 1 )
+                       * int64_t( l_ecx + 1 );
+        int64_t l_num_cores_sharing = ( ((l_eax >> 14) & 0xFFF) + 1 ) / l_hw.num_smt_siblings;
+        if( l_num_cores_sharing < 1 ) {
+          l_num_cores_sharing = 1;
+        }
+
+        if(      l_level == 1 ) l_hw.l1d_cache_size = l_size;
+        else if( l_level == 2 ) l_hw.l2_cache_size = l_size / l_num_cores_sharing;
+        else if( l_level == 3 ) l_hw.l3_cache_size = l_size / l_num_cores_sharing;
+      }
+  #endif
+
+      // NUMA nodes
+      std::set< int64_t > l_nodes = sysfs_cpu_list( sysfs_read( "/sys/devices/system/node/online" ) );
+      l_hw.num_numa_nodes = l_nodes.empty() ? get_num_numa_nodes() : l_nodes.size();
+#endif
+
+      // SIMD width
+#if defined(__x86_64__)
+      __builtin_cpu_init();
+      if(      __builtin_cpu_supports( "avx512f" ) ) l_hw.simd_width = 64;
+      else if( __builtin_cpu_supports( "avx" ) )     l_hw.simd_width = 32;
+#elif defined(__aarch64__) && defined(__linux__) && defined(HWCAP_SVE) && defined(PR_SVE_GET_VL)
+      if( getauxval( AT_HWCAP ) & HWCAP_SVE ) {
+        int l_vl = prctl( PR_SVE_GET_VL );
+        if( l_vl > 0 ) {
+          l_hw.simd_width = l_vl & PR_SVE_VL_LEN_MASK;
+        }
+      }
+#endif
+
+      return l_hw;
+    }
+
+    /**
+     * @brief Get the properties of the host
+     *
+     * The host is queried once, later calls return the cached result.
+     *
+     * @return properties of the host
+     **/
+    inline hardware_info const & get_hardware() {
+      static hardware_info const l_hw = query_hardware();
+      return l_hw;
+    }
+
+  }
+}
+
+#endif
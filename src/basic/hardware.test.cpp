@@ -0,0 +1,35 @@
+#include "catch.hpp"
+#include "hardware.h"
+
+TEST_CASE( "Parsing of sysfs values.", "[hardware]" ) {
+  REQUIRE( einsum_ir::basic::sysfs_size( "48K" ) == 48 * 1024 );
+  REQUIRE( einsum_ir::basic::sysfs_size( "2M" ) == 2 * 1024 * 1024 );
+  REQUIRE( einsum_ir::basic::sysfs_size( "512" ) == 512 );
+  REQUIRE( einsum_ir::basic::sysfs_size( "" ) == 0 );
+
+  std::set< int64_t > l_cpus = einsum_ir::basic::sysfs_cpu_list( "0-3,8-9,15" );
+  REQUIRE( l_cpus.size() == 7 );
+  REQUIRE( l_cpus.count( 3 ) == 1 );
+  REQUIRE( l_cpus.count( 4 ) == 0 );
+  REQUIRE( l_cpus.count( 15 ) == 1 );
+  REQUIRE( einsum_ir::basic::sysfs_cpu_list( "" ).empty() );
+}
+
+TEST_CASE( "Querying the hardware of the host.", "[hardware]" ) {
+  einsum_ir::basic::hardware_info const & l_hw = einsum_ir::basic::get_hardware();
+
+  REQUIRE( l_hw.l1d_cache_size > 0 );
+  REQUIRE( l_hw.l2_cache_size > 0 );
+  REQUIRE( l_hw.l3_cache_size >= 0 );
+  REQUIRE( l_hw.simd_width >= 16 );
+  REQUIRE( l_hw.num_smt_siblings >= 1 );
+  REQUIRE( l_hw.num_cores >= 1 );
+  REQUIRE( l_hw.num_cores_affinity >= 0 );
+  REQUIRE( l_hw.num_ccxs >= 1 );
+  REQUIRE( l_hw.num_ccxs <= l_hw.num_cores );
+  REQUIRE( l_hw.num_sockets >= 1 );
+  REQUIRE( l_hw.num_numa_nodes >= 1 );
+
+  // cached
+  REQUIRE( &einsum_ir::basic::get_hardware() == &l_hw );
+}
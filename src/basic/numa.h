@@ -0,0 +1,66 @@
+#ifndef EINSUM_IR_BASIC_NUMA
+#define EINSUM_IR_BASIC_NUMA
+
+#include <cstdint>
+
+#if defined(EINSUM_IR_USE_NUMA)
+  #include <numa.h>
+#endif
+
+namespace einsum_ir {
+  namespace basic {
+
+    /**
+     * @brief Get the number of NUMA nodes
+     *
+     * @return Number of configured NUMA nodes (always >= 1)
+     **/
+    inline int64_t get_num_numa_nodes() {
+#if defined(EINSUM_IR_USE_NUMA)
+      if( numa_available() >= 0 ) {
+        return static_cast<int64_t>( numa_num_configured_nodes() );
+      }
+#endif
+      return 1;
+    }
+
+    /**
+     * @brief Interleave memory pages round-robin across all NUMA nodes
+     *
+     * Intended for buffers which are read by all threads.
+     * Only pages entirely inside the buffer are affected and the call has to
+     * happen before the pages are touched for the first time.
+     * Without libnuma or on single-node systems this is a no-op.
+     *
+     * @param i_ptr Pointer to the buffer
+     * @param i_size Size of the buffer in bytes
+     **/
+    inline void numa_interleave( void    * i_ptr,
+                                 int64_t   i_size ) {
+#if defined(EINSUM_IR_USE_NUMA)
+      if( get_num_numa_nodes() < 2 ) {
+        return;
+      }
+
+      uintptr_t l_page_size = static_cast<uintptr_t>( numa_pagesize() );
+      uintptr_t l_first = reinterpret_cast<uintptr_t>( i_ptr );
+      uintptr_t l_end   = l_first + static_cast<uintptr_t>( i_size );
+
+      l_first = (l_first + l_page_size - 1) / l_page_size * l_page_size;
+      l_end   =  l_end                      / l_page_size * l_page_size;
+
+      if( l_first < l_end ) {
+        numa_interleave_memory( reinterpret_cast<void *>( l_first ),
+                                l_end - l_first,
+                                numa_all_nodes_ptr );
+      }
+#else
+      (void) i_ptr;
+      (void) i_size;
+#endif
+    }
+
+  }
+}
+
+#endif
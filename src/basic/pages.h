@@ -0,0 +1,160 @@
+#ifndef EINSUM_IR_BASIC_PAGES
+#define EINSUM_IR_BASIC_PAGES
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "constants.h"
+
+namespace einsum_ir {
+  namespace basic {
+
+    /**
+     * @brief Get the size of the system's base pages
+     *
+     * @return Base page size in bytes
+     **/
+    inline int64_t get_base_page_size() {
+      long l_size = sysconf( _SC_PAGESIZE );
+      return l_size > 0 ? static_cast<int64_t>( l_size ) : 4096;
+    }
+
+    /**
+     * @brief Get the size of huge pages
+     *
+     * @return Huge page size in bytes, 2 MiB if not reported by the system
+     **/
+    inline int64_t get_huge_page_size() {
+      int64_t l_size = 0;
+      std::ifstream l_file( "/sys/kernel/mm/transparent_hugepage/hpage_pmd_size" );
+      if( !(l_file >> l_size) || l_size <= 0 ) {
+        l_size = 2097152;
+      }
+      return l_size;
+    }
+
+    /**
+     * @brief Check if transparent huge pages may be requested through madvise
+     *
+     * @return true if transparent huge pages are enabled for madvise regions
+     **/
+    inline bool supports_thp_pages() {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+      std::ifstream l_file( "/sys/kernel/mm/transparent_hugepage/enabled" );
+      std::string l_mode;
+      if( !std::getline( l_file, l_mode ) ) {
+        return false;
+      }
+      return l_mode.find( "[never]" ) == std::string::npos;
+#else
+      return false;
+#endif
+    }
+
+    /**
+     * @brief Allocate zero-initialized memory backed by the given type of pages
+     *
+     * The memory is not touched, i.e., physical pages are placed by the first touch.
+     * Falls back from explicit to transparent huge pages and from transparent huge pages
+     * to base pages if the requested type is unavailable.
+     *
+     * @param i_size Size of the allocation in bytes
+     * @param i_page_type Requested type of pages
+     * @param o_page_size Will be set to the size of the obtained pages in bytes, 0 if the allocation failed
+     * @return Pointer to the memory which is aligned to the obtained page size, nullptr if the allocation failed
+     **/
+    inline void * alloc_pages( int64_t   i_size,
+                               page_t    i_page_type,
+                               int64_t * o_page_size ) {
+      *o_page_size = 0;
+      if( i_size <= 0 ) {
+        return nullptr;
+      }
+
+#if defined(__linux__) && defined(MAP_HUGETLB)
+      if( i_page_type == page_t::HUGETLB_PAGES ) {
+        int64_t l_page_size = get_huge_page_size();
+        int64_t l_size = (i_size + l_page_size - 1) / l_page_size * l_page_size;
+
+        void * l_ptr = mmap( nullptr,
+                             l_size,
+                             PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                             -1,
+                             0 );
+        if( l_ptr != MAP_FAILED ) {
+          *o_page_size = l_page_size;
+          return l_ptr;
+        }
+        i_page_type = page_t::THP_PAGES;
+      }
+#endif
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+      if( i_page_type == page_t::THP_PAGES && supports_thp_pages() ) {
+        int64_t l_page_size = get_huge_page_size();
+        int64_t l_size = (i_size + l_page_size - 1) / l_page_size * l_page_size;
+
+        // over-allocate and trim to obtain huge page alignment
+        char * l_ptr = (char *) mmap( nullptr,
+                                      l_size + l_page_size,
+                                      PROT_READ | PROT_WRITE,
+                                      MAP_PRIVATE | MAP_ANONYMOUS,
+                                      -1,
+                                      0 );
+        if( l_ptr != MAP_FAILED ) {
+          int64_t l_head = (l_page_size - (int64_t)( (uintptr_t) l_ptr % l_page_size )) % l_page_size;
+          if( l_head > 0 ) {
+            munmap( l_ptr, l_head );
+          }
+          munmap( l_ptr + l_head + l_size, l_page_size - l_head );
+          l_ptr += l_head;
+
+          if( madvise( l_ptr, l_size, MADV_HUGEPAGE ) == 0 ) {
+            *o_page_size = l_page_size;
+            return l_ptr;
+          }
+          munmap( l_ptr, l_size );
+        }
+      }
+#endif
+
+      int64_t l_page_size = get_base_page_size();
+      int64_t l_size = (i_size + l_page_size - 1) / l_page_size * l_page_size;
+      void * l_ptr = mmap( nullptr,
+                           l_size,
+                           PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS,
+                           -1,
+                           0 );
+      if( l_ptr == MAP_FAILED ) {
+        return nullptr;
+      }
+      *o_page_size = l_page_size;
+      return l_ptr;
+    }
+
+    /**
+     * @brief Free memory which was allocated through alloc_pages
+     *
+     * @param i_ptr Pointer returned by alloc_pages
+     * @param i_size Size which was passed to alloc_pages
+     * @param i_page_size Page size which was obtained by alloc_pages
+     **/
+    inline void free_pages( void    * i_ptr,
+                            int64_t   i_size,
+                            int64_t   i_page_size ) {
+      if( i_ptr == nullptr || i_page_size <= 0 ) {
+        return;
+      }
+      int64_t l_size = (i_size + i_page_size - 1) / i_page_size * i_page_size;
+      munmap( i_ptr, l_size );
+    }
+
+  }
+}
+
+#endif
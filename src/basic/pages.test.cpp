@@ -0,0 +1,43 @@
+#include "catch.hpp"
+#include "pages.h"
+
+TEST_CASE( "Allocation of memory backed by different types of pages.", "[pages]" ) {
+  einsum_ir::basic::page_t l_page_types[3] = { einsum_ir::basic::page_t::BASE_PAGES,
+                                               einsum_ir::basic::page_t::THP_PAGES,
+                                               einsum_ir::basic::page_t::HUGETLB_PAGES };
+  int64_t l_sizes[3] = { 1, 5000, 5 * 1024 * 1024 + 3 };
+
+  for( int64_t l_ty = 0; l_ty < 3; l_ty++ ) {
+    for( int64_t l_si = 0; l_si < 3; l_si++ ) {
+      int64_t l_page_size = 0;
+      char * l_ptr = (char *) einsum_ir::basic::alloc_pages( l_sizes[l_si],
+                                                             l_page_types[l_ty],
+                                                             &l_page_size );
+
+      // unavailable huge pages fall back to smaller pages
+      REQUIRE( l_ptr != nullptr );
+      REQUIRE( l_page_size >= einsum_ir::basic::get_base_page_size() );
+      REQUIRE( (uintptr_t) l_ptr % l_page_size == 0 );
+      if( l_page_types[l_ty] == einsum_ir::basic::page_t::BASE_PAGES ) {
+        REQUIRE( l_page_size == einsum_ir::basic::get_base_page_size() );
+      }
+
+      // memory is zero-initialized and writable
+      REQUIRE( l_ptr[0] == 0 );
+      REQUIRE( l_ptr[l_sizes[l_si] - 1] == 0 );
+      for( int64_t l_by = 0; l_by < l_sizes[l_si]; l_by++ ) {
+        l_ptr[l_by] = 1;
+      }
+
+      einsum_ir::basic::free_pages( l_ptr,
+                                    l_sizes[l_si],
+                                    l_page_size );
+    }
+  }
+
+  int64_t l_page_size = 0;
+  REQUIRE( einsum_ir::basic::alloc_pages( 0,
+                                          einsum_ir::basic::page_t::BASE_PAGES,
+                                          &l_page_size ) == nullptr );
+  REQUIRE( l_page_size == 0 );
+}
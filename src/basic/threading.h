@@ -2,6 +2,12 @@
 #define EINSUM_IR_BASIC_THREADING
 
 #include <cstdint>
+#include "env.h"
+#include "hardware.h"
+
+#if defined(EINSUM_IR_USE_THREAD_POOL)
+  #include "ThreadPool.h"
+#endif
 
 #if defined(EINSUM_IR_USE_DISPATCH)
   #include <dispatch/dispatch.h>
@@ -17,8 +23,10 @@ namespace einsum_ir {
      * @brief Get available hardware thread count
      *
      * On Apple Silicon, returns P-core (Performance cores) count only.
+     * With OpenMP, SMT siblings share a core's vector units and caches, i.e., at most one thread per physical core
+     * of the process's affinity mask is used unless OMP_NUM_THREADS is set.
      *
-     * @return Number of performance cores (Apple Silicon) or logical CPUs (Intel) (always >= 1)
+     * @return Number of performance cores (Apple Silicon) or physical cores (always >= 1)
      **/
     inline int64_t get_num_threads_available() {
 #if defined(EINSUM_IR_USE_DISPATCH)
@@ -40,8 +48,17 @@ namespace einsum_ir {
       return 1;  // Final fallback
 
 #elif defined(EINSUM_IR_USE_OPENMP)
-      // OpenMP: Use standard API (respects OMP_NUM_THREADS)
-      return static_cast<int64_t>(omp_get_max_threads());
+      // OpenMP: Use standard API (respects OMP_NUM_THREADS and the affinity mask)
+      int64_t l_num_threads = static_cast<int64_t>(omp_get_max_threads());
+
+      // one thread per physical core of the affinity mask if not set explicitly
+      int64_t l_num_cores = get_hardware().num_cores_affinity;
+      if(    env_string( "OMP_NUM_THREADS" ).empty()
+          && l_num_cores > 0
+          && l_num_cores < l_num_threads ) {
+        l_num_threads = l_num_cores;
+      }
+      return l_num_threads;
 
 #else
       // Sequential: Single thread
@@ -52,6 +69,9 @@ namespace einsum_ir {
     /**
      * @brief Execute work function using threaded workers
      *
+     * If EINSUM_IR_USE_THREAD_POOL is defined, the work is executed by the persistent thread pool.
+     * Otherwise, a parallel region of the threading backend is opened for every call.
+     *
      * @tparam WorkFunc Callable with signature void(int64_t thread_id)
      * @param i_num_threads Number of threads to spawn
      * @param i_work Work function, called once per thread with thread ID in [0, i_num_threads)
@@ -65,7 +85,15 @@ namespace einsum_ir {
         return;
       }
 
-#if defined(EINSUM_IR_USE_DISPATCH)
+#if defined(EINSUM_IR_USE_THREAD_POOL)
+      // Persistent thread pool implementation
+      ThreadPool::get().execute( i_num_threads,
+                                 []( void * i_ctx, int64_t i_thread_id ) {
+                                   (*static_cast< WorkFunc * >( i_ctx ))( i_thread_id );
+                                 },
+                                 &i_work );
+
+#elif defined(EINSUM_IR_USE_DISPATCH)
       // Apple Dispatch implementation
       dispatch_queue_attr_t l_attr = dispatch_queue_attr_make_with_qos_class(
         DISPATCH_QUEUE_CONCURRENT,
@@ -100,7 +128,50 @@ namespace einsum_ir {
       }
 #endif
     }
-    
+
+    /**
+     * @brief Check if independent tasks can be executed concurrently by teams of threads
+     *
+     * @return true if execute_teams runs the tasks concurrently, false if it runs them one after another
+     **/
+    inline bool supports_thread_teams() {
+#if defined(EINSUM_IR_USE_THREAD_POOL)
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    /**
+     * @brief Execute independent tasks concurrently on disjoint teams of threads
+     *
+     * Parallel regions opened through execute_threaded inside a task only use the threads of the task's team.
+     * Without the thread pool, the tasks are executed one after another by the calling thread.
+     *
+     * @tparam WorkFunc Callable with signature void(int64_t team_id)
+     * @param i_num_teams Number of teams
+     * @param i_team_sizes Number of threads of every team
+     * @param i_work Work function, called once per team with team ID in [0, i_num_teams)
+     **/
+    template<typename WorkFunc>
+    inline void execute_teams( int64_t           i_num_teams,
+                               int64_t   const * i_team_sizes,
+                               WorkFunc          i_work ) {
+#if defined(EINSUM_IR_USE_THREAD_POOL)
+      ThreadPool::get().execute_teams( i_num_teams,
+                                       i_team_sizes,
+                                       []( void * i_ctx, int64_t i_team_id ) {
+                                         (*static_cast< WorkFunc * >( i_ctx ))( i_team_id );
+                                       },
+                                       &i_work );
+#else
+      (void) i_team_sizes;
+      for( int64_t l_team_id = 0; l_team_id < i_num_teams; l_team_id++ ) {
+        i_work( l_team_id );
+      }
+#endif
+    }
+
   }
 }
 
@@ -23,6 +23,7 @@ void einsum_ir::basic::UnaryBackend::init( std::vector< exec_t >  const & i_exec
   m_dtype_comp = i_dtype_comp;
 
   m_ktype = i_ktype;
+  m_ktype_eltwise = UNDEFINED_KTYPE;
 
   m_num_threads = i_num_threads;
 }
@@ -52,10 +53,21 @@ void einsum_ir::basic::UnaryBackend::init( std::vector< iter_property > const &
   m_dtype_comp = i_dtype_comp;
 
   m_ktype = i_ktype;
+  m_ktype_eltwise = UNDEFINED_KTYPE;
 
   m_num_threads = i_num_threads;
 }
 
+void einsum_ir::basic::UnaryBackend::set_eltwise( kernel_t                  i_ktype,
+                                                  last_touch_params const & i_params ){
+  m_ktype_eltwise  = i_ktype;
+  m_eltwise_params = i_params;
+}
+
+void einsum_ir::basic::UnaryBackend::set_vnni( int64_t i_vnni ){
+  m_vnni = i_vnni;
+}
+
 einsum_ir::basic::err_t einsum_ir::basic::UnaryBackend::compile(){
   err_t l_err = err_t::UNDEFINED_ERROR;
 
@@ -52,6 +52,15 @@ class einsum_ir::basic::UnaryBackend {
     //! type of the main kernel
     kernel_t  m_ktype = UNDEFINED_KTYPE;
 
+    //! type of the elementwise kernel applied to the result of the main kernel
+    kernel_t m_ktype_eltwise = UNDEFINED_KTYPE;
+
+    //! parameters of the elementwise kernel
+    last_touch_params m_eltwise_params;
+
+    //! VNNI factor of the output, i.e., number of interleaved values of the second primitive dimension, 1 for the flat format
+    int64_t m_vnni = 1;
+
     //! kernel m size
     uint64_t m_m = 0;
     //! kernel n size
@@ -108,6 +117,25 @@ class einsum_ir::basic::UnaryBackend {
                kernel_t                             i_ktype,
                int64_t                              i_num_threads );
 
+    /**
+     * Sets an elementwise kernel which is applied to the result of the main kernel, e.g., an activation applied while packing.
+     * Supported are RELU, GELU, SIGMOID, TANH, SCALE_SHIFT and CLAMP; has to be called after initialization and before compilation.
+     *
+     * @param i_ktype type of the elementwise kernel.
+     * @param i_params parameters of SCALE_SHIFT and CLAMP.
+     **/
+    void set_eltwise( kernel_t                  i_ktype,
+                      last_touch_params const & i_params );
+
+    /**
+     * Sets the VNNI format of the output of COPY kernels, has to be called before compilation.
+     * The output's leading dimension is the stride of a group of interleaved values.
+     * Only supported by the TPP backend.
+     *
+     * @param i_vnni VNNI factor, i.e., 2 or 4, 1 for the flat format.
+     **/
+    void set_vnni( int64_t i_vnni );
+
     /**
      * Compiles the unary backend.
      *
@@ -32,6 +32,12 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendScalar::compile_kernels()
     return err_t::COMPILATION_FAILED;
   }
 
+  // elementwise kernels and the VNNI format are only supported by the TPP backend
+  if(    m_ktype_eltwise != UNDEFINED_KTYPE
+      || m_vnni != 1 ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
   // determine if all dtypes are FP32 or FP64
   bool l_dtype_all_fp32 = false;
   bool l_dtype_all_fp64 = false;
@@ -0,0 +1,292 @@
+#include "UnaryBackendSimd.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define EINSUM_IR_SIMD_VECTOR_EXTENSIONS
+#define EINSUM_IR_SIMD_INLINE inline __attribute__((always_inline))
+#else
+#define EINSUM_IR_SIMD_INLINE inline
+#endif
+
+#if defined(EINSUM_IR_SIMD_VECTOR_EXTENSIONS) && ( defined(__x86_64__) || defined(__i386__) )
+#define EINSUM_IR_SIMD_X86
+#endif
+
+namespace {
+  typedef einsum_ir::basic::UnaryBackendSimd::kernel_args kernel_args;
+
+  //! edge length of the tiles of transposing copies
+  constexpr int64_t g_size_tile_trans = 8;
+
+  /**
+   * Zero kernel.
+   *
+   * @param i_args arguments of the kernel.
+   * @param o_out output matrix.
+   **/
+  void zero( kernel_args const & i_args,
+             void        const *,
+             void              * o_out ) {
+    for( int64_t l_n = 0; l_n < i_args.n; l_n++ ) {
+      std::memset( (char *) o_out + l_n * i_args.ldb * i_args.size,
+                   0,
+                   i_args.m * i_args.size );
+    }
+  }
+
+  /**
+   * Copy kernel.
+   *
+   * @param i_args arguments of the kernel.
+   * @param i_in input matrix.
+   * @param o_out output matrix.
+   **/
+  void copy( kernel_args const & i_args,
+             void        const * i_in,
+             void              * o_out ) {
+    for( int64_t l_n = 0; l_n < i_args.n; l_n++ ) {
+      std::memcpy( (char       *) o_out + l_n * i_args.ldb * i_args.size,
+                   (char const *) i_in  + l_n * i_args.lda * i_args.size,
+                   i_args.m * i_args.size );
+    }
+  }
+
+  /**
+   * Transposing copy kernel, the output matrix has the shape n x m.
+   * The matrices are traversed in square tiles to keep the strided accesses in the cache.
+   *
+   * @param_t T unsigned integer with the size of a value.
+   * @param i_args arguments of the kernel.
+   * @param i_in input matrix.
+   * @param o_out output matrix.
+   **/
+  template< typename T >
+  void copy_trans( kernel_args const & i_args,
+                   void        const * i_in,
+                   void              * o_out ) {
+    T const * l_in  = (T const *) i_in;
+    T       * l_out = (T       *) o_out;
+
+    for( int64_t l_n0 = 0; l_n0 < i_args.n; l_n0 += g_size_tile_trans ) {
+      int64_t l_n1 = std::min( l_n0 + g_size_tile_trans, i_args.n );
+      for( int64_t l_m0 = 0; l_m0 < i_args.m; l_m0 += g_size_tile_trans ) {
+        int64_t l_m1 = std::min( l_m0 + g_size_tile_trans, i_args.m );
+        for( int64_t l_m = l_m0; l_m < l_m1; l_m++ ) {
+          for( int64_t l_n = l_n0; l_n < l_n1; l_n++ ) {
+            l_out[ l_m * i_args.ldb + l_n ] = l_in[ l_m + l_n * i_args.lda ];
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Reference ReLU which is applied in place.
+   *
+   * @param_t T datatype.
+   * @param i_args arguments of the kernel.
+   * @param io_out output matrix.
+   **/
+  template< typename T >
+  void relu_ref( kernel_args const & i_args,
+                 void        const *,
+                 void              * io_out ) {
+    for( int64_t l_n = 0; l_n < i_args.n; l_n++ ) {
+      T * l_out = (T *) io_out + l_n * i_args.ldb;
+      for( int64_t l_m = 0; l_m < i_args.m; l_m++ ) {
+        l_out[l_m] = std::max( l_out[l_m], T(0) );
+      }
+    }
+  }
+
+#ifdef EINSUM_IR_SIMD_VECTOR_EXTENSIONS
+  //! vector of W values, the instructions are derived from the target of the calling kernel
+  template< typename T,
+            int64_t  W >
+  struct vec {
+    typedef T type __attribute__(( vector_size( W * sizeof(T) ) ));
+  };
+
+  //! signed integers with the size of the floating point type
+  template< typename T >
+  struct bits;
+  template<>
+  struct bits< float > {
+    typedef int32_t type;
+  };
+  template<>
+  struct bits< double > {
+    typedef int64_t type;
+  };
+
+  /**
+   * Vectorized ReLU which is applied in place.
+   *
+   * @param_t T datatype.
+   * @param_t W number of values per vector.
+   * @param i_args arguments of the kernel.
+   * @param io_out output matrix.
+   **/
+  template< typename T,
+            int64_t  W >
+  EINSUM_IR_SIMD_INLINE void relu( kernel_args const & i_args,
+                                   void        const *,
+                                   void              * io_out ) {
+    typedef typename vec< T, W >::type vec_t;
+    typedef typename vec< typename bits< T >::type, W >::type vec_bits_t;
+
+    vec_t l_zero = {};
+    for( int64_t l_n = 0; l_n < i_args.n; l_n++ ) {
+      T * l_out = (T *) io_out + l_n * i_args.ldb;
+
+      int64_t l_m = 0;
+      for( ; l_m + W <= i_args.m; l_m += W ) {
+        vec_t l_val;
+        vec_bits_t l_bits;
+        std::memcpy( &l_val, l_out + l_m, sizeof(vec_t) );
+        std::memcpy( &l_bits, &l_val, sizeof(vec_t) );
+        l_bits &= (vec_bits_t) ( l_val > l_zero );
+        std::memcpy( l_out + l_m, &l_bits, sizeof(vec_t) );
+      }
+      for( ; l_m < i_args.m; l_m++ ) {
+        l_out[l_m] = std::max( l_out[l_m], T(0) );
+      }
+    }
+  }
+
+  void relu_vec128_fp32( kernel_args const & i_args, void const * i_in, void * io_out ) {
+    relu< float, 4 >( i_args, i_in, io_out );
+  }
+  void relu_vec128_fp64( kernel_args const & i_args, void const * i_in, void * io_out ) {
+    relu< double, 2 >( i_args, i_in, io_out );
+  }
+#else
+  void relu_vec128_fp32( kernel_args const & i_args, void const * i_in, void * io_out ) {
+    relu_ref< float >( i_args, i_in, io_out );
+  }
+  void relu_vec128_fp64( kernel_args const & i_args, void const * i_in, void * io_out ) {
+    relu_ref< double >( i_args, i_in, io_out );
+  }
+#endif
+
+#ifdef EINSUM_IR_SIMD_X86
+  __attribute__((target("avx2"))) void relu_avx2_fp32( kernel_args const & i_args, void const * i_in, void * io_out ) {
+    relu< float, 8 >( i_args, i_in, io_out );
+  }
+  __attribute__((target("avx2"))) void relu_avx2_fp64( kernel_args const & i_args, void const * i_in, void * io_out ) {
+    relu< double, 4 >( i_args, i_in, io_out );
+  }
+
+  __attribute__((target("avx512f"))) void relu_avx512_fp32( kernel_args const & i_args, void const * i_in, void * io_out ) {
+    relu< float, 16 >( i_args, i_in, io_out );
+  }
+  __attribute__((target("avx512f"))) void relu_avx512_fp64( kernel_args const & i_args, void const * i_in, void * io_out ) {
+    relu< double, 8 >( i_args, i_in, io_out );
+  }
+#endif
+
+  /**
+   * Selects the vectorized ReLU of the widest instruction set supported by the executing processor.
+   *
+   * @param i_fp32 true for FP32 values, false for FP64 values.
+   * @return ReLU kernel.
+   **/
+  void (* select_relu( bool i_fp32 ))( kernel_args const &,
+                                       void        const *,
+                                       void              * ) {
+#ifdef EINSUM_IR_SIMD_X86
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports( "avx512f" ) ) {
+      return i_fp32 ? &relu_avx512_fp32 : &relu_avx512_fp64;
+    }
+    if( __builtin_cpu_supports( "avx2" ) ) {
+      return i_fp32 ? &relu_avx2_fp32 : &relu_avx2_fp64;
+    }
+#endif
+    return i_fp32 ? &relu_vec128_fp32 : &relu_vec128_fp64;
+  }
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendSimd::compile_kernels() {
+  // all datatypes have to match
+  if(    m_dtype_in != m_dtype_comp
+      || m_dtype_in != m_dtype_out ) {
+    return err_t::COMPILATION_FAILED;
+  }
+  int64_t l_size = ce_n_bytes( m_dtype_out );
+  bool l_dtype_float = m_dtype_out == FP32 || m_dtype_out == FP64;
+
+  // the VNNI format is only supported by the TPP backend
+  if( m_vnni != 1 ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  m_args.m    = m_m;
+  m_args.n    = m_n;
+  m_args.lda  = m_lda;
+  m_args.ldb  = m_ldb;
+  m_args.size = l_size;
+
+  m_args_eltwise = m_args;
+  if( m_trans_a ) {
+    m_args_eltwise.m = m_n;
+    m_args_eltwise.n = m_m;
+  }
+
+  // main kernel
+  m_kernel = nullptr;
+  if( m_ktype == kernel_t::ZERO ) {
+    m_kernel = &zero;
+  }
+  else if( m_ktype == kernel_t::COPY ) {
+    if( !m_trans_a ) {
+      m_kernel = &copy;
+    }
+    else if( l_size == 1 ) {
+      m_kernel = &copy_trans< uint8_t >;
+    }
+    else if( l_size == 2 ) {
+      m_kernel = &copy_trans< uint16_t >;
+    }
+    else if( l_size == 4 ) {
+      m_kernel = &copy_trans< uint32_t >;
+    }
+    else if( l_size == 8 ) {
+      m_kernel = &copy_trans< uint64_t >;
+    }
+    else {
+      return err_t::COMPILATION_FAILED;
+    }
+  }
+  else if( m_ktype == kernel_t::RELU && l_dtype_float ) {
+    m_kernel = select_relu( m_dtype_out == FP32 );
+  }
+  else {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  // elementwise kernel
+  m_kernel_eltwise = nullptr;
+  if( m_ktype_eltwise == kernel_t::RELU && l_dtype_float ) {
+    m_kernel_eltwise = select_relu( m_dtype_out == FP32 );
+  }
+  else if( m_ktype_eltwise != kernel_t::UNDEFINED_KTYPE ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  return err_t::SUCCESS;
+}
+
+void einsum_ir::basic::UnaryBackendSimd::kernel_main( void const * i_in,
+                                                      void       * io_out ) {
+  m_kernel( m_args,
+            i_in,
+            io_out );
+
+  if( m_kernel_eltwise != nullptr ) {
+    m_kernel_eltwise( m_args_eltwise,
+                      nullptr,
+                      io_out );
+  }
+}
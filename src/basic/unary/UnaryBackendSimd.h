@@ -0,0 +1,67 @@
+#ifndef EINSUM_IR_BASIC_UNARY_BACKEND_SIMD
+#define EINSUM_IR_BASIC_UNARY_BACKEND_SIMD
+
+#include "UnaryBackend.h"
+
+namespace einsum_ir {
+  namespace basic {
+    class UnaryBackendSimd;
+  }
+}
+
+/**
+ * Unary backend with in-tree SIMD kernels, used for packing if libxsmm is unavailable.
+ * Supported are ZERO and COPY kernels of all datatypes, including transposing copies,
+ * and RELU kernels of FP32 and FP64, either as main kernel or applied after a COPY.
+ * The ReLU is compiled for AVX-512, AVX2 and the 128-bit baseline; the instruction set is selected at runtime.
+ **/
+class einsum_ir::basic::UnaryBackendSimd: public UnaryBackend {
+  public:
+    //! arguments of the kernels
+    struct kernel_args {
+      int64_t m = 0;
+      int64_t n = 0;
+      //! leading dimension of the input tensor
+      int64_t lda = 0;
+      //! leading dimension of the output tensor
+      int64_t ldb = 0;
+      //! size of a value in bytes
+      int64_t size = 0;
+    };
+
+  private:
+    //! arguments of the main kernel
+    kernel_args m_args;
+
+    //! arguments of the elementwise kernel, the output of transposing copies has the shape n x m
+    kernel_args m_args_eltwise;
+
+    //! main kernel
+    void (* m_kernel)( kernel_args const &,
+                       void        const *,
+                       void              * ) = nullptr;
+
+    //! elementwise kernel applied to the output of the main kernel in place
+    void (* m_kernel_eltwise)( kernel_args const &,
+                               void        const *,
+                               void              * ) = nullptr;
+
+  public:
+    /**
+     * Executes the main kernel on the given data sections of the tensors.
+     *
+     * @param i_in pointer to a data section of the input tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    void kernel_main( void const * i_in,
+                      void       * io_out );
+
+    /**
+     * Compiles all kernels
+     *
+     * @return SUCCESS if the compilation was successful, otherwise an appropiate error code.
+     **/
+    err_t compile_kernels();
+};
+
+#endif
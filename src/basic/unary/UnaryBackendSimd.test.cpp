@@ -0,0 +1,204 @@
+#include "catch.hpp"
+#include "UnaryBackendSimd.h"
+#include <algorithm>
+#include <cstdint>
+
+TEST_CASE( "Copy with ReLU through the SIMD unary backend using FP32 data.", "[unary_backend_simd]" ) {
+  using namespace einsum_ir::basic;
+
+  // a 3 x 19 x 37 tensor is copied to a tensor with padded columns
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  std::vector< int64_t > l_loop_sizes       = {       3, 19, 37 };
+  std::vector< int64_t > l_loop_strides_in  = { 19 * 37, 37,  1 };
+  std::vector< int64_t > l_loop_strides_out = { 19 * 40, 40,  1 };
+
+  std::vector< float > l_in( 3 * 19 * 37 );
+  for( std::size_t l_en = 0; l_en < l_in.size(); l_en++ ) {
+    l_in[l_en] = ( (l_en * 7) % 13 ) / 6.0f - 1.0f;
+  }
+
+  UnaryBackendSimd l_unary;
+  l_unary.init( l_loop_exec_type,
+                l_loop_sizes,
+                l_loop_strides_in,
+                l_loop_strides_out,
+                data_t::FP32,
+                data_t::FP32,
+                data_t::FP32,
+                kernel_t::COPY,
+                1 );
+  l_unary.set_eltwise( kernel_t::RELU,
+                       last_touch_params() );
+  REQUIRE( l_unary.compile() == err_t::SUCCESS );
+
+  std::vector< float > l_out( 3 * 19 * 40, -1.0f );
+  l_unary.eval( l_in.data(),
+                l_out.data() );
+
+  for( int64_t l_c = 0; l_c < 3; l_c++ ) {
+    for( int64_t l_n = 0; l_n < 19; l_n++ ) {
+      for( int64_t l_m = 0; l_m < 40; l_m++ ) {
+        float l_ref = -1.0f;
+        if( l_m < 37 ) {
+          l_ref = std::max( l_in[ (l_c * 19 + l_n) * 37 + l_m ], 0.0f );
+        }
+        REQUIRE( l_out[ (l_c * 19 + l_n) * 40 + l_m ] == l_ref );
+      }
+    }
+  }
+}
+
+TEST_CASE( "Tensor transposition through the SIMD unary backend using BF16 data.", "[unary_backend_simd]" ) {
+  using namespace einsum_ir::basic;
+
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  std::vector< int64_t > l_loop_sizes       = {       2, 13, 21 };
+  std::vector< int64_t > l_loop_strides_in  = { 13 * 21, 21,  1 };
+  std::vector< int64_t > l_loop_strides_out = { 13 * 21,  1, 13 };
+
+  // the values are only moved, i.e., their bit patterns are checked
+  std::vector< uint16_t > l_in( 2 * 13 * 21 );
+  for( std::size_t l_en = 0; l_en < l_in.size(); l_en++ ) {
+    l_in[l_en] = (uint16_t) l_en;
+  }
+
+  UnaryBackendSimd l_unary;
+  l_unary.init( l_loop_exec_type,
+                l_loop_sizes,
+                l_loop_strides_in,
+                l_loop_strides_out,
+                data_t::BF16,
+                data_t::BF16,
+                data_t::BF16,
+                kernel_t::COPY,
+                1 );
+  REQUIRE( l_unary.compile() == err_t::SUCCESS );
+
+  std::vector< uint16_t > l_out( l_in.size(), 0 );
+  l_unary.eval( l_in.data(),
+                l_out.data() );
+
+  for( int64_t l_c = 0; l_c < 2; l_c++ ) {
+    for( int64_t l_n = 0; l_n < 13; l_n++ ) {
+      for( int64_t l_m = 0; l_m < 21; l_m++ ) {
+        REQUIRE( l_out[ (l_c * 21 + l_m) * 13 + l_n ] == l_in[ (l_c * 13 + l_n) * 21 + l_m ] );
+      }
+    }
+  }
+}
+
+TEST_CASE( "Zero and ReLU kernels of the SIMD unary backend using FP64 data.", "[unary_backend_simd]" ) {
+  using namespace einsum_ir::basic;
+
+  std::vector< exec_t > l_loop_exec_type = { exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  std::vector< int64_t > l_loop_sizes       = {  5, 11 };
+  std::vector< int64_t > l_loop_strides_in  = { 12,  1 };
+  std::vector< int64_t > l_loop_strides_out = { 12,  1 };
+
+  std::vector< double > l_data( 5 * 12 );
+  for( std::size_t l_en = 0; l_en < l_data.size(); l_en++ ) {
+    l_data[l_en] = ( (l_en * 5) % 11 ) / 5.0 - 1.0;
+  }
+
+  // ReLU is applied in place
+  UnaryBackendSimd l_relu;
+  l_relu.init( l_loop_exec_type,
+               l_loop_sizes,
+               l_loop_strides_in,
+               l_loop_strides_out,
+               data_t::FP64,
+               data_t::FP64,
+               data_t::FP64,
+               kernel_t::RELU,
+               1 );
+  REQUIRE( l_relu.compile() == err_t::SUCCESS );
+
+  std::vector< double > l_out = l_data;
+  l_relu.eval( nullptr,
+               l_out.data() );
+  for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+    double l_ref = ( l_en % 12 < 11 ) ? std::max( l_data[l_en], 0.0 ) : l_data[l_en];
+    REQUIRE( l_out[l_en] == l_ref );
+  }
+
+  UnaryBackendSimd l_zero;
+  l_zero.init( l_loop_exec_type,
+               l_loop_sizes,
+               l_loop_strides_in,
+               l_loop_strides_out,
+               data_t::FP64,
+               data_t::FP64,
+               data_t::FP64,
+               kernel_t::ZERO,
+               1 );
+  REQUIRE( l_zero.compile() == err_t::SUCCESS );
+
+  l_out = l_data;
+  l_zero.eval( nullptr,
+               l_out.data() );
+  for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+    double l_ref = ( l_en % 12 < 11 ) ? 0.0 : l_data[l_en];
+    REQUIRE( l_out[l_en] == l_ref );
+  }
+}
+
+TEST_CASE( "Unsupported configurations of the SIMD unary backend.", "[unary_backend_simd]" ) {
+  using namespace einsum_ir::basic;
+
+  std::vector< exec_t > l_loop_exec_type = { exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  std::vector< int64_t > l_loop_sizes       = { 4, 8 };
+  std::vector< int64_t > l_loop_strides_in  = { 8, 1 };
+  std::vector< int64_t > l_loop_strides_out = { 8, 1 };
+
+  // ReLU of integers
+  UnaryBackendSimd l_relu;
+  l_relu.init( l_loop_exec_type,
+               l_loop_sizes,
+               l_loop_strides_in,
+               l_loop_strides_out,
+               data_t::I8,
+               data_t::I8,
+               data_t::I8,
+               kernel_t::RELU,
+               1 );
+  REQUIRE( l_relu.compile() == err_t::COMPILATION_FAILED );
+
+  // VNNI format
+  UnaryBackendSimd l_vnni;
+  l_vnni.init( l_loop_exec_type,
+               l_loop_sizes,
+               l_loop_strides_in,
+               l_loop_strides_out,
+               data_t::BF16,
+               data_t::BF16,
+               data_t::BF16,
+               kernel_t::COPY,
+               1 );
+  l_vnni.set_vnni( 2 );
+  REQUIRE( l_vnni.compile() == err_t::COMPILATION_FAILED );
+
+  // elementwise kernels other than ReLU
+  UnaryBackendSimd l_gelu;
+  l_gelu.init( l_loop_exec_type,
+               l_loop_sizes,
+               l_loop_strides_in,
+               l_loop_strides_out,
+               data_t::FP32,
+               data_t::FP32,
+               data_t::FP32,
+               kernel_t::COPY,
+               1 );
+  l_gelu.set_eltwise( kernel_t::GELU,
+                      last_touch_params() );
+  REQUIRE( l_gelu.compile() == err_t::COMPILATION_FAILED );
+}
@@ -7,6 +7,18 @@ libxsmm_datatype einsum_ir::basic::UnaryBackendTpp::dtype_to_libxsmm( data_t i_d
   else if( i_dtype == FP64 ) {
     return libxsmm_datatype::LIBXSMM_DATATYPE_F64;
   }
+  else if( i_dtype == BF16 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_BF16;
+  }
+  else if( i_dtype == FP16 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_F16;
+  }
+  else if( i_dtype == I8 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_I8;
+  }
+  else if( i_dtype == I32 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_I32;
+  }
 
   return libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED;
 }
@@ -26,6 +38,25 @@ void einsum_ir::basic::UnaryBackendTpp::kernel_main( void const * i_out_aux,
     l_param.out.primary =          io_out;
     m_xmm_kernel_binary( &l_param );
   }
+
+  // elementwise kernel applied in place while the output is in cache
+  if( m_xmm_kernel_eltwise_unary != nullptr ) {
+    libxsmm_meltw_unary_param l_param;
+    l_param.in.primary  = io_out;
+    l_param.out.primary = io_out;
+    m_xmm_kernel_eltwise_unary( &l_param );
+  }
+
+  int64_t l_n_bytes_scalar = m_eltwise_scalars.size() / 2;
+  for( int64_t l_sc = 0; l_sc < 2; l_sc++ ) {
+    if( m_xmm_kernel_eltwise_scalar[l_sc] != nullptr ) {
+      libxsmm_meltw_binary_param l_param;
+      l_param.in0.primary = io_out;
+      l_param.in1.primary = m_eltwise_scalars.data() + l_sc * l_n_bytes_scalar;
+      l_param.out.primary = io_out;
+      m_xmm_kernel_eltwise_scalar[l_sc]( &l_param );
+    }
+  }
 }
 
 einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendTpp::compile_kernels(){
@@ -75,7 +106,18 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendTpp::compile_kernels(){
                                                        LIBXSMM_MELTW_FLAG_UNARY_NONE );
   }
   else if( m_ktype == kernel_t::COPY ) {
-    if(m_trans_a){
+    if( m_vnni > 1 ){
+      if(    m_trans_a
+          || m_n % m_vnni != 0
+          || ( m_vnni != 2 && m_vnni != 4 ) ){
+        return err_t::COMPILATION_FAILED;
+      }
+      m_xmm_kernel_unary = libxsmm_dispatch_meltw_unary( (m_vnni == 2) ? LIBXSMM_MELTW_TYPE_UNARY_TRANSFORM_NORM_TO_VNNI2
+                                                                       : LIBXSMM_MELTW_TYPE_UNARY_TRANSFORM_NORM_TO_VNNI4,
+                                                         l_shape_single_touch_aux_unary,
+                                                         LIBXSMM_MELTW_FLAG_UNARY_NONE );
+    }
+    else if(m_trans_a){
       m_xmm_kernel_unary = libxsmm_dispatch_meltw_unary( LIBXSMM_MELTW_TYPE_UNARY_TRANSFORM_NORM_TO_NORMT,
                                                         l_shape_single_touch_aux_unary,
                                                         LIBXSMM_MELTW_FLAG_UNARY_NONE );
@@ -99,5 +141,101 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendTpp::compile_kernels(){
     return err_t::COMPILATION_FAILED;
   }
 
+  // elementwise kernel, transposed outputs have the shape n x m,
+  // VNNI outputs are (vnni * m) x (n / vnni) matrices since the kernel is independent of the position
+  libxsmm_blasint l_m_out = m_trans_a ? m_n : m_m;
+  libxsmm_blasint l_n_out = m_trans_a ? m_m : m_n;
+  libxsmm_blasint l_ld_out = m_ldb;
+  if( m_vnni > 1 && m_ktype == kernel_t::COPY ){
+    l_m_out  = m_m   * m_vnni;
+    l_n_out  = m_n   / m_vnni;
+    l_ld_out = m_ldb * m_vnni;
+  }
+  libxsmm_meltw_unary_shape l_shape_eltwise = libxsmm_create_meltw_unary_shape( l_m_out,
+                                                                                l_n_out,
+                                                                                l_ld_out,
+                                                                                l_ld_out,
+                                                                                l_xmm_dtype_out,
+                                                                                l_xmm_dtype_out,
+                                                                                l_xmm_dtype_out );
+
+  libxsmm_meltw_unary_type l_eltwise_act = LIBXSMM_MELTW_TYPE_UNARY_NONE;
+  if( m_ktype_eltwise == kernel_t::RELU ) {
+    l_eltwise_act = LIBXSMM_MELTW_TYPE_UNARY_RELU;
+  }
+  else if( m_ktype_eltwise == kernel_t::GELU ) {
+    l_eltwise_act = LIBXSMM_MELTW_TYPE_UNARY_GELU;
+  }
+  else if( m_ktype_eltwise == kernel_t::SIGMOID ) {
+    l_eltwise_act = LIBXSMM_MELTW_TYPE_UNARY_SIGMOID;
+  }
+  else if( m_ktype_eltwise == kernel_t::TANH ) {
+    l_eltwise_act = LIBXSMM_MELTW_TYPE_UNARY_TANH;
+  }
+  else if(    m_ktype_eltwise != kernel_t::SCALE_SHIFT
+           && m_ktype_eltwise != kernel_t::CLAMP
+           && m_ktype_eltwise != kernel_t::UNDEFINED_KTYPE ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  if( l_eltwise_act != LIBXSMM_MELTW_TYPE_UNARY_NONE ) {
+    m_xmm_kernel_eltwise_unary = libxsmm_dispatch_meltw_unary( l_eltwise_act,
+                                                               l_shape_eltwise,
+                                                               LIBXSMM_MELTW_FLAG_UNARY_NONE );
+    if( m_xmm_kernel_eltwise_unary == nullptr ) {
+      return err_t::COMPILATION_FAILED;
+    }
+  }
+
+  if(    m_ktype_eltwise == kernel_t::SCALE_SHIFT
+      || m_ktype_eltwise == kernel_t::CLAMP ) {
+    libxsmm_meltw_binary_type l_types_scalar[2];
+    double l_scalars[2];
+    if( m_ktype_eltwise == kernel_t::SCALE_SHIFT ) {
+      l_types_scalar[0] = LIBXSMM_MELTW_TYPE_BINARY_MUL;
+      l_types_scalar[1] = LIBXSMM_MELTW_TYPE_BINARY_ADD;
+      l_scalars[0] = m_eltwise_params.scale;
+      l_scalars[1] = m_eltwise_params.shift;
+    }
+    else {
+      l_types_scalar[0] = LIBXSMM_MELTW_TYPE_BINARY_MAX;
+      l_types_scalar[1] = LIBXSMM_MELTW_TYPE_BINARY_MIN;
+      l_scalars[0] = m_eltwise_params.clamp_min;
+      l_scalars[1] = m_eltwise_params.clamp_max;
+    }
+
+    // scalars are stored in the output's datatype
+    m_eltwise_scalars.resize( 2 * ce_n_bytes( m_dtype_out ) );
+    for( int64_t l_sc = 0; l_sc < 2; l_sc++ ) {
+      if( m_dtype_out == FP32 ) {
+        ( (float *) m_eltwise_scalars.data() )[l_sc] = (float) l_scalars[l_sc];
+      }
+      else if( m_dtype_out == FP64 ) {
+        ( (double *) m_eltwise_scalars.data() )[l_sc] = l_scalars[l_sc];
+      }
+      else {
+        return err_t::COMPILATION_FAILED;
+      }
+    }
+
+    libxsmm_meltw_binary_shape l_shape_scalar = libxsmm_create_meltw_binary_shape( l_m_out,
+                                                                                   l_n_out,
+                                                                                   l_ld_out,
+                                                                                   1,
+                                                                                   l_ld_out,
+                                                                                   l_xmm_dtype_out,
+                                                                                   l_xmm_dtype_out,
+                                                                                   l_xmm_dtype_out,
+                                                                                   l_xmm_dtype_out );
+    for( int64_t l_sc = 0; l_sc < 2; l_sc++ ) {
+      m_xmm_kernel_eltwise_scalar[l_sc] = libxsmm_dispatch_meltw_binary( l_types_scalar[l_sc],
+                                                                         l_shape_scalar,
+                                                                         LIBXSMM_MELTW_FLAG_BINARY_BCAST_SCALAR_IN_1 );
+      if( m_xmm_kernel_eltwise_scalar[l_sc] == nullptr ) {
+        return err_t::COMPILATION_FAILED;
+      }
+    }
+  }
+
   return err_t::SUCCESS;
 }
\ No newline at end of file
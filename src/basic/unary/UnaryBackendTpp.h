@@ -2,6 +2,7 @@
 #define EINSUM_IR_BASIC_UNARY_BACKEND_TPP
 
 #include <libxsmm.h>
+#include <vector>
 #include "UnaryBackend.h"
 
 namespace einsum_ir {
@@ -18,6 +19,15 @@ class einsum_ir::basic::UnaryBackendTpp: public UnaryBackend {
     //! LIBXSMM-based binary TPP
     libxsmm_meltwfunction_binary m_xmm_kernel_binary = nullptr;
 
+    //! LIBXSMM-based TPP which applies the elementwise kernel to the output in place
+    libxsmm_meltwfunction_unary m_xmm_kernel_eltwise_unary = nullptr;
+
+    //! LIBXSMM-based TPPs which combine the output with the scalars of SCALE_SHIFT and CLAMP elementwise kernels
+    libxsmm_meltwfunction_binary m_xmm_kernel_eltwise_scalar[2] = { nullptr, nullptr };
+
+    //! scalars of SCALE_SHIFT and CLAMP elementwise kernels in the output's datatype
+    std::vector< char > m_eltwise_scalars;
+
     /**
      * converts internal datatypes to libxsmm datatypes
      *
@@ -181,3 +181,70 @@ TEST_CASE( "TPP-based large tensor transposition through the unary backend with
 
   REQUIRE( at::equal( l_t0.permute( {2, 1, 4, 0, 5, 7, 3, 8, 6} ), l_t1 ) );
 }
+
+TEST_CASE( "TPP-based transposition with fused ReLU and clamping through the unary backend using FP32 data.", "[unary_backend_tpp]" ) {
+  using namespace einsum_ir::basic;
+
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                            0,  1,  2
+  std::vector< int64_t > l_loop_sizes       = {   3, 24, 16 };
+  std::vector< int64_t > l_loop_strides_in  = { 384, 16,  1 };
+  std::vector< int64_t > l_loop_strides_out = { 384,  1, 24 };
+
+  at::Tensor l_t0 = at::randn( {3, 24, 16},
+                               at::ScalarType::Float );
+
+  // ReLU
+  UnaryBackendTpp l_unary_relu;
+  l_unary_relu.init( l_loop_exec_type,
+                     l_loop_sizes,
+                     l_loop_strides_in,
+                     l_loop_strides_out,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     kernel_t::COPY,
+                     1 );
+  l_unary_relu.set_eltwise( kernel_t::RELU,
+                            last_touch_params() );
+
+  err_t l_err = l_unary_relu.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  at::Tensor l_t1 = at::randn( {3, 16, 24},
+                               at::ScalarType::Float );
+
+  l_unary_relu.eval( l_t0.data_ptr(),
+                     l_t1.data_ptr() );
+
+  REQUIRE( at::equal( at::relu( l_t0.permute( {0, 2, 1} ) ), l_t1 ) );
+
+  // clamping
+  last_touch_params l_params;
+  l_params.clamp_min = -0.5;
+  l_params.clamp_max =  0.5;
+
+  UnaryBackendTpp l_unary_clamp;
+  l_unary_clamp.init( l_loop_exec_type,
+                      l_loop_sizes,
+                      l_loop_strides_in,
+                      l_loop_strides_out,
+                      data_t::FP32,
+                      data_t::FP32,
+                      data_t::FP32,
+                      kernel_t::COPY,
+                      1 );
+  l_unary_clamp.set_eltwise( kernel_t::CLAMP,
+                             l_params );
+
+  l_err = l_unary_clamp.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_unary_clamp.eval( l_t0.data_ptr(),
+                      l_t1.data_ptr() );
+
+  REQUIRE( at::equal( at::clamp( l_t0.permute( {0, 2, 1} ), -0.5, 0.5 ), l_t1 ) );
+}
@@ -1,12 +1,15 @@
 #include "UnaryOptimizer.h"
+#include "../hardware.h"
 #include <algorithm>
 
 void einsum_ir::basic::UnaryOptimizer::init( std::vector< iter_property > * i_iter_space,
                                              int64_t                        i_num_threads,
-                                             bool                           i_scalar_optim ){
+                                             bool                           i_scalar_optim,
+                                             int64_t                        i_num_bytes ){
   m_iter_space = i_iter_space;
   m_num_threads = i_num_threads;
   m_sclar_optim = i_scalar_optim;
+  m_num_bytes = i_num_bytes;
 }
 
 einsum_ir::basic::err_t einsum_ir::basic::UnaryOptimizer::optimize(){
@@ -63,5 +66,25 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryOptimizer::optimize(){
       m_iter_space->insert(m_iter_space->end() - l_found_stride_one_in, l_new_iter);
     }
   }
+
+  //parallelize the outermost loop if the data does not fit into the L2 cache of a single core
+  if( m_num_threads > 1 && m_num_bytes > 0 ){
+    int64_t l_size_all = 1;
+    bool l_parallel = false;
+    for( std::size_t l_id = 0; l_id < m_iter_space->size(); l_id++ ){
+      l_size_all *= m_iter_space->at(l_id).size;
+      l_parallel = l_parallel || m_iter_space->at(l_id).exec_type == exec_t::OMP;
+    }
+
+    iter_property & l_first = m_iter_space->front();
+    if(    !l_parallel
+        && l_first.exec_type  == exec_t::SEQ
+        && l_first.stride_out != 0
+        && l_first.size       >= m_num_threads
+        && l_size_all * m_num_bytes > get_hardware().l2_cache_size ){
+      l_first.exec_type = exec_t::OMP;
+    }
+  }
+
   return err_t::SUCCESS;
 }
@@ -21,6 +21,9 @@ class einsum_ir::basic::UnaryOptimizer {
   //! true if scalar execution should be generated, false otherwise
    bool m_sclar_optim = false;
 
+   //! number of bytes read and written per element
+   int64_t m_num_bytes = 0;
+
 
   public:
    /**
@@ -29,13 +32,16 @@ class einsum_ir::basic::UnaryOptimizer {
      * @param i_iter_space vector of iters corresponding to an unoptimized unary operation.
      * @param i_num_threads number of participating threads for unary operation.
      * @param i_scalar_optim true if scalar execution should be generated, false otherwise.
+     * @param i_num_bytes number of bytes read and written per element, 0 disables the parallelization.
      **/
     void init( std::vector< iter_property > * i_iter_space,
                int64_t                        i_num_threads, 
-               bool                           i_scalar_optim );    
+               bool                           i_scalar_optim,
+               int64_t                        i_num_bytes = 0 );    
   
    /**
      * Optimizes the iteration space.
+     * The outermost loop is parallelized if the operation exceeds the L2 cache of a single core.
      *
      * @return SUCCESS if the compilation was successful, otherwise an appropiate error code.
      **/
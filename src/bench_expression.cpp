@@ -7,18 +7,19 @@
 
 int main( int     i_argc,
           char  * i_argv[] ) {
-  if( i_argc < 4 ) {
+  if( i_argc < 3 ) {
     std::cerr << "Usage:" << std::endl;
-    std::cerr << "  ./bench_expression einsum_string dimension_sizes contraction_path dtype store_lock print_tree" << std::endl;
+    std::cerr << "  ./bench_expression einsum_string dimension_sizes contraction_path dtype store_lock print_tree path_model" << std::endl;
     std::cerr << std::endl;
     std::cerr << "Arguments:" << std::endl;
     std::cerr << "  * einsum_string:    Einsum expression string. Either in single-character or standard format." << std::endl;
     std::cerr << "  * dimension_sizes:  Dimension sizes have to be in ascending order of the dimension names." << std::endl;
     std::cerr << "                      ASCII numbers (see Example #3) are sorted by their numeric value." << std::endl;
-    std::cerr << "  * contraction_path: Contraction path." << std::endl;
-    std::cerr << "  * dtype:            FP32, FP64, CPX_FP32 or CPX_FP64, default: FP32." << std::endl;
+    std::cerr << "  * contraction_path: Contraction path or path optimizer: auto, greedy, bnb or dp, default: auto." << std::endl;
+    std::cerr << "  * dtype:            FP32, FP64, BF16, FP16, CPX_FP32 or CPX_FP64, default: FP32." << std::endl;
     std::cerr << "  * store_lock:       If 1 all einsum_ir input tensors are stored and locked before evaluation, default: 0." << std::endl;
     std::cerr << "  * print_tree:       If not 0 the einsum tree is printed (1: dimension ids, 2: characters), default: 0." << std::endl;
+    std::cerr << "  * path_model:       Performance model used by the path optimizer: none, zen5, m4 or a76, default: none." << std::endl;
     std::cerr << std::endl;
     std::cerr << "Example #1 (single character format):" << std::endl;
     std::cerr << "  ./bench_expression \"iae,bf,dcba,cg,dh->hgfei\" \"32,8,4,2,16,64,8,8,8\" \"(1,2),(2,3),(0,1),(0,1)\"" << std::endl;
@@ -26,6 +27,8 @@ int main( int     i_argc,
     std::cerr << "  ./bench_expression \"[i,a,e],[b,f],[d,c,b,a],[c,g],[d,h]->[h,g,f,e,i]\" \"32,8,4,2,16,64,8,8,8\" \"(1,2),(2,3),(0,1),(0,1)\"" << std::endl;
     std::cerr << "Example #3 (standard format using integers):" << std::endl;
     std::cerr << "  ./bench_expression \"[8,0,4],[1,5],[3,2,1,0],[2,6],[3,7]->[7,6,5,4,8]\" \"32,8,4,2,16,64,8,8,8\" \"(1,2),(2,3),(0,1),(0,1)\"" << std::endl;
+    std::cerr << "Example #4 (built-in path optimizer):" << std::endl;
+    std::cerr << "  ./bench_expression \"iae,bf,dcba,cg,dh->hgfei\" \"32,8,4,2,16,64,8,8,8\" \"greedy\"" << std::endl;
     return EXIT_FAILURE;
   }
 
@@ -71,16 +74,36 @@ int main( int     i_argc,
   /*
    * parse contraction path
    */
-  std::string l_path_string( i_argv[3] );
+  std::string l_path_string = "auto";
+  if( i_argc > 3 ) {
+    l_path_string = std::string( i_argv[3] );
+  }
   std::vector< int64_t > l_path;
-  einsum_ir::frontend::EinsumExpressionAscii::parse_path( l_path_string,
-                                                          l_path );
+  einsum_ir::path_t l_path_type = einsum_ir::UNDEFINED_PATH;
 
-  std::cout << "parsed contraction path: ";
-  for( std::size_t l_co = 0; l_co < l_path.size(); l_co++ ) {
-    std::cout << l_path[l_co] << " ";
+  if(    l_path_string == ""
+      || l_path_string == "auto" ) {
+    l_path_type = einsum_ir::AUTO_PATH;
+  }
+  else if( l_path_string == "greedy" ) {
+    l_path_type = einsum_ir::GREEDY;
+  }
+  else if( l_path_string == "bnb" ) {
+    l_path_type = einsum_ir::BRANCH_AND_BOUND;
+  }
+  else if( l_path_string == "dp" ) {
+    l_path_type = einsum_ir::DYNAMIC_PROGRAMMING;
+  }
+  else {
+    einsum_ir::frontend::EinsumExpressionAscii::parse_path( l_path_string,
+                                                            l_path );
+
+    std::cout << "parsed contraction path: ";
+    for( std::size_t l_co = 0; l_co < l_path.size(); l_co++ ) {
+      std::cout << l_path[l_co] << " ";
+    }
+    std::cout << std::endl;
   }
-  std::cout << std::endl;
 
   /*
    * create mapping from dimension name to id
@@ -129,6 +152,12 @@ int main( int     i_argc,
     else if( l_arg_dtype == "FP64" ) {
       l_dtype_at = at::ScalarType::Double;
     }
+    else if( l_arg_dtype == "BF16" ) {
+      l_dtype_at = at::ScalarType::BFloat16;
+    }
+    else if( l_arg_dtype == "FP16" ) {
+      l_dtype_at = at::ScalarType::Half;
+    }
     else if( l_arg_dtype == "CPX_FP32" ) {
       l_dtype_at = at::ScalarType::ComplexFloat;
     }
@@ -154,6 +183,12 @@ int main( int     i_argc,
   else if( l_dtype_einsum_ir == einsum_ir::FP64 ) {
     std::cout << "dtype: FP64" << std::endl;
   }
+  else if( l_dtype_einsum_ir == einsum_ir::BF16 ) {
+    std::cout << "dtype: BF16" << std::endl;
+  }
+  else if( l_dtype_einsum_ir == einsum_ir::FP16 ) {
+    std::cout << "dtype: FP16" << std::endl;
+  }
   else {
     std::cerr << "failed to determine dtype" << std::endl;
     return EXIT_FAILURE;
@@ -188,6 +223,22 @@ int main( int     i_argc,
   }
   std::cout << "print_tree: " << l_print_tree << std::endl;
 
+  /*
+   * parse path_model
+   */
+  std::string l_path_model = "none";
+  if( i_argc > 7 ) {
+    l_path_model = std::string( i_argv[7] );
+  }
+  if(    l_path_model != "none"
+      && l_path_model != "zen5"
+      && l_path_model != "m4"
+      && l_path_model != "a76" ) {
+    std::cerr << "error: invalid path_model argument" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "path_model: " << l_path_model << std::endl;
+
   /*
    * assemble einsum_ir data structures
    */
@@ -282,13 +333,25 @@ int main( int     i_argc,
   einsum_ir::frontend::EinsumExpression l_einsum_exp;
   l_einsum_exp.init( l_dim_sizes.size(),
                      l_dim_sizes.data(),
-                     l_path.size()/2,
+                     l_num_tensors-2,
                      l_string_num_dims.data(),
                      l_string_dim_ids.data(),
-                     l_path.data(),
+                     l_path_type == einsum_ir::UNDEFINED_PATH ? l_path.data() : nullptr,
                      l_ctype_einsum_ir,
                      l_dtype_einsum_ir,
                      l_data_ptrs.data() );
+  if( l_path_type != einsum_ir::UNDEFINED_PATH ) {
+    l_einsum_exp.set_path_type( l_path_type );
+  }
+  if( l_path_model == "zen5" ) {
+    l_einsum_exp.set_path_model( einsum_ir::model::common::Model::ZEN5 );
+  }
+  else if( l_path_model == "m4" ) {
+    l_einsum_exp.set_path_model( einsum_ir::model::common::Model::M4 );
+  }
+  else if( l_path_model == "a76" ) {
+    l_einsum_exp.set_path_model( einsum_ir::model::common::Model::A76 );
+  }
 
   l_tp0 = std::chrono::steady_clock::now();
   einsum_ir::err_t l_err = l_einsum_exp.compile();
@@ -301,6 +364,21 @@ int main( int     i_argc,
     return EXIT_FAILURE;
   }
 
+  // use the optimized contraction path for the comparisons
+  if( l_path_type != einsum_ir::UNDEFINED_PATH ) {
+    l_path = l_einsum_exp.m_path_opt;
+
+    l_path_string = "";
+    for( std::size_t l_co = 0; l_co < l_path.size()/2; l_co++ ) {
+      if( l_co > 0 ) {
+        l_path_string += ",";
+      }
+      l_path_string +=   "(" + std::to_string( l_path[l_co*2 + 0] )
+                       + "," + std::to_string( l_path[l_co*2 + 1] ) + ")";
+    }
+    std::cout << "optimized contraction path: " << l_path_string << std::endl;
+  }
+
   // print einsum tree
   std::string l_tree = "";
   if(    l_print_tree == 1
@@ -533,7 +611,16 @@ int main( int     i_argc,
     std::cout << "  frobenius norm of difference:                 " << l_frob_diff << std::endl;
     std::cout << "  relative error:                               " << l_err << std::endl;
 
-    double l_tol = (l_dtype_einsum_ir == einsum_ir::FP32) ? 1.0E-5 : 1.0E-12;
+    double l_tol = 1.0E-12;
+    if( l_dtype_einsum_ir == einsum_ir::FP32 ) {
+      l_tol = 1.0E-5;
+    }
+    else if( l_dtype_einsum_ir == einsum_ir::BF16 ) {
+      l_tol = 1.0E-2;
+    }
+    else if( l_dtype_einsum_ir == einsum_ir::FP16 ) {
+      l_tol = 1.0E-2;
+    }
 
     if( l_err > l_tol ) {
       std::cerr << "warning: relative error is large!" << std::endl;
@@ -42,12 +42,20 @@ namespace einsum_ir {
     INVALID_CPX_DIM           =  8,
     INVALID_DTYPE             =  9,
     INVALID_KTYPE             = 10,
+    INVALID_PATH              = 11,
+    INVALID_MODEL             = 12,
+    INVALID_PLAN              = 13,
+    PLAN_MISMATCH             = 14,
     UNDEFINED_ERROR           = 99
   } err_t;
 
   typedef enum {
     FP32            = 0,
     FP64            = 1,
+    BF16            = 2,
+    FP16            = 3,
+    I8              = 4,
+    I32             = 5,
     UNDEFINED_DTYPE = 99
   } data_t;
 
@@ -74,6 +82,15 @@ namespace einsum_ir {
     BR_MADD         = 12,
     PACKED_MADD     = 13,
     CPX_PACKED_MADD = 14,
+    GELU            = 15,
+    SILU            = 16,
+    SIGMOID         = 17,
+    TANH            = 18,
+    CLAMP           = 19,
+    SCALE_SHIFT     = 20,
+    ADD_RELU        = 21,
+    ADD_GELU        = 22,
+    ADD_SILU        = 23,
     UNDEFINED_KTYPE = 99
   } kernel_t;
 
@@ -83,9 +100,18 @@ namespace einsum_ir {
     TPP    = 2,
     BLAS   = 3,
     TBLIS  = 4,
+    SIMD   = 5,
     UNDEFINED_BACKEND = 99
   } backend_t;
 
+  typedef enum {
+    AUTO_PATH           = 0,
+    GREEDY              = 1,
+    BRANCH_AND_BOUND    = 2,
+    DYNAMIC_PROGRAMMING = 3,
+    UNDEFINED_PATH      = 99
+  } path_t;
+
   constexpr basic::dim_t ce_dimt_to_basic( dim_t i_dim ) {
     if(      i_dim == dim_t::C   ) return basic::dim_t::C;
     else if( i_dim == dim_t::M   ) return basic::dim_t::M;
@@ -100,6 +126,10 @@ namespace einsum_ir {
   constexpr basic::data_t ce_dtype_to_basic( data_t i_dtype ) {
     if(      i_dtype == FP32 ) return basic::data_t::FP32;
     else if( i_dtype == FP64 ) return basic::data_t::FP64;
+    else if( i_dtype == BF16 ) return basic::data_t::BF16;
+    else if( i_dtype == FP16 ) return basic::data_t::FP16;
+    else if( i_dtype == I8   ) return basic::data_t::I8;
+    else if( i_dtype == I32  ) return basic::data_t::I32;
     else                       return basic::data_t::UNDEFINED_DTYPE;
   }
 
@@ -116,6 +146,15 @@ namespace einsum_ir {
     else if( i_ktype == BR_MADD         ) return basic::kernel_t::BR_MADD;
     else if( i_ktype == PACKED_MADD     ) return basic::kernel_t::PACKED_MADD;
     else if( i_ktype == CPX_PACKED_MADD ) return basic::kernel_t::CPX_PACKED_MADD;
+    else if( i_ktype == GELU            ) return basic::kernel_t::GELU;
+    else if( i_ktype == SILU            ) return basic::kernel_t::SILU;
+    else if( i_ktype == SIGMOID         ) return basic::kernel_t::SIGMOID;
+    else if( i_ktype == TANH            ) return basic::kernel_t::TANH;
+    else if( i_ktype == CLAMP           ) return basic::kernel_t::CLAMP;
+    else if( i_ktype == SCALE_SHIFT     ) return basic::kernel_t::SCALE_SHIFT;
+    else if( i_ktype == ADD_RELU        ) return basic::kernel_t::ADD_RELU;
+    else if( i_ktype == ADD_GELU        ) return basic::kernel_t::ADD_GELU;
+    else if( i_ktype == ADD_SILU        ) return basic::kernel_t::ADD_SILU;
     else                                  return basic::kernel_t::UNDEFINED_KTYPE;
   }
 
@@ -129,9 +168,21 @@ namespace einsum_ir {
   constexpr int64_t ce_n_bytes( data_t i_dtype ) {
     if(      i_dtype == FP32 )  return 4;
     else if( i_dtype == FP64 )  return 8;
+    else if( i_dtype == BF16 )  return 2;
+    else if( i_dtype == FP16 )  return 2;
+    else if( i_dtype == I8   )  return 1;
+    else if( i_dtype == I32  )  return 4;
     else                        return -1;
   }
 
+  // reduced precision data types are accumulated in FP32 by default, INT8 in INT32
+  constexpr data_t ce_dtype_comp( data_t i_dtype ) {
+    if(      i_dtype == BF16 )  return FP32;
+    else if( i_dtype == FP16 )  return FP32;
+    else if( i_dtype == I8   )  return I32;
+    else                        return i_dtype;
+  }
+
   constexpr bool ce_cpx_op( kernel_t i_ktype ) {
     if(    i_ktype > kernel_t::CPX_INT_LOW
         && i_ktype < kernel_t::CPX_INT_HIGH ) {
@@ -1,5 +1,9 @@
 #include "EinsumExpression.h"
+#include "PathOptimizer.h"
+#include "PlanCache.h"
+#include "PlanFile.h"
 #include "../basic/threading.h"
+#include "../basic/pages.h"
 #include <deque>
 #include <set>
 #include <cmath>
@@ -117,6 +121,7 @@ void einsum_ir::frontend::EinsumExpression::init( int64_t                 i_num_
   m_dtype = i_dtype;
   m_data_ptrs = i_data_ptrs;
   m_compiled = false;
+  m_plan_restore.clear();
 }
 
 void einsum_ir::frontend::EinsumExpression::init( int64_t                 i_num_dims,
@@ -138,7 +143,199 @@ void einsum_ir::frontend::EinsumExpression::init( int64_t                 i_num_
         i_data_ptrs );
 }
 
+void einsum_ir::frontend::EinsumExpression::set_path_type( path_t i_path_type ) {
+  m_path_type = i_path_type;
+}
+
+void einsum_ir::frontend::EinsumExpression::set_path_model( model::common::Model i_target,
+                                                            double               i_bandwidth,
+                                                            double               i_peak_gflops,
+                                                            int64_t              i_vector_size ) {
+  m_path_use_model = true;
+  m_path_model_target = i_target;
+  m_path_model_bandwidth = i_bandwidth;
+  m_path_model_peak_gflops = i_peak_gflops;
+  m_path_model_vector_size = i_vector_size;
+}
+
+void einsum_ir::frontend::EinsumExpression::set_dtype_comp( data_t i_dtype_comp ) {
+  m_dtype_comp = i_dtype_comp;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::set_data_ptrs( void * const * i_data_ptrs ) {
+  int64_t l_num_tensors = m_num_conts + 2;
+
+  // the compiled expression depends on the tensors without data
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    if( (i_data_ptrs[l_te] == nullptr) != (m_data_ptrs[l_te] == nullptr) ) {
+      return err_t::NO_DATA_PTR_PROVIDED;
+    }
+  }
+
+  m_data_ptrs = i_data_ptrs;
+
+  if( m_compiled ) {
+    for( int64_t l_te = 0; l_te < l_num_tensors - 1; l_te++ ) {
+      m_nodes[l_te].m_data_ptr_ext = m_data_ptrs[l_te];
+    }
+    m_nodes.back().m_data_ptr_ext = m_data_ptrs[l_num_tensors - 1];
+  }
+
+  return err_t::SUCCESS;
+}
+
+void einsum_ir::frontend::EinsumExpression::set_plan_cache( bool i_use_plan_cache ) {
+  m_use_plan_cache = i_use_plan_cache;
+}
+
+std::string einsum_ir::frontend::EinsumExpression::plan_key() const {
+  int64_t l_num_tensors = m_num_conts + 2;
+
+  std::string l_key = "expr";
+  l_key += "|" + std::to_string( (int64_t) m_dtype );
+  l_key += "|" + std::to_string( (int64_t) m_dtype_comp );
+  l_key += "|" + std::to_string( (int64_t) m_ctype_ext );
+
+  l_key += "|";
+  for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+    l_key += std::to_string( m_dim_sizes[l_di] ) + ",";
+  }
+
+  l_key += "|";
+  int64_t l_string_size = 0;
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    l_key += std::to_string( m_string_num_dims_ext[l_te] ) + ",";
+    l_string_size += m_string_num_dims_ext[l_te];
+  }
+
+  l_key += "|";
+  for( int64_t l_en = 0; l_en < l_string_size; l_en++ ) {
+    l_key += std::to_string( m_string_dim_ids_ext[l_en] ) + ",";
+  }
+
+  // path or settings of the path optimizer
+  l_key += "|";
+  if(    m_path_ext != nullptr
+      && m_path_ext != m_path_opt.data() ) {
+    for( int64_t l_en = 0; l_en < m_num_conts*2; l_en++ ) {
+      l_key += std::to_string( m_path_ext[l_en] ) + ",";
+    }
+  }
+  else {
+    l_key += "opt," + std::to_string( (int64_t) m_path_type );
+    if( m_path_use_model ) {
+      l_key += ",model," + std::to_string( (int64_t) m_path_model_target );
+      l_key += "," + std::to_string( m_path_model_bandwidth );
+      l_key += "," + std::to_string( m_path_model_peak_gflops );
+      l_key += "," + std::to_string( m_path_model_vector_size );
+    }
+  }
+
+  // tensors without data are compiled differently
+  l_key += "|";
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    l_key += (m_data_ptrs[l_te] != nullptr) ? "1" : "0";
+  }
+
+  l_key += "|" + std::to_string( einsum_ir::basic::get_num_threads_available() );
+  PlanCache::append_env( l_key );
+
+  return l_key;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile_cached() {
+  std::string l_key = plan_key();
+
+  PlanCache & l_cache = PlanCache::get();
+  std::shared_ptr< PlanCache::Plan const > l_plan = l_cache.find( l_key );
+
+  // restore the cached plan or derive a new one
+  err_t l_err = compile_nodes( (l_plan != nullptr) ? l_plan->m_data : m_plan_restore );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  if( l_plan == nullptr ) {
+    std::shared_ptr< PlanCache::Plan > l_plan_new = std::make_shared< PlanCache::Plan >();
+    store_plan( l_plan_new->m_data );
+    l_plan = l_cache.insert( l_key,
+                             l_plan_new );
+  }
+  m_plan = l_plan;
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::optimize_path() {
+  // assemble dim id to sizes map
+  for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+    m_map_dim_sizes.insert( {l_di, m_dim_sizes[l_di]} );
+  }
+
+  kernel_t l_ktype_first_touch = (m_ctype_ext == complex_t::REAL_ONLY) ? einsum_ir::ZERO : einsum_ir::CPX_ZERO;
+  kernel_t l_ktype_main        = (m_ctype_ext == complex_t::REAL_ONLY) ? einsum_ir::MADD : einsum_ir::CPX_MADD;
+
+  PathOptimizer l_path_opt;
+  l_path_opt.init( m_num_dims,
+                   m_num_conts,
+                   m_string_num_dims_ext,
+                   m_string_dim_ids_ext,
+                   &m_map_dim_sizes,
+                   l_ktype_first_touch,
+                   l_ktype_main );
+
+  err_t l_err = err_t::SUCCESS;
+  if( m_path_use_model ) {
+    l_err = l_path_opt.set_model( m_path_model_target,
+                                  m_dtype,
+                                  m_path_model_bandwidth,
+                                  m_path_model_peak_gflops,
+                                  m_path_model_vector_size,
+                                  (m_dtype_comp != data_t::UNDEFINED_DTYPE) ? m_dtype_comp : backend::EinsumNode::dtype_comp( m_dtype ) );
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+  }
+
+  m_path_opt.resize( m_num_conts*2 );
+  l_err = l_path_opt.optimize( m_path_type,
+                               m_path_opt.data() );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  m_path_ext = m_path_opt.data();
+
+  return err_t::SUCCESS;
+}
+
 einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
+  m_plan = nullptr;
+  if( m_use_plan_cache ) {
+    return compile_cached();
+  }
+
+  return compile_nodes( m_plan_restore );
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile_nodes( std::vector< int64_t > const & i_plan_restore ) {
+  // derive contraction path if none was provided
+  if(    m_path_ext == nullptr
+      || m_path_ext == m_path_opt.data() ) {
+    // use the path of a restored plan
+    if( !i_plan_restore.empty() ) {
+      m_path_opt.assign( i_plan_restore.begin(),
+                         i_plan_restore.begin() + m_num_conts*2 );
+      m_path_ext = m_path_opt.data();
+    }
+    else {
+      err_t l_err = optimize_path();
+      if( l_err != err_t::SUCCESS ) {
+        return l_err;
+      }
+    }
+  }
+
   // derive contraction path using unqiue tensor ids
   m_path_int.resize( m_num_conts*2 );
   unique_tensor_ids( m_num_conts,
@@ -312,6 +509,13 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
                                                     &m_memory,
                                                     l_num_threads );
 
+  // overwrite the default accumulation type of the contractions
+  if( m_dtype_comp != data_t::UNDEFINED_DTYPE ) {
+    for( int64_t l_co = 0; l_co < m_num_conts; l_co++ ) {
+      m_nodes[l_num_tensors_in+l_co].set_dtype_comp( m_dtype_comp );
+    }
+  }
+
   // add batch-outer to batch-inner conversion
   if( m_ctype_ext == complex_t::BATCH_INNER ) {
     int64_t   l_cpx_conv_child    = l_num_tensors_in + m_num_conts - 1;
@@ -329,6 +533,21 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
                          l_num_threads );
   }
 
+  // restore the plans of the nodes
+  if( !i_plan_restore.empty() ) {
+    std::size_t l_pos = m_num_conts*2;
+    for( std::size_t l_no = 0; l_no < m_nodes.size(); l_no++ ) {
+      err_t l_err = m_nodes[l_no].restore_plan( i_plan_restore,
+                                                l_pos );
+      if( l_err != err_t::SUCCESS ) {
+        return l_err;
+      }
+    }
+    if( l_pos != i_plan_restore.size() ) {
+      return err_t::INVALID_PLAN;
+    }
+  }
+
   err_t l_err = m_nodes.back().compile();
 
   m_compiled = true;
@@ -336,6 +555,45 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
   return l_err;
 }
 
+void einsum_ir::frontend::EinsumExpression::store_plan( std::vector< int64_t > & io_plan ) const {
+  io_plan.insert( io_plan.end(),
+                  m_path_ext,
+                  m_path_ext + m_num_conts*2 );
+  for( std::size_t l_no = 0; l_no < m_nodes.size(); l_no++ ) {
+    m_nodes[l_no].store_plan( io_plan );
+  }
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::save_plan( std::string const & i_path ) const {
+  if( m_compiled == false ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+
+  std::vector< int64_t > l_plan;
+  store_plan( l_plan );
+
+  return PlanFile::write( i_path,
+                          plan_key(),
+                          l_plan );
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::load_plan( std::string const & i_path ) {
+  std::vector< int64_t > l_plan;
+  err_t l_err = PlanFile::read( i_path,
+                                plan_key(),
+                                l_plan );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+  if( (int64_t) l_plan.size() < m_num_conts*2 ) {
+    return err_t::INVALID_PLAN;
+  }
+
+  m_plan_restore = l_plan;
+
+  return err_t::SUCCESS;
+}
+
 einsum_ir::err_t einsum_ir::frontend::EinsumExpression::store_and_lock_data( int64_t i_tensor_id ) {
   if( m_compiled == false ) {
     return err_t::CALLED_BEFORE_COMPILATION;
@@ -366,6 +624,135 @@ void einsum_ir::frontend::EinsumExpression::eval() {
   m_nodes.back().eval();
 }
 
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::eval_batch( int64_t                                    i_num_items,
+                                                                    void                               * const * i_data_ptrs,
+                                                                    std::function< void( int64_t ) >     const & i_completion ) {
+  if( m_compiled == false ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+
+  int64_t l_num_tensors = m_num_conts + 2;
+  int64_t l_num_tensors_in = m_num_conts + 1;
+
+  // the compiled plan depends on the tensors without data
+  for( int64_t l_it = 0; l_it < i_num_items; l_it++ ) {
+    for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+      if( (i_data_ptrs[l_it*l_num_tensors + l_te] == nullptr) != (m_data_ptrs[l_te] == nullptr) ) {
+        return err_t::NO_DATA_PTR_PROVIDED;
+      }
+    }
+  }
+
+  // inputs which are permuted ahead of the contractions into double buffers
+  std::vector< int64_t > l_staged;
+  for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+    backend::EinsumNode & l_node = m_nodes[l_te];
+    if(    l_node.m_data_locked == false
+        && l_node.m_req_mem     != 0
+        && m_data_ptrs[l_te]    != nullptr ) {
+      l_staged.push_back( l_te );
+    }
+  }
+
+  int64_t l_num_staged = l_staged.size();
+  std::vector< void * > l_buffers( 2*l_num_staged );
+  std::vector< int64_t > l_buffer_sizes( 2*l_num_staged );
+  std::vector< int64_t > l_page_sizes( 2*l_num_staged );
+  for( int64_t l_bu = 0; l_bu < 2*l_num_staged; l_bu++ ) {
+    l_buffer_sizes[l_bu] = m_nodes[ l_staged[l_bu % l_num_staged] ].m_size;
+    l_buffers[l_bu] = basic::alloc_pages( l_buffer_sizes[l_bu],
+                                          basic::page_t::BASE_PAGES,
+                                          &l_page_sizes[l_bu] );
+
+    // release the buffers if an allocation fails
+    if( l_buffers[l_bu] == nullptr ) {
+      for( int64_t l_fr = 0; l_fr < l_bu; l_fr++ ) {
+        basic::free_pages( l_buffers[l_fr],
+                           l_buffer_sizes[l_fr],
+                           l_page_sizes[l_fr] );
+      }
+      return err_t::UNDEFINED_ERROR;
+    }
+  }
+
+  // permutes the inputs of an item
+  auto l_stage = [&]( int64_t i_item ) {
+    for( int64_t l_st = 0; l_st < l_num_staged; l_st++ ) {
+      int64_t l_te = l_staged[l_st];
+      m_nodes[l_te].m_unary->eval( i_data_ptrs[i_item*l_num_tensors + l_te],
+                                      l_buffers[ (i_item % 2)*l_num_staged + l_st ] );
+    }
+  };
+
+  // binds the data of an item to the nodes
+  auto l_bind = [&]( int64_t i_item ) {
+    for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+      m_nodes[l_te].m_data_ptr_ext = i_data_ptrs[i_item*l_num_tensors + l_te];
+    }
+    for( int64_t l_st = 0; l_st < l_num_staged; l_st++ ) {
+      backend::EinsumNode & l_node = m_nodes[ l_staged[l_st] ];
+      l_node.m_data_ptr_int = l_buffers[ (i_item % 2)*l_num_staged + l_st ];
+      l_node.m_data_locked = true;
+    }
+    m_nodes.back().m_data_ptr_ext = i_data_ptrs[i_item*l_num_tensors + l_num_tensors - 1];
+  };
+
+  // the permutations are only overlapped if a core of the affinity mask is left over by the contractions
+  bool l_overlap =    basic::supports_thread_teams()
+                   && m_nodes.back().m_num_threads < basic::get_hardware().num_cores_affinity;
+
+  if( i_num_items > 0 ) {
+    l_stage( 0 );
+  }
+  for( int64_t l_it = 0; l_it < i_num_items; l_it++ ) {
+    l_bind( l_it );
+
+    bool l_stage_next = l_num_staged > 0 && l_it+1 < i_num_items;
+    if( l_stage_next && l_overlap ) {
+      // the contraction's threads contract, the spare thread permutes the next item's inputs
+      int64_t l_team_sizes[2] = { m_nodes.back().m_num_threads, 1 };
+      basic::execute_teams( 2,
+                            l_team_sizes,
+                            [&]( int64_t i_team_id ) {
+                              if( i_team_id == 0 ) {
+                                m_nodes.back().eval();
+                              }
+                              else {
+                                l_stage( l_it+1 );
+                              }
+                            } );
+    }
+    else {
+      m_nodes.back().eval();
+      if( l_stage_next ) {
+        l_stage( l_it+1 );
+      }
+    }
+
+    if( i_completion ) {
+      i_completion( l_it );
+    }
+  }
+
+  // restore the data of the expression
+  for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+    m_nodes[l_te].m_data_ptr_ext = m_data_ptrs[l_te];
+  }
+  for( int64_t l_st = 0; l_st < l_num_staged; l_st++ ) {
+    m_nodes[ l_staged[l_st] ].m_data_ptr_int = nullptr;
+    m_nodes[ l_staged[l_st] ].m_data_locked = false;
+  }
+  m_nodes.back().m_data_ptr_ext = m_data_ptrs[l_num_tensors - 1];
+
+  for( int64_t l_bu = 0; l_bu < 2*l_num_staged; l_bu++ ) {
+    basic::free_pages( l_buffers[l_bu],
+                       l_buffer_sizes[l_bu],
+                       l_page_sizes[l_bu] );
+  }
+
+  return err_t::SUCCESS;
+}
+
 int64_t einsum_ir::frontend::EinsumExpression::num_ops() {
   if( m_nodes.size() > 0 ) {
     return m_nodes.back().num_ops( true );
@@ -2,8 +2,12 @@
 #define EINSUM_IR_FRONTEND_EINSUM_EXPRESSION
 
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include "../backend/EinsumNode.h"
+#include "PlanCache.h"
+#include "../model/src/common/common.h"
 
 namespace einsum_ir {
   namespace frontend {
@@ -42,6 +46,8 @@ class einsum_ir::frontend::EinsumExpression {
 
     //! datatype of all tensors
     data_t m_dtype = data_t::UNDEFINED_DTYPE;
+    //! datatype of the accumulation in the contractions, the nodes' default is used if undefined
+    data_t m_dtype_comp = data_t::UNDEFINED_DTYPE;
     //! complex type of the external tensors
     complex_t m_ctype_ext = complex_t::UNDEFINED_CTYPE;
 
@@ -52,6 +58,28 @@ class einsum_ir::frontend::EinsumExpression {
     //! tensors are assumed to be removed after every contraction
     int64_t const * m_path_ext = nullptr;
 
+    //! contraction path derived by the built-in path optimizer (standard formulation)
+    //! only used if no external contraction path was provided
+    std::vector< int64_t > m_path_opt;
+
+    //! strategy of the built-in path optimizer
+    path_t m_path_type = path_t::AUTO_PATH;
+
+    //! true if the built-in path optimizer minimizes the time predicted by the performance model
+    bool m_path_use_model = false;
+
+    //! target of the performance model used by the built-in path optimizer
+    model::common::Model m_path_model_target = model::common::Model::GENERIC;
+
+    //! bandwidth (GB/s) of the permutations in the performance model
+    double m_path_model_bandwidth = 0;
+
+    //! peak GFLOPS of the generic performance model
+    double m_path_model_peak_gflops = 0;
+
+    //! vector size of the generic performance model
+    int64_t m_path_model_vector_size = 0;
+
     //! internal contraction path
     //! tensors are not removed after the contraction, i.e., they have unique ids
     std::vector< int64_t > m_path_int;
@@ -76,6 +104,26 @@ class einsum_ir::frontend::EinsumExpression {
     //! true if the expression was compiled
     bool m_compiled = false;
 
+    //! true if compiled plans are looked up in and added to the process-wide plan cache
+    bool m_use_plan_cache = false;
+
+    //! shared plan if the expression was compiled through the plan cache
+    std::shared_ptr< PlanCache::Plan const > m_plan;
+
+    //! serialized plan which is restored during compilation, empty if the plan is derived
+    std::vector< int64_t > m_plan_restore;
+
+    /**
+     * Constructor.
+     **/
+    EinsumExpression() = default;
+
+    /**
+     * The nodes reference each other and the expression's memory, i.e., expressions are not copyable.
+     **/
+    EinsumExpression( EinsumExpression const & ) = delete;
+    EinsumExpression & operator=( EinsumExpression const & ) = delete;
+
     /**
      * Derives a histogram showing how often the dimensions appear in the einsum string.
      *
@@ -140,7 +188,7 @@ class einsum_ir::frontend::EinsumExpression {
      * @param i_num_conts number of binary contractions.
      * @param i_string_num_ids sizes of the substrings describing the input tensors and output tensor.
      * @param i_string_dim_ids einsum string containing the dimension ids.
-     * @param i_path contraction path.
+     * @param i_path contraction path, nullptr if the path should be derived by the built-in path optimizer.
      * @param i_ctype complex type of all tensors.
      * @param i_dtype datatype of all tensors.
      * @param i_data_ptr pointers to the tensor's data.
@@ -163,7 +211,7 @@ class einsum_ir::frontend::EinsumExpression {
      * @param i_num_conts number of binary contractions.
      * @param i_string_num_ids sizes of the substrings describing the input tensors and output tensor.
      * @param i_string_dim_ids einsum string containing the dimension ids.
-     * @param i_path contraction path.
+     * @param i_path contraction path, nullptr if the path should be derived by the built-in path optimizer.
      * @param i_dtype datatype of all tensors.
      * @param i_data_ptr pointers to the tensor's data.
      **/
@@ -176,8 +224,118 @@ class einsum_ir::frontend::EinsumExpression {
                data_t                  i_dtype,
                void          * const * i_data_ptrs );
 
+    /**
+     * Sets the strategy of the built-in path optimizer.
+     * The optimizer is only used if no contraction path was provided during initialization.
+     *
+     * @param i_path_type strategy of the path optimizer.
+     **/
+    void set_path_type( path_t i_path_type );
+
+    /**
+     * Lets the built-in path optimizer minimize the time predicted by the performance model of the given target.
+     * Without a model, the optimizer minimizes the number of operations.
+     *
+     * @param i_target target of the performance model.
+     * @param i_bandwidth bandwidth (GB/s) of the permutations, the target's default is used if not positive.
+     * @param i_peak_gflops peak GFLOPS, only used by the generic model.
+     * @param i_vector_size vector size, only used by the generic model.
+     **/
+    void set_path_model( model::common::Model i_target,
+                         double               i_bandwidth = 0,
+                         double               i_peak_gflops = 0,
+                         int64_t              i_vector_size = 0 );
+
+    /**
+     * Sets the data type of the accumulation in the contractions.
+     * If undefined, the default of backend::EinsumNode::dtype_comp() is used, which is controlled through EINSUM_IR_DTYPE_COMP.
+     * Has to be called before compilation.
+     *
+     * @param i_dtype_comp data type of the accumulation.
+     **/
+    void set_dtype_comp( data_t i_dtype_comp );
+
+    /**
+     * Rebinds the data of the tensors without recompiling the expression.
+     * Tensors without data have to match those of the initialization.
+     *
+     * @param i_data_ptrs pointers to the tensor's data.
+     * @return SUCCESS if successful, NO_DATA_PTR_PROVIDED if the tensors without data differ.
+     **/
+    err_t set_data_ptrs( void * const * i_data_ptrs );
+
+    /**
+     * Enables or disables the process-wide plan cache.
+     * If enabled, compile() restores the plan of a previously compiled expression with the same signature.
+     * Only the plan's optimization outcome is shared, i.e., the expressions own their nodes and memory and are evaluated independently.
+     *
+     * @param i_use_plan_cache true if the plan cache is used.
+     **/
+    void set_plan_cache( bool i_use_plan_cache );
+
+    /**
+     * Derives the key of the expression in the plan cache.
+     * The key covers the einsum string, dimension sizes, datatypes, contraction path or path optimizer settings,
+     * number of threads and backend configuration.
+     *
+     * @return key of the expression.
+     **/
+    std::string plan_key() const;
+
+    /**
+     * Compiles the einsum expression through the plan cache.
+     * Compiles a new plan only if no plan with the same key is cached.
+     *
+     * @return SUCCESS if successful, otherwise an appropriate error code.
+     **/
+    err_t compile_cached();
+
+    /**
+     * Appends the serialized plan of the compiled expression to a vector.
+     *
+     * @param io_plan vector which is extended by the plan.
+     **/
+    void store_plan( std::vector< int64_t > & io_plan ) const;
+
+    /**
+     * Saves the plan of the compiled expression to a file.
+     * The plan holds the contraction path and the outcome of the dimension reordering and loop optimizations.
+     *
+     * @param i_path path of the file.
+     * @return SUCCESS if successful, otherwise an appropriate error code.
+     **/
+    err_t save_plan( std::string const & i_path ) const;
+
+    /**
+     * Loads a plan from a file which is restored by the next compilation.
+     * The compilation then skips the path, dimension order and loop optimizations and only generates the kernels.
+     * Has to be called after initialization.
+     *
+     * @param i_path path of the file.
+     * @return SUCCESS if successful, PLAN_MISMATCH if the plan was saved for another expression, CPU or number of threads,
+     *         otherwise an appropriate error code.
+     **/
+    err_t load_plan( std::string const & i_path );
+
+    /**
+     * Derives a contraction path through the built-in path optimizer.
+     * The path is stored in m_path_opt and used as external contraction path.
+     *
+     * @return SUCCESS if a path was derived, otherwise an appropriate error code.
+     **/
+    err_t optimize_path();
+
+    /**
+     * Compiles the nodes of the einsum expression.
+     *
+     * @param i_plan_restore serialized plan which is restored, empty if the plan is derived.
+     * @return SUCCESS if successful, otherwise an appropriate error code.
+     **/
+    err_t compile_nodes( std::vector< int64_t > const & i_plan_restore );
+
     /**
      * Compiles the einsum expression. 
+     * If no contraction path was provided, a path is derived through the built-in path optimizer.
      **/
     err_t compile();
 
@@ -200,6 +358,23 @@ class einsum_ir::frontend::EinsumExpression {
      */
     void eval();
 
+    /**
+     * Evaluates the compiled expression for a batch of independent data sets.
+     * The permutations of the input tensors of item i+1 are overlapped with the contractions of item i
+     * if the threading backend supports thread teams and the contractions leave a core of the process's affinity mask unused,
+     * e.g., if OMP_NUM_THREADS is smaller than the number of cores.
+     * Otherwise, the permutations are executed after the contractions.
+     *
+     * @param i_num_items number of items in the batch.
+     * @param i_data_ptrs data pointers of the items, i.e., the pointers of all tensors of item 0, followed by those of item 1, etc.
+     *                    The tensors without data have to match those of the compiled expression.
+     * @param i_completion called in order once the output of an item was written, optional: use nullptr if not needed.
+     * @return SUCCESS if successful, UNDEFINED_ERROR if the buffers of the permuted inputs could not be allocated, otherwise an appropriate error code.
+     **/
+    err_t eval_batch( int64_t                                    i_num_items,
+                      void                               * const * i_data_ptrs,
+                      std::function< void( int64_t ) >     const & i_completion = nullptr );
+
     /**
      * Gets the number of scalar operations required to evaluate the expression.
      *
@@ -1,6 +1,8 @@
 #include <ATen/ATen.h>
+#include <cstdio>
 #include "catch.hpp"
 #include "EinsumExpression.h"
+#include "PlanCache.h"
 
 TEST_CASE( "Single matmul example using an einsum expression through the native interface.", "[einsum_exp]" ) {
   // test case:
@@ -527,6 +529,528 @@ TEST_CASE( "Two matmul expression with locked data.", "[einsum_exp]" ) {
   REQUIRE( at::allclose( l_data_bd, l_data_bd_ref )  );
 }
 
+TEST_CASE( "Two matmul expressions sharing a plan through the plan cache.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //         __bd__
+  //        /      \
+  //    ___ba___    da
+  //   /        \
+  // ca          bc
+  //
+  // char   id   size
+  //    a    0      2
+  //    b    1      3
+  //    c    2      4
+  //    d    3      5
+
+  einsum_ir::frontend::PlanCache & l_cache = einsum_ir::frontend::PlanCache::get();
+  l_cache.clear();
+
+  int64_t l_dim_sizes[4] = { 2, 3, 4, 5 };
+
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+
+  int64_t l_string_dim_ids[8] = { 2, 0,   // ca
+                                  1, 2,   // bc
+                                  3, 0,   // da
+                                  1, 3 }; // bd
+
+  int64_t l_path[4] = { 0, 1,   // ba
+                        0, 1 }; // bd
+
+  at::Tensor l_data_ca[2];
+  at::Tensor l_data_bc[2];
+  at::Tensor l_data_da[2];
+  at::Tensor l_data_bd[2];
+  void * l_data_ptrs[2][4];
+  einsum_ir::frontend::EinsumExpression l_einsum_exp[2];
+
+  for( int64_t l_ex = 0; l_ex < 2; l_ex++ ) {
+    l_data_ca[l_ex] = at::rand( {4, 2} );
+    l_data_bc[l_ex] = at::rand( {3, 4} );
+    l_data_da[l_ex] = at::rand( {5, 2} );
+    l_data_bd[l_ex] = at::rand( {3, 5} );
+
+    l_data_ptrs[l_ex][0] = l_data_ca[l_ex].data_ptr();
+    l_data_ptrs[l_ex][1] = l_data_bc[l_ex].data_ptr();
+    l_data_ptrs[l_ex][2] = l_data_da[l_ex].data_ptr();
+    l_data_ptrs[l_ex][3] = l_data_bd[l_ex].data_ptr();
+
+    l_einsum_exp[l_ex].init( 4,
+                             l_dim_sizes,
+                             2,
+                             l_string_num_dims,
+                             l_string_dim_ids,
+                             l_path,
+                             einsum_ir::FP32,
+                             l_data_ptrs[l_ex] );
+    l_einsum_exp[l_ex].set_plan_cache( true );
+
+    einsum_ir::err_t l_err = l_einsum_exp[l_ex].compile();
+    REQUIRE( l_err == einsum_ir::SUCCESS );
+  }
+
+  // second expression reuses the plan of the first one
+  REQUIRE( l_cache.size() == 1 );
+  REQUIRE( l_cache.num_misses() == 1 );
+  REQUIRE( l_cache.num_hits() == 1 );
+  REQUIRE( l_einsum_exp[0].m_plan == l_einsum_exp[1].m_plan );
+  REQUIRE( l_einsum_exp[1].m_nodes.back().m_plan_restored );
+  REQUIRE( l_einsum_exp[1].num_ops() == l_einsum_exp[0].num_ops() );
+
+  // lock the data of the first expression's left input
+  einsum_ir::err_t l_err = l_einsum_exp[0].store_and_lock_data( 0 );
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+  at::Tensor l_data_ca_locked = l_data_ca[0].clone();
+  l_data_ca[0] += at::rand( {4, 2} );
+
+  l_einsum_exp[1].eval();
+  l_einsum_exp[0].eval();
+
+  at::Tensor l_data_bd_ref = at::einsum( "ca,bc,da->bd",
+                                         {l_data_ca_locked, l_data_bc[0], l_data_da[0]} );
+  REQUIRE( at::allclose( l_data_bd[0], l_data_bd_ref ) );
+
+  l_data_bd_ref = at::einsum( "ca,bc,da->bd",
+                              {l_data_ca[1], l_data_bc[1], l_data_da[1]} );
+  REQUIRE( at::allclose( l_data_bd[1], l_data_bd_ref ) );
+
+  // unlock data
+  l_err = l_einsum_exp[0].unlock_data( 0 );
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  l_einsum_exp[0].eval();
+
+  l_data_bd_ref = at::einsum( "ca,bc,da->bd",
+                              {l_data_ca[0], l_data_bc[0], l_data_da[0]} );
+  REQUIRE( at::allclose( l_data_bd[0], l_data_bd_ref ) );
+
+  l_cache.clear();
+}
+
+TEST_CASE( "Two matmul expression restored from a saved plan.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //         __bd__
+  //        /      \
+  //    ___ba___    da
+  //   /        \
+  // ca          bc
+  //
+  // char   id   size
+  //    a    0      2
+  //    b    1      3
+  //    c    2      4
+  //    d    3      5
+
+  // data
+  at::Tensor l_data_ca = at::rand( {4, 2} );
+  at::Tensor l_data_bc = at::rand( {3, 4} );
+  at::Tensor l_data_da = at::rand( {5, 2} );
+  at::Tensor l_data_bd = at::rand( {3, 5} );
+
+  int64_t l_dim_sizes[4] = { 2, 3, 4, 5 };
+
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+
+  int64_t l_string_dim_ids[8] = { 2, 0,   // ca
+                                  1, 2,   // bc
+                                  3, 0,   // da
+                                  1, 3 }; // bd
+
+  void * l_data_ptrs[4] = { l_data_ca.data_ptr(),
+                            l_data_bc.data_ptr(),
+                            l_data_da.data_ptr(),
+                            l_data_bd.data_ptr() };
+
+  std::string l_path_plan = "einsum_exp_test.plan";
+
+  // derive the contraction path through the path optimizer and save the plan
+  einsum_ir::frontend::EinsumExpression l_einsum_exp_save;
+  l_einsum_exp_save.init( 4,
+                          l_dim_sizes,
+                          2,
+                          l_string_num_dims,
+                          l_string_dim_ids,
+                          nullptr,
+                          einsum_ir::FP32,
+                          l_data_ptrs );
+
+  einsum_ir::err_t l_err = l_einsum_exp_save.save_plan( l_path_plan );
+  REQUIRE( l_err == einsum_ir::CALLED_BEFORE_COMPILATION );
+
+  l_err = l_einsum_exp_save.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  l_err = l_einsum_exp_save.save_plan( l_path_plan );
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  // restore the plan
+  einsum_ir::frontend::EinsumExpression l_einsum_exp;
+  l_einsum_exp.init( 4,
+                     l_dim_sizes,
+                     2,
+                     l_string_num_dims,
+                     l_string_dim_ids,
+                     nullptr,
+                     einsum_ir::FP32,
+                     l_data_ptrs );
+
+  l_err = l_einsum_exp.load_plan( l_path_plan );
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  l_err = l_einsum_exp.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  REQUIRE( l_einsum_exp.m_path_opt == l_einsum_exp_save.m_path_opt );
+  for( std::size_t l_no = 0; l_no < l_einsum_exp.m_nodes.size(); l_no++ ) {
+    REQUIRE( l_einsum_exp.m_nodes[l_no].m_plan_restored );
+    REQUIRE( l_einsum_exp.m_nodes[l_no].m_dim_ids_int == l_einsum_exp_save.m_nodes[l_no].m_dim_ids_int );
+  }
+
+  l_einsum_exp.eval();
+
+  at::Tensor l_data_bd_ref = at::einsum( "ca,bc,da->bd",
+                                         {l_data_ca, l_data_bc, l_data_da} );
+  REQUIRE( at::allclose( l_data_bd, l_data_bd_ref ) );
+
+  // plans of other expressions are rejected
+  int64_t l_dim_sizes_other[4] = { 2, 3, 4, 6 };
+  einsum_ir::frontend::EinsumExpression l_einsum_exp_other;
+  l_einsum_exp_other.init( 4,
+                           l_dim_sizes_other,
+                           2,
+                           l_string_num_dims,
+                           l_string_dim_ids,
+                           nullptr,
+                           einsum_ir::FP32,
+                           l_data_ptrs );
+
+  l_err = l_einsum_exp_other.load_plan( l_path_plan );
+  REQUIRE( l_err == einsum_ir::PLAN_MISMATCH );
+
+  std::remove( l_path_plan.c_str() );
+}
+
+TEST_CASE( "Batched evaluation of a two matmul expression.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //         __bd__
+  //        /      \
+  //    ___ba___    ad
+  //   /        \
+  // ca          bc
+  //
+  // char   id   size
+  //    a    0      2
+  //    b    1      3
+  //    c    2      4
+  //    d    3      5
+
+  int64_t l_dim_sizes[4] = { 2, 3, 4, 5 };
+
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+
+  int64_t l_string_dim_ids[8] = { 2, 0,   // ca
+                                  1, 2,   // bc
+                                  0, 3,   // ad
+                                  1, 3 }; // bd
+
+  int64_t l_path[4] = { 0, 1,   // ba
+                        0, 1 }; // bd
+
+  // data
+  int64_t l_num_items = 3;
+  std::vector< at::Tensor > l_data;
+  std::vector< void * > l_data_ptrs;
+  for( int64_t l_it = 0; l_it < l_num_items; l_it++ ) {
+    l_data.push_back( at::rand( {4, 2} ) );
+    l_data.push_back( at::rand( {3, 4} ) );
+    l_data.push_back( at::rand( {2, 5} ) );
+    l_data.push_back( at::rand( {3, 5} ) );
+    for( int64_t l_te = 0; l_te < 4; l_te++ ) {
+      l_data_ptrs.push_back( l_data[l_it*4 + l_te].data_ptr() );
+    }
+  }
+
+  einsum_ir::frontend::EinsumExpression l_einsum_exp;
+
+  l_einsum_exp.init( 4,
+                     l_dim_sizes,
+                     2,
+                     l_string_num_dims,
+                     l_string_dim_ids,
+                     l_path,
+                     einsum_ir::FP32,
+                     l_data_ptrs.data() );
+
+  einsum_ir::err_t l_err = l_einsum_exp.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  std::vector< int64_t > l_completed;
+  l_err = l_einsum_exp.eval_batch( l_num_items,
+                                   l_data_ptrs.data(),
+                                   [&]( int64_t i_item ) {
+                                     l_completed.push_back( i_item );
+                                   } );
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+  REQUIRE( l_completed == std::vector< int64_t >{ 0, 1, 2 } );
+
+  for( int64_t l_it = 0; l_it < l_num_items; l_it++ ) {
+    at::Tensor l_data_bd_ref = at::einsum( "ca,bc,ad->bd",
+                                           {l_data[l_it*4 + 0], l_data[l_it*4 + 1], l_data[l_it*4 + 2]} );
+    REQUIRE( at::allclose( l_data[l_it*4 + 3], l_data_bd_ref ) );
+  }
+
+  // evaluation of the first item after the batch
+  l_data[3].zero_();
+  l_einsum_exp.eval();
+
+  at::Tensor l_data_bd_ref = at::einsum( "ca,bc,ad->bd",
+                                         {l_data[0], l_data[1], l_data[2]} );
+  REQUIRE( at::allclose( l_data[3], l_data_bd_ref ) );
+}
+
+TEST_CASE( "Two matmul expression with rebound data.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //         __bd__
+  //        /      \
+  //    ___ba___    da
+  //   /        \
+  // ca          bc
+  //
+  // char   id   size
+  //    a    0      2
+  //    b    1      3
+  //    c    2      4
+  //    d    3      5
+
+  int64_t l_dim_sizes[4] = { 2, 3, 4, 5 };
+
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+
+  int64_t l_string_dim_ids[8] = { 2, 0,   // ca
+                                  1, 2,   // bc
+                                  3, 0,   // da
+                                  1, 3 }; // bd
+
+  int64_t l_path[4] = { 0, 1,   // ba
+                        0, 1 }; // bd
+
+  at::Tensor l_data_ca = at::rand( {4, 2} );
+  at::Tensor l_data_bc = at::rand( {3, 4} );
+  at::Tensor l_data_da = at::rand( {5, 2} );
+  at::Tensor l_data_bd = at::rand( {3, 5} );
+
+  void * l_data_ptrs[4] = { l_data_ca.data_ptr(),
+                            l_data_bc.data_ptr(),
+                            l_data_da.data_ptr(),
+                            l_data_bd.data_ptr() };
+
+  einsum_ir::frontend::EinsumExpression l_einsum_exp;
+
+  l_einsum_exp.init( 4,
+                     l_dim_sizes,
+                     2,
+                     l_string_num_dims,
+                     l_string_dim_ids,
+                     l_path,
+                     einsum_ir::FP32,
+                     l_data_ptrs );
+
+  einsum_ir::err_t l_err = l_einsum_exp.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  l_einsum_exp.eval();
+
+  at::Tensor l_data_bd_ref = at::einsum( "ca,bc,da->bd",
+                                         {l_data_ca, l_data_bc, l_data_da} );
+  REQUIRE( at::allclose( l_data_bd, l_data_bd_ref ) );
+
+  // rebind all tensors to new buffers
+  at::Tensor l_data_ca_new = at::rand( {4, 2} );
+  at::Tensor l_data_bc_new = at::rand( {3, 4} );
+  at::Tensor l_data_da_new = at::rand( {5, 2} );
+  at::Tensor l_data_bd_new = at::rand( {3, 5} );
+
+  void * l_data_ptrs_new[4] = { l_data_ca_new.data_ptr(),
+                                l_data_bc_new.data_ptr(),
+                                l_data_da_new.data_ptr(),
+                                l_data_bd_new.data_ptr() };
+
+  l_err = l_einsum_exp.set_data_ptrs( l_data_ptrs_new );
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  l_einsum_exp.eval();
+
+  l_data_bd_ref = at::einsum( "ca,bc,da->bd",
+                              {l_data_ca_new, l_data_bc_new, l_data_da_new} );
+  REQUIRE( at::allclose( l_data_bd_new, l_data_bd_ref ) );
+
+  // tensors without data have to match the compiled expression
+  void * l_data_ptrs_invalid[4] = { l_data_ca_new.data_ptr(),
+                                    nullptr,
+                                    l_data_da_new.data_ptr(),
+                                    l_data_bd_new.data_ptr() };
+
+  l_err = l_einsum_exp.set_data_ptrs( l_data_ptrs_invalid );
+  REQUIRE( l_err == einsum_ir::NO_DATA_PTR_PROVIDED );
+}
+
+TEST_CASE( "Two matmul expression in BF16.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //         __bd__
+  //        /      \
+  //    ___ba___    da
+  //   /        \
+  // ca          bc
+  //
+  // char   id   size
+  //    a    0     32
+  //    b    1     24
+  //    c    2     64
+  //    d    3     40
+
+  int64_t l_dim_sizes[4] = { 32, 24, 64, 40 };
+
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+
+  int64_t l_string_dim_ids[8] = { 2, 0,   // ca
+                                  1, 2,   // bc
+                                  3, 0,   // da
+                                  1, 3 }; // bd
+
+  int64_t l_path[4] = { 0, 1,   // ba
+                        0, 1 }; // bd
+
+  at::Tensor l_data_ca = at::randn( {64, 32} ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_data_bc = at::randn( {24, 64} ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_data_da = at::randn( {40, 32} ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_data_bd = at::zeros( {24, 40} ).to( at::ScalarType::BFloat16 );
+
+  void * l_data_ptrs[4] = { l_data_ca.data_ptr(),
+                            l_data_bc.data_ptr(),
+                            l_data_da.data_ptr(),
+                            l_data_bd.data_ptr() };
+
+  einsum_ir::frontend::EinsumExpression l_einsum_exp;
+
+  l_einsum_exp.init( 4,
+                     l_dim_sizes,
+                     2,
+                     l_string_num_dims,
+                     l_string_dim_ids,
+                     l_path,
+                     einsum_ir::BF16,
+                     l_data_ptrs );
+
+  einsum_ir::err_t l_err = l_einsum_exp.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  l_einsum_exp.eval();
+
+  // the intermediate tensor is rounded to BF16
+  at::Tensor l_data_ba_ref = at::einsum( "ca,bc->ba",
+                                         {l_data_ca.to( at::ScalarType::Float ),
+                                          l_data_bc.to( at::ScalarType::Float )} ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_data_bd_ref = at::einsum( "ba,da->bd",
+                                         {l_data_ba_ref.to( at::ScalarType::Float ),
+                                          l_data_da.to( at::ScalarType::Float )} );
+
+  REQUIRE( at::allclose( l_data_bd.to( at::ScalarType::Float ), l_data_bd_ref, 1E-2, 1E-1 ) );
+}
+
+TEST_CASE( "Two matmul expression in FP16.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //         __bd__
+  //        /      \
+  //    ___ba___    da
+  //   /        \
+  // ca          bc
+  //
+  // char   id   size
+  //    a    0     32
+  //    b    1     24
+  //    c    2     64
+  //    d    3     40
+
+  int64_t l_dim_sizes[4] = { 32, 24, 64, 40 };
+
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+
+  int64_t l_string_dim_ids[8] = { 2, 0,   // ca
+                                  1, 2,   // bc
+                                  3, 0,   // da
+                                  1, 3 }; // bd
+
+  int64_t l_path[4] = { 0, 1,   // ba
+                        0, 1 }; // bd
+
+  at::Tensor l_data_ca = at::randn( {64, 32} ).to( at::ScalarType::Half );
+  at::Tensor l_data_bc = at::randn( {24, 64} ).to( at::ScalarType::Half );
+  at::Tensor l_data_da = at::randn( {40, 32} ).to( at::ScalarType::Half );
+  at::Tensor l_data_bd = at::zeros( {24, 40} ).to( at::ScalarType::Half );
+
+  void * l_data_ptrs[4] = { l_data_ca.data_ptr(),
+                            l_data_bc.data_ptr(),
+                            l_data_da.data_ptr(),
+                            l_data_bd.data_ptr() };
+
+  einsum_ir::frontend::EinsumExpression l_einsum_exp;
+
+  l_einsum_exp.init( 4,
+                     l_dim_sizes,
+                     2,
+                     l_string_num_dims,
+                     l_string_dim_ids,
+                     l_path,
+                     einsum_ir::FP16,
+                     l_data_ptrs );
+
+  einsum_ir::err_t l_err = l_einsum_exp.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  l_einsum_exp.eval();
+
+  // the intermediate tensor is rounded to FP16
+  at::Tensor l_data_ba_ref = at::einsum( "ca,bc->ba",
+                                         {l_data_ca.to( at::ScalarType::Float ),
+                                          l_data_bc.to( at::ScalarType::Float )} ).to( at::ScalarType::Half );
+  at::Tensor l_data_bd_ref = at::einsum( "ba,da->bd",
+                                         {l_data_ba_ref.to( at::ScalarType::Float ),
+                                          l_data_da.to( at::ScalarType::Float )} );
+
+  REQUIRE( at::allclose( l_data_bd.to( at::ScalarType::Float ), l_data_bd_ref, 1E-2, 1E-1 ) );
+
+  // explicit FP32 accumulation, independent of EINSUM_IR_DTYPE_COMP
+  einsum_ir::frontend::EinsumExpression l_einsum_exp_fp32;
+
+  l_einsum_exp_fp32.init( 4,
+                          l_dim_sizes,
+                          2,
+                          l_string_num_dims,
+                          l_string_dim_ids,
+                          l_path,
+                          einsum_ir::FP16,
+                          l_data_ptrs );
+  l_einsum_exp_fp32.set_dtype_comp( einsum_ir::FP32 );
+  REQUIRE( l_einsum_exp_fp32.plan_key() != l_einsum_exp.plan_key() );
+
+  l_err = l_einsum_exp_fp32.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+  REQUIRE( l_einsum_exp_fp32.m_nodes[3].m_dtype_comp == einsum_ir::FP32 );
+  REQUIRE( l_einsum_exp_fp32.m_nodes[4].m_dtype_comp == einsum_ir::FP32 );
+
+  l_data_bd.zero_();
+  l_einsum_exp_fp32.eval();
+
+  REQUIRE( at::allclose( l_data_bd.to( at::ScalarType::Float ), l_data_bd_ref, 1E-2, 1E-1 ) );
+}
+
 TEST_CASE( "Single-level einsum expression using the internal interface, stride-1 N.", "[einsum_exp]" ) {
   // test case:
   //
@@ -1,6 +1,9 @@
 #include "EinsumTree.h"
 #include "EinsumTreeAscii.h"
+#include "PlanCache.h"
+#include "PlanFile.h"
 #include "../basic/threading.h"
+#include <cstdio>
 
 void einsum_ir::frontend::EinsumTree::init( std::vector< std::vector< int64_t > >         * i_dim_ids,
                                             std::vector< std::vector< int64_t > >         * i_children,
@@ -13,9 +16,148 @@ void einsum_ir::frontend::EinsumTree::init( std::vector< std::vector< int64_t >
   m_map_dim_sizes = i_map_dim_sizes;
   m_dtype = i_dtype;
   m_data_ptrs = i_data_ptrs;
+  m_plan_restore.clear();
+  m_ktypes_last_touch.clear();
+  m_last_touch_params.clear();
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumTree::set_data_ptrs( void * const * i_data_ptrs ) {
+  // the compiled tree depends on the tensors without data
+  for( std::size_t l_no = 0; l_no < m_children->size(); l_no++ ) {
+    if( (i_data_ptrs[l_no] == nullptr) != (m_data_ptrs[l_no] == nullptr) ) {
+      return err_t::NO_DATA_PTR_PROVIDED;
+    }
+  }
+
+  m_data_ptrs = i_data_ptrs;
+
+  for( std::size_t l_no = 0; l_no < m_nodes.size(); l_no++ ) {
+    m_nodes[l_no].m_data_ptr_ext = m_data_ptrs[l_no];
+  }
+
+  return err_t::SUCCESS;
+}
+
+void einsum_ir::frontend::EinsumTree::set_dtype_comp( data_t i_dtype_comp ) {
+  m_dtype_comp = i_dtype_comp;
+}
+
+void einsum_ir::frontend::EinsumTree::set_plan_cache( bool i_use_plan_cache ) {
+  m_use_plan_cache = i_use_plan_cache;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumTree::set_last_touch( int64_t                          i_tensor_id,
+                                                                  kernel_t                         i_ktype,
+                                                                  basic::last_touch_params const & i_params ) {
+  if(    i_tensor_id < 0
+      || i_tensor_id >= (int64_t) m_children->size()
+      || m_children->at( i_tensor_id ).size() != 2 ) {
+    return err_t::INVALID_ID;
+  }
+
+  // the tree has no auxiliary tensors, i.e., only kernels touching the output are supported
+  if(    i_ktype != kernel_t::RELU
+      && i_ktype != kernel_t::GELU
+      && i_ktype != kernel_t::SILU
+      && i_ktype != kernel_t::SIGMOID
+      && i_ktype != kernel_t::TANH
+      && i_ktype != kernel_t::SCALE_SHIFT
+      && i_ktype != kernel_t::CLAMP
+      && i_ktype != kernel_t::UNDEFINED_KTYPE ) {
+    return err_t::INVALID_KTYPE;
+  }
+
+  m_ktypes_last_touch[i_tensor_id] = i_ktype;
+  m_last_touch_params[i_tensor_id] = i_params;
+
+  return err_t::SUCCESS;
+}
+
+std::string einsum_ir::frontend::EinsumTree::plan_key() const {
+  std::string l_key = "tree";
+  l_key += "|" + std::to_string( (int64_t) m_dtype );
+  l_key += "|" + std::to_string( (int64_t) m_dtype_comp );
+
+  for( std::size_t l_no = 0; l_no < m_children->size(); l_no++ ) {
+    l_key += "|";
+    for( std::size_t l_di = 0; l_di < m_dim_ids->at( l_no ).size(); l_di++ ) {
+      l_key += std::to_string( m_dim_ids->at( l_no )[l_di] ) + ",";
+    }
+    l_key += ">";
+    for( std::size_t l_ch = 0; l_ch < m_children->at( l_no ).size(); l_ch++ ) {
+      l_key += std::to_string( m_children->at( l_no )[l_ch] ) + ",";
+    }
+    // tensors without data are compiled differently
+    l_key += (m_data_ptrs[l_no] != nullptr) ? "1" : "0";
+  }
+
+  // fused epilogues
+  l_key += "|";
+  for( std::map< int64_t, kernel_t >::const_iterator l_it = m_ktypes_last_touch.begin(); l_it != m_ktypes_last_touch.end(); l_it++ ) {
+    basic::last_touch_params const & l_params = m_last_touch_params.at( l_it->first );
+    l_key += std::to_string( l_it->first ) + ":" + std::to_string( (int64_t) l_it->second );
+
+    double l_values[4] = { l_params.scale,
+                           l_params.shift,
+                           l_params.clamp_min,
+                           l_params.clamp_max };
+    for( int64_t l_va = 0; l_va < 4; l_va++ ) {
+      // exact representation of the parameters
+      char l_value[32];
+      std::snprintf( l_value,
+                     sizeof( l_value ),
+                     "%a",
+                     l_values[l_va] );
+      l_key += ":";
+      l_key += l_value;
+    }
+    l_key += ",";
+  }
+
+  l_key += "|";
+  for( std::map< int64_t, int64_t >::const_iterator l_it = m_map_dim_sizes->begin(); l_it != m_map_dim_sizes->end(); l_it++ ) {
+    l_key += std::to_string( l_it->first ) + ":" + std::to_string( l_it->second ) + ",";
+  }
+
+  l_key += "|" + std::to_string( einsum_ir::basic::get_num_threads_available() );
+  PlanCache::append_env( l_key );
+
+  return l_key;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumTree::compile_cached() {
+  std::string l_key = plan_key();
+
+  PlanCache & l_cache = PlanCache::get();
+  std::shared_ptr< PlanCache::Plan const > l_plan = l_cache.find( l_key );
+
+  // restore the cached plan or derive a new one
+  err_t l_err = compile_nodes( (l_plan != nullptr) ? l_plan->m_data : m_plan_restore );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  if( l_plan == nullptr ) {
+    std::shared_ptr< PlanCache::Plan > l_plan_new = std::make_shared< PlanCache::Plan >();
+    store_plan( l_plan_new->m_data );
+    l_plan = l_cache.insert( l_key,
+                             l_plan_new );
+  }
+  m_plan = l_plan;
+
+  return err_t::SUCCESS;
 }
 
 einsum_ir::err_t einsum_ir::frontend::EinsumTree::compile() {
+  m_plan = nullptr;
+  if( m_use_plan_cache ) {
+    return compile_cached();
+  }
+
+  return compile_nodes( m_plan_restore );
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumTree::compile_nodes( std::vector< int64_t > const & i_plan_restore ) {
   err_t l_err = err_t::UNDEFINED_ERROR;
 
   int64_t l_num_threads = einsum_ir::basic::get_num_threads_available();
@@ -59,6 +201,10 @@ einsum_ir::err_t einsum_ir::frontend::EinsumTree::compile() {
       int64_t l_child_right = l_children->at(1);
       kernel_t l_ktype_first_touch = einsum_ir::ZERO;
       kernel_t l_ktype_main        = einsum_ir::MADD;
+      kernel_t l_ktype_last_touch  = kernel_t::UNDEFINED_KTYPE;
+      if( m_ktypes_last_touch.count( l_node_id ) > 0 ) {
+        l_ktype_last_touch = m_ktypes_last_touch.at( l_node_id );
+      }
 
       l_node->init( l_dim_ids->size(),
                     l_dim_ids->data(),
@@ -72,14 +218,35 @@ einsum_ir::err_t einsum_ir::frontend::EinsumTree::compile() {
                     l_data_ptr,
                     l_ktype_first_touch,
                     l_ktype_main,
-                    kernel_t::UNDEFINED_KTYPE,
+                    l_ktype_last_touch,
                     &m_nodes[l_child_left],
                     &m_nodes[l_child_right],
                     &m_memory,
                     l_num_threads );
+      if( m_last_touch_params.count( l_node_id ) > 0 ) {
+        l_node->set_last_touch_params( m_last_touch_params.at( l_node_id ) );
+      }
+      if( m_dtype_comp != data_t::UNDEFINED_DTYPE ) {
+        l_node->set_dtype_comp( m_dtype_comp );
+      }
     }
   }
   
+  //restore the plans of the nodes
+  if( !i_plan_restore.empty() ) {
+    std::size_t l_pos = 0;
+    for( std::size_t l_no = 0; l_no < m_nodes.size(); l_no++ ) {
+      l_err = m_nodes[l_no].restore_plan( i_plan_restore,
+                                          l_pos );
+      if( l_err != err_t::SUCCESS ) {
+        return l_err;
+      }
+    }
+    if( l_pos != i_plan_restore.size() ) {
+      return err_t::INVALID_PLAN;
+    }
+  }
+
   //compile all nodes
   l_err = m_nodes.back().compile();
   if( l_err != einsum_ir::SUCCESS ) {
@@ -89,6 +256,39 @@ einsum_ir::err_t einsum_ir::frontend::EinsumTree::compile() {
   return einsum_ir::SUCCESS;
 }
 
+void einsum_ir::frontend::EinsumTree::store_plan( std::vector< int64_t > & io_plan ) const {
+  for( std::size_t l_no = 0; l_no < m_nodes.size(); l_no++ ) {
+    m_nodes[l_no].store_plan( io_plan );
+  }
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumTree::save_plan( std::string const & i_path ) const {
+  if( m_nodes.empty() || !m_nodes.back().m_compiled ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+
+  std::vector< int64_t > l_plan;
+  store_plan( l_plan );
+
+  return PlanFile::write( i_path,
+                          plan_key(),
+                          l_plan );
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumTree::load_plan( std::string const & i_path ) {
+  std::vector< int64_t > l_plan;
+  err_t l_err = PlanFile::read( i_path,
+                                plan_key(),
+                                l_plan );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  m_plan_restore = l_plan;
+
+  return err_t::SUCCESS;
+}
+
 void einsum_ir::frontend::EinsumTree::eval() {
   m_nodes.back().eval();
 }
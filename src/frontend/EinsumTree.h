@@ -1,10 +1,12 @@
 #ifndef EINSUM_IR_FRONTEND_EINSUM_TREE
 #define EINSUM_IR_FRONTEND_EINSUM_TREE
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
 #include "../backend/EinsumNode.h"
+#include "PlanCache.h"
 
 namespace einsum_ir {
   namespace frontend {
@@ -32,9 +34,27 @@ class einsum_ir::frontend::EinsumTree {
     //! datatype of all tensors
     data_t m_dtype = data_t::UNDEFINED_DTYPE;
 
+    //! datatype of the accumulation in the contractions, the nodes' default is used if undefined
+    data_t m_dtype_comp = data_t::UNDEFINED_DTYPE;
+
     //! mapping from dim ids to sizes
     std::map< int64_t, int64_t > * m_map_dim_sizes;
 
+    //! true if compiled plans are looked up in and added to the process-wide plan cache
+    bool m_use_plan_cache = false;
+
+    //! shared plan if the tree was compiled through the plan cache
+    std::shared_ptr< PlanCache::Plan const > m_plan;
+
+    //! serialized plan which is restored during compilation, empty if the plan is derived
+    std::vector< int64_t > m_plan_restore;
+
+    //! last-touch kernels of the binary nodes, mapping from tensor ids to kernel types
+    std::map< int64_t, kernel_t > m_ktypes_last_touch;
+
+    //! parameters of the last-touch kernels, mapping from tensor ids to parameters
+    std::map< int64_t, basic::last_touch_params > m_last_touch_params;
+
     /**
      * Initializes the einsum tree.
      * @param i_dim_ids vector of all tensors with their dimension ids
@@ -49,11 +69,101 @@ class einsum_ir::frontend::EinsumTree {
                data_t                                          i_dtype,
                void                                  * const * i_data_ptrs );
 
+    /**
+     * Rebinds the data of the tensors without recompiling the tree.
+     * Tensors without data have to match those of the initialization.
+     *
+     * @param i_data_ptrs pointers to the tensor's data.
+     * @return SUCCESS if successful, NO_DATA_PTR_PROVIDED if the tensors without data differ.
+     **/
+    err_t set_data_ptrs( void * const * i_data_ptrs );
+
+    /**
+     * Sets the data type of the accumulation in the contractions.
+     * If undefined, the default of backend::EinsumNode::dtype_comp() is used, which is controlled through EINSUM_IR_DTYPE_COMP.
+     * Has to be called before compilation.
+     *
+     * @param i_dtype_comp data type of the accumulation.
+     **/
+    void set_dtype_comp( data_t i_dtype_comp );
+
+    /**
+     * Enables or disables the process-wide plan cache.
+     * If enabled, compile() restores the plan of a previously compiled tree with the same signature.
+     * Only the plan's optimization outcome is shared, i.e., the trees own their nodes and memory and are evaluated independently.
+     *
+     * @param i_use_plan_cache true if the plan cache is used.
+     **/
+    void set_plan_cache( bool i_use_plan_cache );
+
+    /**
+     * Fuses an epilogue into the contraction of a binary node, i.e., the kernel is applied to the node's output tensor.
+     * Supported are the activations RELU, GELU, SILU, SIGMOID and TANH, and SCALE_SHIFT and CLAMP.
+     * Has to be called after initialization.
+     *
+     * @param i_tensor_id id of the binary node's output tensor.
+     * @param i_ktype type of the last-touch kernel.
+     * @param i_params parameters of SCALE_SHIFT and CLAMP.
+     * @return SUCCESS if successful, INVALID_ID if the tensor is not the output of a binary node, INVALID_KTYPE for unsupported kernels.
+     **/
+    err_t set_last_touch( int64_t                          i_tensor_id,
+                          kernel_t                         i_ktype,
+                          basic::last_touch_params const & i_params = basic::last_touch_params() );
+
+    /**
+     * Derives the key of the tree in the plan cache.
+     *
+     * @return key of the tree.
+     **/
+    std::string plan_key() const;
+
+    /**
+     * Compiles the einsum tree through the plan cache.
+     *
+     * @return SUCCESS if successful, otherwise an appropriate error code.
+     **/
+    err_t compile_cached();
+
+    /**
+     * Compiles the nodes of the einsum tree.
+     *
+     * @param i_plan_restore serialized plan which is restored, empty if the plan is derived.
+     * @return SUCCESS if successful, otherwise an appropriate error code.
+     **/
+    err_t compile_nodes( std::vector< int64_t > const & i_plan_restore );
+
     /**
      * Compiles the einsum tree. 
      **/
     err_t compile();
 
+    /**
+     * Appends the serialized plan of the compiled tree to a vector.
+     *
+     * @param io_plan vector which is extended by the plan.
+     **/
+    void store_plan( std::vector< int64_t > & io_plan ) const;
+
+    /**
+     * Saves the plan of the compiled tree to a file.
+     * The plan holds the outcome of the dimension reordering and loop optimizations.
+     *
+     * @param i_path path of the file.
+     * @return SUCCESS if successful, otherwise an appropriate error code.
+     **/
+    err_t save_plan( std::string const & i_path ) const;
+
+    /**
+     * Loads a plan from a file which is restored by the next compilation.
+     * The compilation then skips the dimension order and loop optimizations and only generates the kernels.
+     * Has to be called after initialization.
+     *
+     * @param i_path path of the file.
+     * @return SUCCESS if successful, PLAN_MISMATCH if the plan was saved for another tree, CPU or number of threads,
+     *         otherwise an appropriate error code.
+     **/
+    err_t load_plan( std::string const & i_path );
+
     /**
      * Evaluates the einsum tree.
      */
@@ -58,6 +58,66 @@ TEST_CASE( "creation of a binary contraction", "[einsum_tree]" ) {
 }
 
 
+TEST_CASE( "binary contraction with rebound data", "[einsum_tree]" ) {
+  std::string l_string_torch = "ad,bcd->abc";
+
+  std::map< int64_t, int64_t> l_dim_sizes = { {0, 2},
+                                              {1, 4},
+                                              {2, 6},
+                                              {3, 8} };
+
+  std::vector< std::vector< int64_t > > l_dim_ids;
+  l_dim_ids.push_back({0, 3});
+  l_dim_ids.push_back({1, 2, 3});
+  l_dim_ids.push_back({0, 1, 2});
+
+  std::vector< std::vector< int64_t > > l_children;
+  l_children.push_back({    });
+  l_children.push_back({    });
+  l_children.push_back({0, 1});
+
+  einsum_ir::data_t l_dtype = einsum_ir::data_t::FP32;
+
+  at::Tensor l_left  = at::rand( {2, 8},    at::ScalarType::Float);
+  at::Tensor l_right = at::rand( {4, 6, 8}, at::ScalarType::Float);
+  at::Tensor l_out   = at::rand( {2, 4, 6}, at::ScalarType::Float);
+
+  void * l_data_ptrs[] = { l_left.data_ptr(),
+                           l_right.data_ptr(),
+                           l_out.data_ptr() };
+
+  einsum_ir::frontend::EinsumTree einsum_tree;
+  einsum_tree.init( &l_dim_ids,
+                    &l_children,
+                    &l_dim_sizes,
+                    l_dtype,
+                    l_data_ptrs );
+
+  einsum_ir::err_t l_err = einsum_tree.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  // rebind to new buffers
+  at::Tensor l_left_new  = at::rand( {2, 8},    at::ScalarType::Float);
+  at::Tensor l_right_new = at::rand( {4, 6, 8}, at::ScalarType::Float);
+  at::Tensor l_out_new   = at::rand( {2, 4, 6}, at::ScalarType::Float);
+
+  void * l_data_ptrs_new[] = { l_left_new.data_ptr(),
+                               l_right_new.data_ptr(),
+                               l_out_new.data_ptr() };
+
+  l_err = einsum_tree.set_data_ptrs( l_data_ptrs_new );
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  einsum_tree.eval();
+
+  //refernce
+  at::Tensor l_out_ref = at::einsum( l_string_torch,
+                                     {l_left_new, l_right_new} );
+
+  // check results
+  REQUIRE( at::allclose( l_out_new, l_out_ref )  );
+}
+
 TEST_CASE( "creation of unary transposition", "[einsum_tree]" ) {
   std::string l_string_tree = "[0,1]->[1,0]";
   std::string l_string_torch = "ab->ba";
@@ -162,3 +222,75 @@ TEST_CASE( "creation of a complex einsum tree", "[einsum_tree]" ) {
   REQUIRE( at::allclose( l_out, l_out_ref )  );
 }
 
+
+TEST_CASE( "two binary contractions with fused epilogues", "[einsum_tree]" ) {
+  std::string l_string_torch_0 = "ad,bcd->abc";
+  std::string l_string_torch_1 = "abc,ce->abe";
+
+  std::map< int64_t, int64_t> l_dim_sizes = { {0, 2},
+                                              {1, 4},
+                                              {2, 6},
+                                              {3, 8},
+                                              {4, 5} };
+
+  std::vector< std::vector< int64_t > > l_dim_ids;
+  l_dim_ids.push_back({0, 3});
+  l_dim_ids.push_back({1, 2, 3});
+  l_dim_ids.push_back({0, 1, 2});
+  l_dim_ids.push_back({2, 4});
+  l_dim_ids.push_back({0, 1, 4});
+
+  std::vector< std::vector< int64_t > > l_children;
+  l_children.push_back({    });
+  l_children.push_back({    });
+  l_children.push_back({0, 1});
+  l_children.push_back({    });
+  l_children.push_back({2, 3});
+
+  einsum_ir::data_t l_dtype = einsum_ir::data_t::FP32;
+
+  at::Tensor l_left   = at::randn( {2, 8},    at::ScalarType::Float);
+  at::Tensor l_right  = at::randn( {4, 6, 8}, at::ScalarType::Float);
+  at::Tensor l_weight = at::randn( {6, 5},    at::ScalarType::Float);
+  at::Tensor l_out    = at::randn( {2, 4, 5}, at::ScalarType::Float);
+
+  void * l_data_ptrs[] = { l_left.data_ptr(),
+                           l_right.data_ptr(),
+                           nullptr,
+                           l_weight.data_ptr(),
+                           l_out.data_ptr() };
+
+  einsum_ir::frontend::EinsumTree einsum_tree;
+  einsum_tree.init( &l_dim_ids,
+                    &l_children,
+                    &l_dim_sizes,
+                    l_dtype,
+                    l_data_ptrs );
+
+  einsum_ir::basic::last_touch_params l_params;
+  l_params.clamp_min = -1.0;
+  l_params.clamp_max =  1.5;
+
+  // only binary nodes have last touches
+  REQUIRE( einsum_tree.set_last_touch( 0, einsum_ir::GELU ) == einsum_ir::INVALID_ID );
+  // the tree has no auxiliary tensors
+  REQUIRE( einsum_tree.set_last_touch( 2, einsum_ir::ADD_RELU ) == einsum_ir::INVALID_KTYPE );
+
+  REQUIRE( einsum_tree.set_last_touch( 2, einsum_ir::GELU ) == einsum_ir::SUCCESS );
+  REQUIRE( einsum_tree.set_last_touch( 4, einsum_ir::CLAMP, l_params ) == einsum_ir::SUCCESS );
+
+  einsum_ir::err_t l_err = einsum_tree.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  einsum_tree.eval();
+
+  // reference
+  at::Tensor l_out_ref = at::einsum( l_string_torch_0,
+                                     {l_left, l_right} );
+  l_out_ref = at::gelu( l_out_ref );
+  l_out_ref = at::einsum( l_string_torch_1,
+                          {l_out_ref, l_weight} );
+  l_out_ref = at::clamp( l_out_ref, -1.0, 1.5 );
+
+  REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
+}
@@ -0,0 +1,745 @@
+#include "PathOptimizer.h"
+#include "EinsumExpression.h"
+#include "../backend/BinaryContraction.h"
+#include "../backend/Tensor.h"
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <limits>
+
+void einsum_ir::frontend::PathOptimizer::standard_tensor_ids( int64_t         i_num_conts,
+                                                              int64_t const * i_path,
+                                                              int64_t       * o_path ) {
+  int64_t l_num_tensors = i_num_conts + 1;
+
+  std::deque< int64_t > l_tensor_ids;
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    l_tensor_ids.push_back( l_te );
+  }
+
+  for( int64_t l_co = 0; l_co < i_num_conts; l_co++ ) {
+    // get positions of the tensors
+    int64_t l_pos_0 = std::find( l_tensor_ids.begin(),
+                                 l_tensor_ids.end(),
+                                 i_path[l_co*2 + 0] ) - l_tensor_ids.begin();
+    int64_t l_pos_1 = std::find( l_tensor_ids.begin(),
+                                 l_tensor_ids.end(),
+                                 i_path[l_co*2 + 1] ) - l_tensor_ids.begin();
+
+    // add contraction to standard path
+    o_path[l_co*2 + 0] = l_pos_0;
+    o_path[l_co*2 + 1] = l_pos_1;
+
+    // remove tensors' ids
+    l_tensor_ids.erase( l_tensor_ids.begin() + std::max( l_pos_0, l_pos_1 ) );
+    l_tensor_ids.erase( l_tensor_ids.begin() + std::min( l_pos_0, l_pos_1 ) );
+
+    // add id of contraction output
+    l_tensor_ids.push_back( l_num_tensors );
+    l_num_tensors++;
+  }
+}
+
+void einsum_ir::frontend::PathOptimizer::init( int64_t                              i_num_dims,
+                                               int64_t                              i_num_conts,
+                                               int64_t                      const * i_string_num_dims,
+                                               int64_t                      const * i_string_dim_ids,
+                                               std::map< int64_t, int64_t > const * i_dim_sizes,
+                                               kernel_t                             i_ktype_first_touch,
+                                               kernel_t                             i_ktype_main ) {
+  m_num_dims = i_num_dims;
+  m_num_tensors_in = i_num_conts + 1;
+  m_dim_sizes = i_dim_sizes;
+  m_ktype_first_touch = i_ktype_first_touch;
+  m_ktype_main = i_ktype_main;
+
+  m_string_dim_ids = i_string_dim_ids;
+
+  m_dim_ids_in.resize( m_num_tensors_in );
+  int64_t l_off = 0;
+  for( int64_t l_te = 0; l_te < m_num_tensors_in; l_te++ ) {
+    m_dim_ids_in[l_te] = std::vector< int64_t >( i_string_dim_ids + l_off,
+                                                 i_string_dim_ids + l_off + i_string_num_dims[l_te] );
+    l_off += i_string_num_dims[l_te];
+  }
+  m_dim_ids_out = std::vector< int64_t >( i_string_dim_ids + l_off,
+                                          i_string_dim_ids + l_off + i_string_num_dims[m_num_tensors_in] );
+  m_string_size = l_off + i_string_num_dims[m_num_tensors_in];
+}
+
+einsum_ir::err_t einsum_ir::frontend::PathOptimizer::set_model( model::common::Model i_target,
+                                                               data_t               i_dtype,
+                                                               double               i_bandwidth,
+                                                               double               i_peak_gflops,
+                                                               int64_t              i_vector_size,
+                                                               data_t               i_dtype_comp ) {
+  if( i_dtype_comp == data_t::UNDEFINED_DTYPE ) {
+    i_dtype_comp = ce_dtype_comp( i_dtype );
+  }
+
+  if( i_dtype == data_t::FP32 ) {
+    m_model_dtype = model::common::DType::FP32;
+    m_dtype_size = 4;
+  }
+  else if( i_dtype == data_t::FP64 ) {
+    m_model_dtype = model::common::DType::FP64;
+    m_dtype_size = 8;
+  }
+  // the models have no BF16 data, BF16 GEMMs accumulate in FP32
+  else if( i_dtype == data_t::BF16 ) {
+    m_model_dtype = model::common::DType::FP32;
+    m_dtype_size = 2;
+  }
+  // FP16 GEMMs either run natively in FP16 or accumulate in FP32
+  else if( i_dtype == data_t::FP16 ) {
+    m_model_dtype = ( i_dtype_comp == data_t::FP16 ) ? model::common::DType::FP16 : model::common::DType::FP32;
+    m_dtype_size = 2;
+  }
+  else {
+    return err_t::INVALID_DTYPE;
+  }
+
+  if(    i_target == model::common::Model::GENERIC
+      && (    i_peak_gflops <= 0
+           || i_vector_size <= 0 ) ) {
+    return err_t::INVALID_MODEL;
+  }
+
+  // default bandwidths (GB/s) of the permutations
+  double l_bandwidth = i_bandwidth;
+  if( l_bandwidth <= 0 ) {
+    if(      i_target == model::common::Model::ZEN5 ) l_bandwidth = 40;
+    else if( i_target == model::common::Model::M4   ) l_bandwidth = 60;
+    else if( i_target == model::common::Model::A76  ) l_bandwidth = 12;
+    else                                              l_bandwidth = 20;
+  }
+
+  m_use_model = true;
+  m_model_target = i_target;
+  m_model_bandwidth = l_bandwidth;
+  m_model_peak_gflops = i_peak_gflops;
+  m_model_vector_size = i_vector_size;
+
+  return err_t::SUCCESS;
+}
+
+int64_t einsum_ir::frontend::PathOptimizer::size( std::vector< int64_t > const & i_dim_ids ) const {
+  double l_size = 1;
+  for( std::size_t l_di = 0; l_di < i_dim_ids.size(); l_di++ ) {
+    l_size *= m_dim_sizes->at( i_dim_ids[l_di] );
+  }
+  if( l_size > std::numeric_limits< int64_t >::max() / 4 ) {
+    return -1;
+  }
+
+  return backend::Tensor::size( 1,
+                                i_dim_ids.size(),
+                                i_dim_ids.data(),
+                                *m_dim_sizes );
+}
+
+bool einsum_ir::frontend::PathOptimizer::shares_dims( std::vector< int64_t > const & i_dim_ids_left,
+                                                      std::vector< int64_t > const & i_dim_ids_right ) {
+  for( std::size_t l_le = 0; l_le < i_dim_ids_left.size(); l_le++ ) {
+    if( std::find( i_dim_ids_right.begin(),
+                   i_dim_ids_right.end(),
+                   i_dim_ids_left[l_le] ) != i_dim_ids_right.end() ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool einsum_ir::frontend::PathOptimizer::requires_permutation( std::vector< dim_t > const & i_dim_types ) {
+  // a permutation is required if the dimensions of one type are not adjacent
+  for( std::size_t l_d0 = 1; l_d0 < i_dim_types.size(); l_d0++ ) {
+    if( i_dim_types[l_d0] == i_dim_types[l_d0-1] ) {
+      continue;
+    }
+    for( std::size_t l_d1 = 0; l_d1+1 < l_d0; l_d1++ ) {
+      if( i_dim_types[l_d1] == i_dim_types[l_d0] ) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+double einsum_ir::frontend::PathOptimizer::cost_contraction( std::vector< int64_t > const & i_dim_ids_left,
+                                                             std::vector< int64_t > const & i_dim_ids_right,
+                                                             std::vector< int64_t > const & i_dim_ids_out,
+                                                             bool                           i_use_model ) const {
+  double l_size_c = 1;
+  double l_size_m = 1;
+  double l_size_n = 1;
+  double l_size_k = 1;
+
+  std::vector< dim_t > l_dim_types_left( i_dim_ids_left.size() );
+  std::vector< dim_t > l_dim_types_right( i_dim_ids_right.size() );
+  std::vector< dim_t > l_dim_types_out( i_dim_ids_out.size() );
+
+  for( std::size_t l_le = 0; l_le < i_dim_ids_left.size(); l_le++ ) {
+    int64_t l_id = i_dim_ids_left[l_le];
+    bool l_right = std::find( i_dim_ids_right.begin(), i_dim_ids_right.end(), l_id ) != i_dim_ids_right.end();
+    bool l_out   = std::find( i_dim_ids_out.begin(),   i_dim_ids_out.end(),   l_id ) != i_dim_ids_out.end();
+
+    if( l_right && l_out ) {
+      l_size_c *= m_dim_sizes->at( l_id );
+      l_dim_types_left[l_le] = dim_t::C;
+    }
+    else if( l_out ) {
+      l_size_m *= m_dim_sizes->at( l_id );
+      l_dim_types_left[l_le] = dim_t::M;
+    }
+    else if( l_right ) {
+      l_size_k *= m_dim_sizes->at( l_id );
+      l_dim_types_left[l_le] = dim_t::K;
+    }
+    else {
+      l_dim_types_left[l_le] = dim_t::I;
+    }
+  }
+
+  for( std::size_t l_ri = 0; l_ri < i_dim_ids_right.size(); l_ri++ ) {
+    int64_t l_id = i_dim_ids_right[l_ri];
+    bool l_left = std::find( i_dim_ids_left.begin(), i_dim_ids_left.end(), l_id ) != i_dim_ids_left.end();
+    bool l_out  = std::find( i_dim_ids_out.begin(),  i_dim_ids_out.end(),  l_id ) != i_dim_ids_out.end();
+
+    if( l_left && l_out ) {
+      l_dim_types_right[l_ri] = dim_t::C;
+    }
+    else if( l_out ) {
+      l_size_n *= m_dim_sizes->at( l_id );
+      l_dim_types_right[l_ri] = dim_t::N;
+    }
+    else if( l_left ) {
+      l_dim_types_right[l_ri] = dim_t::K;
+    }
+    else {
+      l_dim_types_right[l_ri] = dim_t::J;
+    }
+  }
+
+  for( std::size_t l_ou = 0; l_ou < i_dim_ids_out.size(); l_ou++ ) {
+    int64_t l_id = i_dim_ids_out[l_ou];
+    bool l_left  = std::find( i_dim_ids_left.begin(),  i_dim_ids_left.end(),  l_id ) != i_dim_ids_left.end();
+    bool l_right = std::find( i_dim_ids_right.begin(), i_dim_ids_right.end(), l_id ) != i_dim_ids_right.end();
+
+    if( l_left && l_right ) {
+      l_dim_types_out[l_ou] = dim_t::C;
+    }
+    else if( l_left ) {
+      l_dim_types_out[l_ou] = dim_t::M;
+    }
+    else {
+      l_dim_types_out[l_ou] = dim_t::N;
+    }
+  }
+
+  // guard against overflows of the integer arithmetic
+  int64_t l_size_out = size( i_dim_ids_out );
+  if(    l_size_out < 0
+      || l_size_c * l_size_m * l_size_n * l_size_k > std::numeric_limits< int64_t >::max() / 8 ) {
+    return std::numeric_limits< double >::max();
+  }
+
+  int64_t l_num_ops = backend::BinaryContraction::num_ops( l_size_c,
+                                                           l_size_m,
+                                                           l_size_n,
+                                                           l_size_k,
+                                                           m_ktype_first_touch,
+                                                           m_ktype_main );
+
+  if( !i_use_model ) {
+    return (double) l_num_ops + (double) l_size_out;
+  }
+
+  // time of the GEMM kernels, sizes beyond the ranges of the models are clamped
+  double l_gflops = 0;
+  model::common::get_time_model( (int) std::min( l_size_m, 65536.0 ),
+                                 (int) std::min( l_size_n, 65536.0 ),
+                                 (int) std::min( l_size_k, 65536.0 ),
+                                 0,
+                                 0,
+                                 m_model_dtype,
+                                 m_model_target,
+                                 l_gflops,
+                                 m_model_peak_gflops,
+                                 m_model_vector_size );
+  if( l_gflops <= 0 ) {
+    return std::numeric_limits< double >::max();
+  }
+  double l_time = (double) l_num_ops / ( l_gflops * 1.0E9 );
+
+  // time of the permutations, every permuted tensor is read and written once
+  double l_bytes_perm = 0;
+  if( requires_permutation( l_dim_types_left ) ) {
+    l_bytes_perm += 2.0 * size( i_dim_ids_left );
+  }
+  if( requires_permutation( l_dim_types_right ) ) {
+    l_bytes_perm += 2.0 * size( i_dim_ids_right );
+  }
+  if( requires_permutation( l_dim_types_out ) ) {
+    l_bytes_perm += 2.0 * l_size_out;
+  }
+  l_bytes_perm *= m_dtype_size;
+  l_time += l_bytes_perm / ( m_model_bandwidth * 1.0E9 );
+
+  return l_time;
+}
+
+double einsum_ir::frontend::PathOptimizer::contract( int64_t                                 i_id_left,
+                                                     int64_t                                 i_id_right,
+                                                     bool                                    i_use_model,
+                                                     std::vector< std::vector< int64_t > > & io_dim_ids,
+                                                     int64_t                               * io_histogram ) const {
+  std::vector< int64_t > l_dim_ids_out;
+  EinsumExpression::substring_out( io_dim_ids[i_id_left].size(),
+                                   io_dim_ids[i_id_right].size(),
+                                   io_dim_ids[i_id_left].data(),
+                                   io_dim_ids[i_id_right].data(),
+                                   io_histogram,
+                                   l_dim_ids_out );
+  io_dim_ids.push_back( l_dim_ids_out );
+
+  return cost_contraction( io_dim_ids[i_id_left],
+                           io_dim_ids[i_id_right],
+                           io_dim_ids.back(),
+                           i_use_model );
+}
+
+void einsum_ir::frontend::PathOptimizer::uncontract( int64_t                                 i_id_left,
+                                                     int64_t                                 i_id_right,
+                                                     std::vector< std::vector< int64_t > > & io_dim_ids,
+                                                     int64_t                               * io_histogram ) {
+  for( std::size_t l_di = 0; l_di < io_dim_ids.back().size(); l_di++ ) {
+    io_histogram[ io_dim_ids.back()[l_di] ]--;
+  }
+  for( std::size_t l_di = 0; l_di < io_dim_ids[i_id_left].size(); l_di++ ) {
+    io_histogram[ io_dim_ids[i_id_left][l_di] ]++;
+  }
+  for( std::size_t l_di = 0; l_di < io_dim_ids[i_id_right].size(); l_di++ ) {
+    io_histogram[ io_dim_ids[i_id_right][l_di] ]++;
+  }
+  io_dim_ids.pop_back();
+}
+
+void einsum_ir::frontend::PathOptimizer::init_state( std::vector< int64_t >                & o_tensor_ids,
+                                                     std::vector< std::vector< int64_t > > & o_dim_ids,
+                                                     std::vector< int64_t >                & o_histogram ) const {
+  o_tensor_ids.resize( m_num_tensors_in );
+  for( int64_t l_te = 0; l_te < m_num_tensors_in; l_te++ ) {
+    o_tensor_ids[l_te] = l_te;
+  }
+
+  o_dim_ids = m_dim_ids_in;
+  o_dim_ids.reserve( 2*m_num_tensors_in - 1 );
+
+  o_histogram.resize( m_num_dims );
+  EinsumExpression::histogram( m_num_dims,
+                               m_string_size,
+                               m_string_dim_ids,
+                               o_histogram.data() );
+}
+
+double einsum_ir::frontend::PathOptimizer::greedy( int64_t                                 i_num_tensors_final,
+                                                   std::vector< int64_t >                & io_tensor_ids,
+                                                   std::vector< std::vector< int64_t > > & io_dim_ids,
+                                                   int64_t                               * io_histogram,
+                                                   std::vector< int64_t >                & io_path ) const {
+  double l_cost = 0;
+  while( (int64_t) io_tensor_ids.size() > i_num_tensors_final ) {
+    int64_t l_num_tensors = io_tensor_ids.size();
+
+    // outer products are only considered if no other contraction is possible
+    bool l_connected = false;
+    for( int64_t l_t0 = 0; l_t0 < l_num_tensors && !l_connected; l_t0++ ) {
+      for( int64_t l_t1 = l_t0+1; l_t1 < l_num_tensors && !l_connected; l_t1++ ) {
+        l_connected = shares_dims( io_dim_ids[ io_tensor_ids[l_t0] ],
+                                   io_dim_ids[ io_tensor_ids[l_t1] ] );
+      }
+    }
+
+    // select contraction which reduces the memory footprint most, ties are broken through the cost;
+    // with a performance model the contraction with the lowest predicted time is selected
+    int64_t l_best_t0 = -1;
+    int64_t l_best_t1 = -1;
+    double l_best_score = std::numeric_limits< double >::max();
+    double l_best_cost  = std::numeric_limits< double >::max();
+
+    for( int64_t l_t0 = 0; l_t0 < l_num_tensors; l_t0++ ) {
+      for( int64_t l_t1 = l_t0+1; l_t1 < l_num_tensors; l_t1++ ) {
+        int64_t l_id_0 = io_tensor_ids[l_t0];
+        int64_t l_id_1 = io_tensor_ids[l_t1];
+
+        if(    l_connected
+            && !shares_dims( io_dim_ids[l_id_0], io_dim_ids[l_id_1] ) ) {
+          continue;
+        }
+
+        double l_cost_cont = contract( l_id_0,
+                                       l_id_1,
+                                       m_use_model,
+                                       io_dim_ids,
+                                       io_histogram );
+
+        int64_t l_size_out   = size( io_dim_ids.back() );
+        int64_t l_size_left  = size( io_dim_ids[l_id_0] );
+        int64_t l_size_right = size( io_dim_ids[l_id_1] );
+        double l_score = std::numeric_limits< double >::max();
+        if( m_use_model ) {
+          l_score = l_cost_cont;
+        }
+        else if( l_size_out >= 0 ) {
+          l_score = (double) l_size_out - (double) l_size_left - (double) l_size_right;
+        }
+
+        uncontract( l_id_0,
+                    l_id_1,
+                    io_dim_ids,
+                    io_histogram );
+
+        if(      l_best_t0 < 0
+            ||   l_score <  l_best_score
+            || ( l_score == l_best_score && l_cost_cont < l_best_cost ) ) {
+          l_best_t0 = l_t0;
+          l_best_t1 = l_t1;
+          l_best_score = l_score;
+          l_best_cost = l_cost_cont;
+        }
+      }
+    }
+
+    // perform selected contraction
+    int64_t l_id_0 = io_tensor_ids[l_best_t0];
+    int64_t l_id_1 = io_tensor_ids[l_best_t1];
+    l_cost += contract( l_id_0,
+                        l_id_1,
+                        m_use_model,
+                        io_dim_ids,
+                        io_histogram );
+    io_path.push_back( l_id_0 );
+    io_path.push_back( l_id_1 );
+
+    io_tensor_ids.erase( io_tensor_ids.begin() + l_best_t1 );
+    io_tensor_ids.erase( io_tensor_ids.begin() + l_best_t0 );
+    io_tensor_ids.push_back( io_dim_ids.size() - 1 );
+  }
+
+  return l_cost;
+}
+
+void einsum_ir::frontend::PathOptimizer::branch_and_bound_recursive( double                                  i_cost,
+                                                                     std::vector< int64_t >                & io_tensor_ids,
+                                                                     std::vector< std::vector< int64_t > > & io_dim_ids,
+                                                                     int64_t                               * io_histogram,
+                                                                     std::vector< int64_t >                & io_path ) {
+  int64_t l_num_tensors = io_tensor_ids.size();
+
+  if( l_num_tensors == 1 ) {
+    if( i_cost < m_cost_best_bnb ) {
+      m_cost_best_bnb = i_cost;
+      m_path_best_bnb = io_path;
+    }
+    return;
+  }
+
+  if( m_num_nodes_bnb >= m_max_num_nodes_bnb ) {
+    return;
+  }
+  m_num_nodes_bnb++;
+
+  // outer products are only considered if no other contraction is possible
+  bool l_connected = false;
+  for( int64_t l_t0 = 0; l_t0 < l_num_tensors && !l_connected; l_t0++ ) {
+    for( int64_t l_t1 = l_t0+1; l_t1 < l_num_tensors && !l_connected; l_t1++ ) {
+      l_connected = shares_dims( io_dim_ids[ io_tensor_ids[l_t0] ],
+                                 io_dim_ids[ io_tensor_ids[l_t1] ] );
+    }
+  }
+
+  // collect candidates
+  std::vector< std::pair< double, std::pair< int64_t, int64_t > > > l_candidates;
+  for( int64_t l_t0 = 0; l_t0 < l_num_tensors; l_t0++ ) {
+    for( int64_t l_t1 = l_t0+1; l_t1 < l_num_tensors; l_t1++ ) {
+      int64_t l_id_0 = io_tensor_ids[l_t0];
+      int64_t l_id_1 = io_tensor_ids[l_t1];
+
+      if(    l_connected
+          && !shares_dims( io_dim_ids[l_id_0], io_dim_ids[l_id_1] ) ) {
+        continue;
+      }
+
+      double l_cost_cont = contract( l_id_0,
+                                     l_id_1,
+                                     m_use_model,
+                                     io_dim_ids,
+                                     io_histogram );
+      uncontract( l_id_0,
+                  l_id_1,
+                  io_dim_ids,
+                  io_histogram );
+
+      if( i_cost + l_cost_cont < m_cost_best_bnb ) {
+        l_candidates.push_back( { l_cost_cont, { l_t0, l_t1 } } );
+      }
+    }
+  }
+
+  // explore cheapest candidates first
+  std::sort( l_candidates.begin(),
+             l_candidates.end() );
+
+  for( std::size_t l_ca = 0; l_ca < l_candidates.size(); l_ca++ ) {
+    if( i_cost + l_candidates[l_ca].first >= m_cost_best_bnb ) {
+      break;
+    }
+
+    int64_t l_t0 = l_candidates[l_ca].second.first;
+    int64_t l_t1 = l_candidates[l_ca].second.second;
+    int64_t l_id_0 = io_tensor_ids[l_t0];
+    int64_t l_id_1 = io_tensor_ids[l_t1];
+
+    double l_cost_cont = contract( l_id_0,
+                                   l_id_1,
+                                   m_use_model,
+                                   io_dim_ids,
+                                   io_histogram );
+    io_path.push_back( l_id_0 );
+    io_path.push_back( l_id_1 );
+    io_tensor_ids.erase( io_tensor_ids.begin() + l_t1 );
+    io_tensor_ids.erase( io_tensor_ids.begin() + l_t0 );
+    io_tensor_ids.push_back( io_dim_ids.size() - 1 );
+
+    branch_and_bound_recursive( i_cost + l_cost_cont,
+                                io_tensor_ids,
+                                io_dim_ids,
+                                io_histogram,
+                                io_path );
+
+    io_tensor_ids.pop_back();
+    io_tensor_ids.insert( io_tensor_ids.begin() + l_t0, l_id_0 );
+    io_tensor_ids.insert( io_tensor_ids.begin() + l_t1, l_id_1 );
+    io_path.pop_back();
+    io_path.pop_back();
+    uncontract( l_id_0,
+                l_id_1,
+                io_dim_ids,
+                io_histogram );
+  }
+}
+
+double einsum_ir::frontend::PathOptimizer::branch_and_bound( std::vector< int64_t > & o_path ) {
+  std::vector< int64_t > l_tensor_ids;
+  std::vector< std::vector< int64_t > > l_dim_ids;
+  std::vector< int64_t > l_hist;
+
+  // use greedy path as initial upper bound
+  init_state( l_tensor_ids,
+              l_dim_ids,
+              l_hist );
+  m_path_best_bnb.clear();
+  m_cost_best_bnb = greedy( 1,
+                            l_tensor_ids,
+                            l_dim_ids,
+                            l_hist.data(),
+                            m_path_best_bnb );
+  m_num_nodes_bnb = 0;
+
+  init_state( l_tensor_ids,
+              l_dim_ids,
+              l_hist );
+  std::vector< int64_t > l_path;
+  branch_and_bound_recursive( 0,
+                              l_tensor_ids,
+                              l_dim_ids,
+                              l_hist.data(),
+                              l_path );
+
+  o_path = m_path_best_bnb;
+  return m_cost_best_bnb;
+}
+
+double einsum_ir::frontend::PathOptimizer::dynamic_programming( std::vector< int64_t >                const & i_tensor_ids,
+                                                                std::vector< std::vector< int64_t > > const & i_dim_ids,
+                                                                std::vector< int64_t >                      & io_path ) const {
+  int64_t l_num_tensors = i_tensor_ids.size();
+  uint64_t l_num_sets = (uint64_t) 1 << l_num_tensors;
+  uint64_t l_set_all  = l_num_sets - 1;
+
+  // derive the tensors containing a dimension
+  std::vector< uint64_t > l_dim_tensors( m_num_dims, 0 );
+  std::vector< bool > l_dim_out( m_num_dims, false );
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    std::vector< int64_t > const & l_dim_ids_te = i_dim_ids[ i_tensor_ids[l_te] ];
+    for( std::size_t l_di = 0; l_di < l_dim_ids_te.size(); l_di++ ) {
+      l_dim_tensors[ l_dim_ids_te[l_di] ] |= (uint64_t) 1 << l_te;
+    }
+  }
+  for( std::size_t l_di = 0; l_di < m_dim_ids_out.size(); l_di++ ) {
+    l_dim_out[ m_dim_ids_out[l_di] ] = true;
+  }
+
+  // derive dimension ids of the tensors obtained by contracting a subset of the tensors
+  std::vector< std::vector< int64_t > > l_dim_ids( l_num_sets );
+  for( uint64_t l_se = 1; l_se < l_num_sets; l_se++ ) {
+    if( (l_se & (l_se-1)) == 0 ) {
+      int64_t l_te = __builtin_ctzll( l_se );
+      l_dim_ids[l_se] = i_dim_ids[ i_tensor_ids[l_te] ];
+      continue;
+    }
+    for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+      if(    (l_dim_tensors[l_di] & l_se) != 0
+          && (    (l_dim_tensors[l_di] & (l_set_all ^ l_se)) != 0
+               || l_dim_out[l_di] ) ) {
+        l_dim_ids[l_se].push_back( l_di );
+      }
+    }
+  }
+
+  // find optimal split of each subset
+  std::vector< double > l_cost( l_num_sets, 0 );
+  std::vector< uint64_t > l_split( l_num_sets, 0 );
+
+  for( uint64_t l_se = 1; l_se < l_num_sets; l_se++ ) {
+    if( (l_se & (l_se-1)) == 0 ) {
+      continue;
+    }
+
+    uint64_t l_lowest = l_se & (~l_se + 1);
+    l_cost[l_se] = std::numeric_limits< double >::infinity();
+
+    // first pass: only contractions sharing a dimension, second pass: outer products
+    for( int64_t l_pa = 0; l_pa < 2 && l_split[l_se] == 0; l_pa++ ) {
+      for( uint64_t l_s0 = (l_se-1) & l_se; l_s0 > 0; l_s0 = (l_s0-1) & l_se ) {
+        if( (l_s0 & l_lowest) == 0 ) {
+          continue;
+        }
+        uint64_t l_s1 = l_se ^ l_s0;
+
+        double l_cost_se = l_cost[l_s0] + l_cost[l_s1];
+        if( l_cost_se >= l_cost[l_se] ) {
+          continue;
+        }
+
+        if(    l_pa == 0
+            && !shares_dims( l_dim_ids[l_s0], l_dim_ids[l_s1] ) ) {
+          continue;
+        }
+
+        l_cost_se += cost_contraction( l_dim_ids[l_s0],
+                                       l_dim_ids[l_s1],
+                                       l_dim_ids[l_se],
+                                       m_use_model );
+
+        if( l_cost_se < l_cost[l_se] || l_split[l_se] == 0 ) {
+          l_cost[l_se] = l_cost_se;
+          l_split[l_se] = l_s0;
+        }
+      }
+    }
+  }
+
+  // append contractions using unique tensor ids
+  int64_t l_id_next = i_dim_ids.size();
+  std::function< int64_t( uint64_t ) > l_assemble = [&]( uint64_t i_set ) -> int64_t {
+    if( (i_set & (i_set-1)) == 0 ) {
+      return i_tensor_ids[ __builtin_ctzll( i_set ) ];
+    }
+    int64_t l_id_0 = l_assemble( l_split[i_set] );
+    int64_t l_id_1 = l_assemble( i_set ^ l_split[i_set] );
+    io_path.push_back( l_id_0 );
+    io_path.push_back( l_id_1 );
+    return l_id_next++;
+  };
+  l_assemble( l_set_all );
+
+  return l_cost[l_set_all];
+}
+
+einsum_ir::err_t einsum_ir::frontend::PathOptimizer::optimize( path_t    i_path_type,
+                                                              int64_t * o_path ) {
+  if( m_num_tensors_in < 2 ) {
+    return err_t::SUCCESS;
+  }
+
+  int64_t l_max_num_tensors_dp = std::min( m_max_num_tensors_dp, (int64_t) 63 );
+  if(    i_path_type == path_t::DYNAMIC_PROGRAMMING
+      && m_num_tensors_in > l_max_num_tensors_dp ) {
+    return err_t::INVALID_PATH;
+  }
+
+  std::vector< int64_t > l_tensor_ids;
+  std::vector< std::vector< int64_t > > l_dim_ids;
+  std::vector< int64_t > l_hist;
+  init_state( l_tensor_ids,
+              l_dim_ids,
+              l_hist );
+
+  std::vector< int64_t > l_path;
+  if( i_path_type == path_t::GREEDY ) {
+    greedy( 1,
+            l_tensor_ids,
+            l_dim_ids,
+            l_hist.data(),
+            l_path );
+  }
+  else if( i_path_type == path_t::BRANCH_AND_BOUND ) {
+    branch_and_bound( l_path );
+  }
+  else if( i_path_type == path_t::DYNAMIC_PROGRAMMING ) {
+    dynamic_programming( l_tensor_ids,
+                         l_dim_ids,
+                         l_path );
+  }
+  else if( i_path_type == path_t::AUTO_PATH ) {
+    // reduce the expression greedily until dynamic programming becomes feasible
+    int64_t l_num_tensors_dp = std::min( m_max_num_tensors_auto_dp, l_max_num_tensors_dp );
+    l_num_tensors_dp = std::max( l_num_tensors_dp, (int64_t) 1 );
+
+    greedy( l_num_tensors_dp,
+            l_tensor_ids,
+            l_dim_ids,
+            l_hist.data(),
+            l_path );
+    dynamic_programming( l_tensor_ids,
+                         l_dim_ids,
+                         l_path );
+  }
+  else {
+    return err_t::INVALID_PATH;
+  }
+
+  standard_tensor_ids( m_num_tensors_in - 1,
+                       l_path.data(),
+                       o_path );
+
+  return err_t::SUCCESS;
+}
+
+double einsum_ir::frontend::PathOptimizer::cost( int64_t const * i_path ) const {
+  int64_t l_num_conts = m_num_tensors_in - 1;
+
+  std::vector< int64_t > l_path( l_num_conts*2 );
+  EinsumExpression::unique_tensor_ids( l_num_conts,
+                                       i_path,
+                                       l_path.data() );
+
+  std::vector< int64_t > l_tensor_ids;
+  std::vector< std::vector< int64_t > > l_dim_ids;
+  std::vector< int64_t > l_hist;
+  init_state( l_tensor_ids,
+              l_dim_ids,
+              l_hist );
+
+  double l_cost = 0;
+  for( int64_t l_co = 0; l_co < l_num_conts; l_co++ ) {
+    l_cost += contract( l_path[l_co*2 + 0],
+                        l_path[l_co*2 + 1],
+                        m_use_model,
+                        l_dim_ids,
+                        l_hist.data() );
+  }
+
+  return l_cost;
+}
@@ -0,0 +1,294 @@
+#ifndef EINSUM_IR_FRONTEND_PATH_OPTIMIZER
+#define EINSUM_IR_FRONTEND_PATH_OPTIMIZER
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "../constants.h"
+#include "../model/src/common/common.h"
+
+namespace einsum_ir {
+  namespace frontend {
+    class PathOptimizer;
+  }
+}
+
+class einsum_ir::frontend::PathOptimizer {
+  private:
+    //! number of input tensors
+    int64_t m_num_tensors_in = 0;
+
+    //! number of dimensions
+    int64_t m_num_dims = 0;
+
+    //! size of the einsum string
+    int64_t m_string_size = 0;
+
+    //! einsum string containing the dimension ids
+    int64_t const * m_string_dim_ids = nullptr;
+
+    //! dimension ids of the input tensors
+    std::vector< std::vector< int64_t > > m_dim_ids_in;
+
+    //! dimension ids of the output tensor
+    std::vector< int64_t > m_dim_ids_out;
+
+    //! mapping from dim ids to sizes
+    std::map< int64_t, int64_t > const * m_dim_sizes = nullptr;
+
+    //! first-touch kernel type of the binary contractions
+    kernel_t m_ktype_first_touch = kernel_t::UNDEFINED_KTYPE;
+
+    //! main kernel type of the binary contractions
+    kernel_t m_ktype_main = kernel_t::UNDEFINED_KTYPE;
+
+    //! true if the costs are derived through the performance model
+    bool m_use_model = false;
+
+    //! target of the performance model
+    model::common::Model m_model_target = model::common::Model::GENERIC;
+
+    //! data type used in the performance model
+    model::common::DType m_model_dtype = model::common::DType::FP32;
+
+    //! peak GFLOPS of the generic performance model
+    double m_model_peak_gflops = 0;
+
+    //! vector size of the generic performance model
+    int64_t m_model_vector_size = 0;
+
+    //! bandwidth (GB/s) of the permutations
+    double m_model_bandwidth = 0;
+
+    //! size of a scalar in bytes
+    int64_t m_dtype_size = 4;
+
+    //! number of nodes visited by the current branch and bound search
+    int64_t m_num_nodes_bnb = 0;
+
+    //! cost of the best path found by the current branch and bound search
+    double m_cost_best_bnb = 0;
+
+    //! best path (unique tensor ids) found by the current branch and bound search
+    std::vector< int64_t > m_path_best_bnb;
+
+    /**
+     * Checks if a tensor has to be permuted before it can be passed to a GEMM kernel.
+     * This is the case if the dimensions of one type are not adjacent.
+     *
+     * @param i_dim_types types of the tensor's dimensions.
+     * @return true if a permutation is required, false otherwise.
+     **/
+    static bool requires_permutation( std::vector< dim_t > const & i_dim_types );
+
+    /**
+     * Derives the cost of a binary contraction.
+     * By default, the cost is the number of operations plus the number of entries in the output tensor.
+     * If a performance model is used, the cost is the predicted time of the GEMM kernels plus
+     * the time of the permutations which are required to bring the tensors into GEMM layout.
+     *
+     * @param i_dim_ids_left dimension ids of the left tensor.
+     * @param i_dim_ids_right dimension ids of the right tensor.
+     * @param i_dim_ids_out dimension ids of the output tensor.
+     * @param i_use_model if true, the performance model is used.
+     * @return cost of the binary contraction.
+     **/
+    double cost_contraction( std::vector< int64_t > const & i_dim_ids_left,
+                             std::vector< int64_t > const & i_dim_ids_right,
+                             std::vector< int64_t > const & i_dim_ids_out,
+                             bool                           i_use_model ) const;
+
+    /**
+     * Derives the number of entries of a tensor.
+     *
+     * @param i_dim_ids dimension ids of the tensor.
+     * @return number of entries, a negative value if the number does not fit into int64_t.
+     **/
+    int64_t size( std::vector< int64_t > const & i_dim_ids ) const;
+
+    /**
+     * Checks if two tensors share at least one dimension.
+     *
+     * @param i_dim_ids_left dimension ids of the left tensor.
+     * @param i_dim_ids_right dimension ids of the right tensor.
+     * @return true if at least one dimension is shared, false otherwise.
+     **/
+    static bool shares_dims( std::vector< int64_t > const & i_dim_ids_left,
+                             std::vector< int64_t > const & i_dim_ids_right );
+
+    /**
+     * Contracts two tensors of the current state.
+     * The dimension ids of the output tensor are appended to io_dim_ids.
+     *
+     * @param i_id_left id of the left tensor.
+     * @param i_id_right id of the right tensor.
+     * @param i_use_model if true, the cost is derived through the performance model.
+     * @param io_dim_ids dimension ids of all tensors, output will be appended.
+     * @param io_histogram histogram of the current state, will be updated.
+     * @return cost of the binary contraction.
+     **/
+    double contract( int64_t                                 i_id_left,
+                     int64_t                                 i_id_right,
+                     bool                                    i_use_model,
+                     std::vector< std::vector< int64_t > > & io_dim_ids,
+                     int64_t                               * io_histogram ) const;
+
+    /**
+     * Reverts the contraction of two tensors of the current state.
+     *
+     * @param i_id_left id of the left tensor.
+     * @param i_id_right id of the right tensor.
+     * @param io_dim_ids dimension ids of all tensors, last entry will be removed.
+     * @param io_histogram histogram of the current state, will be updated.
+     **/
+    static void uncontract( int64_t                                 i_id_left,
+                            int64_t                                 i_id_right,
+                            std::vector< std::vector< int64_t > > & io_dim_ids,
+                            int64_t                               * io_histogram );
+
+    /**
+     * Initializes the state of a path search with the input tensors.
+     *
+     * @param o_tensor_ids will be set to the ids of the input tensors.
+     * @param o_dim_ids will be set to the dimension ids of the input tensors.
+     * @param o_histogram will be set to the histogram of the einsum string.
+     **/
+    void init_state( std::vector< int64_t >                & o_tensor_ids,
+                     std::vector< std::vector< int64_t > > & o_dim_ids,
+                     std::vector< int64_t >                & o_histogram ) const;
+
+    /**
+     * Greedily contracts the pair of tensors which reduces the memory footprint most.
+     * Ties are broken through the number of operations.
+     * If a performance model is set, the pair with the lowest predicted time is contracted instead.
+     * Stops as soon as i_num_tensors_final tensors are left.
+     *
+     * @param i_num_tensors_final number of tensors which are left after the greedy contractions.
+     * @param io_tensor_ids ids of the tensors which are still part of the expression.
+     * @param io_dim_ids dimension ids of all tensors.
+     * @param io_histogram histogram of the current state.
+     * @param io_path contractions (unique tensor ids) will be appended.
+     * @return cost of the performed contractions.
+     **/
+    double greedy( int64_t                                 i_num_tensors_final,
+                   std::vector< int64_t >                & io_tensor_ids,
+                   std::vector< std::vector< int64_t > > & io_dim_ids,
+                   int64_t                               * io_histogram,
+                   std::vector< int64_t >                & io_path ) const;
+
+    /**
+     * Recursive part of the branch and bound search.
+     *
+     * @param i_cost cost of the contractions performed so far.
+     * @param io_tensor_ids ids of the tensors which are still part of the expression.
+     * @param io_dim_ids dimension ids of all tensors.
+     * @param io_histogram histogram of the current state.
+     * @param io_path contraction path of the contractions performed so far.
+     **/
+    void branch_and_bound_recursive( double                                  i_cost,
+                                     std::vector< int64_t >                & io_tensor_ids,
+                                     std::vector< std::vector< int64_t > > & io_dim_ids,
+                                     int64_t                               * io_histogram,
+                                     std::vector< int64_t >                & io_path );
+
+    /**
+     * Derives a contraction path through a depth-first branch and bound search.
+     * The search is initialized with the greedy path and stopped after m_max_num_nodes_bnb nodes.
+     *
+     * @param o_path will be set to the contraction path using unique tensor ids.
+     * @return cost of the derived contraction path.
+     **/
+    double branch_and_bound( std::vector< int64_t > & o_path );
+
+    /**
+     * Derives an optimal contraction of the given tensors through dynamic programming over all subsets.
+     * Outer products are only considered for subsets which can not be contracted otherwise.
+     *
+     * @param i_tensor_ids ids of the tensors which are still part of the expression.
+     * @param i_dim_ids dimension ids of all tensors.
+     * @param io_path contractions (unique tensor ids) will be appended.
+     * @return cost of the derived contractions.
+     **/
+    double dynamic_programming( std::vector< int64_t >                const & i_tensor_ids,
+                                std::vector< std::vector< int64_t > > const & i_dim_ids,
+                                std::vector< int64_t >                      & io_path ) const;
+
+  public:
+    //! maximum number of nodes visited by the branch and bound search
+    int64_t m_max_num_nodes_bnb = 100000;
+
+    //! maximum number of input tensors for which dynamic programming is used
+    int64_t m_max_num_tensors_dp = 16;
+
+    //! number of tensors for which the automatic selection switches from greedy contractions to dynamic programming
+    int64_t m_max_num_tensors_auto_dp = 12;
+
+    /**
+     * Translates a contraction path with unique tensor ids to the standard formulation.
+     * This is the inverse operation of EinsumExpression::unique_tensor_ids.
+     *
+     * @param i_num_conts number of binary contractions.
+     * @param i_path contraction path with unique tensor ids.
+     * @param o_path will be set to the contraction path in the standard formulation.
+     **/
+    static void standard_tensor_ids( int64_t         i_num_conts,
+                                     int64_t const * i_path,
+                                     int64_t       * o_path );
+
+    /**
+     * Initializes the path optimizer.
+     *
+     * @param i_num_dims number of dimensions.
+     * @param i_num_conts number of binary contractions.
+     * @param i_string_num_dims sizes of the substrings describing the input tensors and output tensor.
+     * @param i_string_dim_ids einsum string containing the dimension ids.
+     * @param i_dim_sizes mapping from dim ids to sizes.
+     * @param i_ktype_first_touch first-touch kernel type of the binary contractions.
+     * @param i_ktype_main main kernel type of the binary contractions.
+     **/
+    void init( int64_t                              i_num_dims,
+               int64_t                              i_num_conts,
+               int64_t                      const * i_string_num_dims,
+               int64_t                      const * i_string_dim_ids,
+               std::map< int64_t, int64_t > const * i_dim_sizes,
+               kernel_t                             i_ktype_first_touch,
+               kernel_t                             i_ktype_main );
+
+    /**
+     * Derives the costs of binary contractions through the performance model of the given target.
+     *
+     * @param i_target target of the performance model.
+     * @param i_dtype data type of the tensors.
+     * @param i_bandwidth bandwidth (GB/s) of the permutations, the target's default is used if not positive.
+     * @param i_peak_gflops peak GFLOPS, only used by the generic model.
+     * @param i_vector_size vector size, only used by the generic model.
+     * @param i_dtype_comp data type of the accumulation, the default of the tensors' data type is used if undefined.
+     * @return SUCCESS if the model was set, otherwise an appropriate error code.
+     **/
+    err_t set_model( model::common::Model i_target,
+                     data_t               i_dtype,
+                     double               i_bandwidth,
+                     double               i_peak_gflops,
+                     int64_t              i_vector_size,
+                     data_t               i_dtype_comp = data_t::UNDEFINED_DTYPE );
+
+    /**
+     * Derives a contraction path.
+     *
+     * @param i_path_type strategy which is used to derive the path.
+     * @param o_path will be set to the contraction path in the standard formulation.
+     * @return SUCCESS if a path was derived, otherwise an appropriate error code.
+     **/
+    err_t optimize( path_t    i_path_type,
+                    int64_t * o_path );
+
+    /**
+     * Derives the cost of a contraction path.
+     *
+     * @param i_path contraction path in the standard formulation.
+     * @return cost of the contraction path.
+     **/
+    double cost( int64_t const * i_path ) const;
+};
+
+#endif
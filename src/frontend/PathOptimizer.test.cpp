@@ -0,0 +1,242 @@
+#include "catch.hpp"
+#include "PathOptimizer.h"
+#include "EinsumExpression.h"
+#include <iostream>
+#include <sstream>
+
+TEST_CASE( "Standard contraction path generation.", "[path_opt]" ) {
+  int64_t l_path[8] = { 1, 2,  2, 3,  0, 1,  0, 1 };
+  int64_t l_path_unique[8] = { 0 };
+  int64_t l_path_standard[8] = { 0 };
+
+  einsum_ir::frontend::EinsumExpression::unique_tensor_ids( 4,
+                                                            l_path,
+                                                            l_path_unique );
+
+  einsum_ir::frontend::PathOptimizer::standard_tensor_ids( 4,
+                                                           l_path_unique,
+                                                           l_path_standard );
+
+  for( int64_t l_en = 0; l_en < 8; l_en++ ) {
+    REQUIRE( l_path_standard[l_en] == l_path[l_en] );
+  }
+}
+
+TEST_CASE( "Path optimization of a matrix chain.", "[path_opt]" ) {
+  // test case:
+  //
+  // ij,jk,kl->il
+  //
+  // char   id   size
+  //    i    0     64
+  //    j    1      2
+  //    k    2     64
+  //    l    3      2
+  //
+  // contracting jk,kl first is cheaper than ij,jk
+  std::map< int64_t, int64_t > l_dim_sizes = { {0, 64}, {1, 2}, {2, 64}, {3, 2} };
+
+  int64_t l_string_dim_ids[8] = { 0, 1,   // ij
+                                  1, 2,   // jk
+                                  2, 3,   // kl
+                                  0, 3 }; // il
+
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+
+  einsum_ir::frontend::PathOptimizer l_path_opt;
+  l_path_opt.init( 4,
+                   2,
+                   l_string_num_dims,
+                   l_string_dim_ids,
+                   &l_dim_sizes,
+                   einsum_ir::ZERO,
+                   einsum_ir::MADD );
+
+  int64_t l_path_ref[4] = { 1, 2,  0, 1 };
+  double l_cost_ref = l_path_opt.cost( l_path_ref );
+  // jk,kl->jl: 2*64*2*2 - 2*2 ops and 2*2 entries
+  // ij,jl->il: 64*2*2*2 - 64*2 ops and 64*2 entries
+  REQUIRE( l_cost_ref == 2*64*2*2 - 2*2 + 2*2 + 64*2*2*2 - 64*2 + 64*2 );
+
+  einsum_ir::path_t l_path_types[4] = { einsum_ir::AUTO_PATH,
+                                        einsum_ir::GREEDY,
+                                        einsum_ir::BRANCH_AND_BOUND,
+                                        einsum_ir::DYNAMIC_PROGRAMMING };
+
+  for( int64_t l_ty = 0; l_ty < 4; l_ty++ ) {
+    int64_t l_path[4] = { -1 };
+    einsum_ir::err_t l_err = l_path_opt.optimize( l_path_types[l_ty],
+                                                  l_path );
+    REQUIRE( l_err == einsum_ir::SUCCESS );
+    REQUIRE( l_path_opt.cost( l_path ) == l_cost_ref );
+    REQUIRE( l_path[0] == 1 );
+    REQUIRE( l_path[1] == 2 );
+    REQUIRE( l_path[2] == 0 );
+    REQUIRE( l_path[3] == 1 );
+  }
+}
+
+TEST_CASE( "Path optimization of a synthetic expression.", "[path_opt]" ) {
+  // test case:
+  //
+  // iaje,bf,dcba,cigj,dh->hgfei
+  //
+  // char   id   size
+  //    a    0     24
+  //    b    1     48
+  //    c    2     12
+  //    d    3     56
+  //    e    4     32
+  //    f    5     64
+  //    g    6      8
+  //    h    7     84
+  //    i    8      8
+  //    j    9     72
+  std::map< int64_t, int64_t > l_dim_sizes = { {0, 24}, {1, 48}, {2, 12}, {3, 56}, {4, 32},
+                                               {5, 64}, {6,  8}, {7, 84}, {8,  8}, {9, 72} };
+
+  int64_t l_string_dim_ids[22] = { 8, 0, 9, 4,
+                                   1, 5,
+                                   3, 2, 1, 0,
+                                   2, 8, 6, 9,
+                                   3, 7,
+                                   7, 6, 5, 4, 8 };
+
+  int64_t l_string_num_dims[6] = { 4, 2, 4, 4, 2, 5 };
+
+  einsum_ir::frontend::PathOptimizer l_path_opt;
+  l_path_opt.init( 10,
+                   4,
+                   l_string_num_dims,
+                   l_string_dim_ids,
+                   &l_dim_sizes,
+                   einsum_ir::ZERO,
+                   einsum_ir::MADD );
+
+  int64_t l_path_ref[8] = { 1, 2,  2, 3,  0, 1,  0, 1 };
+  double l_cost_ref = l_path_opt.cost( l_path_ref );
+
+  int64_t l_path_greedy[8] = { -1 };
+  int64_t l_path_bnb[8] = { -1 };
+  int64_t l_path_dp[8] = { -1 };
+
+  REQUIRE( l_path_opt.optimize( einsum_ir::GREEDY,              l_path_greedy ) == einsum_ir::SUCCESS );
+  REQUIRE( l_path_opt.optimize( einsum_ir::BRANCH_AND_BOUND,    l_path_bnb    ) == einsum_ir::SUCCESS );
+  REQUIRE( l_path_opt.optimize( einsum_ir::DYNAMIC_PROGRAMMING, l_path_dp     ) == einsum_ir::SUCCESS );
+
+  double l_cost_greedy = l_path_opt.cost( l_path_greedy );
+  double l_cost_bnb    = l_path_opt.cost( l_path_bnb );
+  double l_cost_dp     = l_path_opt.cost( l_path_dp );
+
+  REQUIRE( l_cost_bnb <= l_cost_greedy );
+  REQUIRE( l_cost_dp  <= l_cost_bnb );
+  REQUIRE( l_cost_dp  <= l_cost_ref );
+
+  // branch and bound explores the entire search space for small expressions
+  REQUIRE( l_cost_bnb == l_cost_dp );
+
+  // automatic selection reduces the expression greedily before using dynamic programming
+  int64_t l_path_auto[8] = { -1 };
+  l_path_opt.m_max_num_tensors_auto_dp = 3;
+  REQUIRE( l_path_opt.optimize( einsum_ir::AUTO_PATH, l_path_auto ) == einsum_ir::SUCCESS );
+  double l_cost_auto = l_path_opt.cost( l_path_auto );
+  REQUIRE( l_cost_auto <= l_cost_greedy );
+  REQUIRE( l_cost_auto >= l_cost_dp );
+
+  // dynamic programming is rejected for too many tensors
+  l_path_opt.m_max_num_tensors_dp = 4;
+  REQUIRE( l_path_opt.optimize( einsum_ir::DYNAMIC_PROGRAMMING, l_path_dp ) == einsum_ir::INVALID_PATH );
+}
+
+TEST_CASE( "Path optimization using a performance model.", "[path_opt]" ) {
+  // test case:
+  //
+  // iaje,bf,dcba,cigj,dh->hgfei
+  //
+  // see above for the dimension sizes
+  std::map< int64_t, int64_t > l_dim_sizes = { {0, 24}, {1, 48}, {2, 12}, {3, 56}, {4, 32},
+                                               {5, 64}, {6,  8}, {7, 84}, {8,  8}, {9, 72} };
+
+  int64_t l_string_dim_ids[22] = { 8, 0, 9, 4,
+                                   1, 5,
+                                   3, 2, 1, 0,
+                                   2, 8, 6, 9,
+                                   3, 7,
+                                   7, 6, 5, 4, 8 };
+
+  int64_t l_string_num_dims[6] = { 4, 2, 4, 4, 2, 5 };
+
+  einsum_ir::frontend::PathOptimizer l_path_opt_ops;
+  l_path_opt_ops.init( 10,
+                       4,
+                       l_string_num_dims,
+                       l_string_dim_ids,
+                       &l_dim_sizes,
+                       einsum_ir::ZERO,
+                       einsum_ir::MADD );
+
+  einsum_ir::frontend::PathOptimizer l_path_opt_model;
+  l_path_opt_model.init( 10,
+                         4,
+                         l_string_num_dims,
+                         l_string_dim_ids,
+                         &l_dim_sizes,
+                         einsum_ir::ZERO,
+                         einsum_ir::MADD );
+
+  // generic model requires the peak performance and vector size
+  REQUIRE( l_path_opt_model.set_model( einsum_ir::model::common::Model::GENERIC,
+                                       einsum_ir::FP32,
+                                       0,
+                                       0,
+                                       0 ) == einsum_ir::INVALID_MODEL );
+
+  einsum_ir::model::common::Model l_targets[4] = { einsum_ir::model::common::Model::ZEN5,
+                                                   einsum_ir::model::common::Model::M4,
+                                                   einsum_ir::model::common::Model::A76,
+                                                   einsum_ir::model::common::Model::GENERIC };
+
+  // the models must not report inconsistencies, e.g., overflows of the operation counts;
+  // stderr is captured until the end of the test case, also if an assertion fails
+  struct cerr_capture {
+    std::ostringstream str;
+    std::streambuf * buf = std::cerr.rdbuf( str.rdbuf() );
+    ~cerr_capture() {
+      std::cerr.rdbuf( buf );
+    }
+  } l_cerr;
+
+  for( int64_t l_ta = 0; l_ta < 4; l_ta++ ) {
+    REQUIRE( l_path_opt_model.set_model( l_targets[l_ta],
+                                         einsum_ir::FP32,
+                                         0,
+                                         100,
+                                         16 ) == einsum_ir::SUCCESS );
+
+    int64_t l_path_ops[8] = { -1 };
+    int64_t l_path_model[8] = { -1 };
+    REQUIRE( l_path_opt_ops.optimize( einsum_ir::DYNAMIC_PROGRAMMING, l_path_ops ) == einsum_ir::SUCCESS );
+    REQUIRE( l_path_opt_model.optimize( einsum_ir::DYNAMIC_PROGRAMMING, l_path_model ) == einsum_ir::SUCCESS );
+
+    // costs of the model are predicted times in seconds
+    double l_time_ops   = l_path_opt_model.cost( l_path_ops );
+    double l_time_model = l_path_opt_model.cost( l_path_model );
+    REQUIRE( l_time_model > 0 );
+    REQUIRE( l_time_model < 1 );
+    REQUIRE( l_time_model <= l_time_ops );
+
+    // the branch and bound search does not find a faster path
+    int64_t l_path_bnb[8] = { -1 };
+    REQUIRE( l_path_opt_model.optimize( einsum_ir::BRANCH_AND_BOUND, l_path_bnb ) == einsum_ir::SUCCESS );
+    REQUIRE( l_time_model <= Approx( l_path_opt_model.cost( l_path_bnb ) ) );
+
+    // the greedy search ranks the contractions by their predicted times
+    int64_t l_path_greedy[8] = { -1 };
+    REQUIRE( l_path_opt_model.optimize( einsum_ir::GREEDY, l_path_greedy ) == einsum_ir::SUCCESS );
+    double l_time_greedy = l_path_opt_model.cost( l_path_greedy );
+    REQUIRE( l_time_greedy < 1 );
+    REQUIRE( l_time_model <= Approx( l_time_greedy ) );
+  }
+
+  REQUIRE( l_cerr.str.str().empty() );
+}
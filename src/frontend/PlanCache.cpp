@@ -0,0 +1,96 @@
+#include "PlanCache.h"
+#include "../backend/EinsumNode.h"
+#include "../basic/env.h"
+
+einsum_ir::frontend::PlanCache & einsum_ir::frontend::PlanCache::get() {
+  static PlanCache l_cache;
+  return l_cache;
+}
+
+void einsum_ir::frontend::PlanCache::append_env( std::string & io_key ) {
+  // environment variables which are read by the einsum nodes
+  for( char const * l_env_var : backend::EinsumNode::env_vars() ) {
+    io_key += '|';
+    io_key += basic::env_string( l_env_var );
+  }
+}
+
+void einsum_ir::frontend::PlanCache::evict() {
+  while( (int64_t) m_plans.size() > m_capacity ) {
+    m_entries.erase( m_plans.back().first );
+    m_plans.pop_back();
+  }
+}
+
+void einsum_ir::frontend::PlanCache::set_capacity( int64_t i_capacity ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  m_capacity = i_capacity > 0 ? i_capacity : 0;
+  evict();
+}
+
+int64_t einsum_ir::frontend::PlanCache::capacity() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_capacity;
+}
+
+int64_t einsum_ir::frontend::PlanCache::size() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_plans.size();
+}
+
+int64_t einsum_ir::frontend::PlanCache::num_hits() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_num_hits;
+}
+
+int64_t einsum_ir::frontend::PlanCache::num_misses() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_num_misses;
+}
+
+void einsum_ir::frontend::PlanCache::clear() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  m_entries.clear();
+  m_plans.clear();
+  m_num_hits = 0;
+  m_num_misses = 0;
+}
+
+std::shared_ptr< einsum_ir::frontend::PlanCache::Plan > einsum_ir::frontend::PlanCache::find( std::string const & i_key ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  auto l_entry = m_entries.find( i_key );
+  if( l_entry == m_entries.end() ) {
+    m_num_misses++;
+    return nullptr;
+  }
+  m_num_hits++;
+
+  // move to front
+  m_plans.splice( m_plans.begin(),
+                  m_plans,
+                  l_entry->second );
+
+  return l_entry->second->second;
+}
+
+std::shared_ptr< einsum_ir::frontend::PlanCache::Plan > einsum_ir::frontend::PlanCache::insert( std::string             const & i_key,
+                                                                                                std::shared_ptr< Plan >         i_plan ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  auto l_entry = m_entries.find( i_key );
+  if( l_entry != m_entries.end() ) {
+    m_plans.splice( m_plans.begin(),
+                    m_plans,
+                    l_entry->second );
+    return l_entry->second->second;
+  }
+
+  if( m_capacity > 0 ) {
+    m_plans.emplace_front( i_key, i_plan );
+    m_entries[i_key] = m_plans.begin();
+    evict();
+  }
+
+  return i_plan;
+}
@@ -0,0 +1,136 @@
+#ifndef EINSUM_IR_FRONTEND_PLAN_CACHE
+#define EINSUM_IR_FRONTEND_PLAN_CACHE
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace einsum_ir {
+  namespace frontend {
+    class PlanCache;
+  }
+}
+
+/**
+ * Process-wide, thread-safe LRU cache of compiled plans.
+ * Plans are shared through reference counting, i.e., evicted plans stay alive as long as they are used.
+ * Cached plans are immutable, every user compiles its own nodes, kernels and scratch memory from a plan.
+ **/
+class einsum_ir::frontend::PlanCache {
+  public:
+    /**
+     * Compiled plan, i.e., the serialized outcome of the path, dimension order and loop optimizations.
+     **/
+    class Plan {
+      public:
+        //! serialized plan, layout as written by the save_plan functions of the frontends
+        std::vector< int64_t > m_data;
+    };
+
+  private:
+    //! protects the cache's data structures
+    std::mutex m_mutex;
+
+    //! maximum number of cached plans
+    int64_t m_capacity = 64;
+
+    //! cached plans, most recently used first
+    std::list< std::pair< std::string, std::shared_ptr< Plan > > > m_plans;
+
+    //! key to entry mapping
+    std::unordered_map< std::string,
+                        std::list< std::pair< std::string, std::shared_ptr< Plan > > >::iterator > m_entries;
+
+    //! number of successful lookups
+    int64_t m_num_hits = 0;
+
+    //! number of failed lookups
+    int64_t m_num_misses = 0;
+
+    /**
+     * Evicts the least recently used plans until the capacity is met.
+     * The cache's mutex has to be held by the caller.
+     **/
+    void evict();
+
+  public:
+    /**
+     * Gets the process-wide plan cache.
+     *
+     * @return plan cache.
+     **/
+    static PlanCache & get();
+
+    /**
+     * Appends the configuration of the backend, which is read from the environment, to a key.
+     *
+     * @param io_key key which is extended.
+     **/
+    static void append_env( std::string & io_key );
+
+    /**
+     * Sets the maximum number of cached plans.
+     *
+     * @param i_capacity maximum number of plans.
+     **/
+    void set_capacity( int64_t i_capacity );
+
+    /**
+     * Gets the maximum number of cached plans.
+     *
+     * @return maximum number of plans.
+     **/
+    int64_t capacity();
+
+    /**
+     * Gets the number of cached plans.
+     *
+     * @return number of plans.
+     **/
+    int64_t size();
+
+    /**
+     * Gets the number of successful lookups.
+     *
+     * @return number of hits.
+     **/
+    int64_t num_hits();
+
+    /**
+     * Gets the number of failed lookups.
+     *
+     * @return number of misses.
+     **/
+    int64_t num_misses();
+
+    /**
+     * Removes all plans from the cache.
+     **/
+    void clear();
+
+    /**
+     * Looks up the plan of the given key and marks it as most recently used.
+     *
+     * @param i_key key of the plan.
+     * @return plan, nullptr if no plan is cached for the key.
+     **/
+    std::shared_ptr< Plan > find( std::string const & i_key );
+
+    /**
+     * Inserts a plan into the cache.
+     * If a plan with the same key was inserted concurrently, the cached plan is kept.
+     *
+     * @param i_key key of the plan.
+     * @param i_plan plan which is inserted.
+     * @return cached plan of the key.
+     **/
+    std::shared_ptr< Plan > insert( std::string             const & i_key,
+                                    std::shared_ptr< Plan >         i_plan );
+};
+
+#endif
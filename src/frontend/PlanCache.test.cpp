@@ -0,0 +1,62 @@
+#include "catch.hpp"
+#include "PlanCache.h"
+
+TEST_CASE( "Least recently used eviction of the plan cache.", "[plan_cache]" ) {
+  einsum_ir::frontend::PlanCache l_cache;
+  l_cache.set_capacity( 2 );
+  REQUIRE( l_cache.capacity() == 2 );
+
+  std::shared_ptr< einsum_ir::frontend::PlanCache::Plan > l_plan_a = std::make_shared< einsum_ir::frontend::PlanCache::Plan >();
+  std::shared_ptr< einsum_ir::frontend::PlanCache::Plan > l_plan_b = std::make_shared< einsum_ir::frontend::PlanCache::Plan >();
+  std::shared_ptr< einsum_ir::frontend::PlanCache::Plan > l_plan_c = std::make_shared< einsum_ir::frontend::PlanCache::Plan >();
+
+  REQUIRE( l_cache.find( "a" ) == nullptr );
+  REQUIRE( l_cache.insert( "a", l_plan_a ) == l_plan_a );
+  REQUIRE( l_cache.insert( "b", l_plan_b ) == l_plan_b );
+  REQUIRE( l_cache.size() == 2 );
+
+  // a becomes the most recently used plan
+  REQUIRE( l_cache.find( "a" ) == l_plan_a );
+
+  // inserting c evicts b
+  REQUIRE( l_cache.insert( "c", l_plan_c ) == l_plan_c );
+  REQUIRE( l_cache.size() == 2 );
+  REQUIRE( l_cache.find( "b" ) == nullptr );
+  REQUIRE( l_cache.find( "a" ) == l_plan_a );
+  REQUIRE( l_cache.find( "c" ) == l_plan_c );
+
+  REQUIRE( l_cache.num_hits() == 3 );
+  REQUIRE( l_cache.num_misses() == 2 );
+
+  // evicted plans stay alive while used
+  REQUIRE( l_plan_b.use_count() == 1 );
+
+  // shrinking evicts the least recently used plans
+  l_cache.set_capacity( 1 );
+  REQUIRE( l_cache.size() == 1 );
+  REQUIRE( l_cache.find( "c" ) == l_plan_c );
+  REQUIRE( l_cache.find( "a" ) == nullptr );
+
+  l_cache.clear();
+  REQUIRE( l_cache.size() == 0 );
+  REQUIRE( l_cache.num_hits() == 0 );
+  REQUIRE( l_cache.num_misses() == 0 );
+}
+
+TEST_CASE( "Insertion of concurrently compiled plans into the plan cache.", "[plan_cache]" ) {
+  einsum_ir::frontend::PlanCache l_cache;
+
+  std::shared_ptr< einsum_ir::frontend::PlanCache::Plan > l_plan_0 = std::make_shared< einsum_ir::frontend::PlanCache::Plan >();
+  std::shared_ptr< einsum_ir::frontend::PlanCache::Plan > l_plan_1 = std::make_shared< einsum_ir::frontend::PlanCache::Plan >();
+
+  // the first inserted plan is kept
+  REQUIRE( l_cache.insert( "key", l_plan_0 ) == l_plan_0 );
+  REQUIRE( l_cache.insert( "key", l_plan_1 ) == l_plan_0 );
+  REQUIRE( l_cache.size() == 1 );
+
+  // disabled cache
+  l_cache.set_capacity( 0 );
+  REQUIRE( l_cache.size() == 0 );
+  REQUIRE( l_cache.insert( "key", l_plan_1 ) == l_plan_1 );
+  REQUIRE( l_cache.find( "key" ) == nullptr );
+}
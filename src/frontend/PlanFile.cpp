@@ -0,0 +1,160 @@
+#include "PlanFile.h"
+#include "../basic/hardware.h"
+#include "../basic/threading.h"
+#include <cstring>
+#include <fstream>
+
+namespace {
+  //! magic number identifying plan files
+  char const g_magic[8] = { 'E', 'I', 'R', '_', 'P', 'L', 'A', 'N' };
+  //! byte order mark
+  int64_t const g_byte_order = 0x0102030405060708;
+
+  /**
+   * Derives the FNV-1a checksum of a serialized plan.
+   *
+   * @param i_plan serialized plan.
+   * @return checksum.
+   **/
+  int64_t checksum( std::vector< int64_t > const & i_plan ) {
+    uint64_t l_hash = 14695981039346656037ULL;
+    unsigned char const * l_bytes = (unsigned char const *) i_plan.data();
+    for( std::size_t l_by = 0; l_by < i_plan.size() * sizeof(int64_t); l_by++ ) {
+      l_hash ^= l_bytes[l_by];
+      l_hash *= 1099511628211ULL;
+    }
+    return (int64_t) l_hash;
+  }
+
+  /**
+   * Writes an integer to a file.
+   *
+   * @param io_file file.
+   * @param i_value value which is written.
+   **/
+  void write_int( std::ofstream & io_file,
+                  int64_t         i_value ) {
+    io_file.write( (char const *) &i_value, sizeof(int64_t) );
+  }
+
+  /**
+   * Writes a string to a file.
+   *
+   * @param io_file file.
+   * @param i_str string which is written.
+   **/
+  void write_string( std::ofstream     & io_file,
+                     std::string const & i_str ) {
+    write_int( io_file, i_str.size() );
+    io_file.write( i_str.data(), i_str.size() );
+  }
+
+  /**
+   * Reads an integer from a file.
+   *
+   * @param io_file file.
+   * @param o_value will be set to the read value.
+   * @return true if successful, false otherwise.
+   **/
+  bool read_int( std::ifstream & io_file,
+                 int64_t       & o_value ) {
+    return (bool) io_file.read( (char *) &o_value, sizeof(int64_t) );
+  }
+
+  /**
+   * Reads a string from a file.
+   *
+   * @param io_file file.
+   * @param o_str will be set to the read string.
+   * @return true if successful, false otherwise.
+   **/
+  bool read_string( std::ifstream & io_file,
+                    std::string   & o_str ) {
+    int64_t l_size = 0;
+    if( !read_int( io_file, l_size ) || l_size < 0 || l_size > (1 << 24) ) {
+      return false;
+    }
+    o_str.resize( l_size );
+    return (bool) io_file.read( &o_str[0], l_size );
+  }
+}
+
+std::string einsum_ir::frontend::PlanFile::host_cpu() {
+  return basic::host_cpu();
+}
+
+einsum_ir::err_t einsum_ir::frontend::PlanFile::write( std::string            const & i_path,
+                                                       std::string            const & i_key,
+                                                       std::vector< int64_t > const & i_plan ) {
+  std::ofstream l_file( i_path, std::ios::binary | std::ios::trunc );
+  if( !l_file ) {
+    return err_t::INVALID_PLAN;
+  }
+
+  l_file.write( g_magic, sizeof(g_magic) );
+  write_int( l_file, m_version );
+  write_int( l_file, g_byte_order );
+  write_int( l_file, basic::get_num_threads_available() );
+  write_string( l_file, host_cpu() );
+  write_string( l_file, i_key );
+
+  write_int( l_file, i_plan.size() );
+  l_file.write( (char const *) i_plan.data(), i_plan.size() * sizeof(int64_t) );
+  write_int( l_file, checksum( i_plan ) );
+
+  return l_file ? err_t::SUCCESS : err_t::INVALID_PLAN;
+}
+
+einsum_ir::err_t einsum_ir::frontend::PlanFile::read( std::string            const & i_path,
+                                                      std::string            const & i_key,
+                                                      std::vector< int64_t >       & o_plan ) {
+  std::ifstream l_file( i_path, std::ios::binary );
+  if( !l_file ) {
+    return err_t::INVALID_PLAN;
+  }
+
+  // format
+  char l_magic[8];
+  int64_t l_version = 0;
+  int64_t l_byte_order = 0;
+  if(    !l_file.read( l_magic, sizeof(l_magic) )
+      || std::memcmp( l_magic, g_magic, sizeof(g_magic) ) != 0
+      || !read_int( l_file, l_version )
+      || l_version != m_version
+      || !read_int( l_file, l_byte_order )
+      || l_byte_order != g_byte_order ) {
+    return err_t::INVALID_PLAN;
+  }
+
+  // host
+  int64_t l_num_threads = 0;
+  std::string l_cpu;
+  std::string l_key;
+  if(    !read_int( l_file, l_num_threads )
+      || !read_string( l_file, l_cpu )
+      || !read_string( l_file, l_key ) ) {
+    return err_t::INVALID_PLAN;
+  }
+  if(    l_num_threads != basic::get_num_threads_available()
+      || l_cpu != host_cpu()
+      || l_key != i_key ) {
+    return err_t::PLAN_MISMATCH;
+  }
+
+  // plan
+  int64_t l_size = 0;
+  if( !read_int( l_file, l_size ) || l_size < 0 || l_size > (int64_t(1) << 28) ) {
+    return err_t::INVALID_PLAN;
+  }
+  std::vector< int64_t > l_plan( l_size );
+  int64_t l_checksum = 0;
+  if(    !l_file.read( (char *) l_plan.data(), l_size * sizeof(int64_t) )
+      || !read_int( l_file, l_checksum )
+      || l_checksum != checksum( l_plan ) ) {
+    return err_t::INVALID_PLAN;
+  }
+
+  o_plan = l_plan;
+
+  return err_t::SUCCESS;
+}
@@ -0,0 +1,64 @@
+#ifndef EINSUM_IR_FRONTEND_PLAN_FILE
+#define EINSUM_IR_FRONTEND_PLAN_FILE
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../constants.h"
+
+namespace einsum_ir {
+  namespace frontend {
+    class PlanFile;
+  }
+}
+
+/**
+ * Versioned binary format of serialized plans.
+ *
+ * A file consists of a header and the serialized plan:
+ *   magic "EIR_PLAN", format version, byte order mark,
+ *   number of threads, host CPU, key of the plan,
+ *   size of the plan, plan entries, checksum of the plan.
+ * Integers are stored as 64-bit values, strings by their size followed by their characters.
+ **/
+class einsum_ir::frontend::PlanFile {
+  public:
+    //! version of the format, increased on every incompatible change
+    static int64_t const m_version = 1;
+
+    /**
+     * Gets a description of the host CPU.
+     * Plans are only valid on the CPU they were derived for.
+     *
+     * @return description of the host CPU.
+     **/
+    static std::string host_cpu();
+
+    /**
+     * Writes a serialized plan to a file.
+     *
+     * @param i_path path of the file.
+     * @param i_key key of the plan, e.g., describing the einsum expression.
+     * @param i_plan serialized plan.
+     * @return SUCCESS if successful, INVALID_PLAN if the file could not be written.
+     **/
+    static err_t write( std::string            const & i_path,
+                        std::string            const & i_key,
+                        std::vector< int64_t > const & i_plan );
+
+    /**
+     * Reads a serialized plan from a file and validates it against the host.
+     *
+     * @param i_path path of the file.
+     * @param i_key expected key of the plan.
+     * @param o_plan will be set to the serialized plan.
+     * @return SUCCESS if successful,
+     *         INVALID_PLAN if the file could not be read or is corrupt,
+     *         PLAN_MISMATCH if the plan was derived for another CPU, number of threads or key.
+     **/
+    static err_t read( std::string            const & i_path,
+                       std::string            const & i_key,
+                       std::vector< int64_t >       & o_plan );
+};
+
+#endif
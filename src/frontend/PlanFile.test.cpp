@@ -0,0 +1,47 @@
+#include <cstdio>
+#include <fstream>
+#include "catch.hpp"
+#include "PlanFile.h"
+
+TEST_CASE( "Writing and reading a plan file.", "[plan_file]" ) {
+  std::string l_path = "einsum_ir_plan_file_test.plan";
+  std::vector< int64_t > l_plan = { 3, 1, -7, 42, 0, 1234567890123 };
+
+  einsum_ir::err_t l_err = einsum_ir::frontend::PlanFile::write( l_path,
+                                                                 "key",
+                                                                 l_plan );
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  std::vector< int64_t > l_plan_read;
+  l_err = einsum_ir::frontend::PlanFile::read( l_path,
+                                               "key",
+                                               l_plan_read );
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+  REQUIRE( l_plan_read == l_plan );
+
+  // plan of another expression
+  l_err = einsum_ir::frontend::PlanFile::read( l_path,
+                                               "other_key",
+                                               l_plan_read );
+  REQUIRE( l_err == einsum_ir::PLAN_MISMATCH );
+
+  // corrupt the last plan entry
+  {
+    std::fstream l_file( l_path, std::ios::binary | std::ios::in | std::ios::out );
+    l_file.seekp( -2 * (int64_t) sizeof(int64_t), std::ios::end );
+    int64_t l_value = 5;
+    l_file.write( (char const *) &l_value, sizeof(int64_t) );
+  }
+  l_err = einsum_ir::frontend::PlanFile::read( l_path,
+                                               "key",
+                                               l_plan_read );
+  REQUIRE( l_err == einsum_ir::INVALID_PLAN );
+
+  std::remove( l_path.c_str() );
+
+  // missing file
+  l_err = einsum_ir::frontend::PlanFile::read( l_path,
+                                               "key",
+                                               l_plan_read );
+  REQUIRE( l_err == einsum_ir::INVALID_PLAN );
+}
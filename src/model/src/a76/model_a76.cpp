@@ -189,9 +189,9 @@ namespace einsum_ir::model::a76 {
     double time_1_area_k3 = 0.0;
     double time_1_area_k4 = 0.0;
 
-    if (gesamt_flops != (i_m * i_n * i_k * 2.0)) {
+    if (gesamt_flops != (2.0 * i_m * i_n * i_k)) {
       std::cerr << "Flops calculation is wrong!" << std::endl;
-      std::cout << gesamt_flops << " != " << (i_m * i_n * i_k * 2.0) << std::endl;
+      std::cout << gesamt_flops << " != " << (2.0 * i_m * i_n * i_k) << std::endl;
     }
 
     if (kernels.k1.m > 0 && kernels.k1.n > 0) {
@@ -236,7 +236,16 @@ namespace einsum_ir::model::a76 {
                                  int i_transpose_a,
                                  int i_transpose_b,
                                  einsum_ir::model::common::DType i_dtype) {
-    (void)i_dtype;
+    // FP16 FMAs process twice the elements of FP32 FMAs,
+    // i.e., an FP16 kernel has the registers and instructions of the FP32 kernel with half the M size
+    if (i_dtype == einsum_ir::model::common::DType::FP16) {
+      return 2.0 * get_interpolated_gflops((i_m + 1) / 2,
+                                           i_n,
+                                           i_k,
+                                           i_transpose_a,
+                                           i_transpose_b,
+                                           einsum_ir::model::common::DType::FP32);
+    }
     jit_sizes kernels;
 
     get_blocking(i_m,
@@ -1,5 +1,6 @@
 #include "catch.hpp"
 #include "model_a76.h"
+#include "../common/common.h"
 
 TEST_CASE( "Test full size of gflops_table (a76)", "[a76]") {
 
@@ -34,4 +35,18 @@ TEST_CASE( "Get index", "[a76]") {
 
     idx = get_exact_index(N_VALUES, N_SIZE, 20);
     REQUIRE(idx == 14);
-}
\ No newline at end of file
+}
+
+TEST_CASE( "FP16 GFLOPS are derived from the FP32 kernels (a76)", "[a76]") {
+
+    using namespace einsum_ir::model::a76;
+    using einsum_ir::model::common::DType;
+
+    double gflops_fp32 = get_interpolated_gflops(16, 8, 64, 0, 0, DType::FP32);
+    double gflops_fp16 = get_interpolated_gflops(32, 8, 64, 0, 0, DType::FP16);
+    REQUIRE(gflops_fp16 == Approx(2.0 * gflops_fp32));
+
+    gflops_fp32 = get_interpolated_gflops(9, 5, 17, 1, 0, DType::FP32);
+    gflops_fp16 = get_interpolated_gflops(17, 5, 17, 1, 0, DType::FP16);
+    REQUIRE(gflops_fp16 == Approx(2.0 * gflops_fp32));
+}
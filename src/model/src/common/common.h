@@ -27,7 +27,8 @@ namespace einsum_ir::model::common {
    */
   enum class DType {
     FP32,
-    FP64
+    FP64,
+    FP16
   };
 
   /**
@@ -38,7 +39,7 @@ namespace einsum_ir::model::common {
    * @param i_k The K dimension size.
    * @param i_trans_a The transpose flag for matrix A (0 or 1).
    * @param i_trans_b The transpose flag for matrix B (0 or 1).
-   * @param i_dtype The data type (FP32 or FP64).
+   * @param i_dtype The data type (FP32, FP64 or FP16).
    * @param i_model The performance model to use.
    * @param i_peak_gflops Optional peak GFLOPS for generic model (default: 0.0).
    * @param i_vector_size Optional vector width for generic model (default: 0).
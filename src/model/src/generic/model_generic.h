@@ -15,7 +15,7 @@ namespace einsum_ir::model::generic {
    * @param i_k The K dimension size.
    * @param i_trans_a The transpose flag for matrix A (0 or 1).
    * @param i_trans_b The transpose flag for matrix B (0 or 1).
-   * @param i_dtype The data type (FP32 or FP64).
+   * @param i_dtype The data type (FP32, FP64 or FP16).
    * @param i_peak_gflops The peak GFLOPS of the architecture.
    * @param i_vector_size The vector width in bytes.
    *
@@ -46,7 +46,15 @@ namespace einsum_ir::model::m4 {
                                  int i_k,
                                  int i_trans_b,
                                  einsum_ir::model::common::DType i_dtype) {
-    (void)i_dtype;
+    // FP16 FMAs process twice the elements of FP32 FMAs,
+    // i.e., an FP16 kernel has the registers and instructions of the FP32 kernel with half the M size
+    if (i_dtype == einsum_ir::model::common::DType::FP16) {
+      return 2.0 * get_interpolated_gflops((i_m + 1) / 2,
+                                           i_n,
+                                           i_k,
+                                           i_trans_b,
+                                           einsum_ir::model::common::DType::FP32);
+    }
     if (i_trans_b < 0) i_trans_b = 0;
     if (i_trans_b > 1) i_trans_b = 1;
 
@@ -1,5 +1,6 @@
 #include "catch.hpp"
 #include "model_m4.h"
+#include "../common/common.h"
 
 TEST_CASE( "Test full size of gflops_table (m4)" , "[m4]" ) {
     using namespace einsum_ir::model::m4;
@@ -38,4 +39,13 @@ TEST_CASE( "Find bounds for (M & N) ", "[m4]" ) {
     find_bounds_mn(M_VALUES, M_SIZE, 270, idx_lower, t);
     REQUIRE(idx_lower == M_SIZE - 3);
     REQUIRE(t == Approx(13.0/14.0));
-}
\ No newline at end of file
+}
+
+TEST_CASE( "FP16 GFLOPS are derived from the FP32 kernels (m4)", "[m4]" ) {
+    using namespace einsum_ir::model::m4;
+    using einsum_ir::model::common::DType;
+
+    double gflops_fp32 = get_interpolated_gflops(64, 32, 128, 0, DType::FP32);
+    double gflops_fp16 = get_interpolated_gflops(128, 32, 128, 0, DType::FP16);
+    REQUIRE(gflops_fp16 == Approx(2.0 * gflops_fp32));
+}
@@ -42,6 +42,7 @@ namespace einsum_ir::model::zen5 {
   }
 
   double get_interpolated_gflops(int i_m, int i_n, int i_k, int i_trans_a, int i_trans_b, einsum_ir::model::common::DType i_dtype) {
+    // Zen5 has no FP16 FMAs, FP16 data is computed in FP32
     (void)i_dtype;
     if (i_trans_a < 0) i_trans_a = 0;
     if (i_trans_a > 1) i_trans_a = 1;
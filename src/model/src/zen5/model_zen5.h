@@ -31,7 +31,7 @@ namespace einsum_ir::model::zen5 {
    * @param i_k The K dimension size.
    * @param i_trans_a The transpose flag for matrix A (0 or 1).
    * @param i_trans_b The transpose flag for matrix B (0 or 1).
-   * @param i_dtype The data type (FP32 or FP64).
+   * @param i_dtype The data type (FP32, FP64 or FP16).
    *
    * @return The interpolated GFLOPS value.
    */